@@ -13,6 +13,11 @@
   Select the "ESP32 Dev Module" as the board.
 
   The sensor data and configuration are written to microSD using SdFat
+  The sensor data is logged by mySensors.writeLog. The rows are buffered and written to the log file in whole 512-byte sectors.
+  The file is synced once per second, instead of after every row. The writing is done by a FreeRTOS task (beginLogTask),
+  so the sampling loop never waits for the SD card. Each log file is pre-allocated and the log is rotated to a new file every 10MB.
+  The log index (dataLog.idx) records where each file starts, plus every 100th row, so the next log file is found without
+  scanning the card. After a power loss, beginLog recovers every row which was synced
                                   
   License: MIT
   Please see LICENSE.md for more details
@@ -39,20 +44,10 @@ int qwiicPower = 0; //Thing Plus C digital pin 0 is connected to the v-reg that
 #endif
 
 
-// Define the log file type - use the same type as the Qwiic Universal Auto-Detect library
-#if SFE_QUAD_SD_FAT_TYPE == 1
-  File32 sensorDataFile; //File that all sensor data is written to
-#elif SFE_QUAD_SD_FAT_TYPE == 2
-  ExFile sensorDataFile; //File that all sensor data is written to
-#elif SFE_QUAD_SD_FAT_TYPE == 3
-  FsFile sensorDataFile; //File that all sensor data is written to
-#else // SD_FAT_TYPE == 0
-  File sensorDataFile; //File that all sensor data is written to
-#endif  // SD_FAT_TYPE
-
-char sensorDataFileName[30] = ""; // This will hold the name of the sensorDataFile
-bool onlineDataLogging; //This flag indicates if we are logging data to sensorDataFile
+bool onlineDataLogging; //This flag indicates if we are logging data to the log file
 
+const uint32_t maxLogFileSize = 10000000; // Rotate the log file every 10MB. Each file is pre-allocated to this size
+const uint32_t logIndexInterval = 100; // Add every 100th row to the log index
 
 void setup()
 {
@@ -93,21 +88,18 @@ void setup()
   readConfig();
 
   // mySensors.beginStorage has done the sd.begin for us
-  // Open the next available log file
-  onlineDataLogging = false;
-  Serial.println(F("Finding the next available log file..."));
-  if (findNextAvailableLog(sensorDataFileName, "dataLog", false)) // Do not reuse empty files - to save time
-  {
-    // O_CREAT - create the file if it does not exist
-    // O_APPEND - seek to the end of the file prior to each write
-    // O_WRITE - open for write
-    onlineDataLogging = sensorDataFile.open(sensorDataFileName, O_CREAT | O_APPEND | O_WRITE) == true;
-  }
+  // Open the next log file. beginLog writes the sensor and sense names to it
+  mySensors._logWriter.setSyncBudget(1000, 0); // Sync the log file once per second
+  onlineDataLogging = mySensors.beginLog("dataLog", maxLogFileSize, 0, logIndexInterval);
   
   if (onlineDataLogging)
   {
+    mySensors.beginLogTask(); // Write the log from a FreeRTOS task. The task is restarted when the log is rotated
+
+    char logFileName[SFE_QUAD_LOG_NAME_LEN];
+    mySensors.getLogFileName(mySensors.getLogFileNumber(), logFileName);
     Serial.print(F("Logging sensor data to: "));
-    Serial.println(sensorDataFileName);
+    Serial.println(logFileName);
   }
   else
   {
@@ -143,13 +135,9 @@ void setup()
 
   mySensors.getSensorNames(); // Print the sensor names helper
   Serial.println(mySensors.readings);
-  if (onlineDataLogging)
-    sensorDataFile.println(mySensors.readings);
 
   mySensors.getSenseNames(); // Print the sense names helper
   Serial.println(mySensors.readings);
-  if (onlineDataLogging)
-    sensorDataFile.println(mySensors.readings);
 }
 
 void loop()
@@ -169,8 +157,9 @@ void loop()
     if (onlineDataLogging)
     {
       digitalWrite(LED_BUILTIN, HIGH);
-      sensorDataFile.println(mySensors.readings); // Write the data to file
-      sensorDataFile.sync(); // This will help prevent data loss if the power is removed during logging
+      // Add the data to the buffer. The task writes whole sectors and syncs once per second. The log file is rotated when it is full
+      // The index timestamp is millis, which restarts at power-on. Use the RTC time (see Example7) if you want to use findLogPosition across power cycles
+      mySensors.writeLog(mySensors.readings, millis());
       digitalWrite(LED_BUILTIN, LOW);
     }
   }
@@ -192,19 +181,14 @@ void openLoggingMenu(void)
   
   if (onlineDataLogging) // Open a new log file - the sense names may have changed
   {
-    sensorDataFile.close();
-    
-    Serial.println(F("Finding the next available log file..."));
-    
-    if (findNextAvailableLog(sensorDataFileName, "dataLog", false)) // Do not reuse empty files - to save time
-    {
-      onlineDataLogging = sensorDataFile.open(sensorDataFileName, O_CREAT | O_APPEND | O_WRITE) == true;
-    }
+    onlineDataLogging = mySensors.beginLog("dataLog", maxLogFileSize, 0, logIndexInterval); // beginLog closes the old log file
     
     if (onlineDataLogging)
     {
+      char logFileName[SFE_QUAD_LOG_NAME_LEN];
+      mySensors.getLogFileName(mySensors.getLogFileNumber(), logFileName);
       Serial.print(F("Logging sensor data to: "));
-      Serial.println(sensorDataFileName);
+      Serial.println(logFileName);
     }
     else
     {
@@ -214,13 +198,9 @@ void openLoggingMenu(void)
 
   mySensors.getSensorNames(); // Print the sensor names helper - it may have changed
   Serial.println(mySensors.readings);
-  if (onlineDataLogging)
-    sensorDataFile.println(mySensors.readings);
 
   mySensors.getSenseNames(); // Print the sense names helper - it may have changed
   Serial.println(mySensors.readings);
-  if (onlineDataLogging)
-    sensorDataFile.println(mySensors.readings);
 }
 
 void openSettingMenu(void)
@@ -231,13 +211,21 @@ void openSettingMenu(void)
 void writeConfig(void)
 {
   mySensors.getSensorAndMenuConfiguration();
+  if (onlineDataLogging)
+    mySensors.endLogTask(); // The task must not access the SD card while the configuration is written
   if (mySensors.writeConfigurationToStorage(false)) // Set append to false - overwrite the configuration
     Serial.println(F("Logger configuration written to file"));
+  if (onlineDataLogging)
+    mySensors.beginLogTask();
 }
 
 void readConfig(void)
 {
+  if (onlineDataLogging)
+    mySensors.endLogTask(); // The task must not access the SD card while the configuration is read
   mySensors.readConfigurationFromStorage();
+  if (onlineDataLogging)
+    mySensors.beginLogTask();
   mySensors.applySensorAndMenuConfiguration();
 }
 
@@ -245,71 +233,8 @@ void stopLogging(void)
 {
   if (onlineDataLogging)
   {
-    sensorDataFile.close();
+    mySensors.endLog(); // Write everything, release the unused pre-allocation and close the log file
     onlineDataLogging = false;
     Serial.println(F("Log file closed"));
   }
 }
-
-//Returns next available log file name
-bool findNextAvailableLog(char *newFileName, const char *fileLeader, bool reuseEmpty)
-{
-// Define the log file type - use the same type as the Qwiic Universal Auto-Detect library
-#if SFE_QUAD_SD_FAT_TYPE == 1
-  File32 newFile;
-#elif SFE_QUAD_SD_FAT_TYPE == 2
-  ExFile newFile;
-#elif SFE_QUAD_SD_FAT_TYPE == 3
-  FsFile newFile;
-#else // SD_FAT_TYPE == 0
-  File newFile;
-#endif  // SD_FAT_TYPE
-
-  //Search for next available log file
-  int newFileNumber = 0;
-  bool keepGoing = true;
-  while (keepGoing)
-  {
-    char newFileNumberStr[6]; // Five digits plus null
-    if (newFileNumber < 10)
-      sprintf(newFileNumberStr, "0000%d", newFileNumber);
-    else if (newFileNumber < 100)
-      sprintf(newFileNumberStr, "000%d", newFileNumber);
-    else if (newFileNumber < 1000)
-      sprintf(newFileNumberStr, "00%d", newFileNumber);
-    else if (newFileNumber < 10000)
-      sprintf(newFileNumberStr, "0%d", newFileNumber);
-    else
-      sprintf(newFileNumberStr, "%d", newFileNumber);
-    sprintf(newFileName, "%s%s.csv", fileLeader, newFileNumberStr); //Splice the new file number into this file name. Max no. is 99999.
-
-    // Use the same instance of sd as the Qwiic Universal Auto-Detect library
-    if (mySensors.sd.exists(newFileName) == false)
-    {
-      keepGoing = false; //File name not found so we will use it.
-    }
-    else
-    {
-      if (reuseEmpty) // If resuseEmpty is true, open the file and see if it is empty. If it is, use it. Slow but efficient...
-      {
-        newFile.open(newFileName, O_READ); // Open the existing file
-        size_t fileSize = newFile.fileSize(); // Get its size
-        newFile.close(); // Close the file
-        if (fileSize == 0)
-          keepGoing = false; // File is empty so we will use it
-      }
-    }
-
-    newFileNumber++; //Get ready to try the next number
-    
-    if (newFileNumber >= 100000)
-      keepGoing = false; // Have we hit the maximum number of files?
-  }
-
-  if (newFileNumber >= 100000) // Have we hit the maximum number of files?
-  {
-    return (false);
-  }
-
-  return (true);
-}
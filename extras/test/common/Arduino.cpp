@@ -0,0 +1,42 @@
+// Host stand-in for the Arduino core: a simulated clock and a silent Serial
+
+#include "Arduino.h"
+#include "SPI.h"
+
+HardwareSerial Serial;
+SPIClass SPI;
+
+static unsigned long long simMicros = 0;
+
+void simAdvanceMicros(unsigned long us)
+{
+  simMicros += us;
+}
+
+// Each call moves the clock on by 1us so that code which polls millis or micros always makes progress
+unsigned long millis(void)
+{
+  simMicros += 1;
+  return (unsigned long)(simMicros / 1000);
+}
+
+unsigned long micros(void)
+{
+  simMicros += 1;
+  return (unsigned long)simMicros;
+}
+
+void delay(unsigned long ms)
+{
+  simMicros += (unsigned long long)ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  simMicros += us;
+}
+
+void yield(void) {}
+void pinMode(uint8_t pin, uint8_t mode) {}
+void digitalWrite(uint8_t pin, uint8_t val) {}
+int digitalRead(uint8_t pin) { return LOW; }
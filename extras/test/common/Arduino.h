@@ -0,0 +1,180 @@
+// Host stand-in for Arduino.h - just enough of the Arduino API to build the library on the PC.
+// millis, micros and delay use a simulated clock (see Arduino.cpp), so tests run instantly and their timings are repeatable
+
+#ifndef SFE_QUAD_HOST_ARDUINO_H
+#define SFE_QUAD_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef uint16_t word;
+
+#ifndef ARDUINO
+#define ARDUINO 10819
+#endif
+
+#define HEX 16
+#define DEC 10
+#define BIN 2
+#define OUTPUT 1
+#define INPUT 0
+#define INPUT_PULLUP 2
+#define HIGH 1
+#define LOW 0
+
+#define F(x) (x)
+#define PSTR(x) (x)
+#define __FlashStringHelper char
+#define PROGMEM
+#define pgm_read_byte(x) (*(x))
+
+#ifndef __cplusplus
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define lowByte(w) ((uint8_t)((w)&0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+
+#ifdef __cplusplus
+#include <algorithm>
+#include <string>
+using std::max;
+using std::min;
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void yield(void);
+
+void simAdvanceMicros(unsigned long us); // Advance the simulated clock (e.g. for the I2C bus time)
+
+// Just enough of String for the drivers which use it (debug messages and the u-blox AssistNow data)
+class String
+{
+public:
+  String(const char *str = "") : _str((str == NULL) ? "" : str) {}
+  String(long n, int base = DEC)
+  {
+    char buf[40];
+    if (base == HEX)
+      snprintf(buf, sizeof(buf), "%lX", n);
+    else
+      snprintf(buf, sizeof(buf), "%ld", n);
+    _str = buf;
+  }
+  String(int n, int base = DEC) : String((long)n, base) {}
+  String(unsigned int n, int base = DEC) : String((long)n, base) {}
+  String(unsigned char n, int base = DEC) : String((long)n, base) {}
+  String(unsigned long n, int base = DEC) : String((long)n, base) {}
+  const char *c_str() const { return _str.c_str(); }
+  unsigned int length() const { return _str.length(); }
+  String &operator+=(const String &rhs)
+  {
+    _str += rhs._str;
+    return *this;
+  }
+  friend String operator+(const String &lhs, const String &rhs)
+  {
+    String result(lhs);
+    result += rhs;
+    return result;
+  }
+  friend String operator+(const char *lhs, const String &rhs) { return String(lhs) + rhs; }
+
+private:
+  std::string _str;
+};
+
+class Print
+{
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size)
+  {
+    size_t n = 0;
+    while (size--)
+      n += write(*buffer++);
+    return n;
+  }
+  size_t write(const char *str) { return (str == NULL) ? 0 : write((const uint8_t *)str, strlen(str)); }
+  virtual void flush() {}
+
+  size_t print(const char *str) { return write(str); }
+  size_t print(const String &str) { return write(str.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char n, int base = DEC) { return print((unsigned long)n, base); }
+  size_t print(int n, int base = DEC) { return print((long)n, base); }
+  size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+  size_t print(long n, int base = DEC)
+  {
+    if ((base == DEC) && (n < 0))
+      return print('-') + print((unsigned long)-n, base);
+    return print((unsigned long)n, base);
+  }
+  size_t print(unsigned long n, int base = DEC)
+  {
+    char buf[40];
+    snprintf(buf, sizeof(buf), (base == HEX) ? "%lX" : "%lu", n);
+    return write(buf);
+  }
+  size_t print(double n, int digits = 2)
+  {
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%.*f", digits, n);
+    return write(buf);
+  }
+  size_t println(void) { return write("\r\n"); }
+  template <typename T>
+  size_t println(T value) { return print(value) + println(); }
+  template <typename T>
+  size_t println(T value, int format) { return print(value, format) + println(); }
+
+  int getWriteError() { return _writeError; }
+  void clearWriteError() { setWriteError(0); }
+
+protected:
+  void setWriteError(int err = 1) { _writeError = err; }
+
+private:
+  int _writeError = 0;
+};
+
+class Stream : public Print
+{
+public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  virtual int peek() { return -1; }
+  void setTimeout(unsigned long) {}
+};
+
+class HardwareSerial : public Stream
+{
+public:
+  void begin(unsigned long) {}
+  operator bool() { return true; }
+  size_t write(uint8_t c) { return 1; } // Discard debug output
+  using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+#endif // __cplusplus
+
+#endif
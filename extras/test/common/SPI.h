@@ -0,0 +1,32 @@
+// Host stand-in for SPI.h. Some of the drivers (e.g. BME280) also support SPI. The tests only use I2C
+
+#ifndef SFE_QUAD_HOST_SPI_H
+#define SFE_QUAD_HOST_SPI_H
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+class SPISettings
+{
+public:
+  SPISettings(uint32_t clock = 0, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0) {}
+};
+
+class SPIClass
+{
+public:
+  void begin() {}
+  void beginTransaction(SPISettings settings) {}
+  void endTransaction() {}
+  uint8_t transfer(uint8_t data) { return 0xFF; }
+};
+
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,116 @@
+// Host stand-in for SdFat: the in-memory card
+
+#include "SdFat.h"
+
+std::map<std::string, SimCardFile> simCard;
+unsigned long simCardSyncs = 0;
+
+void simCardClear(void)
+{
+  simCard.clear();
+  simCardSyncs = 0;
+}
+
+void simPowerLoss(void)
+{
+  for (std::map<std::string, SimCardFile>::iterator it = simCard.begin(); it != simCard.end(); it++)
+    it->second.data = it->second.synced;
+}
+
+bool FsFile::open(const char *path, int oflag)
+{
+  if (_file != NULL)
+    return false;
+  if ((simCard.count(path) == 0) && ((oflag & O_CREAT) == 0))
+    return false;
+  _path = path;
+  _file = &simCard[_path]; // Creates the file if needed. The directory entry is written immediately
+  _flags = oflag;
+  _position = 0;
+  if ((oflag & O_TRUNC) != 0)
+    _file->data.clear();
+  return true;
+}
+
+bool FsFile::close(void)
+{
+  if (_file == NULL)
+    return false;
+  sync();
+  _file = NULL;
+  return true;
+}
+
+bool FsFile::seekSet(uint64_t position)
+{
+  if ((_file == NULL) || (position > _file->data.size()))
+    return false;
+  _position = position;
+  return true;
+}
+
+bool FsFile::preAllocate(uint64_t length)
+{
+  if ((_file == NULL) || (_file->data.size() > 0))
+    return false;
+  _file->data.assign(length, SIM_CARD_STALE);
+  _file->synced = _file->data; // The size is in the directory entry
+  return true;
+}
+
+bool FsFile::truncate(uint64_t length)
+{
+  if ((_file == NULL) || (length > _file->data.size()))
+    return false;
+  _file->data.resize(length);
+  if (_position > length)
+    _position = length;
+  return sync();
+}
+
+bool FsFile::sync(void)
+{
+  if (_file == NULL)
+    return false;
+  _file->synced = _file->data;
+  simCardSyncs++;
+  return true;
+}
+
+int FsFile::read(void *buffer, size_t count)
+{
+  if (_file == NULL)
+    return -1;
+  size_t remaining = _file->data.size() - _position;
+  if (count > remaining)
+    count = remaining;
+  memcpy(buffer, _file->data.data() + _position, count);
+  _position += count;
+  return (int)count;
+}
+
+int FsFile::read(void)
+{
+  uint8_t b;
+  return (read(&b, 1) == 1) ? b : -1;
+}
+
+int FsFile::peek(void)
+{
+  if ((_file == NULL) || (_position >= _file->data.size()))
+    return -1;
+  return (uint8_t)_file->data[_position];
+}
+
+size_t FsFile::write(const uint8_t *buffer, size_t count)
+{
+  if ((_file == NULL) || ((_flags & O_ACCMODE) == O_RDONLY))
+    return 0;
+  if ((_flags & O_APPEND) != 0)
+    _position = _file->data.size();
+  if (_file->data.size() < _position + count)
+    _file->data.resize(_position + count);
+  memcpy(&_file->data[_position], buffer, count);
+  _position += count;
+  return count;
+}
@@ -0,0 +1,92 @@
+// Host stand-in for SdFat.h: an in-memory card, with just enough of SdFs / FsFile for SFE_QUAD_Sensors__SdFat.
+// Each file has two copies: what the code has written, and what is on the card (updated by sync and close).
+// simPowerLoss throws away everything which was not synced. preAllocate behaves like FAT: it sets the file size, and the
+// pre-allocated clusters hold stale data (SIM_CARD_STALE), not zeros
+
+#ifndef SFE_QUAD_HOST_SDFAT_H
+#define SFE_QUAD_HOST_SDFAT_H
+
+#include <map>
+#include <string>
+
+#include "Arduino.h"
+
+#define O_RDONLY 0x00
+#define O_WRONLY 0x01
+#define O_RDWR 0x02
+#define O_ACCMODE 0x03
+#define O_APPEND 0x08
+#define O_CREAT 0x10
+#define O_TRUNC 0x20
+#define O_READ O_RDONLY
+#define O_WRITE O_WRONLY
+
+#define SHARED_SPI 0
+#define SD_SCK_MHZ(maxMhz) (1000000UL * (maxMhz))
+
+#define SIM_CARD_STALE '#' // The contents of pre-allocated clusters
+
+class SdSpiConfig
+{
+public:
+  SdSpiConfig(int csPin, int options, unsigned long maxSck) {}
+};
+
+// The simulated card
+struct SimCardFile
+{
+  std::string data;   // What the code has written
+  std::string synced; // What is on the card
+};
+extern std::map<std::string, SimCardFile> simCard;
+extern unsigned long simCardSyncs; // Every sync and close
+
+void simCardClear(void); // Delete every file
+void simPowerLoss(void); // Every file goes back to what was synced. Open files must be abandoned (not closed)
+
+class FsFile : public Stream
+{
+public:
+  FsFile() : _file(NULL), _position(0), _flags(0) {}
+
+  bool open(const char *path, int oflag = O_RDONLY);
+  bool close(void);
+  bool isOpen(void) { return (_file != NULL); }
+  operator bool() { return isOpen(); }
+
+  uint64_t fileSize(void) { return (_file == NULL) ? 0 : _file->data.size(); }
+  uint64_t size(void) { return fileSize(); }
+  uint64_t curPosition(void) { return _position; }
+  bool seekSet(uint64_t position);
+  bool preAllocate(uint64_t length);
+  bool truncate(void) { return truncate(_position); }
+  bool truncate(uint64_t length);
+  bool sync(void);
+  void flush(void) { sync(); }
+
+  int read(void *buffer, size_t count);
+  int read(void);
+  int available(void) { return (_file == NULL) ? 0 : (int)(_file->data.size() - _position); }
+  int peek(void);
+
+  size_t write(const uint8_t *buffer, size_t count);
+  size_t write(uint8_t b) { return write(&b, 1); }
+  using Print::write;
+
+private:
+  SimCardFile *_file;
+  std::string _path;
+  uint64_t _position;
+  int _flags;
+};
+
+class SdFs
+{
+public:
+  bool begin(SdSpiConfig spiConfig) { return true; }
+  bool chdir(void) { return true; }
+  bool exists(const char *path) { return (simCard.count(path) > 0); }
+  bool remove(const char *path) { return (simCard.erase(path) > 0); }
+};
+
+#endif
@@ -0,0 +1,106 @@
+// Host stand-in for Wire: the simulated I2C bus
+
+#include "Wire.h"
+
+TwoWire Wire;
+
+TwoWire::TwoWire()
+{
+  for (int i = 0; i < 128; i++)
+    _devices[i] = NULL;
+  _txAddress = 0;
+  _txLength = 0;
+  _rxLength = 0;
+  _rxIndex = 0;
+  resetCounts();
+}
+
+void TwoWire::attach(uint8_t address, SimI2CDevice *device)
+{
+  _devices[address & 0x7F] = device;
+}
+
+void TwoWire::detach(uint8_t address)
+{
+  _devices[address & 0x7F] = NULL;
+}
+
+void TwoWire::resetCounts(void)
+{
+  transactions = 0;
+  bytes = 0;
+}
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+  _txAddress = address & 0x7F;
+  _txLength = 0;
+}
+
+size_t TwoWire::write(uint8_t c)
+{
+  if (_txLength >= SIM_I2C_BUFFER_LENGTH)
+    return 0;
+  _txBuffer[_txLength++] = c;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t len)
+{
+  size_t n = 0;
+  while (len--)
+    n += write(*data++);
+  return n;
+}
+
+// Returns 0 on success, 2 if the address was NACKed (like the Arduino Wire library)
+uint8_t TwoWire::endTransmission(bool stop)
+{
+  transactions++;
+  bytes += _txLength + 1;
+  simAdvanceMicros((_txLength + 1) * SIM_I2C_MICROS_PER_BYTE);
+
+  SimI2CDevice *device = _devices[_txAddress];
+  if ((device == NULL) || (!device->ack()))
+    return 2;
+  device->writes++;
+  device->i2cWrite(_txBuffer, _txLength);
+  return 0;
+}
+
+// Returns the number of bytes read, 0 if the address was NACKed
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t stop)
+{
+  transactions++;
+  bytes += quantity + 1;
+  simAdvanceMicros((quantity + 1) * SIM_I2C_MICROS_PER_BYTE);
+
+  _rxLength = 0;
+  _rxIndex = 0;
+  SimI2CDevice *device = _devices[address & 0x7F];
+  if ((device == NULL) || (!device->ack()))
+    return 0;
+  device->reads++;
+  device->i2cRead(_rxBuffer, quantity);
+  _rxLength = quantity;
+  return quantity;
+}
+
+int TwoWire::available()
+{
+  return (int)(_rxLength - _rxIndex);
+}
+
+int TwoWire::read()
+{
+  if (_rxIndex >= _rxLength)
+    return -1;
+  return _rxBuffer[_rxIndex++];
+}
+
+int TwoWire::peek()
+{
+  if (_rxIndex >= _rxLength)
+    return -1;
+  return _rxBuffer[_rxIndex];
+}
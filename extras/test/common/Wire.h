@@ -0,0 +1,146 @@
+// Host stand-in for Wire.h: a simulated I2C bus.
+// Simulated devices are attached to the bus at their address. The bus counts every transaction
+// (each endTransmission and each requestFrom) and the bytes transferred, and advances the simulated clock by the bus time
+
+#ifndef SFE_QUAD_HOST_WIRE_H
+#define SFE_QUAD_HOST_WIRE_H
+
+#include "Arduino.h"
+
+#define SIM_I2C_BUFFER_LENGTH 256
+#define SIM_I2C_MICROS_PER_BYTE 25 // 9 bits at 400kHz, rounded up
+
+// A device on the simulated bus
+class SimI2CDevice
+{
+public:
+  SimI2CDevice() : writes(0), reads(0) {}
+  virtual ~SimI2CDevice() {}
+
+  virtual void i2cWrite(const uint8_t *data, size_t len) = 0; // One write transaction. len is zero for an address probe
+  virtual void i2cRead(uint8_t *data, size_t len) = 0;        // One read transaction
+  virtual bool ack(void) { return true; }                     // Return false to make the device NACK its address
+
+  unsigned long writes; // Write transactions addressed to this device
+  unsigned long reads;  // Read transactions addressed to this device
+};
+
+class TwoWire : public Stream
+{
+public:
+  TwoWire();
+
+  void attach(uint8_t address, SimI2CDevice *device); // Put a simulated device on the bus
+  void detach(uint8_t address);
+  void resetCounts(void);
+
+  unsigned long transactions; // Every endTransmission and requestFrom
+  unsigned long bytes;        // Every byte written or read
+
+  void begin() {}
+  void setClock(uint32_t) {}
+  void beginTransmission(uint8_t address);
+  void beginTransmission(int address) { beginTransmission((uint8_t)address); }
+  uint8_t endTransmission(bool stop = true);
+  uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t stop = 1);
+  uint8_t requestFrom(int address, int quantity, int stop = 1) { return requestFrom((uint8_t)address, (uint8_t)quantity, (uint8_t)stop); }
+  uint8_t requestFrom(uint8_t address, size_t quantity, bool stop) { return requestFrom(address, (uint8_t)quantity, (uint8_t)stop); }
+  size_t write(uint8_t c);
+  size_t write(const uint8_t *data, size_t len);
+  using Print::write;
+  int available();
+  int read();
+  int peek();
+
+private:
+  SimI2CDevice *_devices[128];
+  uint8_t _txAddress;
+  uint8_t _txBuffer[SIM_I2C_BUFFER_LENGTH];
+  size_t _txLength;
+  uint8_t _rxBuffer[SIM_I2C_BUFFER_LENGTH];
+  size_t _rxLength;
+  size_t _rxIndex;
+};
+
+extern TwoWire Wire;
+
+// A device with 8-bit registers and an auto-incrementing register pointer (e.g. LPS25HB, MCP9600, Qwiic Button).
+// The first byte of each write sets the pointer. pointerMask strips any flag bits from it (e.g. the LPS25HB auto-increment bit)
+class SimByteRegisterDevice : public SimI2CDevice
+{
+public:
+  SimByteRegisterDevice(uint8_t pointerMask = 0xFF) : _pointer(0), _pointerMask(pointerMask) { memset(reg, 0, sizeof(reg)); }
+
+  uint8_t reg[256];
+
+  virtual uint8_t readRegister(uint8_t address) { return reg[address]; }
+  virtual void writeRegister(uint8_t address, uint8_t value) { reg[address] = value; }
+  virtual uint8_t nextPointer(uint8_t address) { return address + 1; }
+
+  void i2cWrite(const uint8_t *data, size_t len)
+  {
+    if (len == 0)
+      return;
+    _pointer = data[0] & _pointerMask;
+    for (size_t i = 1; i < len; i++)
+    {
+      writeRegister(_pointer, data[i]);
+      _pointer = nextPointer(_pointer);
+    }
+  }
+
+  void i2cRead(uint8_t *data, size_t len)
+  {
+    for (size_t i = 0; i < len; i++)
+    {
+      data[i] = readRegister(_pointer);
+      _pointer = nextPointer(_pointer);
+    }
+  }
+
+protected:
+  uint8_t _pointer;
+  uint8_t _pointerMask;
+};
+
+// A device with 16-bit registers (e.g. TMP117, MAX1704X big-endian; VCNL4040 little-endian).
+// The first byte of each write sets the pointer. The next two bytes (if any) are written to that register
+class SimWordRegisterDevice : public SimI2CDevice
+{
+public:
+  SimWordRegisterDevice(bool bigEndian) : _pointer(0), _bigEndian(bigEndian) { memset(reg, 0, sizeof(reg)); }
+
+  uint16_t reg[256];
+
+  virtual uint16_t readRegister(uint8_t address) { return reg[address]; }
+  virtual void writeRegister(uint8_t address, uint16_t value) { reg[address] = value; }
+
+  void i2cWrite(const uint8_t *data, size_t len)
+  {
+    if (len == 0)
+      return;
+    _pointer = data[0];
+    for (size_t i = 1; i + 1 < len; i += 2)
+    {
+      writeRegister(_pointer, _bigEndian ? ((uint16_t)data[i] << 8) | data[i + 1] : ((uint16_t)data[i + 1] << 8) | data[i]);
+      _pointer++;
+    }
+  }
+
+  void i2cRead(uint8_t *data, size_t len)
+  {
+    for (size_t i = 0; i < len; i += 2)
+    {
+      uint16_t value = readRegister(_pointer++);
+      data[i] = _bigEndian ? highByte(value) : lowByte(value);
+      if (i + 1 < len)
+        data[i + 1] = _bigEndian ? lowByte(value) : highByte(value);
+    }
+  }
+
+protected:
+  uint8_t _pointer;
+  bool _bigEndian;
+};
+
+#endif
@@ -0,0 +1,282 @@
+// Host test: SFE_QUAD_Sensors::checkDeadband and the delta records (setDeltaRecords).
+//
+// Three simulated TMP117s: one with an absolute deadband (0.5C), one with a relative deadband (10%) and one without a deadband.
+//
+//   rows       Full rows: the first row, a deadband crossing and the heartbeat are logged. Every logged row moves the references
+//   delta      Delta records: a crossing logs "column:reading" for the senses which crossed, and only their references move.
+//              The first row and the heartbeat are still full rows. The columns follow the enabled senses
+//   replay     A random walk, logged as delta records and replayed: every sense with a deadband stays within its deadband of
+//              the true reading. Prints the bytes logged for every row, for the full rows and for the delta records
+//   config     The deadbands survive getSensorAndMenuConfiguration / applySensorAndMenuConfiguration, including a deadband (-3)
+//              line longer than 191 characters (GNSS has 17 senses)
+
+#include <math.h>
+#include <string>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "SFE_QUAD_Sensors.h"
+
+static int failures = 0;
+
+#define CHECK(condition)                                                            \
+  do                                                                                \
+  {                                                                                 \
+    if (!(condition))                                                               \
+    {                                                                               \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                                   \
+    }                                                                               \
+  } while (0)
+
+// ---- Simulated devices ----
+
+class SimTMP117 : public SimWordRegisterDevice
+{
+public:
+  SimTMP117() : SimWordRegisterDevice(true) { reg[TMP117_DEVICE_ID] = DEVICE_ID_VALUE; }
+
+  void setTempC(double temperature) { reg[TMP117_TEMP_RESULT] = (uint16_t)(int16_t)lround(temperature / TMP117_RESOLUTION); }
+};
+
+// The three TMP117s at 0x48 (0.5C), 0x49 (10%) and 0x4A (no deadband)
+class DeadbandRig
+{
+public:
+  DeadbandRig(bool deltaRecords)
+  {
+    for (uint8_t i = 0; i < 3; i++)
+    {
+      Wire.attach(0x48 + i, &sim[i]);
+      CHECK(sensors.addSensor(SFE_QUAD_Sensors::Sensor_TMP117, 0x48 + i, 0, 0) != NULL);
+    }
+    sensors.setWirePort(Wire);
+    CHECK(sensors.beginSensors());
+    CHECK(sensors.initializeSensors());
+    CHECK(sensors.setDeadband(0, 0.5, false, "TMP117", 0x48));
+    CHECK(sensors.setDeadband(0, 10.0, true, "TMP117", 0x49));
+    sensors.setDeltaRecords(deltaRecords);
+  }
+
+  ~DeadbandRig()
+  {
+    for (uint8_t i = 0; i < 3; i++)
+      Wire.detach(0x48 + i);
+  }
+
+  void set(double t0, double t1, double t2)
+  {
+    sim[0].setTempC(t0);
+    sim[1].setTempC(t1);
+    sim[2].setTempC(t2);
+  }
+
+  // Read the sensors. Return what checkDeadband says should be logged ("" if nothing). fullRow is the row before checkDeadband
+  std::string log(std::string *fullRow = NULL)
+  {
+    CHECK(sensors.getSensorReadings());
+    if (fullRow != NULL)
+      *fullRow = sensors.readings;
+    if (!sensors.checkDeadband())
+      return "";
+    return sensors.readings;
+  }
+
+  SimTMP117 sim[3];
+  SFE_QUAD_Sensors sensors;
+};
+
+#define CHECK_LOGGED(rig, expected)                                                    \
+  do                                                                                   \
+  {                                                                                    \
+    std::string logged = (rig).log();                                                  \
+    if (logged != (expected))                                                          \
+      fprintf(stderr, "  logged \"%s\", expected \"%s\"\n", logged.c_str(), expected); \
+    CHECK(logged == (expected));                                                       \
+  } while (0)
+
+// ---- Scenarios ----
+
+static void testRows(void)
+{
+  DeadbandRig rig(false);
+
+  rig.set(20.0, 30.0, 40.0);
+  CHECK_LOGGED(rig, "20.000,30.000,40.000"); // The first row
+  rig.set(20.25, 31.0, 45.0);
+  CHECK_LOGGED(rig, ""); // 0.25C, 3.3% and no deadband
+  rig.set(20.75, 32.0, 45.0);
+  CHECK_LOGGED(rig, "20.750,32.000,45.000"); // 0.75C. The row moves all three references
+  rig.set(20.75, 34.0, 45.0);
+  CHECK_LOGGED(rig, ""); // 6.25% of 32.0
+
+  rig.sensors.setHeartbeat(60000);
+  simAdvanceMicros(60000000UL);
+  CHECK_LOGGED(rig, "20.750,34.000,45.000"); // The heartbeat
+
+  printf("rows: first row, deadband crossing and heartbeat logged\n");
+}
+
+static void testDelta(void)
+{
+  DeadbandRig rig(true);
+
+  rig.set(20.0, 30.0, 40.0);
+  CHECK_LOGGED(rig, "20.000,30.000,40.000"); // The first row is always full
+  rig.set(20.25, 31.0, 45.0);
+  CHECK_LOGGED(rig, "");
+  rig.set(20.75, 32.0, 45.0);
+  CHECK_LOGGED(rig, "0:20.750"); // Only the first sense moved its reference
+  rig.set(20.75, 33.5, 45.0);
+  CHECK_LOGGED(rig, "1:33.500"); // 11.7% of 30.0. A full row would have moved the reference to 32.0 (4.7%)
+  rig.set(20.5, 33.5, 45.0);
+  CHECK_LOGGED(rig, "");
+  rig.set(21.5, 37.5, 45.0);
+  CHECK_LOGGED(rig, "0:21.500,1:37.500");
+
+  rig.sensors.setHeartbeat(60000);
+  simAdvanceMicros(60000000UL);
+  CHECK_LOGGED(rig, "21.500,37.500,45.000"); // The heartbeat is a full row
+  rig.sensors.setHeartbeat(0);
+
+  for (SFE_QUAD_Sensor *sensor = rig.sensors._head; sensor != NULL; sensor = sensor->_next)
+    if (sensor->_sensorAddress == 0x48)
+      sensor->_logSense[0] = false; // Stop logging the first sensor. The second sense is now column 0
+  rig.set(21.5, 42.0, 45.0);
+  CHECK_LOGGED(rig, "0:42.000");
+
+  rig.sensors.setDeltaRecords(false);
+  rig.set(21.5, 47.0, 45.0);
+  CHECK_LOGGED(rig, "47.000,45.000");
+
+  printf("delta: delta records, full first row and heartbeat, columns follow the enabled senses\n");
+}
+
+// Apply a logged row or delta record to the replayed columns
+static void replay(const std::string &logged, double *columns)
+{
+  const char *ptr = logged.c_str();
+  bool delta = (strchr(ptr, ':') != NULL);
+  int column = 0;
+  while (*ptr != 0)
+  {
+    char *end;
+    if (delta)
+    {
+      column = (int)strtol(ptr, &end, 10);
+      ptr = end + 1; // Skip the colon
+    }
+    columns[column++] = strtod(ptr, &end);
+    ptr = (*end == ',') ? end + 1 : end;
+  }
+}
+
+static void testReplay(void)
+{
+  const int steps = 20000;
+  unsigned long bytes[3] = {0, 0, 0}; // Every row, full rows, delta records
+  unsigned long records[3] = {0, 0, 0};
+
+  for (int deltaRecords = 0; deltaRecords <= 1; deltaRecords++)
+  {
+    DeadbandRig rig(deltaRecords == 1);
+    uint32_t seed = 12345;
+    double temperature[3] = {20.0, 30.0, 40.0};
+    double columns[3] = {0.0, 0.0, 0.0};
+
+    for (int n = 0; n < steps; n++)
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        seed = (seed * 1103515245) + 12345;
+        temperature[i] += (double)((int)((seed >> 16) % 27) - 13) * TMP117_RESOLUTION; // +/- 0.1C
+      }
+      rig.set(temperature[0], temperature[1], temperature[2]);
+
+      std::string fullRow;
+      std::string logged = rig.log(&fullRow);
+      if (deltaRecords == 0)
+      {
+        bytes[0] += fullRow.length() + 2; // Plus CR LF
+        records[0]++;
+      }
+      if (logged.length() == 0)
+        continue;
+      bytes[deltaRecords + 1] += logged.length() + 2;
+      records[deltaRecords + 1]++;
+
+      if (deltaRecords == 0)
+        continue;
+
+      // Replay the delta records. The senses with deadbands must stay within their deadband of the true readings
+      replay(logged, columns);
+      double truth[3];
+      replay(fullRow, truth);
+      CHECK(fabs(truth[0] - columns[0]) <= 0.5 + 0.001);
+      CHECK(fabs(truth[1] - columns[1]) <= (fabs(columns[1]) * 0.1) + 0.001);
+    }
+  }
+
+  printf("replay: %d readings logged as delta records, replayed within their deadbands\n", steps);
+  printf("Logging %d readings               records     bytes\n", steps);
+  printf("every row                        %8lu  %8lu\n", records[0], bytes[0]);
+  printf("full rows (deadband)             %8lu  %8lu\n", records[1], bytes[1]);
+  printf("delta records (deadband)         %8lu  %8lu\n", records[2], bytes[2]);
+}
+
+// Find the deadband of the first sense of the TMP117 at address
+static SFE_QUAD_Sensor::SFE_QUAD_Sense_Deadband_t *deadbandOf(SFE_QUAD_Sensors &sensors, uint8_t address)
+{
+  for (SFE_QUAD_Sensor *sensor = sensors._head; sensor != NULL; sensor = sensor->_next)
+    if ((sensor->_sensorAddress == address) && (sensor->_deadband != NULL))
+      return (&sensor->_deadband[0]);
+  return (NULL);
+}
+
+static void testConfiguration(void)
+{
+  std::string configuration;
+  {
+    DeadbandRig rig(false);
+    CHECK(rig.sensors.setDeadband(0, 1500.0, false, "TMP117", 0x4A));
+    CHECK(rig.sensors.getSensorAndMenuConfiguration());
+    configuration = rig.sensors.configuration;
+  }
+
+  // A long deadband line. The leading zeros stand in for the other senses: the last value must not be cut short
+  std::string longLine = "TMP117,74,0,0,-3," + std::string(200, '0') + "2500.0";
+  configuration += longLine + "\r\n";
+
+  DeadbandRig rig(false);
+  CHECK(rig.sensors.setDeadband(0, 0.0, false, "TMP117")); // Clear the deadbands set by the rig
+  delete[] rig.sensors.configuration;
+  rig.sensors.configuration = new char[configuration.length() + 1];
+  strcpy(rig.sensors.configuration, configuration.c_str());
+  CHECK(rig.sensors.applySensorAndMenuConfiguration());
+
+  SFE_QUAD_Sensor::SFE_QUAD_Sense_Deadband_t *deadband = deadbandOf(rig.sensors, 0x48);
+  CHECK((deadband != NULL) && (deadband->threshold == 0.5f) && (!deadband->relative));
+  deadband = deadbandOf(rig.sensors, 0x49);
+  CHECK((deadband != NULL) && (deadband->threshold == 10.0f) && (deadband->relative));
+  deadband = deadbandOf(rig.sensors, 0x4A);
+  CHECK((deadband != NULL) && (deadband->threshold == 2500.0f)); // The long line comes last
+  if (deadband != NULL)
+    printf("config: deadbands restored, %d-character deadband line parsed as %.1f\n", (int)longLine.length(), deadband->threshold);
+}
+
+int main(void)
+{
+  testRows();
+  testDelta();
+  testReplay();
+  testConfiguration();
+
+  if (failures > 0)
+  {
+    printf("FAIL: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
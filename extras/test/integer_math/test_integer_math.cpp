@@ -0,0 +1,539 @@
+// Host test: the "Integer Math" paths of the MS5637, MS8607 and BME280 and SFE_QUAD_Sensors_sprintf::_fixtostrf.
+//
+//   fixtostrf   Every value from -200000 to 200000 at 0-4 decimals and precisions 0-6, plus the int32 extremes, against an
+//               exact (int64) reference: rounded once, half away from zero, and never "-0".
+//               _dtostrf (the float path) must agree within one LSB of the printed precision
+//   sensors     The wrappers, driven through SFE_QUAD_Sensors with simulated sensors and random ADC values.
+//               Each reading is taken with Integer Math off (float compensation and _dtostrf) and on (integer compensation
+//               and _fixtostrf). The two must agree within one LSB of the integer result (0.01), plus one LSB of the printed precision
+//               (both are rounded), plus half a float ULP (the float path holds the result in a float: 0.004 at 100000 Pa)
+//   sampling    sampleSensors must aggregate the sense values (getSenseValue), not the text readings. At precision 0 the
+//               text is rounded to a whole number, so the statistics would be out by up to 0.5
+//   benchmark   The time to format one reading with _dtostrf and _fixtostrf (on the host)
+
+#include <chrono>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "SFE_QUAD_Sensors.h"
+
+static int failures = 0;
+
+#define CHECK(condition)                                                              \
+  do                                                                                  \
+  {                                                                                   \
+    if (!(condition))                                                                 \
+    {                                                                                 \
+      if (failures < 10)                                                              \
+        fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                                     \
+    }                                                                                 \
+  } while (0)
+
+static uint32_t seed = 12345;
+
+static uint32_t random32(void)
+{
+  seed = (seed * 1103515245) + 12345;
+  return seed;
+}
+
+// A random value from min to max (inclusive)
+static int32_t randomRange(int32_t min, int32_t max)
+{
+  return min + (int32_t)(((random32() >> 8) | ((uint32_t)random32() << 16)) % (uint32_t)(max - min + 1));
+}
+
+// ---- _fixtostrf ----
+
+// The exact result: value / 10^decimals rounded once (half away from zero) to prec decimal places
+static void referenceFixtostrf(int32_t value, uint8_t decimals, uint8_t prec, char *buffer)
+{
+  int64_t magnitude = (value < 0) ? -(int64_t)value : (int64_t)value;
+  for (uint8_t i = decimals; i < prec; i++)
+    magnitude *= 10;
+  if (decimals > prec)
+  {
+    int64_t divisor = 1;
+    for (uint8_t i = prec; i < decimals; i++)
+      divisor *= 10;
+    magnitude = (magnitude + (divisor / 2)) / divisor;
+  }
+  int64_t scale = 1;
+  for (uint8_t i = 0; i < prec; i++)
+    scale *= 10;
+  const char *sign = ((value < 0) && (magnitude > 0)) ? "-" : "";
+  if (prec == 0)
+    sprintf(buffer, "%s%lld", sign, (long long)magnitude);
+  else
+    sprintf(buffer, "%s%lld.%0*lld", sign, (long long)(magnitude / scale), (int)prec, (long long)(magnitude % scale));
+}
+
+static void testFixtostrf(void)
+{
+  SFE_QUAD_Sensors_sprintf fmt;
+  char expected[48];
+  char fixed[48];
+  char floating[48];
+  unsigned long compared = 0;
+  unsigned long floatDifferent = 0;
+
+  // The cases which were wrong: rounding twice, and "-0"
+  fmt.setPrecision(0);
+  fmt._fixtostrf(145, 2, fixed);
+  CHECK(strcmp(fixed, "1") == 0);
+  fmt._fixtostrf(150, 2, fixed);
+  CHECK(strcmp(fixed, "2") == 0);
+  fmt._fixtostrf(-4, 2, fixed);
+  CHECK(strcmp(fixed, "0") == 0);
+  fmt._fixtostrf(-150, 2, fixed);
+  CHECK(strcmp(fixed, "-2") == 0);
+  fmt.setPrecision(1);
+  fmt._fixtostrf(-4, 2, fixed);
+  CHECK(strcmp(fixed, "0.0") == 0);
+  fmt._fixtostrf(-5, 2, fixed);
+  CHECK(strcmp(fixed, "-0.1") == 0);
+  fmt._fixtostrf(1449, 3, fixed);
+  CHECK(strcmp(fixed, "1.4") == 0);
+  fmt.setPrecision(3);
+  fmt._fixtostrf(-4, 2, fixed);
+  CHECK(strcmp(fixed, "-0.040") == 0);
+  fmt.setPrecision(0);
+  fmt._fixtostrf(INT32_MIN, 0, fixed);
+  CHECK(strcmp(fixed, "-2147483648") == 0);
+  fmt._fixtostrf(INT32_MAX, 9, fixed);
+  CHECK(strcmp(fixed, "2") == 0);
+
+  for (uint8_t prec = 0; prec <= 6; prec++)
+  {
+    fmt.setPrecision(prec);
+    for (uint8_t decimals = 0; decimals <= 4; decimals++)
+    {
+      double scale = pow(10.0, decimals);
+      double lsb = pow(10.0, -prec);
+      for (int32_t value = -200000; value <= 200000; value++)
+      {
+        referenceFixtostrf(value, decimals, prec, expected);
+        fmt._fixtostrf(value, decimals, fixed);
+        CHECK(strcmp(fixed, expected) == 0);
+        if (strcmp(fixed, expected) != 0 && failures <= 10)
+          fprintf(stderr, "  _fixtostrf(%d, %u) at precision %u: \"%s\", expected \"%s\"\n", value, decimals, prec, fixed, expected);
+
+        fmt._dtostrf((double)value / scale, floating);
+        if (strcmp(fixed, floating) != 0)
+        {
+          floatDifferent++;
+          CHECK(fabs(strtod(fixed, NULL) - strtod(floating, NULL)) <= lsb * 1.001);
+        }
+        compared++;
+      }
+
+      const int32_t extremes[] = {INT32_MIN, INT32_MIN + 1, -1000000000, 999999999, INT32_MAX - 1, INT32_MAX};
+      for (size_t i = 0; i < sizeof(extremes) / sizeof(extremes[0]); i++)
+      {
+        referenceFixtostrf(extremes[i], decimals, prec, expected);
+        fmt._fixtostrf(extremes[i], decimals, fixed);
+        CHECK(strcmp(fixed, expected) == 0);
+        compared++;
+      }
+    }
+  }
+
+  printf("_fixtostrf: %lu values compared. _dtostrf differs in the last digit for %lu of them (float rounding at the halves, \"-0\")\n", compared, floatDifferent);
+}
+
+// ---- Simulated sensors ----
+
+// The MS5637 and the MS8607 pressure sensor. The PROM holds the datasheet example coefficients; d1 and d2 are the ADC values
+class SimMS56xx : public SimI2CDevice
+{
+public:
+  SimMS56xx() : d1(6465444), d2(8077636), _command(0)
+  {
+    const uint16_t coefficients[7] = {0, 46372, 43981, 29059, 27842, 31553, 28165};
+    for (int i = 0; i < 7; i++)
+      _prom[i] = coefficients[i];
+    _prom[0] |= crc4() << 12;
+  }
+
+  void i2cWrite(const uint8_t *data, size_t len)
+  {
+    if (len == 0)
+      return;
+    if ((data[0] & 0xE0) == 0x40) // Start D1 or D2. The result is ready immediately
+      _result = (data[0] & 0x10) ? d2 : d1;
+    _command = data[0];
+  }
+
+  void i2cRead(uint8_t *data, size_t len)
+  {
+    uint32_t value = 0;
+    if ((_command >= 0xA0) && (_command <= 0xAC)) // PROM read
+      value = (uint32_t)_prom[(_command - 0xA0) / 2] << 16;
+    else if (_command == 0x00) // ADC read
+      value = _result << 8;
+    for (size_t i = 0; i < len; i++)
+      data[i] = (i < 4) ? (uint8_t)(value >> (24 - (8 * i))) : 0;
+  }
+
+  uint32_t d1;
+  uint32_t d2;
+
+private:
+  // The CRC-4 of the PROM (AN520)
+  uint16_t crc4(void)
+  {
+    uint16_t prom[8];
+    for (int i = 0; i < 7; i++)
+      prom[i] = _prom[i];
+    prom[0] &= 0x0FFF;
+    prom[7] = 0;
+    uint16_t rem = 0;
+    for (int cnt = 0; cnt < 16; cnt++)
+    {
+      rem ^= (cnt & 1) ? (prom[cnt >> 1] & 0x00FF) : (prom[cnt >> 1] >> 8);
+      for (int bit = 8; bit > 0; bit--)
+        rem = (rem & 0x8000) ? (uint16_t)((rem << 1) ^ 0x3000) : (uint16_t)(rem << 1);
+    }
+    return (rem >> 12) & 0x000F;
+  }
+
+  uint16_t _prom[7];
+  uint8_t _command;
+  uint32_t _result;
+};
+
+// The MS8607 humidity sensor. adc is the 12-bit humidity ADC value (left-justified in 16 bits)
+class SimMS8607Humidity : public SimI2CDevice
+{
+public:
+  SimMS8607Humidity() : adc(0x6A5C) {}
+
+  void i2cWrite(const uint8_t *data, size_t len) {}
+
+  void i2cRead(uint8_t *data, size_t len)
+  {
+    uint8_t bytes[3] = {(uint8_t)(adc >> 8), (uint8_t)(adc & 0xFC), 0};
+    uint8_t crc = 0;
+    for (int i = 0; i < 2; i++)
+    {
+      crc ^= bytes[i];
+      for (int bit = 0; bit < 8; bit++)
+        crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+    }
+    bytes[2] = crc;
+    for (size_t i = 0; i < len; i++)
+      data[i] = (i < 3) ? bytes[i] : 0;
+  }
+
+  uint16_t adc;
+};
+
+// The BME280. The calibration is a typical part's; setADC writes the measurement registers
+class SimBME280 : public SimByteRegisterDevice
+{
+public:
+  SimBME280()
+  {
+    reg[BME280_CHIP_ID_REG] = 0x60;
+    const int32_t trim[12] = {27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000}; // T1-T3, P1-P9
+    for (int i = 0; i < 12; i++)
+    {
+      reg[BME280_DIG_T1_LSB_REG + (2 * i)] = (uint8_t)(trim[i] & 0xFF);
+      reg[BME280_DIG_T1_LSB_REG + (2 * i) + 1] = (uint8_t)((trim[i] >> 8) & 0xFF);
+    }
+    const int16_t h2 = 362, h4 = 324, h5 = 0;
+    reg[BME280_DIG_H1_REG] = 75;
+    reg[BME280_DIG_H2_LSB_REG] = (uint8_t)(h2 & 0xFF);
+    reg[BME280_DIG_H2_MSB_REG] = (uint8_t)(h2 >> 8);
+    reg[BME280_DIG_H3_REG] = 0;
+    reg[BME280_DIG_H4_MSB_REG] = (uint8_t)(h4 >> 4);
+    reg[BME280_DIG_H4_LSB_REG] = (uint8_t)((h4 & 0x0F) | ((h5 & 0x0F) << 4));
+    reg[BME280_DIG_H5_MSB_REG] = (uint8_t)(h5 >> 4);
+    reg[BME280_DIG_H6_REG] = 30;
+  }
+
+  void setADC(int32_t adcP, int32_t adcT, int32_t adcH)
+  {
+    reg[0xF7] = (uint8_t)(adcP >> 12);
+    reg[0xF8] = (uint8_t)(adcP >> 4);
+    reg[0xF9] = (uint8_t)(adcP << 4);
+    reg[0xFA] = (uint8_t)(adcT >> 12);
+    reg[0xFB] = (uint8_t)(adcT >> 4);
+    reg[0xFC] = (uint8_t)(adcT << 4);
+    reg[0xFD] = (uint8_t)(adcH >> 8);
+    reg[0xFE] = (uint8_t)adcH;
+  }
+};
+
+// ---- Sensors ----
+
+// Read every sense with Integer Math off, then on, and compare. Returns the number of senses compared
+static unsigned long compareReadings(SFE_QUAD_Sensors &sensors, SFE_QUAD_Sensor *sensor, double lsb)
+{
+  SFE_QUAD_Sensor::SFE_QUAD_Sensor_Every_Type_t value;
+  char floatReadings[4 * SFE_QUAD_SENSOR_READING_LEN]; // Long enough for every sense
+  char intReadings[4 * SFE_QUAD_SENSOR_READING_LEN];
+
+  value.BOOL = false;
+  sensor->setSetting(0, &value);
+  CHECK(sensors.getSensorReadings());
+  strcpy(floatReadings, sensors.readings);
+
+  value.BOOL = true;
+  sensor->setSetting(0, &value);
+  CHECK(sensors.getSensorReadings());
+  strcpy(intReadings, sensors.readings);
+
+  unsigned long compared = 0;
+  char *f = floatReadings;
+  char *i = intReadings;
+  while ((*f != 0) && (*i != 0))
+  {
+    double floatValue = strtod(f, &f);
+    double intValue = strtod(i, &i);
+    double tolerance = (0.01 + lsb + (fabs(intValue) * FLT_EPSILON / 2)) * 1.001; // The float path holds the result in a float
+    if (fabs(floatValue - intValue) > tolerance)
+    {
+      CHECK(fabs(floatValue - intValue) <= tolerance);
+      if (failures <= 10)
+        fprintf(stderr, "  %s: float \"%s\", integer \"%s\"\n", sensor->getSensorName(), floatReadings, intReadings);
+    }
+    compared++;
+    if (*f == ',')
+      f++;
+    if (*i == ',')
+      i++;
+  }
+  CHECK((*f == 0) && (*i == 0));
+  return compared;
+}
+
+static void testSensors(void)
+{
+  const int samples = 2000;
+
+  for (uint8_t prec = 0; prec <= 4; prec++)
+  {
+    double lsb = pow(10.0, -prec);
+    unsigned long compared = 0;
+
+    // MS5637: temperature -40C to +85C, pressure 10mbar to 1200mbar (roughly)
+    {
+      SimMS56xx sim;
+      Wire.attach(0x76, &sim);
+      SFE_QUAD_Sensors sensors;
+      sensors.setWirePort(Wire);
+      sensors._sprintf.setPrecision(prec);
+      SFE_QUAD_Sensor *sensor = sensors.addSensor(SFE_QUAD_Sensors::Sensor_MS5637, 0x76, 0, 0);
+      CHECK(sensor != NULL);
+      CHECK(sensors.beginSensors());
+      CHECK(sensors.initializeSensors());
+      for (int n = 0; n < samples; n++)
+      {
+        sim.d2 = (uint32_t)randomRange(8077568 - 1790000, 8077568 + 1940000);
+        sim.d1 = (uint32_t)randomRange(3000000, 9000000);
+        compared += compareReadings(sensors, sensor, lsb);
+      }
+      Wire.detach(0x76);
+    }
+
+    // MS8607: as the MS5637, plus humidity
+    {
+      SimMS56xx pressure;
+      SimMS8607Humidity humidity;
+      Wire.attach(0x76, &pressure);
+      Wire.attach(0x40, &humidity);
+      SFE_QUAD_Sensors sensors;
+      sensors.setWirePort(Wire);
+      sensors._sprintf.setPrecision(prec);
+      SFE_QUAD_Sensor *sensor = sensors.addSensor(SFE_QUAD_Sensors::Sensor_MS8607, 0x40, 0, 0);
+      CHECK(sensor != NULL);
+      CHECK(sensors.beginSensors());
+      CHECK(sensors.initializeSensors());
+      for (int n = 0; n < samples; n++)
+      {
+        pressure.d2 = (uint32_t)randomRange(8077568 - 1790000, 8077568 + 1940000);
+        pressure.d1 = (uint32_t)randomRange(3000000, 9000000);
+        humidity.adc = (uint16_t)randomRange(0x0C00, 0xFC00);
+        compared += compareReadings(sensors, sensor, lsb);
+      }
+      Wire.detach(0x76);
+      Wire.detach(0x40);
+    }
+
+    // BME280
+    {
+      SimBME280 sim;
+      Wire.attach(0x77, &sim);
+      SFE_QUAD_Sensors sensors;
+      sensors.setWirePort(Wire);
+      sensors._sprintf.setPrecision(prec);
+      SFE_QUAD_Sensor *sensor = sensors.addSensor(SFE_QUAD_Sensors::Sensor_BME280, 0x77, 0, 0);
+      CHECK(sensor != NULL);
+      CHECK(sensors.beginSensors());
+      CHECK(sensors.initializeSensors());
+      for (int n = 0; n < samples; n++)
+      {
+        sim.setADC(randomRange(250000, 450000), randomRange(400000, 600000), randomRange(20000, 40000));
+        compared += compareReadings(sensors, sensor, lsb);
+      }
+      Wire.detach(0x77);
+    }
+
+    printf("sensors: precision %u, %lu readings compared\n", prec, compared);
+  }
+}
+
+// ---- Sampling ----
+
+// Sample every sense, then read the same (unchanged) ADC values with getSenseValue and keep the exact statistics.
+// Returns the number of senses compared
+static unsigned long compareStatistics(SFE_QUAD_Sensors &sensors, SFE_QUAD_Sensor *sensor, int samples, void (*setADC)(void))
+{
+  uint8_t senseCount;
+  sensor->getSenseCount(&senseCount);
+  double sum[4] = {0.0, 0.0, 0.0, 0.0};
+  double min[4];
+  double max[4];
+
+  for (int n = 0; n < samples; n++)
+  {
+    setADC();
+    CHECK(sensors.sampleSensors());
+    for (uint8_t sense = 0; sense < senseCount; sense++)
+    {
+      double value = 0.0;
+      CHECK(sensor->getSenseValue(sense, &value));
+      sum[sense] += value;
+      if ((n == 0) || (value < min[sense]))
+        min[sense] = value;
+      if ((n == 0) || (value > max[sense]))
+        max[sense] = value;
+    }
+  }
+
+  for (uint8_t sense = 0; sense < senseCount; sense++)
+  {
+    SFE_QUAD_Sensor::SFE_QUAD_Sense_Statistics_t *stats = &sensor->_statistics[sense];
+    double mean = sum[sense] / samples;
+    CHECK(stats->count == (uint32_t)samples);
+    CHECK(fabs(stats->mean - mean) <= fabs(mean) * 1e-9);
+    CHECK(stats->min == min[sense]);
+    CHECK(stats->max == max[sense]);
+  }
+  return senseCount;
+}
+
+static SimMS56xx *samplingMS5637;
+static SimBME280 *samplingBME280;
+
+static void setMS5637ADC(void)
+{
+  samplingMS5637->d2 = (uint32_t)randomRange(8077568 - 1790000, 8077568 + 1940000);
+  samplingMS5637->d1 = (uint32_t)randomRange(3000000, 9000000);
+}
+
+static void setBME280ADC(void)
+{
+  samplingBME280->setADC(randomRange(250000, 450000), randomRange(400000, 600000), randomRange(20000, 40000));
+}
+
+static void testSampling(void)
+{
+  const int samples = 200;
+  unsigned long compared = 0;
+
+  for (int integerMath = 0; integerMath <= 1; integerMath++)
+  {
+    SFE_QUAD_Sensor::SFE_QUAD_Sensor_Every_Type_t value;
+    value.BOOL = (integerMath == 1);
+
+    {
+      SimMS56xx sim;
+      samplingMS5637 = &sim;
+      Wire.attach(0x76, &sim);
+      SFE_QUAD_Sensors sensors;
+      sensors.setWirePort(Wire);
+      sensors._sprintf.setPrecision(0); // Round the text readings to whole numbers
+      SFE_QUAD_Sensor *sensor = sensors.addSensor(SFE_QUAD_Sensors::Sensor_MS5637, 0x76, 0, 0);
+      CHECK(sensor != NULL);
+      CHECK(sensors.beginSensors());
+      CHECK(sensors.initializeSensors());
+      sensor->setSetting(0, &value);
+      compared += compareStatistics(sensors, sensor, samples, setMS5637ADC);
+      Wire.detach(0x76);
+    }
+
+    {
+      SimBME280 sim;
+      samplingBME280 = &sim;
+      Wire.attach(0x77, &sim);
+      SFE_QUAD_Sensors sensors;
+      sensors.setWirePort(Wire);
+      sensors._sprintf.setPrecision(0);
+      SFE_QUAD_Sensor *sensor = sensors.addSensor(SFE_QUAD_Sensors::Sensor_BME280, 0x77, 0, 0);
+      CHECK(sensor != NULL);
+      CHECK(sensors.beginSensors());
+      CHECK(sensors.initializeSensors());
+      sensor->setSetting(0, &value);
+      compared += compareStatistics(sensors, sensor, samples, setBME280ADC);
+      Wire.detach(0x77);
+    }
+  }
+
+  printf("sampling: %lu senses compared at precision 0\n", compared);
+}
+
+// ---- Benchmark ----
+
+static volatile char sink; // Stop the compiler from removing the loops
+
+static void benchmark(void)
+{
+  SFE_QUAD_Sensors_sprintf fmt;
+  char buffer[48];
+  const int32_t count = 1000000;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int32_t value = 0; value < count; value++)
+  {
+    fmt._dtostrf((double)(float)((float)(value * 7) / 100), buffer);
+    sink ^= buffer[0];
+  }
+  auto middle = std::chrono::steady_clock::now();
+  for (int32_t value = 0; value < count; value++)
+  {
+    fmt._fixtostrf(value * 7, 2, buffer);
+    sink ^= buffer[0];
+  }
+  auto stop = std::chrono::steady_clock::now();
+
+  double floating = std::chrono::duration<double, std::nano>(middle - start).count() / count;
+  double fixed = std::chrono::duration<double, std::nano>(stop - middle).count() / count;
+  printf("Format one reading (host)      ns/reading\n");
+  printf("_dtostrf (float / 100)         %10.2f\n", floating);
+  printf("_fixtostrf (hundredths)        %10.2f\n", fixed);
+}
+
+int main(void)
+{
+  testFixtostrf();
+  testSensors();
+  testSampling();
+  benchmark();
+
+  if (failures > 0)
+  {
+    printf("FAIL: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
@@ -0,0 +1,368 @@
+// Host test: the log manager (SFE_QUAD_Log_Manager) through SFE_QUAD_Sensors__SdFat, on the in-memory card (common/SdFat.h).
+//
+//   rotation   Rows logged with a small maxFileSize are spread over several files. Every row is in exactly one file, in order,
+//              and each file ends with a whole row - none of the pre-allocation is left. Each file has a closed index entry
+//   find       findLogPosition for every timestamp (two rows share each timestamp): reading from the position finds the first
+//              row at or after the timestamp, within indexInterval rows. Also while logging
+//   unclean    A power loss with Example6's settings (index every 100 rows, sync every second), then beginLog: every row which
+//              was synced is kept - including those after the last indexed row - and the pre-allocation is released.
+//              findLogPosition finds the rows after the last indexed row
+//   rotated    A power loss just after a rotation: the new file holds no rows, so beginLog reuses it
+//   lagging    A power loss between a sync and the index update, part way through a row: beginLog cuts the file back to the
+//              last whole row, and the entry for the row which was lost becomes a closed entry. findLogPosition for the lost
+//              row finds the rows logged after beginLog
+
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "SdFat.h"
+
+#include "SFE_QUAD_Sensors.h"
+
+static int failures = 0;
+
+#define CHECK(condition)                                                            \
+  do                                                                                \
+  {                                                                                 \
+    if (!(condition))                                                               \
+    {                                                                               \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                                   \
+    }                                                                               \
+  } while (0)
+
+typedef SFE_QUAD_Log_Manager::SFE_QUAD_Log_Index_t Entry;
+
+// A row in the log files: "R,sequence,timestamp"
+struct Row
+{
+  uint32_t fileNumber;
+  uint32_t offset;
+  uint32_t end;
+  uint32_t sequence;
+  uint32_t timestamp;
+};
+
+static std::string fileName(uint32_t fileNumber)
+{
+  char name[SFE_QUAD_LOG_NAME_LEN];
+  snprintf(name, sizeof(name), "dataLog%05lu.csv", (unsigned long)fileNumber);
+  return name;
+}
+
+static std::string &fileData(uint32_t fileNumber)
+{
+  return simCard[fileName(fileNumber)].data;
+}
+
+// Every row in every log file, in file order
+static std::vector<Row> readRows(void)
+{
+  std::vector<Row> rows;
+  for (uint32_t fileNumber = 0; simCard.count(fileName(fileNumber)) > 0; fileNumber++)
+  {
+    const std::string &data = fileData(fileNumber);
+    size_t start = 0;
+    while (start < data.size())
+    {
+      size_t end = data.find("\r\n", start);
+      if (end == std::string::npos)
+        end = data.size();
+      else
+        end += 2;
+      unsigned long sequence, timestamp;
+      if (sscanf(data.c_str() + start, "R,%lu,%lu", &sequence, &timestamp) == 2)
+        rows.push_back(Row{fileNumber, (uint32_t)start, (uint32_t)end, (uint32_t)sequence, (uint32_t)timestamp});
+      start = end;
+    }
+  }
+  return rows;
+}
+
+static std::vector<Entry> readIndex(void)
+{
+  std::vector<Entry> entries;
+  const std::string &data = simCard["dataLog.idx"].data;
+  for (size_t position = 0; position + sizeof(Entry) <= data.size(); position += sizeof(Entry))
+  {
+    Entry entry;
+    memcpy(&entry, data.data() + position, sizeof(Entry));
+    entries.push_back(entry);
+  }
+  return entries;
+}
+
+// Each file holds whole rows: no pre-allocation (stale data) and no partial row at the end
+static bool filesClean(void)
+{
+  bool clean = true;
+  for (uint32_t fileNumber = 0; simCard.count(fileName(fileNumber)) > 0; fileNumber++)
+  {
+    const std::string &data = fileData(fileNumber);
+    if (data.find(SIM_CARD_STALE) != std::string::npos)
+      clean = false;
+    if ((data.size() < 2) || (data.compare(data.size() - 2, 2, "\r\n") != 0))
+      clean = false;
+  }
+  return clean;
+}
+
+// Each closed entry records the final length of its file
+static bool closedEntriesMatch(const std::vector<Entry> &entries)
+{
+  bool match = true;
+  for (size_t e = 0; e < entries.size(); e++)
+    if ((entries[e].closed != 0) && ((entries[e].offset != fileData(entries[e].fileNumber).size()) || (entries[e].validLength != entries[e].offset)))
+      match = false;
+  return match;
+}
+
+// The index of the first row at or after (fileNumber, offset)
+static size_t rowAt(const std::vector<Row> &rows, uint32_t fileNumber, uint32_t offset)
+{
+  size_t r = 0;
+  while ((r < rows.size()) && ((rows[r].fileNumber < fileNumber) || ((rows[r].fileNumber == fileNumber) && (rows[r].offset < offset))))
+    r++;
+  return r;
+}
+
+// The index of the first row at or after timestamp
+static size_t rowAtTimestamp(const std::vector<Row> &rows, uint32_t timestamp)
+{
+  size_t r = 0;
+  while ((r < rows.size()) && (rows[r].timestamp < timestamp))
+    r++;
+  return r;
+}
+
+static bool logRows(SFE_QUAD_Sensors__SdFat &sensors, uint32_t first, uint32_t count, uint32_t firstTimestamp, uint32_t rowsPerTimestamp, unsigned long rowMillis)
+{
+  bool result = true;
+  for (uint32_t sequence = first; sequence < first + count; sequence++)
+  {
+    uint32_t timestamp = firstTimestamp + ((sequence - first) / rowsPerTimestamp);
+    char row[40];
+    snprintf(row, sizeof(row), "R,%lu,%lu", (unsigned long)sequence, (unsigned long)timestamp);
+    if (!sensors.writeLog(row, timestamp))
+      result = false;
+    simAdvanceMicros(rowMillis * 1000);
+  }
+  return result;
+}
+
+// ---- Tests ----
+
+static void testRotationAndFind(void)
+{
+  simCardClear();
+  SFE_QUAD_Sensors__SdFat sensors;
+  CHECK(sensors.beginStorage(5, "Config.csv"));
+
+  const uint32_t maxFileSize = 1000;
+  const uint32_t indexInterval = 10;
+  CHECK(sensors.beginLog("dataLog", maxFileSize, 0, indexInterval, 1024));
+  CHECK(sensors.getLogFileNumber() == 0);
+  CHECK(logRows(sensors, 0, 150, 1000, 2, 10));
+
+  // findLogPosition while logging: the index is open for writing
+  uint32_t fileNumber = 0xFFFFFFFF, offset = 0xFFFFFFFF;
+  CHECK(sensors.findLogPosition(1000, &fileNumber, &offset));
+  CHECK(fileNumber == 0);
+
+  CHECK(logRows(sensors, 150, 150, 1075, 2, 10));
+  uint32_t lastFile = sensors.getLogFileNumber();
+  CHECK(sensors.endLog());
+
+  // rotation
+  std::vector<Row> rows = readRows();
+  CHECK(rows.size() == 300);
+  bool ordered = true;
+  for (size_t r = 0; r < rows.size(); r++)
+    if (rows[r].sequence != r)
+      ordered = false;
+  CHECK(ordered);
+  CHECK(lastFile >= 2);
+  bool sized = true;
+  for (uint32_t f = 0; f <= lastFile; f++)
+    if (fileData(f).size() >= maxFileSize + 20) // Rotated once a row takes it to maxFileSize
+      sized = false;
+  CHECK(sized);
+  CHECK(simCard.count(fileName(lastFile + 1)) == 0);
+  CHECK(filesClean());
+
+  std::vector<Entry> entries = readIndex();
+  CHECK(closedEntriesMatch(entries));
+  uint32_t closedFiles = 0;
+  bool monotonic = true;
+  for (size_t e = 0; e < entries.size(); e++)
+  {
+    if (entries[e].closed != 0)
+      closedFiles++;
+    if ((e > 0) && (entries[e].timestamp < entries[e - 1].timestamp))
+      monotonic = false;
+  }
+  CHECK(closedFiles == lastFile + 1);
+  CHECK(monotonic);
+  CHECK((entries.size() > 0) && (entries.back().closed != 0) && (entries.back().fileNumber == lastFile));
+
+  // find
+  size_t worst = 0;
+  bool found = true;
+  for (uint32_t timestamp = 990; timestamp <= 1160; timestamp++)
+  {
+    if (!sensors.findLogPosition(timestamp, &fileNumber, &offset))
+    {
+      found = false;
+      continue;
+    }
+    size_t position = rowAt(rows, fileNumber, offset);
+    size_t target = rowAtTimestamp(rows, timestamp);
+    if ((position > target) || (target - position > indexInterval))
+      found = false;
+    else if (target - position > worst)
+      worst = target - position;
+  }
+  CHECK(found);
+
+  printf("rotation: 300 rows in %lu files, %d index entries, %lu syncs\n", (unsigned long)lastFile + 1, (int)entries.size(), simCardSyncs);
+  printf("find: every timestamp found, at most %d rows before the first matching row\n", (int)worst);
+}
+
+static void testUncleanShutdown(void)
+{
+  simCardClear();
+
+  // Example6's settings: index every 100 rows, sync once per second. A row every 100ms
+  SFE_QUAD_Sensors__SdFat *lost = new SFE_QUAD_Sensors__SdFat;
+  CHECK(lost->beginStorage(5, "Config.csv"));
+  lost->_logWriter.setSyncBudget(1000, 0);
+  CHECK(lost->beginLog("dataLog", 0, 0, 100));
+  uint32_t lostFile = lost->getLogFileNumber();
+  CHECK(logRows(*lost, 0, 250, 5000, 1, 100));
+  uint32_t synced = lost->_logWriter.syncedPosition();
+
+  // The last index entry is for row 200, but the rows up to the last sync (a second ago) are on the card
+  std::vector<Entry> entries = readIndex();
+  CHECK((entries.size() == 3) && (entries.back().timestamp == 5200) && (entries.back().validLength == synced));
+
+  simPowerLoss(); // lost is abandoned - never closed
+  CHECK(fileData(lostFile).size() == SFE_QUAD_SDFAT_LOG_PREALLOCATE); // FAT: the size is the pre-allocation
+
+  SFE_QUAD_Sensors__SdFat sensors;
+  CHECK(sensors.beginStorage(5, "Config.csv"));
+  CHECK(sensors.beginLog("dataLog", 0, 0, 100));
+  CHECK(sensors.getLogFileNumber() == lostFile + 1);
+
+  CHECK(fileData(lostFile).size() == synced); // Everything which was synced is kept
+  std::vector<Row> rows = readRows();
+  CHECK((rows.size() > 240) && (rows.back().end == synced));
+  entries = readIndex();
+  CHECK((entries.size() == 4) && (entries.back().closed != 0) && (entries.back().fileNumber == lostFile));
+
+  CHECK(logRows(sensors, 250, 10, 6000, 1, 100));
+  CHECK(sensors.endLog());
+  CHECK(filesClean());
+  CHECK(closedEntriesMatch(readIndex()));
+
+  uint32_t fileNumber, offset;
+  CHECK(sensors.findLogPosition(5230, &fileNumber, &offset));
+  CHECK(fileNumber == lostFile);
+  rows = readRows();
+  size_t position = rowAt(rows, fileNumber, offset);
+  CHECK((position < rows.size()) && (rows[position].timestamp == 5200));
+
+  printf("unclean: 250 rows logged, %d kept after the power loss (the last index entry is for row 200)\n", (int)rowAtTimestamp(rows, 6000));
+}
+
+static void testRotatedShutdown(void)
+{
+  simCardClear();
+
+  SFE_QUAD_Sensors__SdFat *lost = new SFE_QUAD_Sensors__SdFat;
+  CHECK(lost->beginStorage(5, "Config.csv"));
+  CHECK(lost->beginLog("dataLog", 100000, 0, 10));
+  CHECK(logRows(*lost, 0, 20, 100, 1, 10));
+  CHECK(lost->rotateLog());
+  uint32_t emptyFile = lost->getLogFileNumber();
+  CHECK(logRows(*lost, 20, 5, 120, 1, 10)); // Buffered, not synced
+  simPowerLoss();
+  CHECK(fileData(emptyFile).find("R,") == std::string::npos);
+
+  SFE_QUAD_Sensors__SdFat sensors;
+  CHECK(sensors.beginStorage(5, "Config.csv"));
+  CHECK(sensors.beginLog("dataLog", 100000, 0, 10));
+  CHECK(sensors.getLogFileNumber() == emptyFile);
+  CHECK(logRows(sensors, 100, 5, 200, 1, 10));
+  CHECK(sensors.endLog());
+  CHECK(filesClean());
+  CHECK(closedEntriesMatch(readIndex()));
+
+  std::vector<Row> rows = readRows();
+  CHECK((rows.size() == 25) && (rows[20].fileNumber == emptyFile) && (rows[20].sequence == 100));
+
+  printf("rotated: the empty file %lu was reused\n", (unsigned long)emptyFile);
+}
+
+static void testLaggingIndex(void)
+{
+  simCardClear();
+
+  SFE_QUAD_Sensors__SdFat *lost = new SFE_QUAD_Sensors__SdFat;
+  CHECK(lost->beginStorage(5, "Config.csv"));
+  CHECK(lost->beginLog("dataLog", 100000, 0, 10, 1024));
+  uint32_t lostFile = lost->getLogFileNumber();
+  CHECK(logRows(*lost, 0, 200, 300, 1, 10));
+  simPowerLoss();
+
+  // The power went after the last sync, but before the index was updated - and before the sync in which the last indexed
+  // row was written. The previous sync ended part way through a row (as a sync from the writer task can)
+  std::vector<Entry> entries = readIndex();
+  size_t last = entries.size() - 1;
+  uint32_t lostTimestamp = entries[last].timestamp;
+  uint32_t lagging = entries[last].offset - 5;
+  entries[last].validLength = lagging;
+  memcpy(&simCard["dataLog.idx"].data[last * sizeof(Entry)], &entries[last], sizeof(Entry));
+  simCard["dataLog.idx"].synced = simCard["dataLog.idx"].data;
+
+  SFE_QUAD_Sensors__SdFat sensors;
+  CHECK(sensors.beginStorage(5, "Config.csv"));
+  CHECK(sensors.beginLog("dataLog", 100000, 0, 10, 1024));
+  CHECK(sensors.getLogFileNumber() == lostFile + 1);
+
+  uint32_t recovered = fileData(lostFile).size();
+  CHECK((recovered < lagging) && (recovered > lagging - 20)); // Back to the end of the previous whole row
+  std::vector<Entry> after = readIndex();
+  CHECK(after.size() == entries.size()); // The entry for the lost row became the closed entry
+  CHECK((after[last].closed != 0) && (after[last].offset == recovered) && (after[last].timestamp == lostTimestamp));
+
+  CHECK(logRows(sensors, 200, 10, 1000, 1, 10));
+  CHECK(sensors.endLog());
+  CHECK(filesClean());
+  CHECK(closedEntriesMatch(readIndex()));
+
+  uint32_t fileNumber, offset;
+  CHECK(sensors.findLogPosition(lostTimestamp, &fileNumber, &offset));
+  std::vector<Row> rows = readRows();
+  size_t position = rowAt(rows, fileNumber, offset);
+  size_t target = rowAtTimestamp(rows, lostTimestamp);
+  CHECK((position <= target) && (target < rows.size()) && (rows[target].fileNumber == lostFile + 1)); // The row at lostTimestamp was lost
+
+  printf("lagging: valid length %lu (mid-row), recovered %lu\n", (unsigned long)lagging, (unsigned long)recovered);
+}
+
+int main(void)
+{
+  testRotationAndFind();
+  testUncleanShutdown();
+  testRotatedShutdown();
+  testLaggingIndex();
+
+  if (failures > 0)
+  {
+    printf("FAIL: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
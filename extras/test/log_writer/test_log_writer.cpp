@@ -0,0 +1,433 @@
+// Host test: SFE_QUAD_Log_Writer, writing to a simulated file which records every write.
+//
+//   wrap       The rows wrap around the ring buffer many times. The file holds exactly the rows, and every write made by
+//              service starts and ends on a sector boundary
+//   offset     Appending to a file which is not a whole number of sectors: the first write tops up the partial sector,
+//              the rest are whole sectors, including the sectors which are split by the end of the ring
+//   budget     The time budget syncs once syncMillis has passed (and not before), writing the partial sector first.
+//              The byte budget syncs once syncBytes are waiting. Nothing is synced when nothing was written
+//   failure    A short write (card full) makes service and flush return false. A failed sync - through the sync callback
+//              or reported by Print::getWriteError - does not advance syncedPosition, and the next sync tries again
+//   marks      The sync callback takes each mark before its position is synced, in order. Only marks before the position being
+//              synced are taken. When the marks are full, service syncs early - without a time or byte budget
+
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+
+#include "SFE_QUAD_Log_Writer.h"
+
+static int failures = 0;
+
+#define CHECK(condition)                                                            \
+  do                                                                                \
+  {                                                                                 \
+    if (!(condition))                                                               \
+    {                                                                               \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                                   \
+    }                                                                               \
+  } while (0)
+
+// ---- Simulated file ----
+
+class SimFile : public Print
+{
+public:
+  SimFile(uint32_t size = 0) : data(size, '#') {}
+
+  size_t write(const uint8_t *buffer, size_t size)
+  {
+    if (data.size() + size > capacity)
+      size = (data.size() < capacity) ? capacity - data.size() : 0; // Card full
+    writes.push_back(Write{(uint32_t)data.size(), (uint32_t)size});
+    data.append((const char *)buffer, size);
+    return size;
+  }
+  size_t write(uint8_t c) { return write(&c, 1); }
+  using Print::write;
+
+  void flush()
+  {
+    flushes++;
+    if (failSync)
+      setWriteError();
+    else
+      synced = data.size();
+  }
+
+  struct Write
+  {
+    uint32_t position;
+    uint32_t size;
+  };
+
+  std::string data;              // Everything written to the file
+  std::vector<Write> writes;     // Every call to write
+  size_t capacity = 0xFFFFFFFF;  // Writes beyond this are short
+  bool failSync = false;         // Make flush (and the sync callback) fail
+  int flushes = 0;               // The number of calls to flush
+  int syncs = 0;                 // The number of calls to the sync callback
+  uint32_t synced = 0;           // The file size at the last successful sync
+  uint32_t callbackPosition = 0; // The filePosition passed to the sync callback
+};
+
+static bool syncSimFile(void *context, uint32_t filePosition)
+{
+  SimFile *file = (SimFile *)context;
+  file->syncs++;
+  file->callbackPosition = filePosition;
+  if (file->failSync)
+    return false;
+  file->synced = file->data.size();
+  return true;
+}
+
+// A sync callback which takes the marks, like the log manager's: it records each mark, and the synced size at the time
+struct Taken
+{
+  uint32_t position;
+  uint32_t tag;
+  uint32_t synced;
+};
+static std::vector<Taken> taken;
+static SFE_QUAD_Log_Writer *markWriter = NULL;
+
+static bool syncTakeMarks(void *context, uint32_t filePosition)
+{
+  SimFile *file = (SimFile *)context;
+  Taken mark;
+  while (markWriter->takeMark(filePosition, &mark.position, &mark.tag))
+  {
+    mark.synced = file->synced;
+    taken.push_back(mark);
+  }
+  return syncSimFile(context, filePosition);
+}
+
+static std::string makeRow(int n)
+{
+  char row[64];
+  snprintf(row, sizeof(row), "%d,%lu,21.%02d,1013.%02d", n, (unsigned long)n * 1000, n % 100, (n * 7) % 100); // Rows of varying length
+  return row;
+}
+
+// The writes since first: every write must be whole sectors, except that the end of the ring can split one into two writes
+static bool sectorAligned(const SimFile &file, size_t first)
+{
+  if (first >= file.writes.size())
+    return false;
+  if ((file.writes[first].position % SFE_QUAD_LOG_WRITER_SECTOR_SIZE) != 0)
+    return false;
+  const SimFile::Write &last = file.writes.back();
+  return ((last.position + last.size) % SFE_QUAD_LOG_WRITER_SECTOR_SIZE) == 0;
+}
+
+// ---- Tests ----
+
+static void testWrap(void)
+{
+  SimFile file;
+  SFE_QUAD_Log_Writer writer;
+  writer.setSyncBudget(0, 0); // Only flush syncs
+  CHECK(writer.begin(file, 1000)); // Rounded up to 1024
+  writer.setSyncCallback(syncSimFile, &file);
+
+  std::string expected;
+  bool aligned = true;
+  for (int n = 0; n < 500; n++)
+  {
+    std::string row = makeRow(n);
+    CHECK(writer.println(row.c_str()) == row.length() + 2);
+    expected += row + "\r\n";
+
+    size_t first = file.writes.size();
+    CHECK(writer.service());
+    if (file.writes.size() > first)
+      aligned = aligned && sectorAligned(file, first);
+    CHECK(writer.bytesBuffered() < SFE_QUAD_LOG_WRITER_SECTOR_SIZE); // service leaves less than a sector
+  }
+  CHECK(aligned);
+  CHECK(file.syncs == 0);
+  CHECK(writer.syncedPosition() == 0);
+
+  CHECK(writer.flush());
+  CHECK(file.data == expected);
+  CHECK(file.syncs == 1);
+  CHECK(writer.syncedPosition() == expected.length());
+  CHECK(writer.bytesDropped() == 0);
+
+  // Rows longer than the buffer are written in passes (no task: write services the full buffer itself)
+  std::string longRow(3000, 'x');
+  CHECK(writer.println(longRow.c_str()) == longRow.length() + 2);
+  expected += longRow + "\r\n";
+  writer.end();
+  CHECK(file.data == expected);
+  CHECK(file.syncs == 2);
+
+  printf("wrap: %d rows, %d bytes through a 1024-byte ring in %d writes\n", 500, (int)file.data.length(), (int)file.writes.size());
+}
+
+static void testOffset(void)
+{
+  const uint32_t start = 700; // Appending to a file which ends part way through its second sector
+  SimFile file(start);
+  SFE_QUAD_Log_Writer writer;
+  writer.setSyncBudget(0, 0);
+  CHECK(writer.begin(file, 1024, start));
+  writer.setSyncCallback(syncSimFile, &file);
+
+  // Less than the top-up: nothing is written
+  std::string expected(start, '#');
+  std::string row(300, 'a');
+  writer.write(row.c_str());
+  expected += row;
+  CHECK(writer.service());
+  CHECK(file.writes.size() == 0);
+
+  // Enough for the top-up: one write of 1024 - 700 = 324 bytes
+  writer.write(row.c_str());
+  expected += row;
+  CHECK(writer.service());
+  CHECK(file.writes.size() == 1);
+  if (file.writes.size() == 1)
+  {
+    CHECK(file.writes[0].position == start);
+    CHECK(file.writes[0].size == SFE_QUAD_LOG_WRITER_SECTOR_SIZE - (start % SFE_QUAD_LOG_WRITER_SECTOR_SIZE));
+  }
+
+  // The ring starts at file position 700, so its end (1724, 2748, ...) is not on a sector boundary.
+  // A sector across the end of the ring is written in two parts, and the next write still starts on a sector boundary
+  bool aligned = true;
+  bool split = false;
+  for (int n = 0; n < 200; n++)
+  {
+    std::string next = makeRow(n);
+    writer.write(next.c_str());
+    expected += next;
+
+    size_t first = file.writes.size();
+    CHECK(writer.service());
+    if (file.writes.size() > first)
+    {
+      aligned = aligned && sectorAligned(file, first);
+      for (size_t w = first; w < file.writes.size(); w++)
+        if ((file.writes[w].position + file.writes[w].size) % SFE_QUAD_LOG_WRITER_SECTOR_SIZE != 0)
+          split = true;
+    }
+  }
+  CHECK(aligned);
+  CHECK(split);
+
+  CHECK(writer.flush());
+  CHECK(file.data == expected);
+  CHECK(writer.syncedPosition() == expected.length());
+
+  printf("offset: first write %u bytes at %u, then %d more writes\n", (unsigned)file.writes[0].size, (unsigned)file.writes[0].position, (int)file.writes.size() - 1);
+}
+
+static void testBudget(void)
+{
+  // Time budget
+  {
+    SimFile file;
+    SFE_QUAD_Log_Writer writer;
+    writer.setSyncBudget(1000, 0);
+    CHECK(writer.begin(file, 4096));
+    writer.setSyncCallback(syncSimFile, &file);
+
+    simAdvanceMicros(2000000); // Nothing written: nothing to sync
+    CHECK(writer.service());
+    CHECK(file.syncs == 0);
+
+    std::string row = makeRow(1) + "\r\n";
+    writer.write(row.c_str());
+    CHECK(writer.service()); // The budget restarts at the last sync (begin): 2s have passed
+    CHECK(file.syncs == 1);
+    CHECK(file.data == row); // The partial sector was written before the sync
+    CHECK(file.callbackPosition == row.length());
+    CHECK(writer.syncedPosition() == row.length());
+
+    writer.write(row.c_str());
+    simAdvanceMicros(998000);
+    CHECK(writer.service());
+    CHECK(file.syncs == 1); // Not yet
+    CHECK(writer.syncedPosition() == row.length());
+
+    simAdvanceMicros(2000);
+    CHECK(writer.service());
+    CHECK(file.syncs == 2);
+    CHECK(writer.syncedPosition() == 2 * row.length());
+    writer.end();
+  }
+
+  // Byte budget
+  {
+    SimFile file;
+    SFE_QUAD_Log_Writer writer;
+    writer.setSyncBudget(0, 2048);
+    CHECK(writer.begin(file, 4096));
+    writer.setSyncCallback(syncSimFile, &file);
+
+    std::string block(1000, 'b');
+    writer.write(block.c_str());
+    simAdvanceMicros(10000000);
+    CHECK(writer.service());
+    CHECK(file.syncs == 0); // No time budget
+
+    writer.write(block.c_str());
+    CHECK(writer.service());
+    CHECK(file.syncs == 0); // 1536 written, 464 buffered: 2000 < 2048
+    CHECK(file.data.length() == 1536);
+
+    writer.write(block.c_str());
+    CHECK(writer.service());
+    CHECK(file.syncs == 1); // 3000 >= 2048: everything is written and synced
+    CHECK(file.data.length() == 3000);
+    CHECK(writer.syncedPosition() == 3000);
+    writer.end();
+  }
+
+  printf("budget: time and byte budgets sync when due, and not before\n");
+}
+
+static void testFailure(void)
+{
+  // Short write: the card is full after 600 bytes
+  {
+    SimFile file;
+    file.capacity = 600;
+    SFE_QUAD_Log_Writer writer;
+    writer.setSyncBudget(0, 0);
+    CHECK(writer.begin(file, 4096));
+    writer.setSyncCallback(syncSimFile, &file);
+
+    std::string block(1500, 'c');
+    writer.write(block.c_str());
+    CHECK(!writer.service()); // Asked to write 1024, only 600 written
+    CHECK(file.data.length() == 600);
+    CHECK(writer.bytesBuffered() == 900); // The rest is kept
+    CHECK(writer.syncedPosition() == 0);
+
+    CHECK(!writer.flush()); // Still full: the write fails, so there is no sync
+    CHECK(file.syncs == 0);
+    CHECK(writer.syncedPosition() == 0);
+
+    file.capacity = 0xFFFFFFFF; // Space again: the rest is written
+    CHECK(writer.flush());
+    CHECK(file.data == block);
+    CHECK(writer.syncedPosition() == 1500);
+    writer.end();
+  }
+
+  // Failed sync through the callback
+  {
+    SimFile file;
+    SFE_QUAD_Log_Writer writer;
+    writer.setSyncBudget(0, 512);
+    CHECK(writer.begin(file, 4096));
+    writer.setSyncCallback(syncSimFile, &file);
+
+    std::string block(600, 'd');
+    file.failSync = true;
+    writer.write(block.c_str());
+    CHECK(!writer.service());
+    CHECK(file.syncs == 1);
+    CHECK(file.data.length() == 600); // Written, but not synced
+    CHECK(writer.syncedPosition() == 0);
+
+    file.failSync = false;
+    CHECK(writer.service()); // The unsynced bytes still count towards the byte budget: try again
+    CHECK(file.syncs == 2);
+    CHECK(writer.syncedPosition() == 600);
+    CHECK(file.synced == 600);
+    writer.end();
+  }
+
+  // Failed sync reported by Print::getWriteError (no callback)
+  {
+    SimFile file;
+    SFE_QUAD_Log_Writer writer;
+    writer.setSyncBudget(0, 0);
+    CHECK(writer.begin(file, 4096));
+
+    std::string row = makeRow(2);
+    writer.write(row.c_str());
+    file.failSync = true;
+    CHECK(!writer.flush());
+    CHECK(file.flushes == 1);
+    CHECK(writer.syncedPosition() == 0);
+
+    file.failSync = false;
+    CHECK(writer.flush());
+    CHECK(file.flushes == 2);
+    CHECK(writer.syncedPosition() == row.length());
+    writer.end();
+  }
+
+  printf("failure: short writes and failed syncs are reported, and syncedPosition only moves on success\n");
+}
+
+static void testMarks(void)
+{
+  SimFile file;
+  SFE_QUAD_Log_Writer writer;
+  writer.setSyncBudget(0, 0); // Only flush and full marks sync
+  CHECK(writer.begin(file, 4096));
+  writer.setSyncCallback(syncTakeMarks, &file);
+  markWriter = &writer;
+  taken.clear();
+
+  std::vector<uint32_t> positions;
+  uint32_t position = 0;
+  bool added = true;
+  for (int n = 0; n < 20; n++)
+  {
+    positions.push_back(position);
+    added = added && writer.addMark(position, n);
+    std::string row = makeRow(n);
+    position += writer.println(row.c_str());
+    CHECK(writer.service());
+    if (n == SFE_QUAD_LOG_WRITER_MARKS - 2)
+      CHECK(file.syncs == 0);
+    if (n == SFE_QUAD_LOG_WRITER_MARKS - 1)
+      CHECK((file.syncs == 1) && (taken.size() == SFE_QUAD_LOG_WRITER_MARKS)); // Full: synced early
+  }
+  CHECK(added);
+
+  CHECK(writer.addMark(position, 20)); // Nothing written after it: not taken by the sync
+  CHECK(writer.flush());
+  CHECK(taken.size() == 20);
+  bool ordered = true;
+  for (size_t t = 0; t < taken.size(); t++)
+    if ((taken[t].tag != t) || (taken[t].position != positions[t]) || (taken[t].synced > taken[t].position))
+      ordered = false;
+  CHECK(ordered);
+
+  uint32_t markPosition, tag;
+  CHECK(!writer.takeMark(position, &markPosition, &tag));
+  CHECK(writer.takeMark(position + 1, &markPosition, &tag) && (markPosition == position) && (tag == 20));
+  int syncs = file.syncs;
+  writer.end();
+  markWriter = NULL;
+
+  printf("marks: 20 marks taken in order by %d syncs, each before its row was synced\n", syncs);
+}
+
+int main(void)
+{
+  testWrap();
+  testOffset();
+  testBudget();
+  testFailure();
+  testMarks();
+
+  if (failures > 0)
+  {
+    printf("FAIL: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
@@ -0,0 +1,400 @@
+// Host test: the register shadow (src/src/COMMON/SFE_QUAD_Register_Shadow.h) and the drivers which use it.
+//
+// Each scenario runs a typical sequence of configuration calls on a simulated device and counts the I2C transactions.
+// The same test is built twice: with the shadow, and with SFE_QUAD_REGISTER_SHADOW_DISABLE (every access goes to the device).
+// Both builds check that the drivers behave correctly against the simulated registers - including the self-clearing bits,
+// which must always be written.
+//
+//   test_register_shadow_off > counts.txt   Run without the shadow, save the transaction counts
+//   test_register_shadow counts.txt         Run with the shadow, compare the counts ("before" and "after")
+
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "TMP117/SparkFun_TMP117.h"
+#include "MCP9600/SparkFun_MCP9600.h"
+#include "VCNL4040/SparkFun_VCNL4040_Arduino_Library.h"
+#include "LPS25HB/SparkFun_LPS25HB_Arduino_Library.h"
+#include "MAX1704X/SparkFun_MAX1704x_Fuel_Gauge_Arduino_Library.h"
+#include "QWIICBUTTON/SparkFun_Qwiic_Button.h"
+
+static int failures = 0;
+
+#define CHECK(condition)                                                    \
+  do                                                                        \
+  {                                                                         \
+    if (!(condition))                                                       \
+    {                                                                       \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                           \
+    }                                                                       \
+  } while (0)
+
+struct Result
+{
+  std::string name;
+  unsigned long transactions;
+};
+
+static std::vector<Result> results;
+
+static void record(const char *name)
+{
+  Result result;
+  result.name = name;
+  result.transactions = Wire.transactions;
+  results.push_back(result);
+}
+
+// ---- Simulated devices ----
+
+class SimTMP117 : public SimWordRegisterDevice
+{
+public:
+  SimTMP117() : SimWordRegisterDevice(true) { reg[TMP117_DEVICE_ID] = DEVICE_ID_VALUE; }
+};
+
+class SimMCP9600 : public SimByteRegisterDevice
+{
+public:
+  SimMCP9600()
+  {
+    reg[0x20] = DEV_ID_UPPER; // DEVICE_ID
+    reg[0x21] = 0x11;         // Revision
+  }
+};
+
+#define VCNL4040_PS_CONF1 0x03 // The command codes are defined in the .cpp
+#define VCNL4040_PS_CONF3 0x04
+
+class SimVCNL4040 : public SimWordRegisterDevice
+{
+public:
+  SimVCNL4040() : SimWordRegisterDevice(false) { reg[0x0C] = 0x0186; }
+  void writeRegister(uint8_t address, uint16_t value)
+  {
+    if (address == VCNL4040_PS_CONF3)
+    {
+      if (value & VCNL4040_PS_TRIG_TRIGGER)
+        triggers++;
+      value &= ~((uint16_t)VCNL4040_PS_TRIG_TRIGGER); // PS_TRIG clears itself
+    }
+    reg[address] = value;
+  }
+  int triggers = 0;
+};
+
+class SimLPS25HB : public SimByteRegisterDevice
+{
+public:
+  SimLPS25HB() : SimByteRegisterDevice(0x7F) { reg[LPS25HB_REG_WHO_AM_I] = LPS25HB_DEVID; } // Bit 7 of the pointer is the auto-increment flag
+  void writeRegister(uint8_t address, uint8_t value)
+  {
+    if (address == LPS25HB_REG_CTRL_REG1)
+    {
+      if (value & LPS25HB_CTRL_REG1_RESET_AZ)
+        autozeroResets++;
+      value &= ~LPS25HB_CTRL_REG1_RESET_AZ; // Self-clearing
+    }
+    if (address == LPS25HB_REG_CTRL_REG2)
+    {
+      if (value & LPS25HB_CTRL_REG2_ONE_SHOT)
+        oneShots++;
+      if (value & LPS25HB_CTRL_REG2_AUTOZERO)
+        autozeros++;
+      value &= ~(LPS25HB_CTRL_REG2_ONE_SHOT | LPS25HB_CTRL_REG2_AUTOZERO | LPS25HB_CTRL_REG2_SWRESET | LPS25HB_CTRL_REG2_REBOOT_MEM); // Self-clearing
+    }
+    reg[address] = value;
+  }
+  // With the FIFO enabled, the address wraps from TEMP_OUT_H back to PRESS_OUT_XL and each 5 bytes pops a sample
+  uint8_t nextPointer(uint8_t address)
+  {
+    if ((address == LPS25HB_REG_TEMP_OUT_H) && (reg[LPS25HB_REG_CTRL_REG2] & LPS25HB_CTRL_REG2_FIFO_EN))
+      return LPS25HB_REG_PRESS_OUT_XL;
+    return address + 1;
+  }
+  uint8_t readRegister(uint8_t address)
+  {
+    if ((address >= LPS25HB_REG_PRESS_OUT_XL) && (address <= LPS25HB_REG_TEMP_OUT_H))
+      return 0x10 + address; // Sample data
+    return reg[address];
+  }
+  int oneShots = 0;
+  int autozeros = 0;
+  int autozeroResets = 0;
+};
+
+class SimMAX17048 : public SimWordRegisterDevice
+{
+public:
+  SimMAX17048() : SimWordRegisterDevice(true)
+  {
+    reg[MAX17043_VERSION] = 0x0012;
+    reg[MAX17048_HIBRT] = 0x8030;
+  }
+};
+
+class SimQwiicButton : public SimByteRegisterDevice
+{
+public:
+  SimQwiicButton() { reg[SFE_QWIIC_BUTTON_ID] = SFE_QWIIC_BUTTON_DEV_ID; }
+};
+
+// ---- Scenarios ----
+
+// Set the limits and offset, then read them back every reading (like the wrapper's configuration menu / storage)
+static void testTMP117(void)
+{
+  SimTMP117 sim;
+  Wire.attach(0x48, &sim);
+  TMP117 tmp117;
+  CHECK(tmp117.begin(0x48, Wire));
+  Wire.resetCounts();
+
+  tmp117.setHighLimit(30.0);
+  tmp117.setLowLimit(-10.0);
+  tmp117.setTemperatureOffset(0.5);
+  for (int i = 0; i < 10; i++)
+  {
+    CHECK(fabs(tmp117.getHighLimit() - 30.0) < 0.01);
+    CHECK(fabs(tmp117.getLowLimit() + 10.0) < 0.01);
+    CHECK(fabs(tmp117.getTemperatureOffset() - 0.5) < 0.01);
+  }
+  CHECK((int16_t)sim.reg[TMP117_T_HIGH_LIMIT] == (int16_t)(30.0 / 0.0078125));
+
+  record("TMP117 set limits + 10x get");
+  Wire.detach(0x48);
+}
+
+// Set the thermocouple type and filter, then repeat the same settings (as a stored configuration would)
+static void testMCP9600(void)
+{
+  SimMCP9600 sim;
+  Wire.attach(0x67, &sim);
+  MCP9600 mcp9600;
+  CHECK(mcp9600.begin(0x67, Wire));
+  Wire.resetCounts();
+
+  for (int i = 0; i < 10; i++)
+  {
+    mcp9600.setThermocoupleType(TYPE_J);
+    mcp9600.setFilterCoefficient(3);
+    CHECK(mcp9600.getThermocoupleType() == TYPE_J);
+    CHECK(mcp9600.getFilterCoefficient() == 3);
+  }
+  CHECK(sim.reg[THERMO_SENSOR_CONFIG] == ((TYPE_J << 4) | 3));
+
+  record("MCP9600 10x set/get type + filter");
+  Wire.detach(0x67);
+}
+
+// Reapply the begin configuration, then take single (forced) measurements. PS_TRIG must be written every time
+static void testVCNL4040(void)
+{
+  SimVCNL4040 sim;
+  Wire.attach(0x60, &sim);
+  VCNL4040 vcnl4040;
+  CHECK(vcnl4040.begin(Wire));
+  uint16_t conf1 = sim.reg[VCNL4040_PS_CONF1];
+  Wire.resetCounts();
+
+  for (int i = 0; i < 10; i++)
+  {
+    vcnl4040.setLEDCurrent(200);
+    vcnl4040.setIRDutyCycle(40);
+    vcnl4040.setProxIntegrationTime(8);
+    vcnl4040.takeSingleProxMeasurement();
+  }
+  CHECK(sim.triggers == 10);
+  CHECK(sim.reg[VCNL4040_PS_CONF1] == conf1);
+
+  record("VCNL4040 10x reconfigure + trigger");
+  Wire.detach(0x60);
+}
+
+// Set the FIFO mean mode, then repeat it. ONE_SHOT, AUTOZERO and RESET_AZ must be written every time
+static void testLPS25HB(void)
+{
+  SimLPS25HB sim;
+  Wire.attach(LPS25HB_I2C_ADDR_DEF, &sim);
+  LPS25HB lps25hb;
+  CHECK(lps25hb.begin(Wire));
+  Wire.resetCounts();
+
+  for (int i = 0; i < 10; i++)
+  {
+    CHECK(lps25hb.setFIFOMode(LPS25HB_FIFO_CTRL_MEAN));
+    CHECK(lps25hb.setFIFOMeanNum(LPS25HB_FIFO_CTRL_M_8));
+    CHECK(lps25hb.applySetting(LPS25HB_REG_CTRL_REG2, LPS25HB_CTRL_REG2_ONE_SHOT));
+    CHECK(lps25hb.applySetting(LPS25HB_REG_CTRL_REG2, LPS25HB_CTRL_REG2_AUTOZERO));
+    CHECK(lps25hb.applySetting(LPS25HB_REG_CTRL_REG1, LPS25HB_CTRL_REG1_RESET_AZ));
+  }
+  CHECK(sim.oneShots == 10);
+  CHECK(sim.autozeros == 10);
+  CHECK(sim.autozeroResets == 10);
+  CHECK(sim.reg[LPS25HB_REG_FIFO_CTRL] == (LPS25HB_FIFO_CTRL_MEAN | LPS25HB_FIFO_CTRL_M_8));
+  CHECK(sim.reg[LPS25HB_REG_CTRL_REG2] == LPS25HB_CTRL_REG2_FIFO_EN);
+
+  uint8_t value;
+  CHECK(lps25hb.read(LPS25HB_REG_CTRL_REG2, &value, 1) && (value == LPS25HB_CTRL_REG2_FIFO_EN));
+
+  record("LPS25HB 10x FIFO mean + one-shot");
+  Wire.detach(LPS25HB_I2C_ADDR_DEF);
+}
+
+// Drain the FIFO in bursts. The bursts wrap over PRESS_OUT_XL..TEMP_OUT_H and must not touch the shadowed FIFO_CTRL or THS_P
+static void testLPS25HBFIFO(void)
+{
+  SimLPS25HB sim;
+  Wire.attach(LPS25HB_I2C_ADDR_DEF, &sim);
+  LPS25HB lps25hb;
+  CHECK(lps25hb.begin(Wire));
+  CHECK(lps25hb.setFIFOMode(LPS25HB_FIFO_CTRL_STREAM));
+  CHECK(lps25hb.setFIFOWatermark(16));
+  CHECK(lps25hb.setPressureThreshold(0x1234));
+  sim.reg[LPS25HB_REG_FIFO_STATUS] = 12; // 12 samples waiting
+  Wire.resetCounts();
+
+  int32_t pressure[LPS25HB_FIFO_BURST_SAMPLES];
+  int16_t temperature[LPS25HB_FIFO_BURST_SAMPLES];
+  for (int i = 0; i < 10; i++)
+  {
+    uint8_t level = lps25hb.getFIFOLevel();
+    CHECK(level == 12);
+    while (level > 0)
+    {
+      uint8_t samples = lps25hb.readFIFO(pressure, temperature, LPS25HB_FIFO_BURST_SAMPLES);
+      CHECK(samples == LPS25HB_FIFO_BURST_SAMPLES);
+      CHECK((pressure[samples - 1] == 0x3A3938) && (temperature[samples - 1] == 0x3C3B));
+      level -= samples;
+    }
+  }
+
+  uint8_t value;
+  CHECK(lps25hb.read(LPS25HB_REG_FIFO_CTRL, &value, 1) && (value == sim.reg[LPS25HB_REG_FIFO_CTRL]));
+  CHECK(value == (LPS25HB_FIFO_CTRL_STREAM | 16));
+  CHECK(lps25hb.read(LPS25HB_REG_THS_P_L, &value, 1) && (value == 0x34));
+  CHECK(lps25hb.read(LPS25HB_REG_THS_P_H, &value, 1) && (value == 0x12));
+  CHECK(lps25hb.setFIFOWatermark(8)); // The read-modify-write must start from the real FIFO_CTRL
+  CHECK(sim.reg[LPS25HB_REG_FIFO_CTRL] == (LPS25HB_FIFO_CTRL_STREAM | 8));
+
+  record("LPS25HB 10x FIFO drain (12 samples)");
+  Wire.detach(LPS25HB_I2C_ADDR_DEF);
+}
+
+// Set the hibernate thresholds, then read them back every reading
+static void testMAX17048(void)
+{
+  SimMAX17048 sim;
+  Wire.attach(MAX1704x_ADDRESS, &sim);
+  SFE_MAX1704X max17048(MAX1704X_MAX17048);
+  CHECK(max17048.begin(Wire));
+  Wire.resetCounts();
+
+  max17048.setHIBRTActThr((uint8_t)0x20);
+  max17048.setHIBRTHibThr((uint8_t)0x40);
+  for (int i = 0; i < 10; i++)
+  {
+    CHECK(max17048.getHIBRTActThr() == 0x20);
+    CHECK(max17048.getHIBRTHibThr() == 0x40);
+  }
+  CHECK(sim.reg[MAX17048_HIBRT] == 0x4020);
+
+  record("MAX17048 set HIBRT + 10x get");
+  Wire.detach(MAX1704x_ADDRESS);
+}
+
+// Set the debounce time, then toggle the LED on and off with the same settings (as the wrapper does on each click)
+static void testQwiicButton(void)
+{
+  SimQwiicButton sim;
+  Wire.attach(SFE_QWIIC_BUTTON_DEFAULT_ADDRESS, &sim);
+  QwiicButton button;
+  CHECK(button.begin(SFE_QWIIC_BUTTON_DEFAULT_ADDRESS, Wire));
+  Wire.resetCounts();
+
+  button.setDebounceTime(20);
+  for (int i = 0; i < 10; i++)
+  {
+    CHECK(button.getDebounceTime() == 20);
+    CHECK(button.LEDon(100));
+    CHECK(sim.reg[SFE_QWIIC_BUTTON_LED_BRIGHTNESS] == 100);
+    CHECK(button.LEDoff());
+    CHECK(sim.reg[SFE_QWIIC_BUTTON_LED_BRIGHTNESS] == 0);
+  }
+  CHECK((uint32_t)button.readQuadRegister(SFE_QWIIC_BUTTON_PRESSED_QUEUE_FRONT) == 0); // The queues are not shadowed. Only 4 bytes are read (unsigned long is 8 on the host)
+  CHECK((sim.reg[SFE_QWIIC_BUTTON_BUTTON_DEBOUNCE_TIME] | (sim.reg[SFE_QWIIC_BUTTON_BUTTON_DEBOUNCE_TIME + 1] << 8)) == 20);
+
+  record("QwiicButton debounce + 10x LED on/off");
+  Wire.detach(SFE_QWIIC_BUTTON_DEFAULT_ADDRESS);
+}
+
+int main(int argc, char **argv)
+{
+  testTMP117();
+  testMCP9600();
+  testVCNL4040();
+  testLPS25HB();
+  testLPS25HBFIFO();
+  testMAX17048();
+  testQwiicButton();
+
+#ifdef SFE_QUAD_REGISTER_SHADOW_DISABLE
+  // Print the counts for the build with the shadow to compare against
+  for (size_t i = 0; i < results.size(); i++)
+    printf("%lu %s\n", results[i].transactions, results[i].name.c_str());
+#else
+  // Compare with the counts from the build without the shadow
+  std::vector<Result> before;
+  if (argc > 1)
+  {
+    FILE *file = fopen(argv[1], "r");
+    CHECK(file != NULL);
+    char line[128];
+    while ((file != NULL) && (fgets(line, sizeof(line), file) != NULL))
+    {
+      Result result;
+      char *name;
+      result.transactions = strtoul(line, &name, 10);
+      while (*name == ' ')
+        name++;
+      name[strcspn(name, "\r\n")] = 0;
+      result.name = name;
+      before.push_back(result);
+    }
+    if (file != NULL)
+      fclose(file);
+    CHECK(before.size() == results.size());
+  }
+
+  printf("%-40s %8s %8s\n", "I2C transactions", "before", "after");
+  unsigned long totalBefore = 0, totalAfter = 0;
+  for (size_t i = 0; i < results.size(); i++)
+  {
+    if (i < before.size())
+    {
+      CHECK(before[i].name == results[i].name);
+      CHECK(results[i].transactions < before[i].transactions); // The shadow must save transactions in every scenario
+      totalBefore += before[i].transactions;
+      printf("%-40s %8lu %8lu\n", results[i].name.c_str(), before[i].transactions, results[i].transactions);
+    }
+    else
+      printf("%-40s %8s %8lu\n", results[i].name.c_str(), "-", results[i].transactions);
+    totalAfter += results[i].transactions;
+  }
+  printf("%-40s %8lu %8lu\n", "Total", totalBefore, totalAfter);
+#endif
+
+  if (failures > 0)
+  {
+    printf("FAIL: %d checks failed\n", failures);
+    return 1;
+  }
+#ifndef SFE_QUAD_REGISTER_SHADOW_DISABLE
+  printf("PASS\n");
+#endif
+  return 0;
+}
@@ -0,0 +1,222 @@
+// Host test: the shared Sensirion CRC-8 (src/src/COMMON/SFE_QUAD_Sensirion_CRC).
+//
+// The 256-byte table replaced the CRC code in the SCD30, SCD4x, SDP3x, SGP30, SGP40, SHTC3 and STC3x drivers.
+// The old code is copied below: the bit-by-bit loops (computeCRC8 / _CRC8) and the [16][16] nibble-indexed table
+// (SDP3X_LOOKUP_TABLE / SGP30_LOOKUP_TABLE / SGP40_LOOKUP_TABLE).
+//
+// Equivalence: every 16-bit word, every [MSB, LSB, CRC] triplet and a million random buffers (0-32 bytes)
+// must give the same CRC as the old code.
+// Benchmark: the time per 16-bit word for the old loops and the table, on the host. The ratio on an 8-bit AVR
+// (no barrel shifter, table in flash) is larger than on the PC.
+
+#include <chrono>
+#include <stdio.h>
+
+#include "Arduino.h"
+#include "COMMON/SFE_QUAD_Sensirion_CRC.h"
+
+static int failures = 0;
+
+#define CHECK(condition)                                                            \
+  do                                                                                \
+  {                                                                                 \
+    if (!(condition))                                                               \
+    {                                                                               \
+      if (failures < 10)                                                            \
+        fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                                   \
+    }                                                                               \
+  } while (0)
+
+// ---- The old code ----
+
+// SCD30 / SCD4x computeCRC8
+static uint8_t oldComputeCRC8(const uint8_t data[], uint8_t len)
+{
+  uint8_t crc = 0xFF; // Init with 0xFF
+
+  for (uint8_t x = 0; x < len; x++)
+  {
+    crc ^= data[x]; // XOR-in the next input byte
+
+    for (uint8_t i = 0; i < 8; i++)
+    {
+      if ((crc & 0x80) != 0)
+        crc = (uint8_t)((crc << 1) ^ 0x31);
+      else
+        crc <<= 1;
+    }
+  }
+
+  return crc; // No output reflection
+}
+
+// SDP3x / SGP30 / SGP40 _CRC8 (without the lookup table)
+static uint8_t oldWordCRC8(uint16_t data)
+{
+  uint8_t crc = 0xFF; // Init with 0xFF
+
+  crc ^= (data >> 8); // XOR-in the first input byte
+
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    if ((crc & 0x80) != 0)
+      crc = (uint8_t)((crc << 1) ^ 0x31);
+    else
+      crc <<= 1;
+  }
+
+  crc ^= (uint8_t)data; // XOR-in the last input byte
+
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    if ((crc & 0x80) != 0)
+      crc = (uint8_t)((crc << 1) ^ 0x31);
+    else
+      crc <<= 1;
+  }
+
+  return crc; // No output reflection
+}
+
+// SDP3x / SGP30 / SGP40 _CRC8 (with the lookup table)
+static const uint8_t oldLookupTable[16][16] = {
+    {0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97, 0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E},
+    {0x43, 0x72, 0x21, 0x10, 0x87, 0xB6, 0xE5, 0xD4, 0xFA, 0xCB, 0x98, 0xA9, 0x3E, 0x0F, 0x5C, 0x6D},
+    {0x86, 0xB7, 0xE4, 0xD5, 0x42, 0x73, 0x20, 0x11, 0x3F, 0x0E, 0x5D, 0x6C, 0xFB, 0xCA, 0x99, 0xA8},
+    {0xC5, 0xF4, 0xA7, 0x96, 0x01, 0x30, 0x63, 0x52, 0x7C, 0x4D, 0x1E, 0x2F, 0xB8, 0x89, 0xDA, 0xEB},
+    {0x3D, 0x0C, 0x5F, 0x6E, 0xF9, 0xC8, 0x9B, 0xAA, 0x84, 0xB5, 0xE6, 0xD7, 0x40, 0x71, 0x22, 0x13},
+    {0x7E, 0x4F, 0x1C, 0x2D, 0xBA, 0x8B, 0xD8, 0xE9, 0xC7, 0xF6, 0xA5, 0x94, 0x03, 0x32, 0x61, 0x50},
+    {0xBB, 0x8A, 0xD9, 0xE8, 0x7F, 0x4E, 0x1D, 0x2C, 0x02, 0x33, 0x60, 0x51, 0xC6, 0xF7, 0xA4, 0x95},
+    {0xF8, 0xC9, 0x9A, 0xAB, 0x3C, 0x0D, 0x5E, 0x6F, 0x41, 0x70, 0x23, 0x12, 0x85, 0xB4, 0xE7, 0xD6},
+    {0x7A, 0x4B, 0x18, 0x29, 0xBE, 0x8F, 0xDC, 0xED, 0xC3, 0xF2, 0xA1, 0x90, 0x07, 0x36, 0x65, 0x54},
+    {0x39, 0x08, 0x5B, 0x6A, 0xFD, 0xCC, 0x9F, 0xAE, 0x80, 0xB1, 0xE2, 0xD3, 0x44, 0x75, 0x26, 0x17},
+    {0xFC, 0xCD, 0x9E, 0xAF, 0x38, 0x09, 0x5A, 0x6B, 0x45, 0x74, 0x27, 0x16, 0x81, 0xB0, 0xE3, 0xD2},
+    {0xBF, 0x8E, 0xDD, 0xEC, 0x7B, 0x4A, 0x19, 0x28, 0x06, 0x37, 0x64, 0x55, 0xC2, 0xF3, 0xA0, 0x91},
+    {0x47, 0x76, 0x25, 0x14, 0x83, 0xB2, 0xE1, 0xD0, 0xFE, 0xCF, 0x9C, 0xAD, 0x3A, 0x0B, 0x58, 0x69},
+    {0x04, 0x35, 0x66, 0x57, 0xC0, 0xF1, 0xA2, 0x93, 0xBD, 0x8C, 0xDF, 0xEE, 0x79, 0x48, 0x1B, 0x2A},
+    {0xC1, 0xF0, 0xA3, 0x92, 0x05, 0x34, 0x67, 0x56, 0x78, 0x49, 0x1A, 0x2B, 0xBC, 0x8D, 0xDE, 0xEF},
+    {0x82, 0xB3, 0xE0, 0xD1, 0x46, 0x77, 0x24, 0x15, 0x3B, 0x0A, 0x59, 0x68, 0xFF, 0xCE, 0x9D, 0xAC}};
+
+static uint8_t oldNibbleCRC8(uint16_t data)
+{
+  uint8_t crc = 0xFF;                          // inital value
+  crc ^= (uint8_t)(data >> 8);                 // start with MSB
+  crc = oldLookupTable[crc >> 4][crc & 0xF];   // look up table [MSnibble][LSnibble]
+  crc ^= (uint8_t)data;                        // use LSB
+  crc = oldLookupTable[crc >> 4][crc & 0xF];   // look up table [MSnibble][LSnibble]
+  return crc;
+}
+
+// ---- Equivalence ----
+
+// Every 16-bit word: crc8(word), crc8(data, 2) and the three old versions must agree
+static void testWords(void)
+{
+  for (uint32_t w = 0; w <= 0xFFFF; w++)
+  {
+    uint16_t word = (uint16_t)w;
+    uint8_t data[2] = {(uint8_t)(word >> 8), (uint8_t)(word & 0xFF)};
+    uint8_t expected = oldComputeCRC8(data, 2);
+    CHECK(oldWordCRC8(word) == expected);
+    CHECK(oldNibbleCRC8(word) == expected);
+    CHECK(SFE_QUAD_Sensirion_CRC::crc8(word) == expected);
+    CHECK(SFE_QUAD_Sensirion_CRC::crc8(data, 2) == expected);
+  }
+  printf("crc8: 65536 words compared\n");
+}
+
+// Every [MSB, LSB, CRC] triplet: checkFrame must accept the right CRC and reject the 255 wrong ones.
+// The wrong triplet is also checked as the second word of a frame, after a good word
+static void testFrames(void)
+{
+  uint32_t frames = 0;
+  for (uint32_t w = 0; w <= 0xFFFF; w++)
+  {
+    uint8_t frame[6] = {0xBE, 0xEF, 0x92, (uint8_t)(w >> 8), (uint8_t)(w & 0xFF), 0}; // 0xBEEF has CRC 0x92
+    uint8_t good = oldWordCRC8((uint16_t)w);
+    for (uint32_t crc = 0; crc <= 0xFF; crc++)
+    {
+      frame[5] = (uint8_t)crc;
+      bool ok = (crc == good);
+      CHECK(SFE_QUAD_Sensirion_CRC::checkFrame(&frame[3], 1) == ok);
+      CHECK(SFE_QUAD_Sensirion_CRC::checkFrame(frame, 2) == ok);
+      frames += 2;
+    }
+    CHECK(SFE_QUAD_Sensirion_CRC::frameWord(frame, 1) == (uint16_t)w);
+  }
+  CHECK(SFE_QUAD_Sensirion_CRC::checkFrame(NULL, 0)); // Zero words is a valid (empty) frame
+  printf("checkFrame: %lu frames compared\n", (unsigned long)frames);
+}
+
+// A million random buffers of 0 to 32 bytes (fixed seed, so the test is repeatable)
+static void testBuffers(void)
+{
+  uint32_t seed = 12345;
+  uint8_t data[32];
+  for (uint32_t n = 0; n < 1000000; n++)
+  {
+    seed = (seed * 1103515245) + 12345;
+    uint8_t len = (seed >> 16) % (sizeof(data) + 1);
+    for (uint8_t i = 0; i < len; i++)
+    {
+      seed = (seed * 1103515245) + 12345;
+      data[i] = (uint8_t)(seed >> 16);
+    }
+    CHECK(SFE_QUAD_Sensirion_CRC::crc8(data, len) == oldComputeCRC8(data, len));
+  }
+  printf("crc8: 1000000 random buffers compared\n");
+}
+
+// ---- Benchmark ----
+
+static volatile uint8_t sink; // Stop the compiler from removing the loops
+
+template <typename F>
+static double nanosPerWord(F crcOfWord)
+{
+  const int repeats = 100;
+  auto start = std::chrono::steady_clock::now();
+  uint8_t acc = 0;
+  for (int r = 0; r < repeats; r++)
+    for (uint32_t w = 0; w <= 0xFFFF; w++)
+      acc ^= crcOfWord((uint16_t)(w ^ acc));
+  auto stop = std::chrono::steady_clock::now();
+  sink = acc;
+  return std::chrono::duration<double, std::nano>(stop - start).count() / (repeats * 65536.0);
+}
+
+static void benchmark(void)
+{
+  double bitwise = nanosPerWord([](uint16_t w) -> uint8_t
+                                { uint8_t d[2] = {(uint8_t)(w >> 8), (uint8_t)w}; return oldComputeCRC8(d, 2); });
+  double bitwiseWord = nanosPerWord(oldWordCRC8);
+  double nibble = nanosPerWord(oldNibbleCRC8);
+  double table = nanosPerWord([](uint16_t w) -> uint8_t
+                              { return SFE_QUAD_Sensirion_CRC::crc8(w); });
+  double tableBuffer = nanosPerWord([](uint16_t w) -> uint8_t
+                                    { uint8_t d[2] = {(uint8_t)(w >> 8), (uint8_t)w}; return SFE_QUAD_Sensirion_CRC::crc8(d, 2); });
+
+  printf("CRC of one 16-bit word (host)           ns/word   vs table\n");
+  printf("old computeCRC8 (bitwise, buffer)      %8.2f   %6.1fx\n", bitwise, bitwise / table);
+  printf("old _CRC8 (bitwise, word)              %8.2f   %6.1fx\n", bitwiseWord, bitwiseWord / table);
+  printf("old _CRC8 ([16][16] table)             %8.2f   %6.1fx\n", nibble, nibble / table);
+  printf("SFE_QUAD_Sensirion_CRC::crc8(word)     %8.2f   %6.1fx\n", table, 1.0);
+  printf("SFE_QUAD_Sensirion_CRC::crc8(data, 2)  %8.2f   %6.1fx\n", tableBuffer, tableBuffer / table);
+}
+
+int main(void)
+{
+  testWords();
+  testFrames();
+  testBuffers();
+  benchmark();
+
+  if (failures > 0)
+  {
+    printf("FAIL: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
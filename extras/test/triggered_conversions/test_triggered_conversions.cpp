@@ -0,0 +1,392 @@
+// Host test: SFE_QUAD_Sensors::triggerSensors and the MS5637 / MS8607 non-blocking measurements.
+//
+// The library is built for the host and driven through SFE_QUAD_Sensors, with simulated sensors behind a simulated mux.
+// Like the real parts, the simulated MS5637 / MS8607 return zero if the ADC is read before the conversion is complete.
+//
+//   interleaving   1 to 4 MS5637s on mux ports. Blocking reads (the old getSenseReading path) against getSensorReadings,
+//                  which triggers all of the conversions and waits once per stage. Prints the (simulated) time per reading
+//   passes         A single-stage sensor (TMP117 in one-shot mode) must not cause an extra pass (and mux select)
+//   phase          Start the conversions at every point within a millisecond. The ADC must never be read early
+
+#include <string>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "SFE_QUAD_Sensors.h"
+
+static int failures = 0;
+
+#define CHECK(condition)                                                            \
+  do                                                                                \
+  {                                                                                 \
+    if (!(condition))                                                               \
+    {                                                                               \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                                   \
+    }                                                                               \
+  } while (0)
+
+// ---- Simulated devices ----
+
+// A TCA9548 mux. Selecting a port attaches that port's devices to the bus
+class SimMux : public SimI2CDevice
+{
+public:
+  SimMux() : portBits(0), selects(0), _count(0) {}
+
+  void add(uint8_t port, uint8_t address, SimI2CDevice *device)
+  {
+    _port[_count] = port;
+    _address[_count] = address;
+    _device[_count] = device;
+    _count++;
+  }
+
+  void i2cWrite(const uint8_t *data, size_t len)
+  {
+    if (len == 0)
+      return;
+    portBits = data[0];
+    if ((portBits != 0) && ((portBits & (portBits - 1)) == 0)) // One port selected (QWIICMUX::setPort)
+      selects++;
+    for (int i = 0; i < _count; i++)
+      Wire.detach(_address[i]);
+    for (int i = 0; i < _count; i++)
+      if (portBits & (1 << _port[i]))
+        Wire.attach(_address[i], _device[i]);
+  }
+
+  void i2cRead(uint8_t *data, size_t len)
+  {
+    for (size_t i = 0; i < len; i++)
+      data[i] = portBits;
+  }
+
+  uint8_t portBits;
+  unsigned long selects; // The number of times a single port was selected
+
+private:
+  uint8_t _port[16];
+  uint8_t _address[16];
+  SimI2CDevice *_device[16];
+  int _count;
+};
+
+// The MS5637 and the MS8607 pressure sensor: PROM, D1 / D2 conversions and the ADC read.
+// The coefficients and ADC values are the datasheet example: 20.000C, 1100.020mbar
+class SimMS56xx : public SimI2CDevice
+{
+public:
+  SimMS56xx(const unsigned long *conversionMicros) : earlyReads(0), conversions(0), _conversionMicros(conversionMicros), _command(0), _converting(false), _result(0)
+  {
+    const uint16_t coefficients[7] = {0, 46372, 43981, 29059, 27842, 31553, 28165};
+    for (int i = 0; i < 7; i++)
+      _prom[i] = coefficients[i];
+    _prom[0] |= crc4() << 12;
+  }
+
+  void i2cWrite(const uint8_t *data, size_t len)
+  {
+    if (len == 0)
+      return;
+    _command = data[0];
+    if ((_command & 0xE0) == 0x40) // 0x40: D1 (pressure), 0x50: D2 (temperature). Bits 1-3 are the OSR
+    {
+      _converting = true;
+      _conversionStart = micros();
+      _conversionEnd = _conversionStart + _conversionMicros[(_command & 0x0F) / 2];
+      _result = (_command & 0x10) ? 8077636 : 6465444;
+      conversions++;
+    }
+  }
+
+  void i2cRead(uint8_t *data, size_t len)
+  {
+    uint32_t value = 0;
+    if ((_command >= 0xA0) && (_command <= 0xAC)) // PROM read
+      value = (uint32_t)_prom[(_command - 0xA0) / 2] << 16;
+    else if ((_command == 0x00) && _converting) // ADC read
+    {
+      if ((long)(micros() - _conversionEnd) < 0)
+        earlyReads++; // Too soon: the real sensor returns zero
+      else
+        value = _result << 8;
+      _converting = false;
+    }
+    for (size_t i = 0; i < len; i++)
+      data[i] = (i < 3) ? (uint8_t)(value >> (24 - (8 * i))) : 0;
+  }
+
+  unsigned long earlyReads;  // ADC reads before the conversion was complete
+  unsigned long conversions; // D1 and D2 conversions started
+
+private:
+  // The CRC-4 of the PROM (AN520)
+  uint16_t crc4(void)
+  {
+    uint16_t prom[8];
+    for (int i = 0; i < 7; i++)
+      prom[i] = _prom[i];
+    prom[0] &= 0x0FFF;
+    prom[7] = 0;
+    uint16_t rem = 0;
+    for (int cnt = 0; cnt < 16; cnt++)
+    {
+      rem ^= (cnt & 1) ? (prom[cnt >> 1] & 0x00FF) : (prom[cnt >> 1] >> 8);
+      for (int bit = 8; bit > 0; bit--)
+        rem = (rem & 0x8000) ? (uint16_t)((rem << 1) ^ 0x3000) : (uint16_t)(rem << 1);
+    }
+    return (rem >> 12) & 0x000F;
+  }
+
+  const unsigned long *_conversionMicros;
+  uint16_t _prom[7];
+  uint8_t _command;
+  bool _converting;
+  unsigned long _conversionStart;
+  unsigned long _conversionEnd;
+  uint32_t _result;
+};
+
+// Datasheet maximum conversion times (us) for OSR 256 to 8192
+static const unsigned long ms5637ConversionMicros[6] = {540, 1060, 2080, 4130, 8220, 16440};
+static const unsigned long ms8607ConversionMicros[6] = {560, 1100, 2170, 4320, 8610, 17200};
+
+// The MS8607 humidity sensor: measure without hold. The sensor NACKs until the conversion is complete
+class SimMS8607Humidity : public SimI2CDevice
+{
+public:
+  SimMS8607Humidity() : earlyReads(0), _converting(false) {}
+
+  bool ack(void)
+  {
+    if (_converting && ((long)(micros() - _conversionEnd) < 0))
+    {
+      earlyReads++;
+      return false;
+    }
+    return true;
+  }
+
+  void i2cWrite(const uint8_t *data, size_t len)
+  {
+    if ((len > 0) && (data[0] == HSENSOR_READ_HUMIDITY_WO_HOLD_COMMAND))
+    {
+      _converting = true;
+      _conversionEnd = micros() + 16000; // 12-bit
+    }
+  }
+
+  void i2cRead(uint8_t *data, size_t len)
+  {
+    const uint16_t adc = 0x6A5C;
+    uint8_t bytes[3] = {(uint8_t)(adc >> 8), (uint8_t)(adc & 0xFC), 0};
+    uint8_t crc = 0;
+    for (int i = 0; i < 2; i++)
+    {
+      crc ^= bytes[i];
+      for (int bit = 0; bit < 8; bit++)
+        crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+    }
+    bytes[2] = crc;
+    for (size_t i = 0; i < len; i++)
+      data[i] = (i < 3) ? bytes[i] : 0;
+    _converting = false;
+  }
+
+  unsigned long earlyReads; // Reads (NACKed) before the conversion was complete
+
+private:
+  bool _converting;
+  unsigned long _conversionEnd;
+};
+
+class SimTMP117 : public SimWordRegisterDevice
+{
+public:
+  SimTMP117() : SimWordRegisterDevice(true) { reg[TMP117_DEVICE_ID] = DEVICE_ID_VALUE; }
+};
+
+// ---- Scenarios ----
+
+// Read every sense of every sensor the old way: select the mux port, then getSenseReading reads the sensor directly (blocking)
+static void blockingReadings(SFE_QUAD_Sensors &sensors, std::string &readings)
+{
+  char reading[SFE_QUAD_SENSOR_READING_LEN];
+  QWIICMUX mux;
+  for (SFE_QUAD_Sensor *sensor = sensors._head; sensor != NULL; sensor = sensor->_next)
+  {
+    if (sensor->_muxAddress >= 0x70)
+    {
+      mux.begin(sensor->_muxAddress, Wire);
+      mux.setPort(sensor->_muxPort);
+    }
+    uint8_t count;
+    sensor->getSenseCount(&count);
+    for (uint8_t sense = 0; sense < count; sense++)
+    {
+      sensor->getSenseReading(sense, reading);
+      if (readings.length() > 0)
+        readings += ",";
+      readings += reading;
+    }
+  }
+}
+
+static void testInterleaving(void)
+{
+  printf("MS5637s    blocking (ms)   triggered (ms)   I2C blocking   I2C triggered\n");
+  unsigned long triggeredOne = 0;
+
+  for (int n = 1; n <= 4; n++)
+  {
+    SimMux mux;
+    SimMS56xx sims[4] = {SimMS56xx(ms5637ConversionMicros), SimMS56xx(ms5637ConversionMicros), SimMS56xx(ms5637ConversionMicros), SimMS56xx(ms5637ConversionMicros)};
+    Wire.attach(0x70, &mux);
+    for (int i = 0; i < n; i++)
+      mux.add(i, 0x76, &sims[i]);
+
+    SFE_QUAD_Sensors sensors;
+    sensors.setWirePort(Wire);
+    for (int i = 0; i < n; i++)
+      CHECK(sensors.addSensor(SFE_QUAD_Sensors::Sensor_MS5637, 0x76, 0x70, i) != NULL);
+    CHECK(sensors.beginSensors());
+    CHECK(sensors.initializeSensors());
+
+    std::string blocking;
+    Wire.resetCounts();
+    unsigned long start = micros();
+    blockingReadings(sensors, blocking);
+    unsigned long blockingMicros = micros() - start;
+    unsigned long blockingTransactions = Wire.transactions;
+
+    Wire.resetCounts();
+    start = micros();
+    CHECK(sensors.getSensorReadings());
+    unsigned long triggeredMicros = micros() - start;
+    unsigned long triggeredTransactions = Wire.transactions;
+
+    std::string expected;
+    for (int i = 0; i < n; i++)
+      expected += (i == 0) ? "1100.020,20.000" : ",1100.020,20.000";
+    CHECK(blocking == expected);
+    CHECK(std::string(sensors.readings) == expected);
+    for (int i = 0; i < n; i++)
+      CHECK(sims[i].earlyReads == 0);
+
+    printf("%7d    %13.2f   %14.2f   %12lu   %13lu\n", n, blockingMicros / 1000.0, triggeredMicros / 1000.0, blockingTransactions, triggeredTransactions);
+
+    if (n == 1)
+      triggeredOne = triggeredMicros;
+    if (n == 4)
+    {
+      CHECK(triggeredMicros < (triggeredOne * 3) / 2); // Four sensors cost about the same as one
+      CHECK(triggeredMicros < blockingMicros / 2);
+    }
+
+    Wire.detach(0x70);
+    Wire.detach(0x76);
+  }
+}
+
+// An MS5637 (two stages) and a TMP117 in one-shot mode (one stage) on mux ports.
+// triggerSensors selects the MS5637's port three times (trigger, D2 -> D1, collect) and the TMP117's port only once
+static void testPasses(void)
+{
+  SimMux mux;
+  SimMS56xx ms5637(ms5637ConversionMicros);
+  SimTMP117 tmp117;
+  Wire.attach(0x70, &mux);
+  mux.add(0, 0x76, &ms5637);
+  mux.add(3, 0x48, &tmp117);
+
+  SFE_QUAD_Sensors sensors;
+  sensors.setWirePort(Wire);
+  CHECK(sensors.addSensor(SFE_QUAD_Sensors::Sensor_MS5637, 0x76, 0x70, 0) != NULL);
+  SFE_QUAD_Sensor_TMP117 *tmp = (SFE_QUAD_Sensor_TMP117 *)sensors.addSensor(SFE_QUAD_Sensors::Sensor_TMP117, 0x48, 0x70, 3);
+  CHECK(tmp != NULL);
+  tmp->_oneShot = true;
+  CHECK(sensors.beginSensors());
+  CHECK(sensors.initializeSensors());
+
+  for (int i = 0; i < 3; i++)
+  {
+    mux.selects = 0;
+    CHECK(sensors.triggerSensors());
+    CHECK(mux.selects == 4);
+  }
+  CHECK(ms5637.earlyReads == 0);
+
+  printf("triggerSensors: MS5637 + one-shot TMP117, %lu mux selects per cycle\n", mux.selects);
+
+  Wire.detach(0x70);
+  Wire.detach(0x76);
+  Wire.detach(0x48);
+}
+
+// Start the conversions at every microsecond offset within a millisecond. millis() may tick just after a conversion is started,
+// so measurement_wait must allow for the partial millisecond
+static void testPhase(void)
+{
+  SimMS56xx ms5637(ms5637ConversionMicros);
+  SimMS56xx ms8607Pressure(ms8607ConversionMicros);
+  SimMS8607Humidity ms8607Humidity;
+  const int cycles = 1000;
+
+  // MS5637
+  {
+    Wire.attach(0x76, &ms5637);
+    SFE_QUAD_Sensors sensors;
+    sensors.setWirePort(Wire);
+    CHECK(sensors.addSensor(SFE_QUAD_Sensors::Sensor_MS5637, 0x76, 0, 0) != NULL);
+    CHECK(sensors.beginSensors());
+    CHECK(sensors.initializeSensors());
+    for (int phase = 0; phase < cycles; phase++)
+    {
+      simAdvanceMicros(1000 + phase - (micros() % 1000));
+      CHECK(sensors.getSensorReadings());
+    }
+    CHECK(ms5637.conversions == 2 * cycles);
+    Wire.detach(0x76);
+  }
+
+  // MS8607
+  {
+    Wire.attach(0x76, &ms8607Pressure);
+    Wire.attach(0x40, &ms8607Humidity);
+    SFE_QUAD_Sensors sensors;
+    sensors.setWirePort(Wire);
+    CHECK(sensors.addSensor(SFE_QUAD_Sensors::Sensor_MS8607, 0x40, 0, 0) != NULL);
+    CHECK(sensors.beginSensors());
+    CHECK(sensors.initializeSensors());
+    for (int phase = 0; phase < cycles; phase++)
+    {
+      simAdvanceMicros(1000 + phase - (micros() % 1000));
+      CHECK(sensors.getSensorReadings());
+    }
+    CHECK(ms8607Pressure.conversions == 2 * cycles);
+    Wire.detach(0x76);
+    Wire.detach(0x40);
+  }
+
+  CHECK(ms5637.earlyReads == 0);
+  CHECK(ms8607Pressure.earlyReads == 0);
+  CHECK(ms8607Humidity.earlyReads == 0);
+  printf("measurement_wait: %d start phases, early ADC reads: MS5637 %lu, MS8607 %lu + %lu\n", cycles, ms5637.earlyReads, ms8607Pressure.earlyReads, ms8607Humidity.earlyReads);
+}
+
+int main(void)
+{
+  testInterleaving();
+  testPasses();
+  testPhase();
+
+  if (failures > 0)
+  {
+    printf("FAIL: %d checks failed\n", failures);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
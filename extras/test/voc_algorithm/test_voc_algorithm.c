@@ -0,0 +1,158 @@
+/*
+ * Host test: the SGP40 VOC algorithm must be bit-exact with the original
+ * Sensirion code.
+ *
+ * Compares the original code (reference/) with the library code using both
+ * the 64-bit and 16-bit fix16_mul, for several sensors processed in turn.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sensirion_voc_algorithm.h"
+
+#define DECLARE_VARIANT(v)                                                     \
+    void v##_init(VocAlgorithmParams* params);                                 \
+    void v##_get_states(VocAlgorithmParams* params, int32_t* state0,           \
+                        int32_t* state1);                                      \
+    void v##_process(VocAlgorithmParams* params, int32_t sraw,                 \
+                     int32_t* voc_index);                                      \
+    fix16_t v##_fix16_mul(fix16_t a, fix16_t b);
+
+DECLARE_VARIANT(Ref)
+DECLARE_VARIANT(New64)
+DECLARE_VARIANT(New16)
+
+#define SENSORS 8
+#define SAMPLES 50000 /* About 14 hours at one sample per second */
+#define RANDOM_MULS 20000000UL
+
+static uint32_t rngState = 0x12345678;
+
+static uint32_t xorshift32(void) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static int failures = 0;
+
+static void checkMul(fix16_t a, fix16_t b) {
+    fix16_t ref = Ref_fix16_mul(a, b);
+    fix16_t new64 = New64_fix16_mul(a, b);
+    fix16_t new16 = New16_fix16_mul(a, b);
+    if ((ref != new64) || (ref != new16)) {
+        if (failures++ < 10)
+            printf("fix16_mul(0x%08lX, 0x%08lX): ref 0x%08lX 64-bit 0x%08lX "
+                   "16-bit 0x%08lX\n",
+                   (unsigned long)(uint32_t)a, (unsigned long)(uint32_t)b,
+                   (unsigned long)(uint32_t)ref, (unsigned long)(uint32_t)new64,
+                   (unsigned long)(uint32_t)new16);
+    }
+}
+
+/* A synthetic SGP40 raw signal: a slow baseline drift, noise, occasional
+ * VOC events and the odd out-of-range value */
+static int32_t sraw(int sensor, long sample) {
+    int32_t value = 27000 + sensor * 1500 + (int32_t)((sample / 97) % 2000);
+    value += (int32_t)(xorshift32() % 200) - 100;
+    if (((sample / 1000) % 7) == (sensor % 7))
+        value -= 4000 + (int32_t)((sample % 1000) * 3); /* VOC event */
+    if ((xorshift32() % 5000) == 0)
+        value = (xorshift32() & 1) ? 0 : 65535;
+    return value;
+}
+
+int main(void) {
+    static const fix16_t edges[] = {
+        0,          1,          -1,         0x8000,     -0x8000,
+        0x10000,    -0x10000,   0x7FFF,     0x18000,    -0x18000,
+        0x7FFFFFFF, -0x7FFFFFFF, (fix16_t)0x80000000, 0x00FFFFFF,
+        0x01000000, -0x01000000, 0x00B504F3, 0x00B504F4, 0x12345678,
+        -0x12345678};
+    const int numEdges = sizeof(edges) / sizeof(edges[0]);
+    int i, j;
+    unsigned long n;
+    long sample;
+
+    /* fix16_mul: every pair of edge values, then random pairs */
+    for (i = 0; i < numEdges; i++)
+        for (j = 0; j < numEdges; j++)
+            checkMul(edges[i], edges[j]);
+    for (n = 0; n < RANDOM_MULS; n++) {
+        fix16_t a = (fix16_t)xorshift32();
+        fix16_t b = (fix16_t)xorshift32();
+        switch (n & 3) { /* Mostly realistic magnitudes, some full range */
+        case 0:
+            a >>= 8;
+            b >>= 8;
+            break;
+        case 1:
+            a >>= 12;
+            break;
+        case 2:
+            b >>= 16;
+            break;
+        default:
+            break;
+        }
+        checkMul(a, b);
+    }
+    printf("fix16_mul: %lu products compared\n",
+           RANDOM_MULS + (unsigned long)(numEdges * numEdges));
+
+    /* The whole algorithm: reference, 64-bit and 16-bit */
+    {
+        static VocAlgorithmParams ref[SENSORS], single64[SENSORS],
+            single16[SENSORS];
+        int32_t raw[SENSORS];
+
+        for (i = 0; i < SENSORS; i++) {
+            Ref_init(&ref[i]);
+            New64_init(&single64[i]);
+            New16_init(&single16[i]);
+        }
+
+        for (sample = 0; sample < SAMPLES; sample++) {
+            for (i = 0; i < SENSORS; i++)
+                raw[i] = sraw(i, sample);
+
+            for (i = 0; i < SENSORS; i++) {
+                int32_t refIndex, single64Index, single16Index;
+                Ref_process(&ref[i], raw[i], &refIndex);
+                New64_process(&single64[i], raw[i], &single64Index);
+                New16_process(&single16[i], raw[i], &single16Index);
+                if ((single64Index != refIndex) ||
+                    (single16Index != refIndex)) {
+                    if (failures++ < 10)
+                        printf("Sensor %d sample %ld (sraw %ld): ref %ld "
+                               "64-bit %ld 16-bit %ld\n",
+                               i, sample, (long)raw[i], (long)refIndex,
+                               (long)single64Index, (long)single16Index);
+                }
+            }
+        }
+
+        /* The internal state must match too, not just the VOC Index */
+        for (i = 0; i < SENSORS; i++) {
+            if ((memcmp(&ref[i], &single64[i], sizeof(VocAlgorithmParams)) !=
+                 0) ||
+                (memcmp(&ref[i], &single16[i], sizeof(VocAlgorithmParams)) !=
+                 0)) {
+                if (failures++ < 10)
+                    printf("Sensor %d: algorithm state differs\n", i);
+            }
+        }
+        printf("VocAlgorithm_process: %d sensors x %d samples compared\n",
+               SENSORS, SAMPLES);
+    }
+
+    if (failures > 0) {
+        printf("FAIL: %d differences\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,35 @@
+/*
+ * Builds one variant of the Sensirion VOC algorithm with its public functions
+ * renamed, so that several variants can be linked into the same test:
+ *
+ *   -DVOC_VARIANT=Ref  -DVOC_REFERENCE      the original Sensirion code (reference/)
+ *   -DVOC_VARIANT=New64                      the library code, 64-bit fix16_mul
+ *   -DVOC_VARIANT=New16 -DFIXMATH_NO_64BIT   the library code, 16-bit fix16_mul
+ */
+
+#define VOC_CAT2(a, b) a##b
+#define VOC_CAT(a, b) VOC_CAT2(a, b)
+#define VOC_NAME(name) VOC_CAT(VOC_VARIANT, name)
+
+#define fix16_from_int VOC_NAME(_fix16_from_int)
+#define fix16_cast_to_int VOC_NAME(_fix16_cast_to_int)
+#define VocAlgorithm_init VOC_NAME(_init)
+#define VocAlgorithm_get_states VOC_NAME(_get_states)
+#define VocAlgorithm_set_states VOC_NAME(_set_states)
+#define VocAlgorithm_set_tuning_parameters VOC_NAME(_set_tuning_parameters)
+#define VocAlgorithm_process VOC_NAME(_process)
+
+#ifdef VOC_REFERENCE
+#include "reference/sensirion_voc_algorithm.c"
+#else
+#include "sensirion_voc_algorithm.c"
+#endif
+
+/* The inline helpers need an external definition when they are not inlined */
+extern inline fix16_t fix16_from_int(int32_t a);
+extern inline int32_t fix16_cast_to_int(fix16_t a);
+
+/* Expose the (static) multiply so it can be compared directly */
+fix16_t VOC_NAME(_fix16_mul)(fix16_t a, fix16_t b) {
+    return fix16_mul(a, b);
+}
@@ -0,0 +1,479 @@
+#include "SFE_QUAD_Log_Manager.h"
+
+// The storage class destructors call endLog. The file access has gone by the time this destructor runs
+SFE_QUAD_Log_Manager::~SFE_QUAD_Log_Manager(void)
+{
+  if (_logFileLeader != NULL)
+    delete[] _logFileLeader;
+  if (_logHeader != NULL)
+    delete[] _logHeader;
+}
+
+// Called by the storage classes' beginLog. Open the next log file and write header (the sensor and sense names) to it.
+// header must be allocated with new[] (or be NULL). The manager deletes it.
+// The log files are named fileLeader00000.csv, fileLeader00001.csv, etc..
+// The index is fileLeader.idx. The last index entry holds the most recent file number, so the next file is found without scanning the card.
+// If maxFileSize is non-zero, the log file is rotated once it reaches that size (SdFat: each file is pre-allocated to maxFileSize)
+// If maxFileMillis is non-zero, the log file is rotated once it has been open that long
+// Every indexInterval rows, a (timestamp, file, offset) entry is added to the index. The first row of each file is always indexed
+bool SFE_QUAD_Log_Manager::openLog(const char *fileLeader, char *header, uint32_t maxFileSize, unsigned long maxFileMillis, uint32_t indexInterval, size_t bufferSize, Stream *debugPort)
+{
+  _logDebugPort = debugPort;
+
+  if (_logging) // Close the previous log (if any). The sense names may have changed
+    endLog();
+
+  if (_logHeader != NULL)
+    delete[] _logHeader;
+  _logHeader = header;
+
+  if ((fileLeader == NULL) || (strlen(fileLeader) > (SFE_QUAD_LOG_NAME_LEN - 15))) // Leave room for the file number, extension and NULL
+  {
+    if (_logDebugPort != NULL)
+      _logDebugPort->println(F("beginLog: invalid fileLeader!"));
+    return (false);
+  }
+
+  if (_logFileLeader != NULL)
+    delete[] _logFileLeader;
+  _logFileLeader = new char[strlen(fileLeader) + 1];
+  if (_logFileLeader == NULL)
+  {
+    if (_logDebugPort != NULL)
+      _logDebugPort->println(F("beginLog: failed to allocate memory for _logFileLeader!"));
+    return (false);
+  }
+  strcpy(_logFileLeader, fileLeader);
+
+  _maxLogFileSize = maxFileSize;
+  _maxLogFileMillis = maxFileMillis;
+  _logIndexInterval = indexInterval;
+  _logBufferSize = bufferSize;
+
+  // Open the index
+
+  char fileName[SFE_QUAD_LOG_NAME_LEN];
+  snprintf(fileName, sizeof(fileName), "%s.idx", _logFileLeader);
+
+  if (!logOpenIndex(fileName, true))
+  {
+    if (_logDebugPort != NULL)
+      _logDebugPort->println(F("beginLog: failed to open the index!"));
+    return (false);
+  }
+
+  // A partial entry left by a power loss is ignored. The next entry overwrites it
+  _logIndexEntries = logIndexSize() / sizeof(SFE_QUAD_Log_Index_t);
+
+  // Resume from the last index entry. Fall back to scanning for the next free file number if the index is empty
+
+  SFE_QUAD_Log_Index_t index;
+  bool haveIndex = ((_logIndexEntries > 0) && (readLogIndex(_logIndexEntries - 1, &index)));
+
+  // The last log file was not closed (power loss?). validLength is updated on every sync, but the power could have gone
+  // between a sync and the index update: it is a lower bound. logRecoverFile finds the end of the last whole row.
+  // Entries are written just before their rows are synced: any for rows which did not make it become closed entries.
+  // Then record that the file has been closed
+  if ((haveIndex) && (index.closed == 0))
+  {
+    uint32_t fileNumber = index.fileNumber;
+    uint32_t validLength = index.validLength;
+    getLogFileName(fileNumber, fileName);
+    if (logRecoverFile(fileName, &validLength))
+    {
+      if (_logDebugPort != NULL)
+      {
+        _logDebugPort->print(F("beginLog: log file was not closed. Recovered "));
+        _logDebugPort->println(validLength);
+      }
+
+      SFE_QUAD_Log_Index_t closedIndex = index;
+      closedIndex.offset = validLength;
+      closedIndex.validLength = validLength;
+      closedIndex.closed = SFE_QUAD_LOG_INDEX_RECOVERED;
+
+      uint32_t entry = _logIndexEntries;
+      while ((entry > 0) && (readLogIndex(entry - 1, &index)) && (index.fileNumber == fileNumber) && (index.closed == 0) && (index.offset >= validLength))
+      {
+        entry--;
+        closedIndex.timestamp = index.timestamp;
+        writeLogIndex(entry, &closedIndex);
+      }
+      if (entry == _logIndexEntries) // No entries were lost: add the closed entry
+      {
+        if (writeLogIndex(_logIndexEntries, &closedIndex))
+          _logIndexEntries++;
+      }
+    }
+    haveIndex = ((_logIndexEntries > 0) && (readLogIndex(_logIndexEntries - 1, &index)));
+  }
+
+  _logFileNumber = 0;
+  _logLastTimestamp = 0;
+  if (haveIndex)
+  {
+    _logFileNumber = index.fileNumber + 1;
+    _logLastTimestamp = index.timestamp;
+  }
+
+  // A file may have been opened after the last index entry was written. The first row of each file is indexed before
+  // it is synced, so the file holds no rows - just the sensor and sense names (and the pre-allocation). Reuse it
+  getLogFileName(_logFileNumber, fileName);
+  while (logFileExists(fileName))
+  {
+    if (haveIndex && logRemoveFile(fileName))
+      break;
+    _logFileNumber++;
+    getLogFileName(_logFileNumber, fileName);
+  }
+
+  if (_logDebugPort != NULL)
+  {
+    _logDebugPort->print(F("beginLog: index entries: "));
+    _logDebugPort->println(_logIndexEntries);
+  }
+
+  return (openLogFile());
+}
+
+// Buffer row (plus CR LF). Every indexInterval rows, mark the row: the sync callback indexes it just before it is synced.
+// Without the task, write any whole sectors to the log file. With the task (beginLogTask), the task does the writing.
+// timestamp must not go backwards (e.g. millis or the RTC time) - else findLogPosition will not be able to find it.
+// The log file is rotated once it reaches maxFileSize or maxFileMillis
+bool SFE_QUAD_Log_Manager::writeLog(const char *row, uint32_t timestamp)
+{
+  if (!_logging)
+  {
+    if (_logDebugPort != NULL)
+      _logDebugPort->println(F("writeLog: log is not open. Did you forget to call beginLog?"));
+    return (false);
+  }
+
+  if (row == NULL)
+    return (false);
+
+  bool result = true;
+
+  if ((_logIndexPending) || ((_logIndexInterval > 0) && (_logRowsSinceIndex >= _logIndexInterval)))
+  {
+    if (_logWriter.addMark(_logFileBytes, timestamp)) // If the marks are full, try again on the next row
+    {
+      _logRowsSinceIndex = 0;
+      _logIndexPending = false;
+    }
+  }
+
+  _logLastTimestamp = timestamp;
+
+  size_t rowLen = strlen(row) + 2;
+  size_t written = _logWriter.println(row);
+  _logFileBytes += written;
+  _logRowsSinceIndex++;
+
+  if (written != rowLen)
+    result = false;
+
+  if ((_logTaskPriority == 0) && (!_logWriter.service()))
+    result = false;
+
+  if (((_maxLogFileSize > 0) && (_logFileBytes >= _maxLogFileSize)) || ((_maxLogFileMillis > 0) && (millis() - _logFileOpened >= _maxLogFileMillis)))
+  {
+    if (!rotateLog())
+      result = false;
+  }
+
+  return (result);
+}
+
+// Close the log file and open the next one. With the task, this waits for the task to write everything
+bool SFE_QUAD_Log_Manager::rotateLog(void)
+{
+  if (!_logging)
+    return (false);
+
+  closeLogFile();
+  _logFileNumber++;
+  return (openLogFile());
+}
+
+// Write everything, close the log file and the index
+bool SFE_QUAD_Log_Manager::endLog(void)
+{
+  if (!_logging)
+    return (false);
+
+  bool result = closeLogFile();
+  logCloseIndex();
+
+  if (_logDebugPort != NULL)
+    _logDebugPort->println(F("endLog: complete"));
+
+  return (result);
+}
+
+// Binary search the index for the last entry before timestamp. Rows which share a timestamp may not all be indexed,
+// so an entry at timestamp could be after some of them. Reading from fileNumber at offset will then find the rows at or after timestamp.
+// If timestamp is at or before the first entry, the first entry is returned.
+// Can be called while logging (the task is paused), or after beginLog / endLog have set the file leader
+bool SFE_QUAD_Log_Manager::findLogPosition(uint32_t timestamp, uint32_t *fileNumber, uint32_t *offset)
+{
+  if ((_logFileLeader == NULL) || (fileNumber == NULL) || (offset == NULL))
+  {
+    if (_logDebugPort != NULL)
+      _logDebugPort->println(F("findLogPosition: file leader not found. Did you forget to call beginLog?"));
+    return (false);
+  }
+
+  if (_logTaskPriority > 0) // The task writes to the index
+    _logWriter.endTask();
+
+  bool wasOpen = logIndexIsOpen();
+  bool result = true;
+  if (!wasOpen)
+  {
+    char fileName[SFE_QUAD_LOG_NAME_LEN];
+    snprintf(fileName, sizeof(fileName), "%s.idx", _logFileLeader);
+    result = logOpenIndex(fileName, false);
+    if ((!result) && (_logDebugPort != NULL))
+      _logDebugPort->println(F("findLogPosition: failed to open the index!"));
+  }
+
+  uint32_t entries = result ? logIndexSize() / sizeof(SFE_QUAD_Log_Index_t) : 0;
+
+  // Find the first entry at or after timestamp
+  uint32_t lower = 0;
+  uint32_t upper = entries;
+  result = (entries > 0);
+  SFE_QUAD_Log_Index_t index;
+  while (result && (lower < upper))
+  {
+    uint32_t middle = lower + ((upper - lower) / 2);
+    result = readLogIndex(middle, &index);
+    if (index.timestamp < timestamp)
+      lower = middle + 1;
+    else
+      upper = middle;
+  }
+
+  uint32_t entry = (lower > 0) ? lower - 1 : 0;
+  if (result)
+    result = readLogIndex(entry, &index);
+
+  // A recovered file may hold rows after its last indexed row, and their timestamps are not known.
+  // Start from the last indexed row in that file
+  if (result && (index.closed == SFE_QUAD_LOG_INDEX_RECOVERED))
+  {
+    SFE_QUAD_Log_Index_t previous;
+    uint32_t previousEntry = entry;
+    while ((previousEntry > 0) && (readLogIndex(previousEntry - 1, &previous)) && (previous.fileNumber == index.fileNumber))
+    {
+      previousEntry--;
+      if (previous.closed == 0)
+      {
+        entry = previousEntry;
+        index = previous;
+        break;
+      }
+    }
+  }
+
+  // A closed entry marks the end of a file. The next rows are in the next file - if there is one
+  while (result && (index.closed != 0) && (entry < (entries - 1)))
+  {
+    entry++;
+    result = readLogIndex(entry, &index);
+  }
+
+  if (result)
+  {
+    *fileNumber = index.fileNumber;
+    *offset = index.offset;
+  }
+
+  if ((!wasOpen) && (logIndexIsOpen()))
+    logCloseIndex();
+
+  if ((_logTaskPriority > 0) && (_logging))
+    _logWriter.beginTask(_logTaskPriority);
+
+  return (result);
+}
+
+// Helper function for the log file names. fileName must be at least SFE_QUAD_LOG_NAME_LEN chars
+bool SFE_QUAD_Log_Manager::getLogFileName(uint32_t fileNumber, char *fileName)
+{
+  if ((_logFileLeader == NULL) || (fileName == NULL))
+    return (false);
+
+  snprintf(fileName, SFE_QUAD_LOG_NAME_LEN, "%s%05lu.csv", _logFileLeader, (unsigned long)fileNumber);
+  return (true);
+}
+
+// Return the current log file number
+uint32_t SFE_QUAD_Log_Manager::getLogFileNumber(void)
+{
+  return (_logFileNumber);
+}
+
+// ESP32 only: write, sync and index the log from a FreeRTOS task, so writeLog never waits for the card.
+// Can be called before or after beginLog. The task is restarted when the log is rotated.
+// While the task is running, your code must not access the card (e.g. writeConfigurationToStorage). Call endLogTask first
+bool SFE_QUAD_Log_Manager::beginLogTask(uint8_t priority)
+{
+  if (priority == 0)
+    priority = 1;
+  _logTaskPriority = priority;
+
+  if (!_logging)
+    return (true); // openLogFile starts the task
+
+  if (!_logWriter.beginTask(_logTaskPriority))
+  {
+    _logTaskPriority = 0; // Not supported (or failed). writeLog services the writer instead
+    return (false);
+  }
+
+  return (true);
+}
+
+// ESP32 only: stop the task. Waits for the task to finish its current write. writeLog then writes the sectors itself
+void SFE_QUAD_Log_Manager::endLogTask(void)
+{
+  _logTaskPriority = 0;
+  _logWriter.endTask();
+}
+
+// Open and begin writing _logFileNumber. Write the sensor and sense names
+bool SFE_QUAD_Log_Manager::openLogFile(void)
+{
+  char fileName[SFE_QUAD_LOG_NAME_LEN];
+  getLogFileName(_logFileNumber, fileName);
+
+  _logging = false;
+
+  uint32_t logFileBytes = 0;
+  if (!logOpenFile(fileName, _maxLogFileSize, &logFileBytes))
+  {
+    if (_logDebugPort != NULL)
+    {
+      _logDebugPort->print(F("openLogFile: failed to open "));
+      _logDebugPort->println(fileName);
+    }
+    return (false);
+  }
+
+  _logWriter.setSyncCallback(logSyncCallback, this); // Index the rows as they are synced
+  if (!_logWriter.begin(logFile(), _logBufferSize, logFileBytes))
+  {
+    if (_logDebugPort != NULL)
+      _logDebugPort->println(F("openLogFile: failed to allocate memory for _logWriter!"));
+    logCloseFile();
+    return (false);
+  }
+
+  _logFileBytes = logFileBytes;
+  _logSyncedBytes = logFileBytes;
+  _logFileOpened = millis();
+  _logRowsSinceIndex = 0;
+  _logIndexPending = true;
+  _logFileIndexed = false;
+  _logging = true;
+
+  if (_logHeader != NULL)
+    _logFileBytes += _logWriter.write(_logHeader);
+
+  if ((_logTaskPriority > 0) && (!_logWriter.beginTask(_logTaskPriority)))
+    _logTaskPriority = 0; // Not supported (or failed). writeLog services the writer instead
+
+  if (_logDebugPort != NULL)
+  {
+    _logDebugPort->print(F("openLogFile: logging to "));
+    _logDebugPort->println(fileName);
+  }
+
+  return (true);
+}
+
+// Write everything, stop the task and close the log file.
+// Add a closed entry to the index, so beginLog knows the file does not need to be recovered
+bool SFE_QUAD_Log_Manager::closeLogFile(void)
+{
+  _logging = false;
+
+  bool result = _logWriter.flush();
+  _logWriter.end();
+  uint32_t length = _logSyncedBytes;
+  if (!logCloseFile())
+    result = false;
+
+  SFE_QUAD_Log_Index_t index;
+  index.timestamp = _logLastTimestamp;
+  index.fileNumber = _logFileNumber;
+  index.offset = length;
+  index.validLength = length;
+  index.closed = SFE_QUAD_LOG_INDEX_CLOSED;
+  if (writeLogIndex(_logIndexEntries, &index))
+    _logIndexEntries++;
+  else
+    result = false;
+
+  return (result);
+}
+
+// Helper function for findLogPosition and openLog. Read an entry from the index
+bool SFE_QUAD_Log_Manager::readLogIndex(uint32_t entry, SFE_QUAD_Log_Index_t *index)
+{
+  return (logReadIndex(entry * sizeof(SFE_QUAD_Log_Index_t), (uint8_t *)index, sizeof(SFE_QUAD_Log_Index_t)));
+}
+
+// Helper function for syncLog, closeLogFile and openLog. Write an entry to the index and sync it
+bool SFE_QUAD_Log_Manager::writeLogIndex(uint32_t entry, SFE_QUAD_Log_Index_t *index)
+{
+  return (logWriteIndex(entry * sizeof(SFE_QUAD_Log_Index_t), (const uint8_t *)index, sizeof(SFE_QUAD_Log_Index_t)));
+}
+
+// The _logWriter sync callback. Called by service or flush - from the task, if it is running
+bool SFE_QUAD_Log_Manager::logSyncCallback(void *context, uint32_t filePosition)
+{
+  return (((SFE_QUAD_Log_Manager *)context)->syncLog(filePosition));
+}
+
+// Sync the log file up to filePosition:
+// Index the marked rows which are about to be synced. Their validLength is the old synced length, so the entries are on
+// the card before their rows are. Then sync the log file. Then record the new synced length in the last entry for this file,
+// so beginLog can recover every synced row after a power loss - not just those up to the last indexed row.
+// Returns the result of the log file sync: a failed index write loses an entry, not rows
+bool SFE_QUAD_Log_Manager::syncLog(uint32_t filePosition)
+{
+  SFE_QUAD_Log_Index_t index;
+  uint32_t timestamp;
+  while (_logWriter.takeMark(filePosition, &index.offset, &timestamp))
+  {
+    index.timestamp = timestamp;
+    index.fileNumber = _logFileNumber;
+    index.validLength = _logSyncedBytes;
+    index.closed = 0;
+    if (writeLogIndex(_logIndexEntries, &index))
+    {
+      _logLastEntry = index;
+      _logIndexEntries++;
+      _logFileIndexed = true;
+    }
+    else if (_logDebugPort != NULL)
+      _logDebugPort->println(F("syncLog: failed to write the index!"));
+  }
+
+  if (!logSyncFile())
+    return (false);
+
+  _logSyncedBytes = filePosition;
+
+  if (_logFileIndexed)
+  {
+    _logLastEntry.validLength = filePosition;
+    if ((!writeLogIndex(_logIndexEntries - 1, &_logLastEntry)) && (_logDebugPort != NULL))
+      _logDebugPort->println(F("syncLog: failed to update the index!"));
+  }
+
+  return (true);
+}
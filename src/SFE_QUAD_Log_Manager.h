@@ -0,0 +1,88 @@
+#ifndef SPARKFUN_QUAD_LOG_MANAGER_H
+#define SPARKFUN_QUAD_LOG_MANAGER_H
+
+// SparkFun Qwiic Universal Auto-Detect Log Manager
+
+// Log file rotation and a (timestamp, file, offset) index, on top of SFE_QUAD_Log_Writer.
+// The storage classes (SdFat, SD and LittleFS) inherit it and provide the file access.
+
+#include "Arduino.h"
+#include "SFE_QUAD_Log_Writer.h"
+
+#define SFE_QUAD_LOG_NAME_LEN 40 // The maximum length of the log file names (including the NULL)
+
+#define SFE_QUAD_LOG_INDEX_CLOSED 1    // SFE_QUAD_Log_Index_t.closed: closed by endLog or rotateLog
+#define SFE_QUAD_LOG_INDEX_RECOVERED 2 // SFE_QUAD_Log_Index_t.closed: recovered by beginLog after a power loss. Rows after the last indexed row may be later than timestamp
+
+class SFE_QUAD_Log_Manager
+{
+public:
+  typedef struct
+  {
+    uint32_t timestamp;   // The timestamp passed to writeLog
+    uint32_t fileNumber;  // The log file number
+    uint32_t offset;      // The position of the row in the log file
+    uint32_t validLength; // The length of the log file known to be on the card (synced). Updated on every sync
+    uint32_t closed;      // Non-zero if the log file was closed (CLOSED or RECOVERED). There is no row: offset and validLength are the final length of the file
+  } SFE_QUAD_Log_Index_t;
+
+  virtual ~SFE_QUAD_Log_Manager(void);
+
+  bool writeLog(const char *row, uint32_t timestamp);                               // Buffer row, index it every indexInterval rows and rotate the file when it is full or old
+  bool rotateLog(void);                                                             // Close the log file and open the next one
+  bool endLog(void);                                                                // Write everything and close the log file
+  bool findLogPosition(uint32_t timestamp, uint32_t *fileNumber, uint32_t *offset); // Binary search the index for the last entry before timestamp
+  bool getLogFileName(uint32_t fileNumber, char *fileName);                         // Helper function for the log file names
+  uint32_t getLogFileNumber(void);                                                  // Return the current log file number
+  bool beginLogTask(uint8_t priority = 1);                                          // ESP32 only: write the log from a FreeRTOS task
+  void endLogTask(void);                                                            // ESP32 only: stop the task
+  SFE_QUAD_Log_Writer _logWriter;                                                   // Buffers the log rows
+
+protected:
+  bool openLog(const char *fileLeader, char *header, uint32_t maxFileSize, unsigned long maxFileMillis, uint32_t indexInterval, size_t bufferSize, Stream *debugPort); // Called by beginLog
+
+  // The file access, provided by the storage classes. Only one log file and the index are open at a time
+  virtual bool logFileExists(const char *fileName) = 0;                                  // Return true if the file exists
+  virtual bool logRemoveFile(const char *fileName) = 0;                                  // Delete the file
+  virtual bool logOpenFile(const char *fileName, uint32_t maxFileSize, uint32_t *fileSize) = 0; // Open (create) the log file for writing. Return the size of the existing data
+  virtual Print &logFile(void) = 0;                                                      // The open log file
+  virtual bool logSyncFile(void) = 0;                                                    // Sync the log file
+  virtual bool logCloseFile(void) = 0;                                                   // Release the unused pre-allocation (if any) and close the log file
+  virtual bool logRecoverFile(const char *fileName, uint32_t *length) = 0;               // Find the end of the last whole row in a file which was not closed. *length is a lower bound
+  virtual bool logOpenIndex(const char *fileName, bool write) = 0;                       // Open the index. write: create it and allow writes anywhere (not append)
+  virtual bool logIndexIsOpen(void) = 0;                                                 // Return true if the index is open
+  virtual uint32_t logIndexSize(void) = 0;                                               // The size of the index
+  virtual bool logReadIndex(uint32_t position, uint8_t *data, size_t len) = 0;           // Read from the index
+  virtual bool logWriteIndex(uint32_t position, const uint8_t *data, size_t len) = 0;    // Write to the index and sync it
+  virtual void logCloseIndex(void) = 0;                                                  // Close the index
+
+private:
+  bool openLogFile(void);                                             // Open and begin writing _logFileNumber
+  bool closeLogFile(void);                                            // Write everything and close the log file. Add a closed entry to the index
+  bool readLogIndex(uint32_t entry, SFE_QUAD_Log_Index_t *index);     // Read an entry from the index
+  bool writeLogIndex(uint32_t entry, SFE_QUAD_Log_Index_t *index);    // Write an entry to the index and sync it
+  bool syncLog(uint32_t filePosition);                                // Index the rows being synced, sync the log file, record the synced length
+  static bool logSyncCallback(void *context, uint32_t filePosition); // The _logWriter sync callback. Calls syncLog
+
+  Stream *_logDebugPort = NULL;        // Debug messages - set by openLog
+  char *_logFileLeader = NULL;         // The log file name leader - set by openLog
+  char *_logHeader = NULL;             // The sensor and sense names. Written at the start of each log file
+  uint32_t _logFileNumber = 0;         // The current log file number
+  uint32_t _logFileBytes = 0;          // The number of bytes logged to the current file
+  uint32_t _logSyncedBytes = 0;        // The length of the current file known to be on the card
+  unsigned long _logFileOpened = 0;    // When the current log file was opened (millis)
+  uint32_t _maxLogFileSize = 0;        // Rotate the log file at this size. 0 = no limit
+  unsigned long _maxLogFileMillis = 0; // Rotate the log file after this many millis. 0 = no limit
+  uint32_t _logIndexInterval = 100;    // Index every indexInterval rows
+  uint32_t _logIndexEntries = 0;       // The number of entries in the index
+  SFE_QUAD_Log_Index_t _logLastEntry;  // The last entry written for the current file. Its validLength is updated on every sync
+  bool _logFileIndexed = false;        // true once the current file has an entry in the index
+  uint32_t _logRowsSinceIndex = 0;     // Rows written since the last index entry
+  uint32_t _logLastTimestamp = 0;      // The timestamp of the last row. Used for the entry written when the log file is closed
+  bool _logIndexPending = false;       // true when the next row must be indexed (start of a new file)
+  size_t _logBufferSize = 4096;        // The size of the _logWriter buffer
+  uint8_t _logTaskPriority = 0;        // The priority of the _logWriter task. 0 = no task
+  bool _logging = false;               // true while a log file is open
+};
+
+#endif
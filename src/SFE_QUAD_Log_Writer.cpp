@@ -0,0 +1,451 @@
+#include "SFE_QUAD_Log_Writer.h"
+
+SFE_QUAD_Log_Writer::SFE_QUAD_Log_Writer(void)
+{
+  _file = NULL;
+  _buffer = NULL;
+  _bufferSize = 0;
+  _head = 0;
+  _tail = 0;
+  _buffered = 0;
+  _filePosition = 0;
+  _syncMillis = 1000;
+  _syncBytes = 0;
+  _lastSync = 0;
+  _unsyncedBytes = 0;
+  _droppedBytes = 0;
+  _syncCallback = NULL;
+  _syncContext = NULL;
+  _markHead = 0;
+  _marks = 0;
+#if defined(ARDUINO_ARCH_ESP32)
+  _taskHandle = NULL;
+  _bufferMutex = NULL;
+  _fileMutex = NULL;
+  _taskStop = false;
+#endif
+}
+
+SFE_QUAD_Log_Writer::~SFE_QUAD_Log_Writer(void)
+{
+  end();
+}
+
+// Allocate the buffer and attach the writer to the (open) log file.
+// bufferSize is rounded up to a whole number of sectors.
+// filePosition is the current size of the file. Set it when appending to an existing file so the writes stay aligned with the sectors
+bool SFE_QUAD_Log_Writer::begin(Print &file, size_t bufferSize, uint32_t filePosition)
+{
+  end(); // Release the previous buffer (if any)
+
+  if (bufferSize < SFE_QUAD_LOG_WRITER_SECTOR_SIZE)
+    bufferSize = SFE_QUAD_LOG_WRITER_SECTOR_SIZE;
+  bufferSize = ((bufferSize + SFE_QUAD_LOG_WRITER_SECTOR_SIZE - 1) / SFE_QUAD_LOG_WRITER_SECTOR_SIZE) * SFE_QUAD_LOG_WRITER_SECTOR_SIZE;
+
+  _buffer = new uint8_t[bufferSize];
+  if (_buffer == NULL)
+    return (false);
+
+  _file = &file;
+  _bufferSize = bufferSize;
+  _head = 0;
+  _tail = 0;
+  _buffered = 0;
+  _filePosition = filePosition;
+  _lastSync = millis();
+  _unsyncedBytes = 0;
+  _droppedBytes = 0;
+  _markHead = 0;
+  _marks = 0;
+
+  return (true);
+}
+
+// Write everything, sync, stop the task (if any) and release the buffer.
+// The caller is still responsible for closing the file
+void SFE_QUAD_Log_Writer::end(void)
+{
+  endTask();
+
+  if (_buffer != NULL)
+  {
+    flush();
+    delete[] _buffer;
+    _buffer = NULL;
+  }
+
+  _file = NULL;
+  _bufferSize = 0;
+  _head = 0;
+  _tail = 0;
+  _buffered = 0;
+}
+
+// Sync the file after syncMillis or once syncBytes have been written, whichever comes first.
+// Setting either to zero disables that budget. Setting both to zero means the file is only synced by flush
+void SFE_QUAD_Log_Writer::setSyncBudget(unsigned long syncMillis, uint32_t syncBytes)
+{
+  _syncMillis = syncMillis;
+  _syncBytes = syncBytes;
+}
+
+// Sync the file by calling syncCallback instead of Print::flush. Print::flush does not return a result, so a failed sync
+// is only seen if the file reports it through getWriteError. The callback returns the result of the sync (e.g. SdFat's sync).
+// filePosition is the number of bytes written to the file: once the callback returns true, they survive a power loss
+void SFE_QUAD_Log_Writer::setSyncCallback(bool (*syncCallback)(void *context, uint32_t filePosition), void *context)
+{
+  lockFile();
+  _syncCallback = syncCallback;
+  _syncContext = context;
+  unlockFile();
+}
+
+// Add text to the buffer. Returns the number of chars buffered.
+// Without the task, a full buffer is serviced immediately - which will block while the sectors are written.
+// With the task, the main code must never block: the chars which do not fit are dropped and counted by bytesDropped
+size_t SFE_QUAD_Log_Writer::write(const char *str)
+{
+  if ((_buffer == NULL) || (str == NULL))
+    return (0);
+
+  size_t len = strlen(str);
+  size_t copied = 0;
+
+  while (copied < len)
+  {
+    lockBuffer();
+    size_t space = _bufferSize - _buffered;
+    size_t chunk = len - copied;
+    if (chunk > space)
+      chunk = space;
+    if (chunk > _bufferSize - _head)
+      chunk = _bufferSize - _head; // Stop at the end of the ring. Copy the rest next time around
+    memcpy(&_buffer[_head], &str[copied], chunk);
+    _head = (_head + chunk) % _bufferSize;
+    _buffered = _buffered + chunk;
+    unlockBuffer();
+
+    copied += chunk;
+
+    if ((chunk == 0) && (copied < len)) // Buffer is full
+    {
+#if defined(ARDUINO_ARCH_ESP32)
+      if (_taskHandle != NULL)
+      {
+        _droppedBytes += len - copied;
+        return (copied);
+      }
+#endif
+      if (!service()) // Write the whole sectors to make space
+      {
+        _droppedBytes += len - copied;
+        return (copied);
+      }
+    }
+  }
+
+  return (copied);
+}
+
+// Add text plus CR LF to the buffer. Returns the number of chars buffered
+size_t SFE_QUAD_Log_Writer::println(const char *str)
+{
+  size_t copied = write(str);
+  copied += write("\r\n");
+  return (copied);
+}
+
+// Note a position in the file - e.g. the start of a row which needs to be indexed. The sync callback takes the mark (takeMark)
+// just before the position is synced. Returns false if SFE_QUAD_LOG_WRITER_MARKS marks are already waiting
+bool SFE_QUAD_Log_Writer::addMark(uint32_t filePosition, uint32_t tag)
+{
+  bool result = false;
+  lockBuffer();
+  if (_marks < SFE_QUAD_LOG_WRITER_MARKS)
+  {
+    uint8_t mark = (_markHead + _marks) % SFE_QUAD_LOG_WRITER_MARKS;
+    _markPosition[mark] = filePosition;
+    _markTag[mark] = tag;
+    _marks = _marks + 1;
+    result = true;
+  }
+  unlockBuffer();
+  return (result);
+}
+
+// For the sync callback: take the oldest mark before filePosition (the position being synced). Returns false if there is none
+bool SFE_QUAD_Log_Writer::takeMark(uint32_t filePosition, uint32_t *markPosition, uint32_t *tag)
+{
+  bool result = false;
+  lockBuffer();
+  if ((_marks > 0) && (_markPosition[_markHead] < filePosition))
+  {
+    *markPosition = _markPosition[_markHead];
+    *tag = _markTag[_markHead];
+    _markHead = (_markHead + 1) % SFE_QUAD_LOG_WRITER_MARKS;
+    _marks = _marks - 1;
+    result = true;
+  }
+  unlockBuffer();
+  return (result);
+}
+
+// Write any whole sectors to the file, then sync if the time or byte budget has been reached - or if the marks are full.
+// Call this between samples if not using the task. Returns false if the file write failed
+bool SFE_QUAD_Log_Writer::service(void)
+{
+  if ((_buffer == NULL) || (_file == NULL))
+    return (false);
+
+  bool result = true;
+
+  lockFile();
+
+  // The first chunk tops up the current (partial) sector. The following chunks are whole sectors
+  size_t firstChunk = SFE_QUAD_LOG_WRITER_SECTOR_SIZE - (_filePosition % SFE_QUAD_LOG_WRITER_SECTOR_SIZE);
+  lockBuffer();
+  size_t available = _buffered;
+  bool marksFull = (_marks >= SFE_QUAD_LOG_WRITER_MARKS);
+  unlockBuffer();
+
+  if (available >= firstChunk)
+  {
+    size_t len = firstChunk + (((available - firstChunk) / SFE_QUAD_LOG_WRITER_SECTOR_SIZE) * SFE_QUAD_LOG_WRITER_SECTOR_SIZE);
+    result = writeToFile(len);
+    available -= len;
+  }
+
+  if (result)
+  {
+    bool syncNow = false;
+    if ((_syncBytes > 0) && ((_unsyncedBytes + available) >= _syncBytes))
+      syncNow = true;
+    if ((_syncMillis > 0) && (millis() - _lastSync >= _syncMillis) && ((_unsyncedBytes + available) > 0))
+      syncNow = true;
+    if (marksFull) // The sync callback takes the marks. Sync early so the next mark can be added
+      syncNow = true;
+
+    if (syncNow)
+    {
+      if (available > 0)
+        result = writeToFile(available); // Write the partial sector
+      if (result)
+        result = syncFile();
+    }
+  }
+
+  unlockFile();
+
+  return (result);
+}
+
+// Write everything in the buffer to the file and sync it (if anything was written since the last sync). Call this before closing the file.
+// Safe to call while the task is running
+bool SFE_QUAD_Log_Writer::flush(void)
+{
+  if ((_buffer == NULL) || (_file == NULL))
+    return (false);
+
+  lockFile();
+
+  lockBuffer();
+  size_t available = _buffered;
+  unlockBuffer();
+
+  bool result = true;
+  if (available > 0)
+    result = writeToFile(available);
+  if ((result) && (_unsyncedBytes > 0)) // Nothing to sync if nothing was written since the last sync
+    result = syncFile();
+
+  unlockFile();
+
+  return (result);
+}
+
+// The number of bytes waiting to be written
+size_t SFE_QUAD_Log_Writer::bytesBuffered(void)
+{
+  lockBuffer();
+  size_t available = _buffered;
+  unlockBuffer();
+  return (available);
+}
+
+// The number of bytes lost because the buffer was full
+uint32_t SFE_QUAD_Log_Writer::bytesDropped(void)
+{
+  return (_droppedBytes);
+}
+
+// The file position up to which the file has been written and synced. The data before it survives a power loss
+uint32_t SFE_QUAD_Log_Writer::syncedPosition(void)
+{
+  lockFile();
+  uint32_t position = _filePosition - _unsyncedBytes;
+  unlockFile();
+  return (position);
+}
+
+// Helper function for service and flush. Write len bytes from the tail of the buffer to the file.
+// The ring wraps, so this may take two writes. lockFile must be held
+bool SFE_QUAD_Log_Writer::writeToFile(size_t len)
+{
+  while (len > 0)
+  {
+    size_t chunk = len;
+    if (chunk > _bufferSize - _tail)
+      chunk = _bufferSize - _tail;
+
+    size_t written = _file->write(&_buffer[_tail], chunk);
+
+    lockBuffer();
+    _tail = (_tail + written) % _bufferSize;
+    _buffered = _buffered - written;
+    unlockBuffer();
+
+    _filePosition += written;
+    _unsyncedBytes += written;
+    len -= written;
+
+    if (written < chunk) // Write failed (card full or removed?)
+      return (false);
+  }
+
+  return (true);
+}
+
+// Helper function for service and flush. Sync the file and restart the budget.
+// The synced position only moves if the sync succeeded. If it failed, the bytes stay unsynced and the next sync tries again. lockFile must be held
+bool SFE_QUAD_Log_Writer::syncFile(void)
+{
+  bool result;
+
+  if (_syncCallback != NULL)
+    result = _syncCallback(_syncContext, _filePosition);
+  else
+  {
+    _file->clearWriteError();
+    _file->flush(); // Print::flush calls sync for SdFat, SD and LittleFS files
+    result = (_file->getWriteError() == 0);
+  }
+
+  _lastSync = millis();
+  if (result)
+    _unsyncedBytes = 0;
+
+  return (result);
+}
+
+void SFE_QUAD_Log_Writer::lockBuffer(void)
+{
+#if defined(ARDUINO_ARCH_ESP32)
+  if (_bufferMutex != NULL)
+    xSemaphoreTake(_bufferMutex, portMAX_DELAY);
+#endif
+}
+
+void SFE_QUAD_Log_Writer::unlockBuffer(void)
+{
+#if defined(ARDUINO_ARCH_ESP32)
+  if (_bufferMutex != NULL)
+    xSemaphoreGive(_bufferMutex);
+#endif
+}
+
+void SFE_QUAD_Log_Writer::lockFile(void)
+{
+#if defined(ARDUINO_ARCH_ESP32)
+  if (_fileMutex != NULL)
+    xSemaphoreTake(_fileMutex, portMAX_DELAY);
+#endif
+}
+
+void SFE_QUAD_Log_Writer::unlockFile(void)
+{
+#if defined(ARDUINO_ARCH_ESP32)
+  if (_fileMutex != NULL)
+    xSemaphoreGive(_fileMutex);
+#endif
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+// ESP32 only: service the writer from a FreeRTOS task, so the main code never waits for the SD card.
+// While the task is running, the main code must not access the SD card (other than through flush)
+bool SFE_QUAD_Log_Writer::beginTask(uint8_t priority)
+{
+  if (_buffer == NULL)
+    return (false);
+
+  if (_taskHandle != NULL)
+    return (true); // Task is already running
+
+  _bufferMutex = xSemaphoreCreateMutex();
+  _fileMutex = xSemaphoreCreateMutex();
+  if ((_bufferMutex == NULL) || (_fileMutex == NULL))
+  {
+    endTask(); // Delete whichever mutex was created
+    return (false);
+  }
+
+  _taskStop = false;
+  if (xTaskCreate(logWriterTask, "QUAD_Log_Writer", 4096, this, priority, &_taskHandle) != pdPASS)
+  {
+    _taskHandle = NULL;
+    endTask();
+    return (false);
+  }
+
+  return (true);
+}
+
+// ESP32 only: stop the task. Waits for the task to finish its current write
+void SFE_QUAD_Log_Writer::endTask(void)
+{
+  if (_taskHandle != NULL)
+  {
+    _taskStop = true;
+    while (_taskHandle != NULL) // The task clears _taskHandle when it exits
+      delay(1);
+  }
+
+  if (_bufferMutex != NULL)
+  {
+    vSemaphoreDelete(_bufferMutex);
+    _bufferMutex = NULL;
+  }
+  if (_fileMutex != NULL)
+  {
+    vSemaphoreDelete(_fileMutex);
+    _fileMutex = NULL;
+  }
+}
+
+void SFE_QUAD_Log_Writer::logWriterTask(void *pvParameters)
+{
+  SFE_QUAD_Log_Writer *writer = (SFE_QUAD_Log_Writer *)pvParameters;
+
+  while (!writer->_taskStop)
+  {
+    writer->service();
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
+
+  writer->_taskHandle = NULL;
+  vTaskDelete(NULL);
+}
+
+#else
+
+bool SFE_QUAD_Log_Writer::beginTask(uint8_t priority)
+{
+  (void)priority;
+  return (false); // Not supported. Call service between samples instead
+}
+
+void SFE_QUAD_Log_Writer::endTask(void)
+{
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef SPARKFUN_QUAD_LOG_WRITER_H
+#define SPARKFUN_QUAD_LOG_WRITER_H
+
+// SparkFun Qwiic Universal Auto-Detect Log Writer
+
+// Buffers the log rows in RAM and writes them to the log file in whole 512-byte sectors.
+// The file is only synced when the time or byte budget is reached. On ESP32, the writing can be done by a FreeRTOS task.
+
+#include "Arduino.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#endif
+
+#define SFE_QUAD_LOG_WRITER_SECTOR_SIZE 512 // Write the file in chunks of this size, aligned to the sectors
+#define SFE_QUAD_LOG_WRITER_MARKS 8          // The number of marks which can wait for the next sync
+
+class SFE_QUAD_Log_Writer
+{
+public:
+  SFE_QUAD_Log_Writer(void);
+  ~SFE_QUAD_Log_Writer(void);
+
+  bool begin(Print &file, size_t bufferSize = 4096, uint32_t filePosition = 0); // Allocate the buffer. filePosition is the size of the file (when appending) so the writes can be sector-aligned
+  void end(void);                                                                 // Write everything, sync, stop the task (if any) and release the buffer
+  void setSyncBudget(unsigned long syncMillis, uint32_t syncBytes);              // Sync after this much time or this many bytes. Zero disables that budget
+  void setSyncCallback(bool (*syncCallback)(void *context, uint32_t filePosition), void *context = NULL); // Sync the file with this (e.g. SdFat sync) instead of Print::flush
+
+  size_t write(const char *str);   // Add text to the buffer. Returns the number of chars buffered
+  size_t println(const char *str); // Add text plus CR LF to the buffer. Returns the number of chars buffered
+
+  bool service(void); // Write any whole sectors to the file and sync if the budget has been reached. Call this between samples (if not using the task)
+  bool flush(void);   // Write everything in the buffer to the file and sync it. Call this before closing the file
+
+  bool addMark(uint32_t filePosition, uint32_t tag);                            // Note a position in the file. The sync callback takes the mark once the position is written
+  bool takeMark(uint32_t filePosition, uint32_t *markPosition, uint32_t *tag); // For the sync callback: take the oldest mark before filePosition
+
+  size_t bytesBuffered(void);           // The number of bytes waiting to be written
+  uint32_t bytesDropped(void);          // The number of bytes lost because the buffer was full (only possible when using the task)
+  uint32_t syncedPosition(void);        // The file position up to which the file has been written and synced
+  bool beginTask(uint8_t priority = 1); // ESP32 only: service the writer from a FreeRTOS task
+  void endTask(void);                   // ESP32 only: stop the task
+
+private:
+  bool writeToFile(size_t len); // Write len bytes from the tail of the buffer to the file
+  bool syncFile(void);          // Sync (flush) the file and restart the budget
+  void lockBuffer(void);        // Protect _head and _tail from the task
+  void unlockBuffer(void);
+  void lockFile(void); // Stop the task and the main code from writing to the file at the same time
+  void unlockFile(void);
+
+  Print *_file;              // The log file
+  uint8_t *_buffer;          // The ring buffer
+  size_t _bufferSize;        // The size of the ring buffer
+  volatile size_t _head;     // The next byte to be written into the buffer
+  volatile size_t _tail;     // The next byte to be written to the file
+  volatile size_t _buffered; // The number of bytes in the buffer
+  uint32_t _filePosition;    // The number of bytes written to the file. Used to align the writes with the sectors
+  unsigned long _syncMillis; // The time budget (ms)
+  uint32_t _syncBytes;       // The byte budget
+  unsigned long _lastSync;   // When the file was last synced (millis)
+  uint32_t _unsyncedBytes;   // The number of bytes written since the last sync
+  uint32_t _droppedBytes;    // The number of bytes lost because the buffer was full
+  bool (*_syncCallback)(void *context, uint32_t filePosition); // Syncs the file. NULL = use Print::flush
+  void *_syncContext;                                          // Passed to _syncCallback
+  uint32_t _markPosition[SFE_QUAD_LOG_WRITER_MARKS];           // The marks: a ring of (file position, tag)
+  uint32_t _markTag[SFE_QUAD_LOG_WRITER_MARKS];
+  volatile uint8_t _markHead; // The oldest mark
+  volatile uint8_t _marks;    // The number of marks
+
+#if defined(ARDUINO_ARCH_ESP32)
+  static void logWriterTask(void *pvParameters); // The FreeRTOS task
+  TaskHandle_t _taskHandle;
+  SemaphoreHandle_t _bufferMutex;
+  SemaphoreHandle_t _fileMutex;
+  volatile bool _taskStop;
+#endif
+};
+
+#endif
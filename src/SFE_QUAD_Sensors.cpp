@@ -70,6 +70,66 @@ char *SFE_QUAD_Sensors_sprintf::_dtostrf(double value, char *buffer)
   return out;
 }
 
+char *SFE_QUAD_Sensors_sprintf::_fixtostrf(int32_t value, uint8_t decimals, char *buffer)
+{
+  char *out = buffer;
+
+  // Handle negative numbers
+  bool negative = (value < 0);
+  uint32_t magnitude;
+  if (negative)
+    magnitude = (uint32_t)(-(value + 1)) + 1; // Avoid overflow on INT32_MIN
+  else
+    magnitude = (uint32_t)value;
+
+  // Drop any surplus decimal places in one division, rounding half up. Rounding one digit at a time would round twice:
+  // 1.45 would become 1.5 and then 2
+  if (decimals > _prec)
+  {
+    if (decimals - _prec > 9) // 10^10 does not fit in uint32_t. The result is always zero
+      magnitude = 0;
+    else
+    {
+      uint32_t divisor = 1;
+      for (uint8_t i = _prec; i < decimals; i++)
+        divisor *= 10;
+      magnitude = (magnitude / divisor) + (((magnitude % divisor) >= (divisor / 2)) ? 1 : 0);
+    }
+    decimals = _prec;
+  }
+
+  // Don't print "-0" if the value has rounded to zero
+  if (negative && (magnitude > 0))
+    *out++ = '-';
+
+  // Extract the digits, least significant first. Print at least one digit before the decimal point
+  char digits[12];
+  uint8_t numDigits = 0;
+  do
+  {
+    digits[numDigits++] = (char)('0' + (magnitude % 10));
+    magnitude /= 10;
+  } while ((magnitude > 0) || (numDigits <= decimals));
+
+  // Print the digits, and if necessary, the decimal point
+  while (numDigits > 0)
+  {
+    *out++ = digits[--numDigits];
+    if ((numDigits == decimals) && (decimals > 0))
+      *out++ = '.';
+  }
+
+  // Pad with zeros to match the precision
+  if ((decimals == 0) && (_prec > 0))
+    *out++ = '.';
+  while (decimals++ < _prec)
+    *out++ = '0';
+
+  // make sure the string is terminated
+  *out = 0;
+  return out;
+}
+
 char *SFE_QUAD_Sensors_sprintf::_etoa(double value, char *buffer)
 {
   if (sizeof(double) != sizeof(uint64_t))
@@ -279,14 +339,24 @@ SFE_QUAD_Sensors::SFE_QUAD_Sensors(void)
   _debugPort = NULL;
   _printDebug = false;
   _menuPort = NULL;
+  _aggregates = SFE_QUAD_AGGREGATE_MEAN;
+  _heartbeatMillis = 0;
+  _lastLoggedMillis = 0;
+  _rowLogged = false;
+  _deltaRecords = false;
 
   readings = new char[1]; // Initialize readings
   *readings = 0;
 
+  events = new char[1]; // Initialize events
+  *events = 0;
+
   configuration = new char[1]; // Initialize configuration
   *configuration = 0;
 
   _head = NULL; // Initialize the sensor linked list head
+
+  _compensationHead = NULL; // Initialize the compensation linked list head
 }
 
 SFE_QUAD_Sensors::~SFE_QUAD_Sensors(void)
@@ -294,9 +364,14 @@ SFE_QUAD_Sensors::~SFE_QUAD_Sensors(void)
   if (readings != NULL)
     delete[] readings;
 
+  if (events != NULL)
+    delete[] events;
+
   if (configuration != NULL)
     delete[] configuration;
 
+  clearCompensationLinks();
+
   while (_head != NULL) // Have we found any sensors?
   {
     if (_head->_next == NULL) // Is the the last / only sensor?
@@ -466,6 +541,18 @@ bool SFE_QUAD_Sensors::detectSensors(void)
                     _debugPort->println(F(" as it was found on the main branch"));
                   }
                 }
+                // Check if we already have this sensor at this location (e.g. from detectSensorsFromConfiguration). Skip it if we have
+                else if ((muxAddr >= 0x70) && (sensorExists(tryThisSensorType->getSensorName(), tryThisAddress, muxAddr, muxPort) != NULL))
+                {
+                  if (_printDebug)
+                  {
+                    _debugPort->print(F("detectSensors: skipping sensor "));
+                    _debugPort->print(tryThisSensorType->getSensorName());
+                    _debugPort->print(F(" address 0x"));
+                    _debugPort->print(tryThisAddress, HEX);
+                    _debugPort->println(F(" as it has already been found"));
+                  }
+                }
                 // If this is a MS5637, check if we have already found a MS8607. Skip it if we have
                 else if ((strcmp(tryThisSensorType->getSensorName(), "MS5637") == 0) && ((sensorExists("MS8607", 0x40, 0, 0) != NULL) || (sensorExists("MS8607", 0x40, muxAddr == 0x6F ? 0 : muxAddr, muxPort) != NULL)))
                 {
@@ -509,29 +596,7 @@ bool SFE_QUAD_Sensors::detectSensors(void)
                         _debugPort->println();
                     }
 
-                    if (_head == NULL) // Is this the first sensor we've found?
-                    {
-                      _head = sensorFactory((SFEQUADSensorType)type);
-                      _head->_sensorAddress = tryThisAddress;
-                      _head->_muxAddress = muxAddr == 0x6F ? 0 : muxAddr;
-                      _head->_muxPort = muxAddr == 0x6F ? 0 : muxPort;
-                      _head->_sprintf._prec = _sprintf._prec; // Inherit _prec from the Sensors
-                      _head->_type = type;
-                    }
-                    else
-                    {
-                      SFE_QUAD_Sensor *nextSensor = _head; // Start at the head
-                      while (nextSensor->_next != NULL)    // Keep going until we reach the end of the list
-                      {
-                        nextSensor = nextSensor->_next;
-                      }
-                      nextSensor->_next = sensorFactory((SFEQUADSensorType)type);
-                      nextSensor->_next->_sensorAddress = tryThisAddress;
-                      nextSensor->_next->_muxAddress = muxAddr == 0x6F ? 0 : muxAddr;
-                      nextSensor->_next->_muxPort = muxAddr == 0x6F ? 0 : muxPort;
-                      nextSensor->_next->_sprintf._prec = _sprintf._prec; // Inherit _prec from the Sensors
-                      nextSensor->_next->_type = type;
-                    }
+                    addSensor((SFEQUADSensorType)type, tryThisAddress, muxAddr == 0x6F ? 0 : muxAddr, muxAddr == 0x6F ? 0 : muxPort);
                   }
                 }
               }
@@ -577,6 +642,243 @@ bool SFE_QUAD_Sensors::detectSensors(void)
   return (true);
 }
 
+bool SFE_QUAD_Sensors::detectSensorsFromConfiguration(void)
+{
+  if (_i2cPort == NULL)
+  {
+    if (_printDebug)
+      _debugPort->println(F("detectSensorsFromConfiguration: _i2cPort is NULL. Did you forget to call setWirePort?"));
+    return (false);
+  }
+
+  // Walk through configuration, looking for the logging settings lines: sensorName,sensorAddress,muxAddress,muxPort,-1,...
+  // There is one per sensor, in the order the sensors were detected
+  // Don't use strtok here. configuration needs to be left intact for applySensorAndMenuConfiguration
+
+  // First, begin each mux in the configuration. This checks the mux is present and disables all of its ports
+  bool muxBegun[6] = {false, false, false, false, false, false};
+  bool muxMissing = false;
+  QWIICMUX *thisMux = new QWIICMUX;
+  if (thisMux == NULL)
+  {
+    if (_printDebug)
+      _debugPort->println(F("detectSensorsFromConfiguration: could not allocate memory for thisMux!"));
+    return (false);
+  }
+
+  size_t sensorCount = 0; // The number of sensors in the configuration
+
+  for (uint8_t pass = 0; (pass < 2) && (!muxMissing); pass++) // Pass 0: begin the muxes. Pass 1: verify the sensors
+  {
+    const char *line = configuration;
+
+    while ((line != NULL) && (*line != 0) && (!muxMissing))
+    {
+      char lineCopy[96]; // Copy the line so sscanf can't wander into the next one
+      const char *lineEnd = strchr(line, '\n');
+      size_t lineLen = (lineEnd == NULL) ? strlen(line) : (size_t)(lineEnd - line);
+      if (lineLen >= sizeof(lineCopy))
+        lineLen = sizeof(lineCopy) - 1;
+      memcpy(lineCopy, line, lineLen);
+      lineCopy[lineLen] = 0;
+      line = (lineEnd == NULL) ? NULL : lineEnd + 1;
+
+      char sensorName[64];
+      int sensorAddress, muxAddress, muxPort, configItem;
+      if ((sscanf(lineCopy, "%63[^,],%d,%d,%d,%d,", sensorName, &sensorAddress, &muxAddress, &muxPort, &configItem) != 5) || (configItem != -1))
+        continue; // Not a logging settings line
+
+      if (pass == 0)
+      {
+        if ((muxAddress >= 0x70) && (muxAddress <= 0x75) && (!muxBegun[muxAddress - 0x70]))
+        {
+          if (!thisMux->begin(muxAddress, *_i2cPort))
+          {
+            if (_printDebug)
+            {
+              _debugPort->print(F("detectSensorsFromConfiguration: mux not found at address 0x"));
+              _debugPort->println(muxAddress, HEX);
+            }
+            muxMissing = true;
+          }
+          muxBegun[muxAddress - 0x70] = true;
+        }
+        continue;
+      }
+
+      if (sensorExists(sensorName, sensorAddress, muxAddress, muxPort) != NULL) // Ignore duplicates
+        continue;
+
+      sensorCount++;
+
+      // Find the sensor type from its name
+      SFE_QUAD_Sensor *thisSensor = NULL;
+      uint16_t type;
+      for (type = 0; (type < (uint16_t)SFE_QUAD_Sensor_Number_Of_Sensors) && (thisSensor == NULL); type++)
+      {
+        SFE_QUAD_Sensor *tryThisSensorType = sensorFactory((SFEQUADSensorType)type);
+        if (tryThisSensorType != NULL)
+        {
+          if ((tryThisSensorType->_classPtr != NULL) && (strcmp(tryThisSensorType->getSensorName(), sensorName) == 0))
+            thisSensor = tryThisSensorType; // Keep it - it is used for the identity probe below
+          else
+          {
+            tryThisSensorType->deleteSensorStorage(); // Be nice. Release the memory
+            delete tryThisSensorType;
+          }
+        }
+      }
+
+      if ((thisSensor == NULL) && (_printDebug)) // Sensor type not found (or not included)
+      {
+        _debugPort->print(F("detectSensorsFromConfiguration: unknown sensor "));
+        _debugPort->println(sensorName);
+      }
+      if (thisSensor != NULL)
+        type--; // Undo the final increment
+
+      // Select the mux port
+      if (muxAddress >= 0x70)
+      {
+        thisMux->begin(muxAddress, *_i2cPort);
+        thisMux->setPort(muxPort);
+      }
+
+      // Verify the sensor: a single ACK, then the identity probe (detectSensor)
+      bool verified = false;
+      if (thisSensor != NULL)
+      {
+        _i2cPort->beginTransmission((uint8_t)sensorAddress);
+        verified = (_i2cPort->endTransmission() == 0);
+        if (verified)
+          verified = thisSensor->detectSensor(sensorAddress, *_i2cPort);
+
+        thisSensor->deleteSensorStorage(); // Be nice. Release the memory
+        delete thisSensor;
+      }
+
+      if (verified)
+      {
+        if (_printDebug)
+        {
+          _debugPort->print(F("detectSensorsFromConfiguration: verified sensor "));
+          _debugPort->print(sensorName);
+          _debugPort->print(F(" at address 0x"));
+          _debugPort->println(sensorAddress, HEX);
+        }
+
+        addSensor((SFEQUADSensorType)type, sensorAddress, muxAddress, muxPort);
+      }
+      else
+      {
+        if (_printDebug)
+        {
+          _debugPort->print(F("detectSensorsFromConfiguration: could not verify "));
+          _debugPort->print(sensorName);
+          _debugPort->println(F(". Probing its address for all sensor types"));
+        }
+
+        // Only this location is probed (e.g. the sensor has been swapped). The other sensors carry on being verified
+        detectSensorAtLocation(sensorAddress, muxAddress, muxPort);
+      }
+
+      // Deselect the mux port so this mux does not interfere with the sensors on the main branch or other muxes
+      if (muxAddress >= 0x70)
+        thisMux->disablePort(muxPort);
+    }
+  }
+
+  delete thisMux;
+
+  if ((!muxMissing) && (sensorCount > 0))
+    return (true);
+
+  // A missing mux means the wiring has changed, and an empty configuration has nothing to verify. Do a full detection
+  if (_printDebug)
+    _debugPort->println(F("detectSensorsFromConfiguration: falling back to detectSensors"));
+
+  return (detectSensors()); // Any sensors verified above are skipped by detectSensors
+}
+
+// Helper function for detectSensorsFromConfiguration. The sensor in the configuration was not found at this location:
+// probe the address with every sensor type which can use it. The mux port must already be selected. Returns true if a sensor was added
+bool SFE_QUAD_Sensors::detectSensorAtLocation(uint8_t sensorAddress, uint8_t muxAddress, uint8_t muxPort)
+{
+  _i2cPort->beginTransmission(sensorAddress);
+  if (_i2cPort->endTransmission() != 0) // Nothing at this address (e.g. the sensor has been unplugged). No need to try each type
+    return (false);
+
+  bool found = false;
+  for (uint16_t type = 0; (type < (uint16_t)SFE_QUAD_Sensor_Number_Of_Sensors) && (!found); type++)
+  {
+    SFE_QUAD_Sensor *tryThisSensorType = sensorFactory((SFEQUADSensorType)type);
+    if (tryThisSensorType == NULL)
+      continue;
+
+    if (tryThisSensorType->_classPtr != NULL) // Check if sensor can be included
+    {
+      bool tryThisAddress = false;
+      uint8_t numAddresses = tryThisSensorType->getNumI2cAddresses();
+      for (uint8_t addressIndex = 0; addressIndex < numAddresses; addressIndex++)
+        if (tryThisSensorType->getI2cAddress(addressIndex) == sensorAddress)
+          tryThisAddress = true;
+
+      // As in detectSensors: skip the MS5637 if there is a MS8607 here, and the VEML7700 if there is a VEML6075
+      if ((strcmp(tryThisSensorType->getSensorName(), "MS5637") == 0) && (sensorExists("MS8607", 0x40, muxAddress, muxPort) != NULL))
+        tryThisAddress = false;
+      if ((strcmp(tryThisSensorType->getSensorName(), "VEML7700") == 0) && (sensorExists("VEML6075", 0x10, muxAddress, muxPort) != NULL))
+        tryThisAddress = false;
+
+      if ((tryThisAddress) && (sensorExists(tryThisSensorType->getSensorName(), sensorAddress, muxAddress, muxPort) == NULL) && (tryThisSensorType->detectSensor(sensorAddress, *_i2cPort)))
+      {
+        if (_printDebug)
+        {
+          _debugPort->print(F("detectSensorAtLocation: found sensor "));
+          _debugPort->print(tryThisSensorType->getSensorName());
+          _debugPort->print(F(" at address 0x"));
+          _debugPort->println(sensorAddress, HEX);
+        }
+        addSensor((SFEQUADSensorType)type, sensorAddress, muxAddress, muxPort);
+        found = true;
+      }
+    }
+
+    tryThisSensorType->deleteSensorStorage(); // Be nice. Release the memory
+    delete tryThisSensorType;
+  }
+
+  return (found);
+}
+
+SFE_QUAD_Sensor *SFE_QUAD_Sensors::addSensor(SFEQUADSensorType type, uint8_t i2cAddress, uint8_t muxAddress, uint8_t muxPort)
+{
+  SFE_QUAD_Sensor *newSensor = sensorFactory(type);
+  if (newSensor == NULL)
+    return (NULL);
+
+  newSensor->_sensorAddress = i2cAddress;
+  newSensor->_muxAddress = muxAddress;
+  newSensor->_muxPort = muxPort;
+  newSensor->_sprintf._prec = _sprintf._prec; // Inherit _prec from the Sensors
+  newSensor->_type = type;
+
+  if (_head == NULL) // Is this the first sensor we've found?
+  {
+    _head = newSensor;
+  }
+  else
+  {
+    SFE_QUAD_Sensor *nextSensor = _head; // Start at the head
+    while (nextSensor->_next != NULL)    // Keep going until we reach the end of the list
+    {
+      nextSensor = nextSensor->_next;
+    }
+    nextSensor->_next = newSensor;
+  }
+
+  return (newSensor);
+}
+
 bool SFE_QUAD_Sensors::beginSensors(void)
 {
   if (_head == NULL) // If head is NULL no sensors have been found
@@ -657,6 +959,175 @@ bool SFE_QUAD_Sensors::initializeSensors(void)
   return (true);
 }
 
+bool SFE_QUAD_Sensors::saveSnapshot(SFE_QUAD_Sensors_Snapshot_t *snapshot)
+{
+  if (snapshot == NULL)
+    return (false);
+
+  memset(snapshot, 0, sizeof(SFE_QUAD_Sensors_Snapshot_t)); // Clear the snapshot. An invalid snapshot has the wrong magic
+
+  if (_head == NULL) // If head is NULL no sensors have been found
+  {
+    if (_printDebug)
+      _debugPort->println(F("saveSnapshot: no sensors found!"));
+    return (false);
+  }
+
+  SFE_QUAD_Sensor *thisSensor = _head; // Point to the first sensor
+  uint8_t numSensors = 0;
+
+  while (thisSensor != NULL)
+  {
+    if (numSensors == SFE_QUAD_SNAPSHOT_MAX_SENSORS)
+    {
+      if (_printDebug)
+        _debugPort->println(F("saveSnapshot: too many sensors! Increase SFE_QUAD_SNAPSHOT_MAX_SENSORS"));
+      return (false);
+    }
+
+    uint8_t senseCount = 0;
+    thisSensor->getSenseCount(&senseCount);
+    if (senseCount >= 32) // The logSense mask has room for the sensor enable plus 31 senses
+    {
+      if (_printDebug)
+        _debugPort->println(F("saveSnapshot: too many senses!"));
+      return (false);
+    }
+
+    SFE_QUAD_Sensor_Snapshot_t *entry = &snapshot->sensor[numSensors];
+    entry->type = (uint16_t)thisSensor->_type;
+    entry->sensorAddress = thisSensor->_sensorAddress;
+    entry->muxAddress = thisSensor->_muxAddress;
+    entry->muxPort = thisSensor->_muxPort;
+    for (uint8_t i = 0; i <= senseCount; i++)
+      if (thisSensor->_logSense[i])
+        entry->logSense |= ((uint32_t)1) << i;
+    entry->stateLen = thisSensor->getSensorState(entry->state, SFE_QUAD_SNAPSHOT_STATE_BYTES);
+    if (entry->stateLen > SFE_QUAD_SNAPSHOT_STATE_BYTES)
+      entry->stateLen = SFE_QUAD_SNAPSHOT_STATE_BYTES;
+
+    numSensors++;
+    thisSensor = thisSensor->_next; // Point to the next sensor
+  }
+
+  snapshot->numSensors = numSensors;
+  snapshot->prec = _sprintf._prec;
+  snapshot->checksum = snapshotChecksum(snapshot);
+  snapshot->magic = SFE_QUAD_SNAPSHOT_MAGIC;
+
+  return (true);
+}
+
+bool SFE_QUAD_Sensors::resumeSensors(const SFE_QUAD_Sensors_Snapshot_t *snapshot)
+{
+  if (_i2cPort == NULL)
+  {
+    if (_printDebug)
+      _debugPort->println(F("resumeSensors: _i2cPort is NULL. Did you forget to call setWirePort?"));
+    return (false);
+  }
+
+  if (_head != NULL) // resumeSensors replaces detectSensors. The sensor list must be empty
+  {
+    if (_printDebug)
+      _debugPort->println(F("resumeSensors: sensors have already been detected!"));
+    return (false);
+  }
+
+  if ((snapshot == NULL) || (snapshot->magic != SFE_QUAD_SNAPSHOT_MAGIC) || (snapshot->numSensors == 0) || (snapshot->numSensors > SFE_QUAD_SNAPSHOT_MAX_SENSORS) || (snapshot->checksum != snapshotChecksum(snapshot)))
+  {
+    if (_printDebug)
+      _debugPort->println(F("resumeSensors: snapshot is invalid!"));
+    return (false);
+  }
+
+  QWIICMUX *thisMux = new QWIICMUX;
+  if (thisMux == NULL)
+  {
+    if (_printDebug)
+      _debugPort->println(F("resumeSensors: could not allocate memory for thisMux!"));
+    return (false);
+  }
+
+  _sprintf._prec = snapshot->prec; // Restore _prec before the sensors inherit it
+
+  bool success = true;
+
+  for (uint8_t i = 0; (i < snapshot->numSensors) && success; i++)
+  {
+    const SFE_QUAD_Sensor_Snapshot_t *entry = &snapshot->sensor[i];
+
+    SFE_QUAD_Sensor *thisSensor = NULL;
+    if (entry->type < (uint16_t)SFE_QUAD_Sensor_Number_Of_Sensors)
+      thisSensor = addSensor((SFEQUADSensorType)entry->type, entry->sensorAddress, entry->muxAddress, entry->muxPort);
+    if (thisSensor == NULL) // Sensor type not included
+    {
+      if (_printDebug)
+        _debugPort->println(F("resumeSensors: could not add sensor!"));
+      success = false;
+      break;
+    }
+
+    uint8_t senseCount = 0;
+    thisSensor->getSenseCount(&senseCount);
+    for (uint8_t j = 0; (j <= senseCount) && (j < 32); j++)
+      thisSensor->_logSense[j] = (entry->logSense & (((uint32_t)1) << j)) != 0;
+
+    // If required, configure the mux port
+    if (entry->muxAddress >= 0x70)
+    {
+      thisMux->begin(entry->muxAddress, *_i2cPort);
+      thisMux->setPort(entry->muxPort);
+    }
+
+    if (thisSensor->resumeSensor(entry->sensorAddress, *_i2cPort, entry->state, entry->stateLen))
+    {
+      if (_printDebug)
+      {
+        _debugPort->print(F("resumeSensors: resumed sensor "));
+        _debugPort->println(thisSensor->getSensorName());
+      }
+    }
+    else // Sensor state not intact (or resume not supported). Begin and initialize it as usual
+    {
+      if (_printDebug)
+      {
+        _debugPort->print(F("resumeSensors: beginning sensor "));
+        _debugPort->println(thisSensor->getSensorName());
+      }
+      thisSensor->beginSensor(entry->sensorAddress, *_i2cPort);
+      thisSensor->initializeSensor(entry->sensorAddress, *_i2cPort);
+    }
+  }
+
+  delete thisMux;
+
+  return (success);
+}
+
+uint16_t SFE_QUAD_Sensors::snapshotChecksum(const SFE_QUAD_Sensors_Snapshot_t *snapshot)
+{
+  // Fletcher-16 of numSensors, prec and the sensor entries which are in use
+  uint16_t sum1 = 0;
+  uint16_t sum2 = 0;
+  uint8_t numSensors = snapshot->numSensors;
+  if (numSensors > SFE_QUAD_SNAPSHOT_MAX_SENSORS)
+    numSensors = SFE_QUAD_SNAPSHOT_MAX_SENSORS;
+  const uint8_t *ptr = &snapshot->numSensors;
+  size_t len = 2; // numSensors and prec
+  for (uint8_t pass = 0; pass < 2; pass++)
+  {
+    for (size_t i = 0; i < len; i++)
+    {
+      sum1 = (sum1 + ptr[i]) % 255;
+      sum2 = (sum2 + sum1) % 255;
+    }
+    ptr = (const uint8_t *)&snapshot->sensor[0];
+    len = sizeof(SFE_QUAD_Sensor_Snapshot_t) * numSensors;
+  }
+  return ((sum2 << 8) | sum1);
+}
+
 bool SFE_QUAD_Sensors::setCustomInitialize(void (*pointer)(uint8_t sensorAddress, TwoWire &port, void *_classPtr), const char *sensorName, uint8_t i2cAddress, uint8_t muxAddress, uint8_t muxPort)
 {
   SFE_QUAD_Sensor *theSensor = sensorExists(sensorName, i2cAddress, muxAddress, muxPort);
@@ -697,18 +1168,70 @@ bool SFE_QUAD_Sensors::setCustomInitialize(void (*pointer)(uint8_t sensorAddress
   return (true);
 }
 
-bool SFE_QUAD_Sensors::getSensorReadings(void)
+bool SFE_QUAD_Sensors::setReadingPeriod(unsigned long periodMillis, const char *sensorName, uint8_t i2cAddress, uint8_t muxAddress, uint8_t muxPort)
 {
-  if (_head == NULL) // If head is NULL no sensors have been found
-  {
-    if (_printDebug)
-      _debugPort->println(F("getSensorReadings: no sensors found!"));
+  SFE_QUAD_Sensor *theSensor = sensorExists(sensorName, i2cAddress, muxAddress, muxPort);
+
+  if (theSensor == NULL)
     return (false);
+
+  theSensor->_readingPeriod = periodMillis;
+  theSensor->_readingDue = millis(); // Read the sensor at the next getSensorReadings, then every periodMillis
+  if ((periodMillis == 0) && (theSensor->_lastReadings != NULL)) // The last readings are only needed if the sensor has a period
+  {
+    delete[] theSensor->_lastReadings;
+    theSensor->_lastReadings = NULL;
   }
 
-  if (readings != NULL)
-    delete[] readings;    // Delete the old readings
-  readings = new char[1]; // Initialize readings
+  return (true);
+}
+
+bool SFE_QUAD_Sensors::setReadingPeriod(unsigned long periodMillis, const char *sensorName)
+{
+  if (_head == NULL) // If head is NULL no sensors have been found
+  {
+    if (_printDebug)
+      _debugPort->println(F("setReadingPeriod: no sensors found!"));
+    return (false);
+  }
+
+  SFE_QUAD_Sensor *thisSensor = _head; // Point to the first sensor
+  bool keepGoing = true;
+
+  while (keepGoing)
+  {
+    setReadingPeriod(periodMillis, sensorName, thisSensor->_sensorAddress, thisSensor->_muxAddress, thisSensor->_muxPort);
+
+    if (thisSensor->_next != NULL)    // Have we reached the end of the sensor list?
+      thisSensor = thisSensor->_next; // Point to the next sensor
+    else
+      keepGoing = false;
+  }
+
+  return (true);
+}
+
+bool SFE_QUAD_Sensors::getSensorReadings(void)
+{
+  if (_head == NULL) // If head is NULL no sensors have been found
+  {
+    if (_printDebug)
+      _debugPort->println(F("getSensorReadings: no sensors found!"));
+    return (false);
+  }
+
+  if (!scheduleSensors()) // Decide which sensors are due to be read
+    return (false);
+
+  if (!compensateSensors()) // Pass the latest compensation values from the producers to the consumers
+    return (false);
+
+  if (!triggerSensors()) // Trigger any sensors which can share a single conversion wait
+    return (false);
+
+  if (readings != NULL)
+    delete[] readings;    // Delete the old readings
+  readings = new char[1]; // Initialize readings
   *readings = 0;
 
   SFE_QUAD_Sensor *thisSensor = _head; // Point to the first sensor
@@ -721,8 +1244,8 @@ bool SFE_QUAD_Sensors::getSensorReadings(void)
     {
       if (thisSensor->_logSense[0]) // Is logging enable for this sensor?
       {
-        // If required, configure the mux port
-        if (thisSensor->_muxAddress >= 0x70)
+        // If required, configure the mux port. Not needed if the sensor is not due: its last readings are logged instead
+        if ((thisSensor->_muxAddress >= 0x70) && (thisSensor->_readingScheduled))
         {
           QWIICMUX *thisMux = new QWIICMUX;
           if (thisMux == NULL)
@@ -743,14 +1266,30 @@ bool SFE_QUAD_Sensors::getSensorReadings(void)
           if (thisSensor->_logSense[sense + 1]) // Is logging enabled for this sense?
           {
             // Log this sense
-            char *scratchpad = new char[32]; // Allocate memory to hold the sense reading temporarily
-            if (scratchpad == NULL)          // Did the memory allocation fail?
+            char *scratchpad = new char[SFE_QUAD_SENSOR_READING_LEN]; // Allocate memory to hold the sense reading temporarily
+            if (scratchpad == NULL)                                   // Did the memory allocation fail?
             {
               if (_printDebug)
                 _debugPort->println(F("getSensorReadings: scratchpad memory allocation failed!"));
               return (false);
             }
-            thisSensor->getSenseReading(sense, scratchpad); // Get the reading. Store it in scratchpad
+            if (thisSensor->_readingScheduled)
+            {
+              double value;
+              bool numeric = readSense(thisSensor, sense, scratchpad, &value); // Get the reading. Store it in scratchpad
+              if (thisSensor->_lastReadings != NULL)                           // Keep a copy if the sensor has a reading period
+              {
+                strncpy(&thisSensor->_lastReadings[sense * SFE_QUAD_SENSOR_READING_LEN], scratchpad, SFE_QUAD_SENSOR_READING_LEN - 1);
+                thisSensor->_lastReadings[(sense * SFE_QUAD_SENSOR_READING_LEN) + SFE_QUAD_SENSOR_READING_LEN - 1] = 0;
+              }
+              if (thisSensor->_deadband != NULL) // Record the numeric value for checkDeadband
+              {
+                thisSensor->_deadband[sense].current = value;
+                thisSensor->_deadband[sense].currentValid = numeric;
+              }
+            }
+            else
+              strcpy(scratchpad, &thisSensor->_lastReadings[sense * SFE_QUAD_SENSOR_READING_LEN]); // The sensor is not due. Log its last reading. The deadband keeps its last value
             size_t readingsLen = strlen(readings);          // Get the current readings length
             readingsLen += strlen(scratchpad);              // Get the length of the reading
             char *newReadings = new char[readingsLen + 2];  // Allocate memory to hold readings plus scrtachpad plus comma and null
@@ -792,163 +1331,1023 @@ bool SFE_QUAD_Sensors::getSensorReadings(void)
       }
     }
 
-    if (thisSensor->_next == NULL) // Have we reached the end of the sensor list?
+    if (thisSensor->_next == NULL) // Have we reached the end of the sensor list?
+    {
+      if (strlen(readings) > 0) // Delete the final comma
+        memset(&readings[strlen(readings) - 1], 0, 1);
+      keepGoing = false;
+    }
+    else
+      thisSensor = thisSensor->_next; // Point to the next sensor
+  }
+
+  return (true);
+}
+
+bool SFE_QUAD_Sensors::getSensorEvents(void)
+{
+  if (_head == NULL) // If head is NULL no sensors have been found
+  {
+    if (_printDebug)
+      _debugPort->println(F("getSensorEvents: no sensors found!"));
+    return (false);
+  }
+
+  if (events != NULL)
+    delete[] events;    // Delete the old events
+  events = new char[1]; // Initialize events
+  *events = 0;
+
+  SFE_QUAD_Sensor *thisSensor = _head; // Point to the first sensor
+
+  bool keepGoing = true;
+
+  while (keepGoing)
+  {
+    if (thisSensor->_logSense != NULL) // Check if memory has been allocated for _logSense
+    {
+      if (thisSensor->_logSense[0]) // Is logging enabled for this sensor?
+      {
+        // If required, configure the mux port
+        if (thisSensor->_muxAddress >= 0x70)
+        {
+          QWIICMUX *thisMux = new QWIICMUX;
+          if (thisMux == NULL)
+          {
+            if (_printDebug)
+              _debugPort->println(F("getSensorEvents: could not allocate memory for thisMux!"));
+            return (false);
+          }
+          thisMux->begin(thisSensor->_muxAddress, *_i2cPort);
+          thisMux->setPort(thisSensor->_muxPort);
+          delete thisMux;
+        }
+
+        char *event = new char[32];      // Allocate memory to hold each event temporarily
+        char *scratchpad = new char[64]; // Allocate memory to hold the sensor name plus the event
+        if ((event == NULL) || (scratchpad == NULL)) // Did the memory allocation fail?
+        {
+          if (_printDebug)
+            _debugPort->println(F("getSensorEvents: scratchpad memory allocation failed!"));
+          if (event != NULL)
+            delete[] event;
+          if (scratchpad != NULL)
+            delete[] scratchpad;
+          return (false);
+        }
+
+        while (thisSensor->getSensorEvent(thisSensor->_sensorAddress, *_i2cPort, event)) // Collect all the events from this sensor
+        {
+          sprintf(scratchpad, "%s_%d_%d_%d,%s\n", thisSensor->getSensorName(), thisSensor->_sensorAddress,
+                  thisSensor->_muxAddress, thisSensor->_muxPort, event); // Prefix the event with the sensor name
+          size_t eventsLen = strlen(events) + strlen(scratchpad);      // Get the new events length
+          char *newEvents = new char[eventsLen + 1];                   // Allocate memory to hold events plus scratchpad plus null
+          if (newEvents == NULL)                                       // Did the memory allocation fail?
+          {
+            if (_printDebug)
+              _debugPort->println(F("getSensorEvents: newEvents memory allocation failed!"));
+            delete[] event;
+            delete[] scratchpad;
+            return (false);
+          }
+          memset(newEvents, 0, eventsLen + 1);         // Clear the memory to make sure it is null-terminated
+          memcpy(newEvents, events, strlen(events));   // Copy in the existing events
+          strcat(newEvents, scratchpad);               // Append the new event
+          delete[] events;                             // Delete events
+          events = newEvents;                          // Make events point to newEvents
+        }
+
+        delete[] event;
+        delete[] scratchpad;
+      }
+    }
+
+    if (thisSensor->_next == NULL) // Have we reached the end of the sensor list?
+    {
+      if (strlen(events) > 0) // Delete the final newline
+        memset(&events[strlen(events) - 1], 0, 1);
+      keepGoing = false;
+    }
+    else
+      thisSensor = thisSensor->_next; // Point to the next sensor
+  }
+
+  return (true);
+}
+
+bool SFE_QUAD_Sensors::pollSensors(void)
+{
+  if (_head == NULL) // If head is NULL no sensors have been found
+  {
+    if (_printDebug)
+      _debugPort->println(F("pollSensors: no sensors found!"));
+    return (false);
+  }
+
+  SFE_QUAD_Sensor *thisSensor = _head; // Point to the first sensor
+
+  bool keepGoing = true;
+
+  while (keepGoing)
+  {
+    if (thisSensor->_logSense != NULL) // Check if memory has been allocated for _logSense
+    {
+      if ((thisSensor->_logSense[0]) && (thisSensor->pollingEnabled())) // Is logging enabled for this sensor? Does it need polling?
+      {
+        // If required, configure the mux port
+        if (thisSensor->_muxAddress >= 0x70)
+        {
+          QWIICMUX *thisMux = new QWIICMUX;
+          if (thisMux == NULL)
+          {
+            if (_printDebug)
+              _debugPort->println(F("pollSensors: could not allocate memory for thisMux!"));
+            return (false);
+          }
+          thisMux->begin(thisSensor->_muxAddress, *_i2cPort);
+          thisMux->setPort(thisSensor->_muxPort);
+          delete thisMux;
+        }
+
+        thisSensor->pollSensor(thisSensor->_sensorAddress, *_i2cPort);
+      }
+    }
+
+    if (thisSensor->_next == NULL) // Have we reached the end of the sensor list?
+      keepGoing = false;
+    else
+      thisSensor = thisSensor->_next; // Point to the next sensor
+  }
+
+  return (true);
+}
+
+bool SFE_QUAD_Sensors::triggerSensors(void)
+{
+  if (_head == NULL) // If head is NULL no sensors have been found
+  {
+    if (_printDebug)
+      _debugPort->println(F("triggerSensors: no sensors found!"));
+    return (false);
+  }
+
+  // Pass 0 triggers every sensor which supports it. Later passes advance any multi-stage measurements (continueTrigger)
+  // Each pass waits once for the slowest sensor, so the stages of several sensors are interleaved
+  // Only the sensors which report another stage are visited again: single-stage sensors just add their settleMillis to the wait
+  bool anotherPass = true;
+
+  for (uint8_t pass = 0; anotherPass; pass++)
+  {
+    anotherPass = false;
+
+    SFE_QUAD_Sensor *thisSensor = _head; // Point to the first sensor
+
+    unsigned long startTime = millis();
+    unsigned long longestWait = 0; // The longest wait (since startTime) needed by any of the triggered sensors
+
+    bool keepGoing = true;
+
+    while (keepGoing)
+    {
+      if (thisSensor->_logSense != NULL) // Check if memory has been allocated for _logSense
+      {
+        if ((thisSensor->_logSense[0]) && (thisSensor->_readingScheduled) && ((pass == 0) || (thisSensor->_triggerPending))) // Is logging enabled for this sensor? Is it due? Is a measurement in progress?
+        {
+          // If required, configure the mux port
+          if (thisSensor->_muxAddress >= 0x70)
+          {
+            QWIICMUX *thisMux = new QWIICMUX;
+            if (thisMux == NULL)
+            {
+              if (_printDebug)
+                _debugPort->println(F("triggerSensors: could not allocate memory for thisMux!"));
+              return (false);
+            }
+            thisMux->begin(thisSensor->_muxAddress, *_i2cPort);
+            thisMux->setPort(thisSensor->_muxPort);
+            delete thisMux;
+          }
+
+          unsigned long settleMillis = 0;
+          if (pass == 0)
+            thisSensor->_triggerPending = thisSensor->triggerSensor(thisSensor->_sensorAddress, *_i2cPort, &settleMillis);
+          else
+            thisSensor->_triggerPending = thisSensor->continueTrigger(thisSensor->_sensorAddress, *_i2cPort, &settleMillis);
+
+          if (thisSensor->_triggerPending)
+            anotherPass = true;
+
+          if (settleMillis > 0)
+          {
+            unsigned long wait = (millis() - startTime) + settleMillis; // The sensor is ready this long after startTime
+            if (wait > longestWait)
+              longestWait = wait;
+          }
+        }
+      }
+
+      if (thisSensor->_next == NULL) // Have we reached the end of the sensor list?
+        keepGoing = false;
+      else
+        thisSensor = thisSensor->_next; // Point to the next sensor
+    }
+
+    while ((millis() - startTime) < longestWait) // Wait once for the slowest triggered sensor
+      delay(1);
+  }
+
+  return (true);
+}
+
+bool SFE_QUAD_Sensors::compensateSensors(void)
+{
+  SFE_QUAD_Sensor_Compensation_Link *thisLink = _compensationHead; // Point to the first link
+
+  // First, acquire the compensation values from each producer - once only
+  while (thisLink != NULL)
+  {
+    bool acquired = false; // Check if this producer has already been acquired via an earlier link
+    for (SFE_QUAD_Sensor_Compensation_Link *earlierLink = _compensationHead; earlierLink != thisLink; earlierLink = earlierLink->_next)
+      if (earlierLink->_producer == thisLink->_producer)
+        acquired = true;
+
+    if ((!acquired) && (thisLink->_producer->_readingScheduled)) // If the producer is not due, its consumers use the value acquired last time
+    {
+      SFE_QUAD_Sensor *thisSensor = thisLink->_producer;
+
+      // If required, configure the mux port
+      if (thisSensor->_muxAddress >= 0x70)
+      {
+        QWIICMUX *thisMux = new QWIICMUX;
+        if (thisMux == NULL)
+        {
+          if (_printDebug)
+            _debugPort->println(F("compensateSensors: could not allocate memory for thisMux!"));
+          return (false);
+        }
+        thisMux->begin(thisSensor->_muxAddress, *_i2cPort);
+        thisMux->setPort(thisSensor->_muxPort);
+        delete thisMux;
+      }
+
+      if ((!thisSensor->acquireCompensation(thisSensor->_sensorAddress, *_i2cPort)) && (_printDebug))
+      {
+        _debugPort->print(F("compensateSensors: acquireCompensation failed for sensor "));
+        _debugPort->println(thisSensor->getSensorName());
+      }
+    }
+
+    thisLink = thisLink->_next; // Point to the next link
+  }
+
+  // Now pass the values to the consumers. The consumers apply them when they are next read - when the mux port is selected
+  thisLink = _compensationHead;
+
+  while (thisLink != NULL)
+  {
+    float value;
+    if (thisLink->_producer->getCompensation(thisLink->_type, &value))
+      thisLink->_consumer->setCompensation(thisLink->_type, value);
+
+    thisLink = thisLink->_next; // Point to the next link
+  }
+
+  return (true);
+}
+
+bool SFE_QUAD_Sensors::scheduleSensors(void)
+{
+  if (_head == NULL) // If head is NULL no sensors have been found
+  {
+    if (_printDebug)
+      _debugPort->println(F("scheduleSensors: no sensors found!"));
+    return (false);
+  }
+
+  unsigned long now = millis();
+
+  SFE_QUAD_Sensor *thisSensor = _head; // Point to the first sensor
+
+  while (thisSensor != NULL)
+  {
+    if (thisSensor->_readingPeriod == 0) // No reading period. Read the sensor every time
+    {
+      thisSensor->_readingScheduled = true;
+    }
+    else
+    {
+      uint8_t senseCount;
+      thisSensor->getSenseCount(&senseCount);
+
+      if (thisSensor->_lastReadings == NULL) // Allocate memory for the last readings
+      {
+        thisSensor->_lastReadings = new char[senseCount * SFE_QUAD_SENSOR_READING_LEN];
+        if (thisSensor->_lastReadings == NULL)
+        {
+          if (_printDebug)
+            _debugPort->println(F("scheduleSensors: _lastReadings memory allocation failed!"));
+          return (false);
+        }
+        memset(thisSensor->_lastReadings, 0, senseCount * SFE_QUAD_SENSOR_READING_LEN);
+      }
+
+      // The sensor is due if its deadline has passed - or if an enabled sense has no last reading (e.g. it has just been enabled)
+      bool due = ((long)(now - thisSensor->_readingDue) >= 0);
+      for (uint8_t sense = 0; (sense < senseCount) && (!due); sense++)
+        if ((thisSensor->_logSense != NULL) && (thisSensor->_logSense[sense + 1]) && (thisSensor->_lastReadings[sense * SFE_QUAD_SENSOR_READING_LEN] == 0))
+          due = true;
+
+      if (due)
+      {
+        thisSensor->_readingDue += thisSensor->_readingPeriod; // Advance the deadline by one period so the readings do not drift
+        if ((long)(now - thisSensor->_readingDue) >= 0)        // Have we missed one or more deadlines? Don't try to catch up
+          thisSensor->_readingDue = now + thisSensor->_readingPeriod;
+      }
+
+      thisSensor->_readingScheduled = due;
+    }
+
+    thisSensor = thisSensor->_next; // Point to the next sensor
+  }
+
+  return (true);
+}
+
+bool SFE_QUAD_Sensors::getMillisToNextReading(unsigned long *millisToNext)
+{
+  bool found = false;
+  unsigned long now = millis();
+
+  for (SFE_QUAD_Sensor *thisSensor = _head; thisSensor != NULL; thisSensor = thisSensor->_next)
+  {
+    if ((thisSensor->_readingPeriod == 0) || (thisSensor->_logSense == NULL) || (!thisSensor->_logSense[0])) // Ignore sensors without a period, and disabled sensors
+      continue;
+
+    unsigned long wait = 0;
+    if ((long)(thisSensor->_readingDue - now) > 0) // Is the reading due in the future?
+      wait = thisSensor->_readingDue - now;
+
+    if ((!found) || (wait < *millisToNext))
+      *millisToNext = wait;
+    found = true;
+  }
+
+  return (found);
+}
+
+bool SFE_QUAD_Sensors::getSensorNames(void)
+{
+  if (_head == NULL) // If head is NULL no sensors have been found
+  {
+    if (_printDebug)
+      _debugPort->println(F("getSensorNames: no sensors found!"));
+    return (false);
+  }
+
+  if (readings != NULL)
+    delete[] readings;    // Delete the old readings
+  readings = new char[1]; // Initialize readings
+  *readings = 0;
+
+  SFE_QUAD_Sensor *thisSensor = _head; // Point to the first sensor
+
+  bool keepGoing = true;
+
+  while (keepGoing)
+  {
+    if (thisSensor->_logSense != NULL) // Check if memory has been allocated for _logSense
+    {
+      if (thisSensor->_logSense[0]) // Is logging enable for this sensor?
+      {
+        uint8_t senseCount;
+        thisSensor->getSenseCount(&senseCount);
+        for (uint8_t sense = 0; sense < senseCount; sense++)
+        {
+          if (thisSensor->_logSense[sense + 1]) // Is logging enabled for this sense?
+          {
+            // Log this name
+            char *scratchpad = new char[32]; // Allocate memory to hold the sensor name etc. temporarily
+            if (scratchpad == NULL)          // Did the memory allocation fail?
+            {
+              if (_printDebug)
+                _debugPort->println(F("getSensorNames: scratchpad memory allocation failed!"));
+              return (false);
+            }
+            sprintf(scratchpad, "%s_%d_%d_%d,", thisSensor->getSensorName(), thisSensor->_sensorAddress,
+                    thisSensor->_muxAddress, thisSensor->_muxPort); // Get the sensor name. Store it in scratchpad
+            size_t readingsLen = strlen(readings);                  // Get the current readings length
+            readingsLen += strlen(scratchpad);                      // Get the length of the reading
+            char *newReadings = new char[readingsLen + 1];          // Allocate memory to hold readings plus scrtachpad plus comma and null
+            if (newReadings == NULL)                                // Did the memory allocation fail?
+            {
+              if (_printDebug)
+                _debugPort->println(F("getSensorNames: newReadings memory allocation failed!"));
+              delete[] scratchpad; // Delete the scratchpad
+              return (false);
+            }
+            memset(newReadings, 0, readingsLen + 1);         // Clear the memory to make sure it is null-terminated
+            memcpy(newReadings, readings, strlen(readings)); // Copy in the existing readings
+            strcat(newReadings, scratchpad);                 // Append the new reading from scratchpad
+            delete[] readings;                               // Delete readings
+            readings = newReadings;                          // Make readings point to newReadings
+            delete[] scratchpad;                             // Delete the scratchpad
+          }
+        }
+      }
+    }
+
+    if (thisSensor->_next == NULL) // Have we reached the end of the sensor list?
+    {
+      if (strlen(readings) > 0) // Delete the final comma
+        memset(&readings[strlen(readings) - 1], 0, 1);
+      keepGoing = false;
+    }
+    else
+      thisSensor = thisSensor->_next; // Point to the next sensor
+  }
+
+  return (true);
+}
+
+bool SFE_QUAD_Sensors::getSenseNames(void)
+{
+  if (_head == NULL) // If head is NULL no sensors have been found
+  {
+    if (_printDebug)
+      _debugPort->println(F("getSenseNames: no sensors found!"));
+    return (false);
+  }
+
+  if (readings != NULL)
+    delete[] readings;    // Delete the old readings
+  readings = new char[1]; // Initialize readings
+  *readings = 0;
+
+  SFE_QUAD_Sensor *thisSensor = _head; // Point to the first sensor
+
+  bool keepGoing = true;
+
+  while (keepGoing)
+  {
+    if (thisSensor->_logSense != NULL) // Check if memory has been allocated for _logSense
+    {
+      if (thisSensor->_logSense[0]) // Is logging enable for this sensor?
+      {
+        uint8_t senseCount;
+        thisSensor->getSenseCount(&senseCount);
+        for (uint8_t sense = 0; sense < senseCount; sense++)
+        {
+          if (thisSensor->_logSense[sense + 1]) // Is logging enabled for this sense?
+          {
+            // Log this name
+            char *scratchpad = new char[thisSensor->getSenseNameMaxLen() + 2]; // Allocate memory to hold the sense name temporarily
+            if (scratchpad == NULL)                                            // Did the memory allocation fail?
+            {
+              if (_printDebug)
+                _debugPort->println(F("getSenseNames: scratchpad memory allocation failed!"));
+              return (false);
+            }
+            sprintf(scratchpad, "%s,", thisSensor->getSenseName(sense)); // Get the sensor name. Store it in scratchpad
+            size_t readingsLen = strlen(readings);                       // Get the current readings length
+            readingsLen += strlen(scratchpad);                           // Get the length of the reading
+            char *newReadings = new char[readingsLen + 1];               // Allocate memory to hold readings plus scrtachpad plus comma and null
+            if (newReadings == NULL)                                     // Did the memory allocation fail?
+            {
+              if (_printDebug)
+                _debugPort->println(F("getSenseNames: newReadings memory allocation failed!"));
+              delete[] scratchpad; // Delete the scratchpad
+              return (false);
+            }
+            memset(newReadings, 0, readingsLen + 1);         // Clear the memory to make sure it is null-terminated
+            memcpy(newReadings, readings, strlen(readings)); // Copy in the existing readings
+            strcat(newReadings, scratchpad);                 // Append the new reading from scratchpad
+            delete[] readings;                               // Delete readings
+            readings = newReadings;                          // Make readings point to newReadings
+            delete[] scratchpad;                             // Delete the scratchpad
+          }
+        }
+      }
+    }
+
+    if (thisSensor->_next == NULL) // Have we reached the end of the sensor list?
+    {
+      if (strlen(readings) > 0) // Delete the final comma
+        memset(&readings[strlen(readings) - 1], 0, 1);
+      keepGoing = false;
+    }
+    else
+      thisSensor = thisSensor->_next; // Point to the next sensor
+  }
+
+  return (true);
+}
+
+// Return the sensor and sense names (CSV, each followed by CR LF), to be written at the start of each log file.
+// The text is allocated with new[]: the caller must delete[] it. Returns NULL if the memory allocation fails
+char *SFE_QUAD_Sensors::getLogHeader(void)
+{
+  char *sensorNames = NULL;
+  if (getSensorNames())
+  {
+    sensorNames = new char[strlen(readings) + 1];
+    if (sensorNames != NULL)
+      strcpy(sensorNames, readings);
+  }
+  size_t headerLen = 1;
+  if (sensorNames != NULL)
+    headerLen += strlen(sensorNames) + 2;
+  bool haveSenseNames = getSenseNames();
+  if (haveSenseNames)
+    headerLen += strlen(readings) + 2;
+
+  char *header = new char[headerLen];
+  if (header != NULL)
+  {
+    *header = 0;
+    if (sensorNames != NULL)
+    {
+      strcat(header, sensorNames);
+      strcat(header, "\r\n");
+    }
+    if (haveSenseNames)
+    {
+      strcat(header, readings);
+      strcat(header, "\r\n");
+    }
+  }
+  if (sensorNames != NULL)
+    delete[] sensorNames;
+
+  return (header);
+}
+
+void SFE_QUAD_Sensors::setAggregates(uint8_t aggregates)
+{
+  _aggregates = aggregates;
+}
+
+bool SFE_QUAD_Sensors::sampleSensors(void)
+{
+  if (_head == NULL) // If head is NULL no sensors have been found
+  {
+    if (_printDebug)
+      _debugPort->println(F("sampleSensors: no sensors found!"));
+    return (false);
+  }
+
+  if (!scheduleSensors()) // Decide which sensors are due to be read
+    return (false);
+
+  if (!compensateSensors()) // Pass the latest compensation values from the producers to the consumers
+    return (false);
+
+  if (!triggerSensors()) // Trigger any sensors which can share a single conversion wait
+    return (false);
+
+  for (SFE_QUAD_Sensor *thisSensor = _head; thisSensor != NULL; thisSensor = thisSensor->_next)
+  {
+    if ((thisSensor->_logSense == NULL) || (!thisSensor->_logSense[0]) || (!thisSensor->_readingScheduled)) // Is logging enabled for this sensor? Is it due?
+      continue;
+
+    uint8_t senseCount;
+    thisSensor->getSenseCount(&senseCount);
+
+    if (thisSensor->_statistics == NULL) // Allocate memory for the statistics - once only
+    {
+      thisSensor->_statistics = new SFE_QUAD_Sensor::SFE_QUAD_Sense_Statistics_t[senseCount];
+      if (thisSensor->_statistics == NULL)
+      {
+        if (_printDebug)
+          _debugPort->println(F("sampleSensors: _statistics memory allocation failed!"));
+        return (false);
+      }
+      memset(thisSensor->_statistics, 0, senseCount * sizeof(SFE_QUAD_Sensor::SFE_QUAD_Sense_Statistics_t));
+    }
+
+    // If required, configure the mux port
+    if (thisSensor->_muxAddress >= 0x70)
+    {
+      QWIICMUX *thisMux = new QWIICMUX;
+      if (thisMux == NULL)
+      {
+        if (_printDebug)
+          _debugPort->println(F("sampleSensors: could not allocate memory for thisMux!"));
+        return (false);
+      }
+      thisMux->begin(thisSensor->_muxAddress, *_i2cPort);
+      thisMux->setPort(thisSensor->_muxPort);
+      delete thisMux;
+    }
+
+    for (uint8_t sense = 0; sense < senseCount; sense++)
+    {
+      if (!thisSensor->_logSense[sense + 1]) // Is logging enabled for this sense?
+        continue;
+
+      char scratchpad[SFE_QUAD_SENSOR_READING_LEN];
+      double value;
+      bool numeric = readSense(thisSensor, sense, scratchpad, &value); // Get the reading. The text is only needed for _lastReadings
+      if (thisSensor->_lastReadings != NULL)                           // Keep a copy if the sensor has a reading period
+      {
+        char *lastReading = &thisSensor->_lastReadings[sense * SFE_QUAD_SENSOR_READING_LEN];
+        size_t readingLen = strlen(scratchpad);
+        if (readingLen > SFE_QUAD_SENSOR_READING_LEN - 1)
+          readingLen = SFE_QUAD_SENSOR_READING_LEN - 1;
+        memcpy(lastReading, scratchpad, readingLen);
+        lastReading[readingLen] = 0;
+      }
+
+      if (!numeric) // Ignore readings which are not numeric
+        continue;
+
+      // Welford's method: update the mean and the sum of squared differences without storing the samples
+      SFE_QUAD_Sensor::SFE_QUAD_Sense_Statistics_t *stats = &thisSensor->_statistics[sense];
+      stats->count++;
+      double delta = value - stats->mean;
+      stats->mean += delta / (double)stats->count;
+      stats->m2 += delta * (value - stats->mean);
+      if ((stats->count == 1) || (value < stats->min))
+        stats->min = value;
+      if ((stats->count == 1) || (value > stats->max))
+        stats->max = value;
+    }
+  }
+
+  return (true);
+}
+
+bool SFE_QUAD_Sensors::getAggregatedReadings(void)
+{
+  if (_head == NULL) // If head is NULL no sensors have been found
+  {
+    if (_printDebug)
+      _debugPort->println(F("getAggregatedReadings: no sensors found!"));
+    return (false);
+  }
+
+  if (readings != NULL)
+    delete[] readings;    // Delete the old readings
+  readings = new char[1]; // Initialize readings
+  *readings = 0;
+
+  bool firstColumn = true;
+
+  for (SFE_QUAD_Sensor *thisSensor = _head; thisSensor != NULL; thisSensor = thisSensor->_next)
+  {
+    if ((thisSensor->_logSense == NULL) || (!thisSensor->_logSense[0])) // Is logging enabled for this sensor?
+      continue;
+
+    uint8_t senseCount;
+    thisSensor->getSenseCount(&senseCount);
+
+    for (uint8_t sense = 0; sense < senseCount; sense++)
+    {
+      if (!thisSensor->_logSense[sense + 1]) // Is logging enabled for this sense?
+        continue;
+
+      SFE_QUAD_Sensor::SFE_QUAD_Sense_Statistics_t empty;
+      memset(&empty, 0, sizeof(empty));
+      SFE_QUAD_Sensor::SFE_QUAD_Sense_Statistics_t *stats = (thisSensor->_statistics == NULL) ? &empty : &thisSensor->_statistics[sense];
+
+      for (uint8_t aggregate = SFE_QUAD_AGGREGATE_MEAN; aggregate <= SFE_QUAD_AGGREGATE_COUNT; aggregate <<= 1)
+      {
+        if ((_aggregates & aggregate) == 0)
+          continue;
+
+        // The statistic is left empty if there were no numeric samples
+        char column[SFE_QUAD_SENSOR_READING_LEN + 16]; // Allow for large values: _dtostrf does not use exponent format
+        char *ptr = column;
+        if (!firstColumn)
+          *ptr++ = ',';
+        *ptr = 0;
+        firstColumn = false;
+
+        if (aggregate == SFE_QUAD_AGGREGATE_COUNT)
+          sprintf(ptr, "%lu", (unsigned long)stats->count);
+        else if (stats->count > 0)
+        {
+          if (aggregate == SFE_QUAD_AGGREGATE_MEAN)
+            _sprintf._dtostrf(stats->mean, ptr);
+          else if (aggregate == SFE_QUAD_AGGREGATE_MIN)
+            _sprintf._dtostrf(stats->min, ptr);
+          else if (aggregate == SFE_QUAD_AGGREGATE_MAX)
+            _sprintf._dtostrf(stats->max, ptr);
+          else if (aggregate == SFE_QUAD_AGGREGATE_STDDEV)
+            _sprintf._dtostrf((stats->count > 1) ? sqrt(stats->m2 / (double)(stats->count - 1)) : 0.0, ptr);
+        }
+
+        if (!appendToReadings(column))
+          return (false);
+      }
+    }
+
+    if (thisSensor->_statistics != NULL) // Restart the statistics for the next interval
+      memset(thisSensor->_statistics, 0, senseCount * sizeof(SFE_QUAD_Sensor::SFE_QUAD_Sense_Statistics_t));
+  }
+
+  return (true);
+}
+
+bool SFE_QUAD_Sensors::getAggregatedSenseNames(void)
+{
+  if (_head == NULL) // If head is NULL no sensors have been found
+  {
+    if (_printDebug)
+      _debugPort->println(F("getAggregatedSenseNames: no sensors found!"));
+    return (false);
+  }
+
+  if (readings != NULL)
+    delete[] readings;    // Delete the old readings
+  readings = new char[1]; // Initialize readings
+  *readings = 0;
+
+  bool firstColumn = true;
+
+  for (SFE_QUAD_Sensor *thisSensor = _head; thisSensor != NULL; thisSensor = thisSensor->_next)
+  {
+    if ((thisSensor->_logSense == NULL) || (!thisSensor->_logSense[0])) // Is logging enabled for this sensor?
+      continue;
+
+    uint8_t senseCount;
+    thisSensor->getSenseCount(&senseCount);
+
+    for (uint8_t sense = 0; sense < senseCount; sense++)
+    {
+      if (!thisSensor->_logSense[sense + 1]) // Is logging enabled for this sense?
+        continue;
+
+      for (uint8_t aggregate = SFE_QUAD_AGGREGATE_MEAN; aggregate <= SFE_QUAD_AGGREGATE_COUNT; aggregate <<= 1)
+      {
+        if ((_aggregates & aggregate) == 0)
+          continue;
+
+        if ((!firstColumn) && (!appendToReadings(",")))
+          return (false);
+        firstColumn = false;
+
+        if (!appendToReadings(thisSensor->getSenseName(sense)))
+          return (false);
+
+        const char *suffix;
+        if (aggregate == SFE_QUAD_AGGREGATE_MEAN)
+          suffix = " mean";
+        else if (aggregate == SFE_QUAD_AGGREGATE_MIN)
+          suffix = " min";
+        else if (aggregate == SFE_QUAD_AGGREGATE_MAX)
+          suffix = " max";
+        else if (aggregate == SFE_QUAD_AGGREGATE_STDDEV)
+          suffix = " stddev";
+        else
+          suffix = " count";
+
+        if (!appendToReadings(suffix))
+          return (false);
+      }
+    }
+  }
+
+  return (true);
+}
+
+bool SFE_QUAD_Sensors::setDeadband(uint8_t sense, float threshold, bool relative, const char *sensorName, uint8_t i2cAddress, uint8_t muxAddress, uint8_t muxPort)
+{
+  SFE_QUAD_Sensor *theSensor = sensorExists(sensorName, i2cAddress, muxAddress, muxPort);
+
+  if (theSensor == NULL)
+    return (false);
+
+  uint8_t senseCount;
+  theSensor->getSenseCount(&senseCount);
+  if (sense >= senseCount)
+    return (false);
+
+  if (theSensor->_deadband == NULL) // Allocate memory for the deadbands - once only
+  {
+    theSensor->_deadband = new SFE_QUAD_Sensor::SFE_QUAD_Sense_Deadband_t[senseCount];
+    if (theSensor->_deadband == NULL)
     {
-      if (strlen(readings) > 0) // Delete the final comma
-        memset(&readings[strlen(readings) - 1], 0, 1);
-      keepGoing = false;
+      if (_printDebug)
+        _debugPort->println(F("setDeadband: _deadband memory allocation failed!"));
+      return (false);
     }
-    else
-      thisSensor = thisSensor->_next; // Point to the next sensor
+    memset(theSensor->_deadband, 0, senseCount * sizeof(SFE_QUAD_Sensor::SFE_QUAD_Sense_Deadband_t));
   }
 
+  theSensor->_deadband[sense].threshold = (threshold < 0.0) ? -threshold : threshold;
+  theSensor->_deadband[sense].relative = relative;
+
   return (true);
 }
 
-bool SFE_QUAD_Sensors::getSensorNames(void)
+bool SFE_QUAD_Sensors::setDeadband(uint8_t sense, float threshold, bool relative, const char *sensorName)
 {
   if (_head == NULL) // If head is NULL no sensors have been found
   {
     if (_printDebug)
-      _debugPort->println(F("getSensorNames: no sensors found!"));
+      _debugPort->println(F("setDeadband: no sensors found!"));
     return (false);
   }
 
-  if (readings != NULL)
-    delete[] readings;    // Delete the old readings
-  readings = new char[1]; // Initialize readings
-  *readings = 0;
+  for (SFE_QUAD_Sensor *thisSensor = _head; thisSensor != NULL; thisSensor = thisSensor->_next)
+    setDeadband(sense, threshold, relative, sensorName, thisSensor->_sensorAddress, thisSensor->_muxAddress, thisSensor->_muxPort);
 
-  SFE_QUAD_Sensor *thisSensor = _head; // Point to the first sensor
+  return (true);
+}
 
-  bool keepGoing = true;
+void SFE_QUAD_Sensors::setHeartbeat(unsigned long heartbeatMillis)
+{
+  _heartbeatMillis = heartbeatMillis;
+}
 
-  while (keepGoing)
+void SFE_QUAD_Sensors::setDeltaRecords(bool enable)
+{
+  _deltaRecords = enable;
+}
+
+bool SFE_QUAD_Sensors::checkDeadband(void)
+{
+  unsigned long now = millis();
+
+  bool fullRow = !_rowLogged; // Always log the first row in full
+  bool logThisRow = false;
+  bool deadbandFound = false;
+
+  if ((_heartbeatMillis > 0) && ((now - _lastLoggedMillis) >= _heartbeatMillis)) // Has the heartbeat expired?
+    fullRow = true;
+
+  for (SFE_QUAD_Sensor *thisSensor = _head; thisSensor != NULL; thisSensor = thisSensor->_next)
   {
-    if (thisSensor->_logSense != NULL) // Check if memory has been allocated for _logSense
+    if ((thisSensor->_deadband == NULL) || (thisSensor->_logSense == NULL) || (!thisSensor->_logSense[0])) // Does this sensor have deadbands? Is logging enabled?
+      continue;
+
+    uint8_t senseCount;
+    thisSensor->getSenseCount(&senseCount);
+    for (uint8_t sense = 0; sense < senseCount; sense++)
     {
-      if (thisSensor->_logSense[0]) // Is logging enable for this sensor?
+      SFE_QUAD_Sensor::SFE_QUAD_Sense_Deadband_t *deadband = &thisSensor->_deadband[sense];
+      deadband->changed = false;
+      if ((!thisSensor->_logSense[sense + 1]) || (deadband->threshold == 0.0) || (!deadband->currentValid))
+        continue;
+
+      deadbandFound = true;
+
+      if (!deadband->loggedValid)
       {
-        uint8_t senseCount;
-        thisSensor->getSenseCount(&senseCount);
-        for (uint8_t sense = 0; sense < senseCount; sense++)
-        {
-          if (thisSensor->_logSense[sense + 1]) // Is logging enabled for this sense?
-          {
-            // Log this name
-            char *scratchpad = new char[32]; // Allocate memory to hold the sensor name etc. temporarily
-            if (scratchpad == NULL)          // Did the memory allocation fail?
-            {
-              if (_printDebug)
-                _debugPort->println(F("getSensorNames: scratchpad memory allocation failed!"));
-              return (false);
-            }
-            sprintf(scratchpad, "%s_%d_%d_%d,", thisSensor->getSensorName(), thisSensor->_sensorAddress,
-                    thisSensor->_muxAddress, thisSensor->_muxPort); // Get the sensor name. Store it in scratchpad
-            size_t readingsLen = strlen(readings);                  // Get the current readings length
-            readingsLen += strlen(scratchpad);                      // Get the length of the reading
-            char *newReadings = new char[readingsLen + 1];          // Allocate memory to hold readings plus scrtachpad plus comma and null
-            if (newReadings == NULL)                                // Did the memory allocation fail?
-            {
-              if (_printDebug)
-                _debugPort->println(F("getSensorNames: newReadings memory allocation failed!"));
-              delete[] scratchpad; // Delete the scratchpad
-              return (false);
-            }
-            memset(newReadings, 0, readingsLen + 1);         // Clear the memory to make sure it is null-terminated
-            memcpy(newReadings, readings, strlen(readings)); // Copy in the existing readings
-            strcat(newReadings, scratchpad);                 // Append the new reading from scratchpad
-            delete[] readings;                               // Delete readings
-            readings = newReadings;                          // Make readings point to newReadings
-            delete[] scratchpad;                             // Delete the scratchpad
-          }
-        }
+        deadband->changed = true;
+        continue;
       }
+
+      double limit = deadband->threshold;
+      if (deadband->relative)
+        limit = limit * fabs(deadband->logged) / 100.0;
+
+      if (fabs(deadband->current - deadband->logged) > limit) // Has the sense crossed its deadband?
+        deadband->changed = true;
     }
+  }
 
-    if (thisSensor->_next == NULL) // Have we reached the end of the sensor list?
+  if (!deadbandFound) // No deadbands have been set. Log every row
+    fullRow = true;
+
+  for (SFE_QUAD_Sensor *thisSensor = _head; (thisSensor != NULL) && (!logThisRow); thisSensor = thisSensor->_next)
+  {
+    if ((thisSensor->_deadband == NULL) || (thisSensor->_logSense == NULL) || (!thisSensor->_logSense[0]))
+      continue;
+
+    uint8_t senseCount;
+    thisSensor->getSenseCount(&senseCount);
+    for (uint8_t sense = 0; sense < senseCount; sense++)
+      if (thisSensor->_deadband[sense].changed)
+        logThisRow = true;
+  }
+
+  bool deltaRecord = false;
+  if (fullRow)
+    logThisRow = true;
+  else if (logThisRow && _deltaRecords)
+    deltaRecord = makeDeltaRecord(); // Only some senses have changed. Log just those. readings keeps the full row if this fails
+
+  if (logThisRow) // Record what was logged. The deadbands are measured from these values
+  {
+    _rowLogged = true;
+    _lastLoggedMillis = now;
+
+    for (SFE_QUAD_Sensor *thisSensor = _head; thisSensor != NULL; thisSensor = thisSensor->_next)
     {
-      if (strlen(readings) > 0) // Delete the final comma
-        memset(&readings[strlen(readings) - 1], 0, 1);
-      keepGoing = false;
+      if (thisSensor->_deadband == NULL)
+        continue;
+
+      uint8_t senseCount;
+      thisSensor->getSenseCount(&senseCount);
+      for (uint8_t sense = 0; sense < senseCount; sense++)
+      {
+        if (deltaRecord && (!thisSensor->_deadband[sense].changed)) // A delta record only moves the senses it contains
+          continue;
+        thisSensor->_deadband[sense].logged = thisSensor->_deadband[sense].current;
+        thisSensor->_deadband[sense].loggedValid = thisSensor->_deadband[sense].currentValid;
+      }
     }
-    else
-      thisSensor = thisSensor->_next; // Point to the next sensor
   }
 
-  return (true);
+  return (logThisRow);
 }
 
-bool SFE_QUAD_Sensors::getSenseNames(void)
+// Helper function for checkDeadband. Replace the full row in readings with a delta record: "column:reading" for each sense
+// which has crossed its deadband, separated by commas. column is the position of the reading in the full row (0 is the first)
+bool SFE_QUAD_Sensors::makeDeltaRecord(void)
 {
-  if (_head == NULL) // If head is NULL no sensors have been found
+  char *fullRow = readings;
+  readings = new char[1]; // Initialize readings
+  if (readings == NULL)
   {
     if (_printDebug)
-      _debugPort->println(F("getSenseNames: no sensors found!"));
+      _debugPort->println(F("makeDeltaRecord: readings memory allocation failed!"));
+    readings = fullRow;
     return (false);
   }
-
-  if (readings != NULL)
-    delete[] readings;    // Delete the old readings
-  readings = new char[1]; // Initialize readings
   *readings = 0;
 
-  SFE_QUAD_Sensor *thisSensor = _head; // Point to the first sensor
-
-  bool keepGoing = true;
+  const char *reading = fullRow; // Walk the full row one reading at a time, in the same order as getSensorReadings
+  uint16_t column = 0;
+  bool result = true;
 
-  while (keepGoing)
+  for (SFE_QUAD_Sensor *thisSensor = _head; (thisSensor != NULL) && (*reading != 0) && result; thisSensor = thisSensor->_next)
   {
-    if (thisSensor->_logSense != NULL) // Check if memory has been allocated for _logSense
+    if ((thisSensor->_logSense == NULL) || (!thisSensor->_logSense[0])) // Is logging enabled for this sensor?
+      continue;
+
+    uint8_t senseCount;
+    thisSensor->getSenseCount(&senseCount);
+    for (uint8_t sense = 0; (sense < senseCount) && (*reading != 0) && result; sense++)
     {
-      if (thisSensor->_logSense[0]) // Is logging enable for this sensor?
+      if (!thisSensor->_logSense[sense + 1]) // Is logging enabled for this sense?
+        continue;
+
+      const char *nextReading = strchr(reading, ',');
+      size_t readingLen = (nextReading == NULL) ? strlen(reading) : (size_t)(nextReading - reading);
+      nextReading = (nextReading == NULL) ? &reading[readingLen] : nextReading + 1; // Point to the start of the next reading (or the NULL)
+
+      if ((thisSensor->_deadband != NULL) && (thisSensor->_deadband[sense].changed))
       {
-        uint8_t senseCount;
-        thisSensor->getSenseCount(&senseCount);
-        for (uint8_t sense = 0; sense < senseCount; sense++)
-        {
-          if (thisSensor->_logSense[sense + 1]) // Is logging enabled for this sense?
-          {
-            // Log this name
-            char *scratchpad = new char[thisSensor->getSenseNameMaxLen() + 2]; // Allocate memory to hold the sense name temporarily
-            if (scratchpad == NULL)                                            // Did the memory allocation fail?
-            {
-              if (_printDebug)
-                _debugPort->println(F("getSenseNames: scratchpad memory allocation failed!"));
-              return (false);
-            }
-            sprintf(scratchpad, "%s,", thisSensor->getSenseName(sense)); // Get the sensor name. Store it in scratchpad
-            size_t readingsLen = strlen(readings);                       // Get the current readings length
-            readingsLen += strlen(scratchpad);                           // Get the length of the reading
-            char *newReadings = new char[readingsLen + 1];               // Allocate memory to hold readings plus scrtachpad plus comma and null
-            if (newReadings == NULL)                                     // Did the memory allocation fail?
-            {
-              if (_printDebug)
-                _debugPort->println(F("getSenseNames: newReadings memory allocation failed!"));
-              delete[] scratchpad; // Delete the scratchpad
-              return (false);
-            }
-            memset(newReadings, 0, readingsLen + 1);         // Clear the memory to make sure it is null-terminated
-            memcpy(newReadings, readings, strlen(readings)); // Copy in the existing readings
-            strcat(newReadings, scratchpad);                 // Append the new reading from scratchpad
-            delete[] readings;                               // Delete readings
-            readings = newReadings;                          // Make readings point to newReadings
-            delete[] scratchpad;                             // Delete the scratchpad
-          }
-        }
+        char scratchpad[SFE_QUAD_SENSOR_READING_LEN + 8];
+        if (readingLen >= SFE_QUAD_SENSOR_READING_LEN)
+          readingLen = SFE_QUAD_SENSOR_READING_LEN - 1;
+        sprintf(scratchpad, "%s%u:", (strlen(readings) > 0) ? "," : "", column);
+        strncat(scratchpad, reading, readingLen);
+        result = appendToReadings(scratchpad);
       }
-    }
 
-    if (thisSensor->_next == NULL) // Have we reached the end of the sensor list?
-    {
-      if (strlen(readings) > 0) // Delete the final comma
-        memset(&readings[strlen(readings) - 1], 0, 1);
-      keepGoing = false;
+      reading = nextReading;
+      column++;
     }
-    else
-      thisSensor = thisSensor->_next; // Point to the next sensor
   }
 
+  if (!result) // Restore the full row
+  {
+    delete[] readings;
+    readings = fullRow;
+    return (false);
+  }
+
+  delete[] fullRow;
+  return (true);
+}
+
+// Helper function for getSensorReadings and sampleSensors. Read one sense as a number and convert it to text.
+// Sensors which only provide getSenseReading are read as text and the number is parsed from it.
+// Returns true if value holds a numeric reading
+bool SFE_QUAD_Sensors::readSense(SFE_QUAD_Sensor *sensor, uint8_t sense, char *reading, double *value)
+{
+  if (sensor->getSenseValue(sense, value))
+  {
+    if (!sensor->formatSenseValue(sense, *value, reading))
+      sensor->_sprintf._dtostrf(*value, reading);
+    return (true);
+  }
+
+  *reading = 0;
+  sensor->getSenseReading(sense, reading);
+  char *end;
+  *value = strtod(reading, &end);
+  return (end != reading);
+}
+
+bool SFE_QUAD_Sensors::appendToReadings(const char *str)
+{
+  size_t readingsLen = strlen(readings) + strlen(str); // Get the new readings length
+  char *newReadings = new char[readingsLen + 1];       // Allocate memory to hold readings plus str plus a null
+  if (newReadings == NULL)                             // Did the memory allocation fail?
+  {
+    if (_printDebug)
+      _debugPort->println(F("appendToReadings: newReadings memory allocation failed!"));
+    return (false);
+  }
+  memset(newReadings, 0, readingsLen + 1);         // Clear the memory to make sure it is null-terminated
+  memcpy(newReadings, readings, strlen(readings)); // Copy in the existing readings
+  strcat(newReadings, str);                        // Append str
+  delete[] readings;                               // Delete readings
+  readings = newReadings;                          // Make readings point to newReadings
   return (true);
 }
 
@@ -981,6 +2380,126 @@ SFE_QUAD_Sensor *SFE_QUAD_Sensors::sensorExists(const char *sensorName, uint8_t
   return (NULL);
 }
 
+bool SFE_QUAD_Sensors::addCompensationLink(SFE_QUAD_Sensor *producer, SFE_QUAD_Sensor *consumer, SFE_QUAD_Sensor::SFE_QUAD_Sensor_Compensation_Type_e type)
+{
+  if ((producer == NULL) || (consumer == NULL))
+  {
+    if (_printDebug)
+      _debugPort->println(F("addCompensationLink: producer or consumer is NULL!"));
+    return (false);
+  }
+
+  if ((!producer->producesCompensation(type)) || (!consumer->consumesCompensation(type)))
+  {
+    if (_printDebug)
+      _debugPort->println(F("addCompensationLink: producer or consumer does not support this compensation type!"));
+    return (false);
+  }
+
+  // Each consumer input can only have one producer. Check if a link already exists
+  SFE_QUAD_Sensor_Compensation_Link *thisLink = _compensationHead;
+  SFE_QUAD_Sensor_Compensation_Link *lastLink = NULL;
+
+  while (thisLink != NULL)
+  {
+    if ((thisLink->_consumer == consumer) && (thisLink->_type == type))
+    {
+      thisLink->_producer = producer; // Replace the producer
+      return (true);
+    }
+    lastLink = thisLink;
+    thisLink = thisLink->_next;
+  }
+
+  SFE_QUAD_Sensor_Compensation_Link *newLink = new SFE_QUAD_Sensor_Compensation_Link;
+  if (newLink == NULL)
+  {
+    if (_printDebug)
+      _debugPort->println(F("addCompensationLink: could not allocate memory for newLink!"));
+    return (false);
+  }
+
+  newLink->_producer = producer;
+  newLink->_consumer = consumer;
+  newLink->_type = type;
+  newLink->_next = NULL;
+
+  if (lastLink == NULL) // Is this the first link?
+    _compensationHead = newLink;
+  else
+    lastLink->_next = newLink; // Add the new link to the end of the list
+
+  return (true);
+}
+
+bool SFE_QUAD_Sensors::autoWireCompensation(void)
+{
+  if (_head == NULL) // If head is NULL no sensors have been found
+  {
+    if (_printDebug)
+      _debugPort->println(F("autoWireCompensation: no sensors found!"));
+    return (false);
+  }
+
+  for (SFE_QUAD_Sensor *consumer = _head; consumer != NULL; consumer = consumer->_next)
+  {
+    for (int type = 0; type < (int)SFE_QUAD_Sensor::SFE_QUAD_COMPENSATION_UNKNOWN; type++)
+    {
+      SFE_QUAD_Sensor::SFE_QUAD_Sensor_Compensation_Type_e thisType = (SFE_QUAD_Sensor::SFE_QUAD_Sensor_Compensation_Type_e)type;
+
+      if (!consumer->consumesCompensation(thisType))
+        continue;
+
+      bool linked = false; // Don't replace any link added manually with addCompensationLink
+      for (SFE_QUAD_Sensor_Compensation_Link *thisLink = _compensationHead; thisLink != NULL; thisLink = thisLink->_next)
+        if ((thisLink->_consumer == consumer) && (thisLink->_type == thisType))
+          linked = true;
+      if (linked)
+        continue;
+
+      // Look for a producer on the same mux port first, then on the main branch
+      SFE_QUAD_Sensor *onPort = NULL;
+      SFE_QUAD_Sensor *onMain = NULL;
+      for (SFE_QUAD_Sensor *producer = _head; producer != NULL; producer = producer->_next)
+      {
+        if ((producer == consumer) || (!producer->producesCompensation(thisType)))
+          continue;
+        if ((onPort == NULL) && (producer->_muxAddress == consumer->_muxAddress) && (producer->_muxPort == consumer->_muxPort))
+          onPort = producer;
+        if ((onMain == NULL) && (producer->_muxAddress < 0x70))
+          onMain = producer;
+      }
+
+      SFE_QUAD_Sensor *producer = (onPort != NULL) ? onPort : onMain;
+      if (producer != NULL)
+      {
+        if (!addCompensationLink(producer, consumer, thisType))
+          return (false);
+
+        if (_printDebug)
+        {
+          _debugPort->print(F("autoWireCompensation: linked "));
+          _debugPort->print(producer->getSensorName());
+          _debugPort->print(F(" to "));
+          _debugPort->println(consumer->getSensorName());
+        }
+      }
+    }
+  }
+
+  return (true);
+}
+
+void SFE_QUAD_Sensors::clearCompensationLinks(void)
+{
+  while (_compensationHead != NULL)
+  {
+    SFE_QUAD_Sensor_Compensation_Link *nextLink = _compensationHead->_next;
+    delete _compensationHead;
+    _compensationHead = nextLink;
+  }
+}
+
 bool SFE_QUAD_Sensors::loggingMenu(void)
 {
   if (_menuPort == NULL)
@@ -1184,46 +2703,44 @@ bool SFE_QUAD_Sensors::settingMenu(void)
     while (keepGoing)
     {
       uint8_t settingCount;
-      thisSensor->getSettingCount(&settingCount);
+      if (!thisSensor->getSettingCount(&settingCount))
+        settingCount = 0;
 
-      if (settingCount > 0)
-      {
-        _menuPort->print(F("Sensor "));
-        _menuPort->print(thisSensor->getSensorName());
-        _menuPort->print(F(" at address 0x"));
-        _menuPort->print(thisSensor->_sensorAddress, HEX);
+      // Every sensor has at least one setting: its reading period
+      _menuPort->print(F("Sensor "));
+      _menuPort->print(thisSensor->getSensorName());
+      _menuPort->print(F(" at address 0x"));
+      _menuPort->print(thisSensor->_sensorAddress, HEX);
 
-        if (thisSensor->_muxAddress >= 0x70)
-        {
-          _menuPort->print(F(", mux address 0x"));
-          _menuPort->print(thisSensor->_muxAddress, HEX);
-          _menuPort->print(F(" port "));
-          _menuPort->println(thisSensor->_muxPort);
-        }
-        else
-          _menuPort->println();
+      if (thisSensor->_muxAddress >= 0x70)
+      {
+        _menuPort->print(F(", mux address 0x"));
+        _menuPort->print(thisSensor->_muxAddress, HEX);
+        _menuPort->print(F(" port "));
+        _menuPort->println(thisSensor->_muxPort);
+      }
+      else
+        _menuPort->println();
 
-        for (uint8_t setting = 0; setting < settingCount; setting++)
-        {
-          _menuPort->print(menuItems);
-          _menuPort->print(F("\t: "));
-          _menuPort->println(thisSensor->getSettingName(setting));
-          menuItems++;
-        }
+      for (uint8_t setting = 0; setting < settingCount; setting++)
+      {
+        _menuPort->print(menuItems);
+        _menuPort->print(F("\t: "));
+        _menuPort->println(thisSensor->getSettingName(setting));
+        menuItems++;
       }
 
+      _menuPort->print(menuItems);
+      _menuPort->print(F("\t: Reading Period (ms) : "));
+      _menuPort->println(thisSensor->_readingPeriod);
+      menuItems++;
+
       if (thisSensor->_next == NULL) // Have we reached the end of the sensor list?
         keepGoing = false;
       else
         thisSensor = thisSensor->_next; // Point to the next sensor
     }
 
-    if (menuItems == 1)
-    {
-      _menuPort->println(F("settingMenu: the connected sensors have no settings! Exiting..."));
-      return (false);
-    }
-
     _menuPort->println(F("Enter a number to change the setting, or enter 0 to exit:"));
 
     uint32_t menuChoice = getMenuChoice(10000UL); // Get menu choice. Timeout after 10 seconds
@@ -1357,6 +2874,24 @@ bool SFE_QUAD_Sensors::settingMenu(void)
         }
       }
 
+      // The reading period follows the sensor's own settings
+      if (menuChoice == menuItems)
+      {
+        _menuPort->println(F("Enter the reading period in ms. 0 reads the sensor every time (or wait 10 seconds to abort): "));
+        double period;
+        result = getSettingValueDouble(&period, 10000UL); // Get setting value. Timeout after 10 seconds
+        if (result)
+          result = (period >= 0.0) && (period <= 4294967295.0);
+        if (result)
+          result = setReadingPeriod((unsigned long)period, thisSensor->getSensorName(), thisSensor->_sensorAddress, thisSensor->_muxAddress, thisSensor->_muxPort);
+        if (result)
+          _menuPort->println(F("Reading Period (ms) was successful"));
+        else
+          _menuPort->println(F("Reading Period (ms) failed!"));
+        keepGoing = false;
+      }
+      menuItems++;
+
       if (thisSensor->_next == NULL) // Have we reached the end of the sensor list?
         keepGoing = false;
       else
@@ -1504,7 +3039,7 @@ bool SFE_QUAD_Sensors::getSensorAndMenuConfiguration(void)
       // First, record the logging settings
       uint8_t senseCount;
       thisSensor->getSenseCount(&senseCount);
-      char loggingStr[strlen(thisSensor->getSensorName()) + 32 + (senseCount * 2)]; // TODO: find a better way to do this!
+      char loggingStr[(strlen(thisSensor->getSensorName()) * 3) + 96 + (senseCount * (SFE_QUAD_SENSOR_READING_LEN + 2))]; // TODO: find a better way to do this!
       // Use -1 to indicate that these are the logging settings, not a configuration item
       sprintf(loggingStr, "%s,%d,%d,%d,-1,", thisSensor->getSensorName(), thisSensor->_sensorAddress, thisSensor->_muxAddress, thisSensor->_muxPort);
       for (uint8_t sense = 0; sense <= senseCount; sense++)
@@ -1515,6 +3050,31 @@ bool SFE_QUAD_Sensors::getSensorAndMenuConfiguration(void)
           strcat(loggingStr, "1");
       }
       strcat(loggingStr, "\r\n");
+      // Use -2 to indicate that this is the reading period
+      sprintf(&loggingStr[strlen(loggingStr)], "%s,%d,%d,%d,-2,%lu\r\n", thisSensor->getSensorName(), thisSensor->_sensorAddress, thisSensor->_muxAddress, thisSensor->_muxPort, thisSensor->_readingPeriod);
+      // Use -3 to indicate that these are the deadbands (if any): one per sense, separated by semicolons. A trailing % indicates relative
+      if (thisSensor->_deadband != NULL)
+      {
+        sprintf(&loggingStr[strlen(loggingStr)], "%s,%d,%d,%d,-3,", thisSensor->getSensorName(), thisSensor->_sensorAddress, thisSensor->_muxAddress, thisSensor->_muxPort);
+        uint8_t lastSense = 0; // Stop after the last non-zero deadband to keep the line short
+        for (uint8_t sense = 0; sense < senseCount; sense++)
+          if (thisSensor->_deadband[sense].threshold != 0.0)
+            lastSense = sense;
+        for (uint8_t sense = 0; sense <= lastSense; sense++)
+        {
+          if (sense > 0)
+            strcat(loggingStr, ";");
+          if (thisSensor->_deadband[sense].threshold == 0.0)
+            strcat(loggingStr, "0");
+          else
+          {
+            char *ptr = _sprintf._dtostrf(thisSensor->_deadband[sense].threshold, &loggingStr[strlen(loggingStr)]);
+            if (thisSensor->_deadband[sense].relative)
+              strcpy(ptr, "%");
+          }
+        }
+        strcat(loggingStr, "\r\n");
+      }
 
       if (_printDebug)
       {
@@ -1794,7 +3354,7 @@ bool SFE_QUAD_Sensors::applySensorAndMenuConfiguration(void)
   while (line != NULL)
   {
     char sensorName[64];      // TODO: find a better way to determine the maximum name length
-    char configItemValue[64]; // TODO: find a better way to determine the maximum value length
+    char configItemValue[strlen(line) + 1]; // The value can't be longer than the line. The deadbands (-3) can be long (e.g. GNSS)
     int sensorAddress, muxAddress, muxPort, configItem;
 
     int scanNum = sscanf(line, "%[^,],%d,%d,%d,%d,%[^,]\r",
@@ -1849,6 +3409,30 @@ bool SFE_QUAD_Sensors::applySensorAndMenuConfiguration(void)
           if (_printDebug)
             _debugPort->println(F("applySensorAndMenuConfiguration: using logging settings"));
         }
+        else if (configItem == -2) // Is this the reading period?
+        {
+          setReadingPeriod(strtoul(configItemValue, NULL, 10), sensorName, sensorAddress, muxAddress, muxPort);
+          if (_printDebug)
+            _debugPort->println(F("applySensorAndMenuConfiguration: using reading period"));
+        }
+        else if (configItem == -3) // Are these the deadbands?
+        {
+          char *ptr = configItemValue;
+          for (uint8_t sense = 0; (*ptr != 0) && (*ptr != '\r'); sense++)
+          {
+            float threshold = (float)strtod(ptr, &ptr);
+            bool relative = (*ptr == '%');
+            if (relative)
+              ptr++;
+            setDeadband(sense, threshold, relative, sensorName, sensorAddress, muxAddress, muxPort);
+            if (*ptr == ';')
+              ptr++;
+            else
+              break;
+          }
+          if (_printDebug)
+            _debugPort->println(F("applySensorAndMenuConfiguration: using deadbands"));
+        }
         else
         {
           uint8_t configCount;
@@ -1953,6 +3537,7 @@ bool SFE_QUAD_Sensors::applySensorAndMenuConfiguration(void)
 
 SFE_QUAD_Sensors__SD::~SFE_QUAD_Sensors__SD(void)
 {
+  endLog(); // Close the log (if open) while the file access still exists
   if (_theStorageName != NULL) // Clear the previous file name (if any)
     delete _theStorageName;
 }
@@ -2095,6 +3680,141 @@ bool SFE_QUAD_Sensors__SD::endStorage(void)
   return (true);
 }
 
+// Open the next log file and write the sensor and sense names to it. See SFE_QUAD_Log_Manager::openLog for the details.
+// There is no pre-allocation with SD. On ESP32, fileLeader must start with a '/' (e.g. "/dataLog")
+bool SFE_QUAD_Sensors__SD::beginLog(const char *fileLeader, uint32_t maxFileSize, unsigned long maxFileMillis, uint32_t indexInterval, size_t bufferSize)
+{
+  if (_csPin == -1)
+  {
+    if (_printDebug)
+      _debugPort->println(F("beginLog: CS pin not found. Did you forget to call beginStorage?"));
+    return (false);
+  }
+
+  return (openLog(fileLeader, getLogHeader(), maxFileSize, maxFileMillis, indexInterval, bufferSize, _printDebug ? _debugPort : NULL));
+}
+
+// The log file access for SFE_QUAD_Log_Manager
+
+bool SFE_QUAD_Sensors__SD::logFileExists(const char *fileName)
+{
+  return (SD.exists(fileName));
+}
+
+bool SFE_QUAD_Sensors__SD::logRemoveFile(const char *fileName)
+{
+  return (SD.remove(fileName));
+}
+
+// Open the log file for appending
+bool SFE_QUAD_Sensors__SD::logOpenFile(const char *fileName, uint32_t maxFileSize, uint32_t *fileSize)
+{
+  (void)maxFileSize; // No pre-allocation
+  _theLogFile = SD.open(fileName, FILE_APPEND);
+  if (!_theLogFile)
+    return (false);
+  *fileSize = _theLogFile.size();
+  return (true);
+}
+
+Print &SFE_QUAD_Sensors__SD::logFile(void)
+{
+  return (_theLogFile);
+}
+
+// flush does not return a result. A failed write is reported through getWriteError
+bool SFE_QUAD_Sensors__SD::logSyncFile(void)
+{
+  _theLogFile.clearWriteError();
+  _theLogFile.flush();
+  return (_theLogFile.getWriteError() == 0);
+}
+
+bool SFE_QUAD_Sensors__SD::logCloseFile(void)
+{
+  _theLogFile.close();
+  return (true);
+}
+
+// The log file was not closed. There is no pre-allocation, so the file size is the length which was synced (*length, from the index,
+// can be a little less). A sync can land part way through a row: move back to the end of the last whole row.
+// SD cannot truncate files: a partial row is left at the end of the file. The closed index entry records the length of the whole rows
+bool SFE_QUAD_Sensors__SD::logRecoverFile(const char *fileName, uint32_t *length)
+{
+  File logFile = SD.open(fileName, FILE_READ);
+  if (!logFile)
+  {
+    if (_printDebug)
+    {
+      _debugPort->print(F("logRecoverFile: failed to open "));
+      _debugPort->println(fileName);
+    }
+    return (false);
+  }
+
+  *length = logFile.size();
+
+  while ((*length > 0) && (logFile.seek(*length - 1)) && (logFile.read() != '\n'))
+    (*length)--;
+
+  logFile.close();
+
+  return (true);
+}
+
+// Open the index. Not append: the last entry is rewritten on every sync
+bool SFE_QUAD_Sensors__SD::logOpenIndex(const char *fileName, bool write)
+{
+  if (!write)
+    _theLogIndex = SD.open(fileName, FILE_READ);
+  else
+  {
+#if defined(ARDUINO_ARCH_ESP32)
+    if (!SD.exists(fileName)) // "r+" does not create the file
+    {
+      File newIndex = SD.open(fileName, FILE_WRITE);
+      newIndex.close();
+    }
+    _theLogIndex = SD.open(fileName, "r+");
+#else
+    _theLogIndex = SD.open(fileName, O_READ | O_WRITE | O_CREAT);
+#endif
+  }
+  return ((bool)_theLogIndex);
+}
+
+bool SFE_QUAD_Sensors__SD::logIndexIsOpen(void)
+{
+  return ((bool)_theLogIndex);
+}
+
+uint32_t SFE_QUAD_Sensors__SD::logIndexSize(void)
+{
+  return (_theLogIndex.size());
+}
+
+bool SFE_QUAD_Sensors__SD::logReadIndex(uint32_t position, uint8_t *data, size_t len)
+{
+  if (!_theLogIndex.seek(position))
+    return (false);
+  return ((size_t)_theLogIndex.read(data, len) == len);
+}
+
+bool SFE_QUAD_Sensors__SD::logWriteIndex(uint32_t position, const uint8_t *data, size_t len)
+{
+  if (!_theLogIndex.seek(position))
+    return (false);
+  if (_theLogIndex.write(data, len) != len)
+    return (false);
+  _theLogIndex.flush();
+  return (true);
+}
+
+void SFE_QUAD_Sensors__SD::logCloseIndex(void)
+{
+  _theLogIndex.close();
+}
+
 #endif
 
 // SdFat Support
@@ -2103,6 +3823,7 @@ bool SFE_QUAD_Sensors__SD::endStorage(void)
 
 SFE_QUAD_Sensors__SdFat::~SFE_QUAD_Sensors__SdFat(void)
 {
+  endLog(); // Close the log (if open) while the file access still exists
   if (_theStorageName != NULL) // Clear the previous file name (if any)
     delete _theStorageName;
 }
@@ -2256,6 +3977,154 @@ bool SFE_QUAD_Sensors__SdFat::endStorage(void)
   return (true);
 }
 
+// Open the next log file and write the sensor and sense names to it. See SFE_QUAD_Log_Manager::openLog for the details.
+// Each log file is pre-allocated to maxFileSize (or SFE_QUAD_SDFAT_LOG_PREALLOCATE) so the FAT does not need to be updated as the file grows
+bool SFE_QUAD_Sensors__SdFat::beginLog(const char *fileLeader, uint32_t maxFileSize, unsigned long maxFileMillis, uint32_t indexInterval, size_t bufferSize)
+{
+  if (_csPin == -1)
+  {
+    if (_printDebug)
+      _debugPort->println(F("beginLog: CS pin not found. Did you forget to call beginStorage?"));
+    return (false);
+  }
+
+  return (openLog(fileLeader, getLogHeader(), maxFileSize, maxFileMillis, indexInterval, bufferSize, _printDebug ? _debugPort : NULL));
+}
+
+// The log file access for SFE_QUAD_Log_Manager
+
+bool SFE_QUAD_Sensors__SdFat::logFileExists(const char *fileName)
+{
+  return (sd.exists(fileName));
+}
+
+bool SFE_QUAD_Sensors__SdFat::logRemoveFile(const char *fileName)
+{
+  return (sd.remove(fileName));
+}
+
+// Open the log file. If it is empty, pre-allocate contiguous clusters
+bool SFE_QUAD_Sensors__SdFat::logOpenFile(const char *fileName, uint32_t maxFileSize, uint32_t *fileSize)
+{
+  // Not O_APPEND: on FAT, preAllocate sets the file size to the pre-allocated length. The rows are written from the start of the pre-allocation
+  if (!_theLogFile.open(fileName, O_CREAT | O_WRITE))
+    return (false);
+
+  *fileSize = _theLogFile.fileSize(); // Write after the existing data (if any)
+
+  if (*fileSize == 0)
+  {
+    if ((!_theLogFile.preAllocate(maxFileSize > 0 ? maxFileSize : SFE_QUAD_SDFAT_LOG_PREALLOCATE)) && (_printDebug))
+      _debugPort->println(F("logOpenFile: preAllocate failed. Continuing without it"));
+  }
+
+  if (!_theLogFile.seekSet(*fileSize))
+  {
+    _theLogFile.close();
+    return (false);
+  }
+
+  return (true);
+}
+
+Print &SFE_QUAD_Sensors__SdFat::logFile(void)
+{
+  return (_theLogFile);
+}
+
+bool SFE_QUAD_Sensors__SdFat::logSyncFile(void)
+{
+  return (_theLogFile.sync());
+}
+
+// Release the unused pre-allocation and close the log file
+bool SFE_QUAD_Sensors__SdFat::logCloseFile(void)
+{
+  bool result = _theLogFile.truncate(); // Truncate at the current position - the end of the data
+  if (!_theLogFile.close())
+    result = false;
+  return (result);
+}
+
+// The log file was not closed. It is still pre-allocated and, on FAT, its size is the pre-allocated length: everything
+// after the synced length is garbage. *length (from the index) is the synced length - or a little less. A sync can land part
+// way through a row: move back to the end of the last whole row, then release the rest
+bool SFE_QUAD_Sensors__SdFat::logRecoverFile(const char *fileName, uint32_t *length)
+{
+#if SFE_QUAD_SD_FAT_TYPE == 1
+  File32 logFile;
+#elif SFE_QUAD_SD_FAT_TYPE == 2
+  ExFile logFile;
+#elif SFE_QUAD_SD_FAT_TYPE == 3
+  FsFile logFile;
+#else  // SD_FAT_TYPE == 0
+  File logFile;
+#endif // SD_FAT_TYPE
+
+  if (!logFile.open(fileName, O_RDWR))
+  {
+    if (_printDebug)
+    {
+      _debugPort->print(F("logRecoverFile: failed to open "));
+      _debugPort->println(fileName);
+    }
+    return (false);
+  }
+
+  if (*length > logFile.fileSize()) // exFAT does not extend the file size when pre-allocating
+    *length = logFile.fileSize();
+
+  uint8_t c = 0;
+  while ((*length > 0) && (logFile.seekSet(*length - 1)) && (logFile.read(&c, 1) == 1) && (c != '\n'))
+    (*length)--;
+
+  bool result = true;
+  if (logFile.fileSize() > *length)
+    result = logFile.truncate(*length);
+  logFile.close();
+
+  return (result);
+}
+
+// Open the index. Not O_APPEND: the last entry is rewritten on every sync
+bool SFE_QUAD_Sensors__SdFat::logOpenIndex(const char *fileName, bool write)
+{
+  if (write)
+    return (_theLogIndex.open(fileName, O_CREAT | O_RDWR));
+  return (_theLogIndex.open(fileName, O_READ));
+}
+
+bool SFE_QUAD_Sensors__SdFat::logIndexIsOpen(void)
+{
+  return (_theLogIndex.isOpen());
+}
+
+uint32_t SFE_QUAD_Sensors__SdFat::logIndexSize(void)
+{
+  return (_theLogIndex.fileSize());
+}
+
+bool SFE_QUAD_Sensors__SdFat::logReadIndex(uint32_t position, uint8_t *data, size_t len)
+{
+  if (!_theLogIndex.seekSet(position))
+    return (false);
+  return (_theLogIndex.read(data, len) == (int)len);
+}
+
+bool SFE_QUAD_Sensors__SdFat::logWriteIndex(uint32_t position, const uint8_t *data, size_t len)
+{
+  if (!_theLogIndex.seekSet(position))
+    return (false);
+  if (_theLogIndex.write(data, len) != len)
+    return (false);
+  return (_theLogIndex.sync());
+}
+
+void SFE_QUAD_Sensors__SdFat::logCloseIndex(void)
+{
+  _theLogIndex.close();
+}
+
 #endif
 
 // LittleFS Support
@@ -2264,6 +4133,7 @@ bool SFE_QUAD_Sensors__SdFat::endStorage(void)
 
 SFE_QUAD_Sensors__LittleFS::~SFE_QUAD_Sensors__LittleFS(void)
 {
+  endLog(); // Close the log (if open) while the file access still exists
   if (_theStorageName != NULL) // Clear the previous file name (if any)
     delete _theStorageName;
 }
@@ -2401,6 +4271,137 @@ bool SFE_QUAD_Sensors__LittleFS::endStorage(void)
   return (true);
 }
 
+// Open the next log file and write the sensor and sense names to it. See SFE_QUAD_Log_Manager::openLog for the details.
+// There is no pre-allocation with LittleFS. On ESP32, fileLeader must start with a '/' (e.g. "/dataLog")
+bool SFE_QUAD_Sensors__LittleFS::beginLog(const char *fileLeader, uint32_t maxFileSize, unsigned long maxFileMillis, uint32_t indexInterval, size_t bufferSize)
+{
+  if (_theStorageName == NULL)
+  {
+    if (_printDebug)
+      _debugPort->println(F("beginLog: LittleFS not started. Did you forget to call beginStorage?"));
+    return (false);
+  }
+
+  return (openLog(fileLeader, getLogHeader(), maxFileSize, maxFileMillis, indexInterval, bufferSize, _printDebug ? _debugPort : NULL));
+}
+
+// The log file access for SFE_QUAD_Log_Manager
+
+bool SFE_QUAD_Sensors__LittleFS::logFileExists(const char *fileName)
+{
+  return (LittleFS.exists(fileName));
+}
+
+bool SFE_QUAD_Sensors__LittleFS::logRemoveFile(const char *fileName)
+{
+  return (LittleFS.remove(fileName));
+}
+
+// Open the log file for appending
+bool SFE_QUAD_Sensors__LittleFS::logOpenFile(const char *fileName, uint32_t maxFileSize, uint32_t *fileSize)
+{
+  (void)maxFileSize; // No pre-allocation
+  _theLogFile = LittleFS.open(fileName, FILE_APPEND);
+  if (!_theLogFile)
+    return (false);
+  *fileSize = _theLogFile.size();
+  return (true);
+}
+
+Print &SFE_QUAD_Sensors__LittleFS::logFile(void)
+{
+  return (_theLogFile);
+}
+
+// flush does not return a result. A failed write is reported through getWriteError
+bool SFE_QUAD_Sensors__LittleFS::logSyncFile(void)
+{
+  _theLogFile.clearWriteError();
+  _theLogFile.flush();
+  return (_theLogFile.getWriteError() == 0);
+}
+
+bool SFE_QUAD_Sensors__LittleFS::logCloseFile(void)
+{
+  _theLogFile.close();
+  return (true);
+}
+
+// The log file was not closed. There is no pre-allocation, so the file size is the length which was synced (*length, from the index,
+// can be a little less). A sync can land part way through a row: move back to the end of the last whole row.
+// LittleFS cannot truncate files: a partial row is left at the end of the file. The closed index entry records the length of the whole rows
+bool SFE_QUAD_Sensors__LittleFS::logRecoverFile(const char *fileName, uint32_t *length)
+{
+  File logFile = LittleFS.open(fileName, FILE_READ);
+  if (!logFile)
+  {
+    if (_printDebug)
+    {
+      _debugPort->print(F("logRecoverFile: failed to open "));
+      _debugPort->println(fileName);
+    }
+    return (false);
+  }
+
+  *length = logFile.size();
+
+  while ((*length > 0) && (logFile.seek(*length - 1)) && (logFile.read() != '\n'))
+    (*length)--;
+
+  logFile.close();
+
+  return (true);
+}
+
+// Open the index. Not append: the last entry is rewritten on every sync
+bool SFE_QUAD_Sensors__LittleFS::logOpenIndex(const char *fileName, bool write)
+{
+  if (!write)
+    _theLogIndex = LittleFS.open(fileName, FILE_READ);
+  else
+  {
+    if (!LittleFS.exists(fileName)) // "r+" does not create the file
+    {
+      File newIndex = LittleFS.open(fileName, FILE_WRITE);
+      newIndex.close();
+    }
+    _theLogIndex = LittleFS.open(fileName, "r+");
+  }
+  return ((bool)_theLogIndex);
+}
+
+bool SFE_QUAD_Sensors__LittleFS::logIndexIsOpen(void)
+{
+  return ((bool)_theLogIndex);
+}
+
+uint32_t SFE_QUAD_Sensors__LittleFS::logIndexSize(void)
+{
+  return (_theLogIndex.size());
+}
+
+bool SFE_QUAD_Sensors__LittleFS::logReadIndex(uint32_t position, uint8_t *data, size_t len)
+{
+  if (!_theLogIndex.seek(position))
+    return (false);
+  return ((size_t)_theLogIndex.read(data, len) == len);
+}
+
+bool SFE_QUAD_Sensors__LittleFS::logWriteIndex(uint32_t position, const uint8_t *data, size_t len)
+{
+  if (!_theLogIndex.seek(position))
+    return (false);
+  if (_theLogIndex.write(data, len) != len)
+    return (false);
+  _theLogIndex.flush();
+  return (true);
+}
+
+void SFE_QUAD_Sensors__LittleFS::logCloseIndex(void)
+{
+  _theLogIndex.close();
+}
+
 #endif
 
 // EEPROM Support
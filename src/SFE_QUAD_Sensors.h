@@ -42,10 +42,14 @@
 #include <Wire.h>
 
 #include "SFE_QUAD_Menus.h"
+#include "SFE_QUAD_Log_Writer.h"
+#include "SFE_QUAD_Log_Manager.h"
 
 #include "src/I2C_MUX/SparkFun_I2C_Mux_Arduino_Library.h"
 
 // Stringify helpers
+#define SFE_QUAD_SENSOR_READING_LEN 32 // The maximum length of a single sense reading, including the NULL
+
 #define STR(x) STRSTR(x)
 #define STRSTR(x) #x
 
@@ -54,6 +58,7 @@ class SFE_QUAD_Sensors_sprintf
 public:
   char *_dtostrf(double value, char *buffer);             // Convert double to string (included because not all platforms support dtostrf correctly)
   char *_etoa(double value, char *buffer);                // Convert double to ASCII text using exponent format
+  char *_fixtostrf(int32_t value, uint8_t decimals, char *buffer); // Convert a scaled integer (value / 10^decimals) to string without using floating point
   bool expStrToDouble(const char *str, double *value);    // Convert exponent-format string to double
   unsigned char _prec = 3;                                // precision
   void setPrecision(unsigned char prec) { _prec = prec; } // Call setPrecision to change the number of decimal places for the readings
@@ -89,6 +94,22 @@ public:
   // Record the sensor type so we can delete it safely
   uint16_t _type;
 
+  // True while a multi-stage measurement started by triggerSensor has another stage to run. Used by triggerSensors
+  bool _triggerPending;
+
+  // The minimum interval between readings of this sensor (ms). Zero: read every time getSensorReadings is called
+  unsigned long _readingPeriod;
+
+  // When the next reading is due (millis). Set by scheduleSensors
+  unsigned long _readingDue;
+
+  // True if the sensor is due to be read during this getSensorReadings. Set by scheduleSensors
+  bool _readingScheduled;
+
+  // The most recent reading of each sense, SFE_QUAD_SENSOR_READING_LEN chars per sense. Logged while the sensor is not due
+  // Only allocated if _readingPeriod is non-zero
+  char *_lastReadings;
+
   SFE_QUAD_Sensor(void)
   {
     _sensorAddress = 0;
@@ -99,11 +120,24 @@ public:
     _logSense = NULL;
     _customInitializePtr = NULL;
     _type = 0xFFFF; // Mark the _type as 'unknown' for now. Higher code will set this - after calling sensorFactory
+    _triggerPending = false;
+    _readingPeriod = 0;
+    _readingDue = 0;
+    _readingScheduled = true;
+    _lastReadings = NULL;
+    _statistics = NULL;
+    _deadband = NULL;
   }
 
   virtual ~SFE_QUAD_Sensor(void)
   {
     deleteSensorStorage();
+    if (_lastReadings != NULL)
+      delete[] _lastReadings;
+    if (_statistics != NULL)
+      delete[] _statistics;
+    if (_deadband != NULL)
+      delete[] _deadband;
   }
 
   // Enum for the different settings types
@@ -131,6 +165,43 @@ public:
     uint32_t UINT32_T;
   } SFE_QUAD_Sensor_Every_Type_t;
 
+  // Enum for the environmental compensation values which can be passed from one sensor to another
+  typedef enum
+  {
+    SFE_QUAD_COMPENSATION_TEMPERATURE = 0, // Degrees C
+    SFE_QUAD_COMPENSATION_HUMIDITY,        // %RH
+    SFE_QUAD_COMPENSATION_PRESSURE,        // mbar (hPa)
+    SFE_QUAD_COMPENSATION_UNKNOWN          // Must be last
+  } SFE_QUAD_Sensor_Compensation_Type_e;
+
+  // Running statistics for one sense, updated using Welford's method. Used by sampleSensors and getAggregatedReadings
+  typedef struct
+  {
+    uint32_t count; // The number of numeric samples
+    double mean;
+    double m2;      // The sum of the squares of the differences from the mean
+    double min;
+    double max;
+  } SFE_QUAD_Sense_Statistics_t;
+
+  // Pointer to an array of running statistics, one per sense. Only allocated by sampleSensors
+  SFE_QUAD_Sense_Statistics_t *_statistics;
+
+  // The deadband (report-by-exception) threshold and state for one sense. Used by getSensorReadings and checkDeadband
+  typedef struct
+  {
+    float threshold;   // Zero: this sense does not cause a row to be logged
+    bool relative;     // true: threshold is a percentage of the last logged value. false: threshold is absolute
+    bool currentValid; // true if current holds a numeric reading
+    bool loggedValid;  // true if logged holds a numeric reading
+    double current;    // The latest reading. Set by getSensorReadings
+    double logged;     // The reading when the last row was logged. Set by checkDeadband
+    bool changed;      // true if the last checkDeadband found this sense outside its deadband. Used for the delta records
+  } SFE_QUAD_Sense_Deadband_t;
+
+  // Pointer to an array of deadbands, one per sense. Only allocated by setDeadband
+  SFE_QUAD_Sense_Deadband_t *_deadband;
+
   // Delete (deallocate) the _classPtr and _logSense
   virtual void deleteSensorStorage(void) { ; }
 
@@ -152,6 +223,49 @@ public:
   // Initialize the sensor - apply any additional settings required after begin. A custom initializer can be provided with setCustomInitialize
   virtual bool initializeSensor(uint8_t sensorAddress, TwoWire &port) { return (false); }
 
+  // Return true if the sensor needs to be polled between readings (e.g. to collect samples from a free-running sensor)
+  virtual bool pollingEnabled(void) { return (false); }
+
+  // Poll the sensor between readings - collect any new samples. Called by pollSensors
+  virtual bool pollSensor(uint8_t sensorAddress, TwoWire &port) { return (false); }
+
+  // Trigger a measurement ahead of getSenseReading so that several sensors can share one conversion wait. Called by triggerSensors
+  // Set settleMillis to how long the sensor needs before it can be read (or before the next stage)
+  // Return true only if the measurement has another stage, i.e. continueTrigger must be called once settleMillis has elapsed
+  virtual bool triggerSensor(uint8_t sensorAddress, TwoWire &port, unsigned long *settleMillis) { return (false); }
+
+  // Advance a multi-stage measurement (e.g. MS5637 D2 then D1) once the previous stage's settleMillis has elapsed. Called by triggerSensors
+  // Return true if another stage was started and set settleMillis to how long it needs. Return false when the measurement is complete
+  virtual bool continueTrigger(uint8_t sensorAddress, TwoWire &port, unsigned long *settleMillis) { return (false); }
+
+  // Return the next event (e.g. a button press) as text: the time of the event (millis) and the event name, separated by a comma
+  // Return false when there are no more events. Called repeatedly by getSensorEvents
+  virtual bool getSensorEvent(uint8_t sensorAddress, TwoWire &port, char *event) { return (false); }
+
+  // Return true if this sensor can produce the specified compensation value (for other sensors)
+  virtual bool producesCompensation(SFE_QUAD_Sensor_Compensation_Type_e type) { return (false); }
+
+  // Read all of the compensation values this sensor produces in one go. Called by compensateSensors
+  // The values are latched so that the following getSenseReading calls use them instead of reading the sensor again
+  virtual bool acquireCompensation(uint8_t sensorAddress, TwoWire &port) { return (false); }
+
+  // Return the compensation value latched by acquireCompensation
+  virtual bool getCompensation(SFE_QUAD_Sensor_Compensation_Type_e type, float *value) { return (false); }
+
+  // Return true if this sensor can use the specified compensation value (from another sensor)
+  virtual bool consumesCompensation(SFE_QUAD_Sensor_Compensation_Type_e type) { return (false); }
+
+  // Set the compensation value. Called by compensateSensors. The sensor applies it the next time it is read
+  virtual bool setCompensation(SFE_QUAD_Sensor_Compensation_Type_e type, float value) { return (false); }
+
+  // Save any state resumeSensor will need after an MCU deep sleep (e.g. the compensation value already applied) into state
+  // Return the number of bytes used (<= maxLen). Called by saveSnapshot
+  virtual uint8_t getSensorState(uint8_t *state, uint8_t maxLen) { return (0); }
+
+  // Re-attach to a sensor which stayed powered (and configured) while the MCU was in deep sleep - without calling begin or initialize
+  // Return false if the sensor state is not intact. resumeSensors then calls beginSensor and initializeSensor instead. Called by resumeSensors
+  virtual bool resumeSensor(uint8_t sensorAddress, TwoWire &port, const uint8_t *state, uint8_t stateLen) { return (false); }
+
   // Set the custom initializer pointer for this sensor
   void setCustomInitializePtr(void (*pointer)(uint8_t sensorAddress, TwoWire &port, void *_classPtr)) { _customInitializePtr = pointer; }
 
@@ -166,8 +280,20 @@ public:
   // Return the largest number of characters in the array of sense names
   virtual uint8_t getSenseNameMaxLen() { return (0); }
 
-  // Return the sense reading as char
-  virtual bool getSenseReading(uint8_t sense, char *reading) { return (NULL); }
+  // Return the sense reading as a number. Used by getSensorReadings, checkDeadband and sampleSensors
+  virtual bool getSenseValue(uint8_t sense, double *value) { return (false); }
+
+  // Convert a value returned by getSenseValue to text, in the sense's own format (e.g. integer counts have no decimal places)
+  virtual bool formatSenseValue(uint8_t sense, double value, char *reading) { return (false); }
+
+  // Return the sense reading as char. Sensors which provide getSenseValue and formatSenseValue do not need to override this
+  virtual bool getSenseReading(uint8_t sense, char *reading)
+  {
+    double value;
+    if (!getSenseValue(sense, &value))
+      return (false);
+    return (formatSenseValue(sense, value, reading));
+  }
 
   // A sensor may have several things which can be set
   // E.g. the NAU7802 scale has 2 : zero offset (calculateZeroOffset) and calibration factor (calculateCalibrationFactor)
@@ -219,6 +345,16 @@ public:
   SFE_QUAD_Sensors_sprintf _sprintf; // Provide access to the common sprintf(%f) and sprintf(%e) functions
 };
 
+// A link in the compensation graph: the producer's compensation value is passed to the consumer before each reading
+class SFE_QUAD_Sensor_Compensation_Link
+{
+public:
+  SFE_QUAD_Sensor *_producer;                                 // The sensor which produces the value (e.g. BME280)
+  SFE_QUAD_Sensor *_consumer;                                 // The sensor which uses the value (e.g. SGP40)
+  SFE_QUAD_Sensor::SFE_QUAD_Sensor_Compensation_Type_e _type; // Which value
+  SFE_QUAD_Sensor_Compensation_Link *_next;                   // Pointer to the next link in the linked list
+};
+
 #include "SFE_QUAD_Headers.h"
 
 #if __has_include("SFE_QUAD_Headers.h") // Check if the compiler supports __has_include
@@ -533,37 +669,116 @@ public:
 #endif
   }
 
+#define SFE_QUAD_SNAPSHOT_MAX_SENSORS 16    // The maximum number of sensors saveSnapshot can record
+#define SFE_QUAD_SNAPSHOT_STATE_BYTES 16    // The maximum number of bytes of per-sensor state (getSensorState)
+#define SFE_QUAD_SNAPSHOT_MAGIC 0x51534E50 // "QSNP" - marks a snapshot written by saveSnapshot
+
+  // One sensor in the snapshot
+  typedef struct
+  {
+    uint16_t type;         // SFEQUADSensorType
+    uint8_t sensorAddress; // I2C address
+    uint8_t muxAddress;    // 0 if the sensor is on the main branch
+    uint8_t muxPort;
+    uint8_t stateLen;      // The number of bytes of state used
+    uint8_t reserved[2];
+    uint32_t logSense;     // _logSense as a bit mask. Bit 0 is the sensor enable, bit 1 is sense 0, etc.
+    uint8_t state[SFE_QUAD_SNAPSHOT_STATE_BYTES]; // The per-sensor state from getSensorState
+  } SFE_QUAD_Sensor_Snapshot_t;
+
+  // A compact copy of the sensor list which can be retained through deep sleep (e.g. RTC_DATA_ATTR on ESP32)
+  typedef struct
+  {
+    uint32_t magic;      // SFE_QUAD_SNAPSHOT_MAGIC
+    uint16_t checksum;   // Fletcher-16 of numSensors, prec and the sensor entries
+    uint8_t numSensors;
+    uint8_t prec;        // _sprintf._prec
+    SFE_QUAD_Sensor_Snapshot_t sensor[SFE_QUAD_SNAPSHOT_MAX_SENSORS];
+  } SFE_QUAD_Sensors_Snapshot_t;
+
+  // The statistics which getAggregatedReadings can produce for each sense. OR them together for setAggregates
+  typedef enum
+  {
+    SFE_QUAD_AGGREGATE_MEAN = 0x01,
+    SFE_QUAD_AGGREGATE_MIN = 0x02,
+    SFE_QUAD_AGGREGATE_MAX = 0x04,
+    SFE_QUAD_AGGREGATE_STDDEV = 0x08, // Sample standard deviation
+    SFE_QUAD_AGGREGATE_COUNT = 0x10   // The number of samples
+  } SFE_QUAD_Aggregate_e;
+
   void setWirePort(TwoWire &port);    // Define which Wire (I2C) port will be used
   void enableDebugging(Stream &port); // Define which Serial port (Stream) will be used for debug messages
   void setMenuPort(Stream &port);     // Define which Serial port (Stream) will be used for the menus
   bool detectSensors(void);           // Detect which I2C sensors are attached
+  bool detectSensorsFromConfiguration(void); // Fast boot: rebuild the sensor list from configuration (readConfigurationFromStorage). Re-probes only the locations which do not match
   bool beginSensors(void);            // Begin each sensor - usually by calling the sensor's .begin function
   bool initializeSensors(void);       // Apply any additional settings needed for initialization
+  bool saveSnapshot(SFE_QUAD_Sensors_Snapshot_t *snapshot);         // Save the sensor list, mux map, logging selection and sensor state before deep sleep
+  bool resumeSensors(const SFE_QUAD_Sensors_Snapshot_t *snapshot); // Rebuild the sensor list from the snapshot after deep sleep. Replaces detect, begin and initialize
   bool getSensorReadings(void);       // Get all enabled readings from all enabled sensors. Readings are stored in readings in CSV format
+  bool pollSensors(void);             // Poll all enabled sensors which need polling between readings. Call this as often as possible
+  bool triggerSensors(void);          // Trigger all enabled sensors which support it, then wait once for the slowest. Called by getSensorReadings
+  bool compensateSensors(void);       // Acquire the compensation values from the producers and pass them to the consumers. Called by getSensorReadings
+  bool scheduleSensors(void);         // Decide which sensors are due to be read, based on their reading periods. Called by getSensorReadings
+  bool getMillisToNextReading(unsigned long *millisToNext); // Return how long until the next sensor with a reading period is due
+  bool getSensorEvents(void);         // Get all events (e.g. button presses) from all enabled sensors. Stored in events in CSV format, one event per line
   bool getSensorNames(void);          // Get the names etc. all enabled sensors. Stored in readings in CSV format
   bool getSenseNames(void);           // Get the names all enabled sensor senses. Stored in readings in CSV format
+  char *getLogHeader(void);           // Get the sensor and sense names for the start of a log file. The caller must delete[] it
+
+  void setAggregates(uint8_t aggregates); // Select which statistics getAggregatedReadings produces for each sense (SFE_QUAD_AGGREGATE_MEAN etc.)
+  bool sampleSensors(void);               // Add a sample of all enabled senses to their running statistics. Call this at the (fast) sample rate
+  bool getAggregatedReadings(void);       // Get the statistics of all enabled senses since the last call. Stored in readings in CSV format
+  bool getAggregatedSenseNames(void);     // Get the names of the columns produced by getAggregatedReadings. Stored in readings in CSV format
+
+  bool setDeadband(uint8_t sense, float threshold, bool relative, const char *sensorName, uint8_t i2cAddress, uint8_t muxAddress = 0, uint8_t muxPort = 0); // Set the deadband for this sense of this sensor. Zero: the sense does not cause a row to be logged
+  bool setDeadband(uint8_t sense, float threshold, bool relative, const char *sensorName);                                                                  // Set the deadband for this sense of all instances of this sensor
+  void setHeartbeat(unsigned long heartbeatMillis);                                                                                                         // Log a row at least this often, even if no sense has crossed its deadband. Zero: no heartbeat
+  bool checkDeadband(void);                                                                                                                                 // Return true if the latest readings should be logged: a sense has crossed its deadband or the heartbeat has expired
+  void setDeltaRecords(bool enable);                                                                                                                        // true: when only some senses have crossed their deadband, checkDeadband replaces readings with a sparse delta record
 
   bool setCustomInitialize(void (*pointer)(uint8_t sensorAddress, TwoWire &port, void *_classPtr), const char *sensorName, uint8_t i2cAddress, uint8_t muxAddress = 0, uint8_t muxPort = 0); // Set a custom initialize function for this sensor
   bool setCustomInitialize(void (*pointer)(uint8_t sensorAddress, TwoWire &port, void *_classPtr), const char *sensorName);                                                                  // Set a custom initialize function for all instances of this sensor
 
+  bool setReadingPeriod(unsigned long periodMillis, const char *sensorName, uint8_t i2cAddress, uint8_t muxAddress = 0, uint8_t muxPort = 0); // Set the minimum interval between readings for this sensor. Zero: read every time
+  bool setReadingPeriod(unsigned long periodMillis, const char *sensorName);                                                                  // Set the minimum interval between readings for all instances of this sensor
+
   SFE_QUAD_Sensor *sensorExists(const char *sensorName, uint8_t i2cAddress, uint8_t muxAddress = 0, uint8_t muxPort = 0); // Check if a sensor exists. Returns NULL if the sensor does not exist
+  SFE_QUAD_Sensor *addSensor(SFEQUADSensorType type, uint8_t i2cAddress, uint8_t muxAddress, uint8_t muxPort);            // Append a new sensor of the selected type to the end of the linked list
+  bool detectSensorAtLocation(uint8_t sensorAddress, uint8_t muxAddress, uint8_t muxPort);                               // Helper function for detectSensorsFromConfiguration. Probe one address on the selected mux port for all sensor types
+
+  bool addCompensationLink(SFE_QUAD_Sensor *producer, SFE_QUAD_Sensor *consumer, SFE_QUAD_Sensor::SFE_QUAD_Sensor_Compensation_Type_e type); // Pass the producer's compensation value to the consumer before each reading
+  bool autoWireCompensation(void);                                                                                                            // Link each consumer to a producer on the same mux port (or the main branch)
+  void clearCompensationLinks(void);                                                                                                          // Delete all compensation links
 
   bool loggingMenu(void);                        // The logging menu - select which sensors and which senses are enabled for logging
   uint32_t getMenuChoice(unsigned long timeout); // Helper function for loggingMenu - select a menu choice
 
+  uint16_t snapshotChecksum(const SFE_QUAD_Sensors_Snapshot_t *snapshot); // Helper function for saveSnapshot and resumeSensors
+  bool appendToReadings(const char *str);                                // Helper function for getAggregatedReadings and getAggregatedSenseNames
+  bool makeDeltaRecord(void);                                            // Helper function for checkDeadband. Replace readings with the senses which have changed
+  bool readSense(SFE_QUAD_Sensor *sensor, uint8_t sense, char *reading, double *value); // Helper function for getSensorReadings and sampleSensors. Returns true if value is numeric
+
   bool settingMenu(void);                                           // The setting menu - apply settings to individual sensors. Note: settings are different to configuration
   bool getSettingValueDouble(double *value, unsigned long timeout); // Helper function for settingMenu - allow the user to enter a double value via the menu port. Supports exponent format
 
   bool getSensorAndMenuConfiguration(void);   // Read the sensor configuration from the sensors. Store it in configuration in text format
   bool applySensorAndMenuConfiguration(void); // Apply the configuration to the sensors
 
-  SFE_QUAD_Sensor *_head; // The head of the linked list of sensors
-  char *readings;         // The sensor readings stored as text (CSV)
-  char *configuration;    // The sensor configuration, read by getSensorConfiguration, stored as text
-  bool _printDebug;       // A flag to show if debug messages are enabled. Set true by enableDebugging
-  TwoWire *_i2cPort;      // The I2C (TwoWire) port which the sensors are connected to
-  Stream *_menuPort;      // The Serial port (Stream) used for the menu
-  Stream *_debugPort;     // The Serial port (Stream) used for debug messages. Call enableDebugging to set the port
+  SFE_QUAD_Sensor *_head;                               // The head of the linked list of sensors
+  SFE_QUAD_Sensor_Compensation_Link *_compensationHead; // The head of the linked list of compensation links
+  char *readings;                                       // The sensor readings stored as text (CSV)
+  char *events;                                         // The sensor events stored as text (CSV), one event per line
+  char *configuration;                                  // The sensor configuration, read by getSensorConfiguration, stored as text
+  bool _printDebug;                                     // A flag to show if debug messages are enabled. Set true by enableDebugging
+  TwoWire *_i2cPort;                                    // The I2C (TwoWire) port which the sensors are connected to
+  Stream *_menuPort;                                    // The Serial port (Stream) used for the menu
+  Stream *_debugPort;                                   // The Serial port (Stream) used for debug messages. Call enableDebugging to set the port
+  uint8_t _aggregates;                                  // The statistics produced by getAggregatedReadings. Set by setAggregates
+  unsigned long _heartbeatMillis;                       // The maximum interval between logged rows when using deadbands. Set by setHeartbeat
+  unsigned long _lastLoggedMillis;                      // When checkDeadband last returned true (millis)
+  bool _rowLogged;                                      // true once checkDeadband has returned true
+  bool _deltaRecords;                                  // true if checkDeadband produces sparse delta records. Set by setDeltaRecords
 
   SFE_QUAD_Menu theMenu; // Add an instance of the menu
 
@@ -578,7 +793,7 @@ public:
 #include <SPI.h>
 #include <SD.h>
 
-class SFE_QUAD_Sensors__SD : public SFE_QUAD_Sensors
+class SFE_QUAD_Sensors__SD : public SFE_QUAD_Sensors, public SFE_QUAD_Log_Manager
 {
 public:
   ~SFE_QUAD_Sensors__SD();
@@ -588,8 +803,29 @@ public:
   bool readConfigurationFromStorage(void);               // Read theFileName, copy the contents into configuration
   bool endStorage(void);                                 // End the storage (if required)
   File _theStorage;                                      // SD File
+  File _theLogFile;                                      // SD File for the sensor data
+  File _theLogIndex;                                     // SD File for the log index
   char *_theStorageName = NULL;                          // The name of the settings file - set by beginStorage
 
+  // Log file management: rotation and a (timestamp, file, offset) index. See SFE_QUAD_Log_Manager for writeLog etc.
+  bool beginLog(const char *fileLeader = "dataLog", uint32_t maxFileSize = 0, unsigned long maxFileMillis = 0, uint32_t indexInterval = 100, size_t bufferSize = 4096); // Open the next log file. Write the sensor and sense names
+
+protected:
+  // The log file access for SFE_QUAD_Log_Manager
+  bool logFileExists(const char *fileName);
+  bool logRemoveFile(const char *fileName);
+  bool logOpenFile(const char *fileName, uint32_t maxFileSize, uint32_t *fileSize);
+  Print &logFile(void);
+  bool logSyncFile(void);
+  bool logCloseFile(void);
+  bool logRecoverFile(const char *fileName, uint32_t *length);
+  bool logOpenIndex(const char *fileName, bool write);
+  bool logIndexIsOpen(void);
+  uint32_t logIndexSize(void);
+  bool logReadIndex(uint32_t position, uint8_t *data, size_t len);
+  bool logWriteIndex(uint32_t position, const uint8_t *data, size_t len);
+  void logCloseIndex(void);
+
 private:
   int _csPin = -1; // The SPI Chip Select pin - set by beginStorage
 };
@@ -604,7 +840,11 @@ private:
 #include <SPI.h>
 #include <SdFat.h> //SdFat by Bill Greiman: http://librarymanager/All#SdFat_exFAT
 
-class SFE_QUAD_Sensors__SdFat : public SFE_QUAD_Sensors
+#ifndef SFE_QUAD_SDFAT_LOG_PREALLOCATE
+#define SFE_QUAD_SDFAT_LOG_PREALLOCATE 100000000 // Pre-allocate 100MB for each log file - unless maxFileSize is set
+#endif
+
+class SFE_QUAD_Sensors__SdFat : public SFE_QUAD_Sensors, public SFE_QUAD_Log_Manager
 {
 public:
   ~SFE_QUAD_Sensors__SdFat();
@@ -614,6 +854,9 @@ public:
   bool readConfigurationFromStorage(void);               // Read theFileName, copy the contents into configuration
   bool endStorage(void);                                 // End the storage (if required)
 
+  // Log file management: rotation, pre-allocation and a (timestamp, file, offset) index. See SFE_QUAD_Log_Manager for writeLog etc.
+  bool beginLog(const char *fileLeader = "dataLog", uint32_t maxFileSize = 0, unsigned long maxFileMillis = 0, uint32_t indexInterval = 100, size_t bufferSize = 4096); // Open the next log file. Write the sensor and sense names
+
 #ifndef SFE_QUAD_SD_FAT_TYPE
 #define SFE_QUAD_SD_FAT_TYPE 3 // SD_FAT_TYPE = 0 for SdFat/File, 1 for FAT16/FAT32, 2 for exFAT, 3 for FAT16/FAT32 and exFAT.
 #endif
@@ -631,17 +874,41 @@ public:
 #endif // SD_FAT_TYPE
 
 #if SFE_QUAD_SD_FAT_TYPE == 1
-  File32 _theStorage; // SdFat File
+  File32 _theStorage;  // SdFat File
+  File32 _theLogFile;  // SdFat File for the sensor data
+  File32 _theLogIndex; // SdFat File for the log index
 #elif SFE_QUAD_SD_FAT_TYPE == 2
-  ExFile _theStorage; // SdFat File
+  ExFile _theStorage;  // SdFat File
+  ExFile _theLogFile;  // SdFat File for the sensor data
+  ExFile _theLogIndex; // SdFat File for the log index
 #elif SFE_QUAD_SD_FAT_TYPE == 3
-  FsFile _theStorage; // SdFat File
+  FsFile _theStorage;  // SdFat File
+  FsFile _theLogFile;  // SdFat File for the sensor data
+  FsFile _theLogIndex; // SdFat File for the log index
 #else  // SD_FAT_TYPE == 0
-  File _theStorage; // SdFat File
+  File _theStorage;  // SdFat File
+  File _theLogFile;  // SdFat File for the sensor data
+  File _theLogIndex; // SdFat File for the log index
 #endif // SD_FAT_TYPE
 
   char *_theStorageName = NULL; // The name of the settings file - set by beginStorage
 
+protected:
+  // The log file access for SFE_QUAD_Log_Manager
+  bool logFileExists(const char *fileName);
+  bool logRemoveFile(const char *fileName);
+  bool logOpenFile(const char *fileName, uint32_t maxFileSize, uint32_t *fileSize);
+  Print &logFile(void);
+  bool logSyncFile(void);
+  bool logCloseFile(void);
+  bool logRecoverFile(const char *fileName, uint32_t *length);
+  bool logOpenIndex(const char *fileName, bool write);
+  bool logIndexIsOpen(void);
+  uint32_t logIndexSize(void);
+  bool logReadIndex(uint32_t position, uint8_t *data, size_t len);
+  bool logWriteIndex(uint32_t position, const uint8_t *data, size_t len);
+  void logCloseIndex(void);
+
 private:
   int _csPin = -1; // The SPI Chip Select pin - set by beginStorage
 };
@@ -658,7 +925,7 @@ private:
 
 #define FORMAT_LITTLEFS_IF_FAILED true
 
-class SFE_QUAD_Sensors__LittleFS : public SFE_QUAD_Sensors
+class SFE_QUAD_Sensors__LittleFS : public SFE_QUAD_Sensors, public SFE_QUAD_Log_Manager
 {
 public:
   ~SFE_QUAD_Sensors__LittleFS();
@@ -668,7 +935,28 @@ public:
   bool readConfigurationFromStorage(void);               // Read theFileName, copy the contents into configuration
   bool endStorage(void);                                 // End the storage (if required)
   File _theStorage;                                      // SD File
+  File _theLogFile;                                      // LittleFS File for the sensor data
+  File _theLogIndex;                                     // LittleFS File for the log index
   char *_theStorageName = NULL;                          // The name of the settings file - set by beginStorage
+
+  // Log file management: rotation and a (timestamp, file, offset) index. See SFE_QUAD_Log_Manager for writeLog etc.
+  bool beginLog(const char *fileLeader = "dataLog", uint32_t maxFileSize = 0, unsigned long maxFileMillis = 0, uint32_t indexInterval = 100, size_t bufferSize = 4096); // Open the next log file. Write the sensor and sense names
+
+protected:
+  // The log file access for SFE_QUAD_Log_Manager
+  bool logFileExists(const char *fileName);
+  bool logRemoveFile(const char *fileName);
+  bool logOpenFile(const char *fileName, uint32_t maxFileSize, uint32_t *fileSize);
+  Print &logFile(void);
+  bool logSyncFile(void);
+  bool logCloseFile(void);
+  bool logRecoverFile(const char *fileName, uint32_t *length);
+  bool logOpenIndex(const char *fileName, bool write);
+  bool logIndexIsOpen(void);
+  uint32_t logIndexSize(void);
+  bool logReadIndex(uint32_t position, uint8_t *data, size_t len);
+  bool logWriteIndex(uint32_t position, const uint8_t *data, size_t len);
+  void logCloseIndex(void);
 };
 
 #endif
@@ -79,8 +79,8 @@ boolean SFE_ADS122C04::configureADCmode(uint8_t wire_mode, uint8_t rate)
     initParams.gainLevel = ADS122C04_GAIN_8; // Set the gain to 8
     initParams.pgaBypass = ADS122C04_PGA_ENABLED; // The PGA must be enabled for gains >= 8
     initParams.dataRate = rate; // Set the data rate (samples per second). Defaults to 20
-    initParams.opMode = ADS122C04_OP_MODE_NORMAL; // Disable turbo mode
-    initParams.convMode = ADS122C04_CONVERSION_MODE_SINGLE_SHOT; // Use single shot mode
+    initParams.opMode = _opMode; // Normal mode unless turbo has been selected by startContinuousConversion
+    initParams.convMode = _convMode; // Single shot mode unless startContinuousConversion has been called
     initParams.selectVref = ADS122C04_VREF_EXT_REF_PINS; // Use the external REF pins
     initParams.tempSensorEn = ADS122C04_TEMP_SENSOR_OFF; // Disable the temperature sensor
     initParams.dataCounterEn = ADS122C04_DCNT_DISABLE; // Disable the data counter
@@ -97,8 +97,8 @@ boolean SFE_ADS122C04::configureADCmode(uint8_t wire_mode, uint8_t rate)
     initParams.gainLevel = ADS122C04_GAIN_4; // Set the gain to 4
     initParams.pgaBypass = ADS122C04_PGA_ENABLED; // Enable the PGA
     initParams.dataRate = rate; // Set the data rate (samples per second). Defaults to 20
-    initParams.opMode = ADS122C04_OP_MODE_NORMAL; // Disable turbo mode
-    initParams.convMode = ADS122C04_CONVERSION_MODE_SINGLE_SHOT; // Use single shot mode
+    initParams.opMode = _opMode; // Normal mode unless turbo has been selected by startContinuousConversion
+    initParams.convMode = _convMode; // Single shot mode unless startContinuousConversion has been called
     initParams.selectVref = ADS122C04_VREF_EXT_REF_PINS; // Use the external REF pins
     initParams.tempSensorEn = ADS122C04_TEMP_SENSOR_OFF; // Disable the temperature sensor
     initParams.dataCounterEn = ADS122C04_DCNT_DISABLE; // Disable the data counter
@@ -115,8 +115,8 @@ boolean SFE_ADS122C04::configureADCmode(uint8_t wire_mode, uint8_t rate)
     initParams.gainLevel = ADS122C04_GAIN_8; // Set the gain to 8
     initParams.pgaBypass = ADS122C04_PGA_ENABLED; // The PGA must be enabled for gains >= 8
     initParams.dataRate = rate; // Set the data rate (samples per second). Defaults to 20
-    initParams.opMode = ADS122C04_OP_MODE_NORMAL; // Disable turbo mode
-    initParams.convMode = ADS122C04_CONVERSION_MODE_SINGLE_SHOT; // Use single shot mode
+    initParams.opMode = _opMode; // Normal mode unless turbo has been selected by startContinuousConversion
+    initParams.convMode = _convMode; // Single shot mode unless startContinuousConversion has been called
     initParams.selectVref = ADS122C04_VREF_EXT_REF_PINS; // Use the external REF pins
     initParams.tempSensorEn = ADS122C04_TEMP_SENSOR_OFF; // Disable the temperature sensor
     initParams.dataCounterEn = ADS122C04_DCNT_DISABLE; // Disable the data counter
@@ -133,8 +133,8 @@ boolean SFE_ADS122C04::configureADCmode(uint8_t wire_mode, uint8_t rate)
     initParams.gainLevel = ADS122C04_GAIN_4; // Set the gain to 4
     initParams.pgaBypass = ADS122C04_PGA_ENABLED; // Enable the PGA
     initParams.dataRate = rate; // Set the data rate (samples per second). Defaults to 20
-    initParams.opMode = ADS122C04_OP_MODE_NORMAL; // Disable turbo mode
-    initParams.convMode = ADS122C04_CONVERSION_MODE_SINGLE_SHOT; // Use single shot mode
+    initParams.opMode = _opMode; // Normal mode unless turbo has been selected by startContinuousConversion
+    initParams.convMode = _convMode; // Single shot mode unless startContinuousConversion has been called
     initParams.selectVref = ADS122C04_VREF_EXT_REF_PINS; // Use the external REF pins
     initParams.tempSensorEn = ADS122C04_TEMP_SENSOR_OFF; // Disable the temperature sensor
     initParams.dataCounterEn = ADS122C04_DCNT_DISABLE; // Disable the data counter
@@ -151,8 +151,8 @@ boolean SFE_ADS122C04::configureADCmode(uint8_t wire_mode, uint8_t rate)
     initParams.gainLevel = ADS122C04_GAIN_8; // Set the gain to 8
     initParams.pgaBypass = ADS122C04_PGA_ENABLED; // The PGA must be enabled for gains >= 8
     initParams.dataRate = rate; // Set the data rate (samples per second). Defaults to 20
-    initParams.opMode = ADS122C04_OP_MODE_NORMAL; // Disable turbo mode
-    initParams.convMode = ADS122C04_CONVERSION_MODE_SINGLE_SHOT; // Use single shot mode
+    initParams.opMode = _opMode; // Normal mode unless turbo has been selected by startContinuousConversion
+    initParams.convMode = _convMode; // Single shot mode unless startContinuousConversion has been called
     initParams.selectVref = ADS122C04_VREF_EXT_REF_PINS; // Use the external REF pins
     initParams.tempSensorEn = ADS122C04_TEMP_SENSOR_OFF; // Disable the temperature sensor
     initParams.dataCounterEn = ADS122C04_DCNT_DISABLE; // Disable the data counter
@@ -169,8 +169,8 @@ boolean SFE_ADS122C04::configureADCmode(uint8_t wire_mode, uint8_t rate)
     initParams.gainLevel = ADS122C04_GAIN_4; // Set the gain to 4
     initParams.pgaBypass = ADS122C04_PGA_ENABLED; // Enable the PGA
     initParams.dataRate = rate; // Set the data rate (samples per second). Defaults to 20
-    initParams.opMode = ADS122C04_OP_MODE_NORMAL; // Disable turbo mode
-    initParams.convMode = ADS122C04_CONVERSION_MODE_SINGLE_SHOT; // Use single shot mode
+    initParams.opMode = _opMode; // Normal mode unless turbo has been selected by startContinuousConversion
+    initParams.convMode = _convMode; // Single shot mode unless startContinuousConversion has been called
     initParams.selectVref = ADS122C04_VREF_EXT_REF_PINS; // Use the external REF pins
     initParams.tempSensorEn = ADS122C04_TEMP_SENSOR_OFF; // Disable the temperature sensor
     initParams.dataCounterEn = ADS122C04_DCNT_DISABLE; // Disable the data counter
@@ -225,7 +225,14 @@ boolean SFE_ADS122C04::configureADCmode(uint8_t wire_mode, uint8_t rate)
     }
     return(false);
   }
-  return(ADS122C04_init(&initParams)); // Configure the chip
+
+  boolean ret_val = ADS122C04_init(&initParams); // Configure the chip
+
+  // In continuous mode, the conversions need to be (re)started after the configuration has been written
+  if ((ret_val == true) && (initParams.convMode == ADS122C04_CONVERSION_MODE_CONTINUOUS))
+    ret_val = start();
+
+  return(ret_val);
 }
 
 //Returns true if device answers on _deviceAddress
@@ -271,10 +278,11 @@ float SFE_ADS122C04::readPT100Centigrade(void) // Read the temperature in Centig
   unsigned long start_time = millis(); // Record the start time so we can timeout
   boolean drdy = false; // DRDY (1 == new data is ready)
   float ret_val = 0.0; // Return value
-  float RTD, POLY; // Variables needed to convert RTD to Centigrade
 
-  // Start the conversion (assumes we are using single shot mode)
-  start();
+  // Start the conversion (if we are using single shot mode)
+  // In continuous mode the ADC is free-running and the next conversion will be along shortly
+  if (_convMode == ADS122C04_CONVERSION_MODE_SINGLE_SHOT)
+    start();
 
   // Wait for DRDY to go valid
   while((drdy == false) && (millis() < (start_time + ADS122C04_CONVERSION_TIMEOUT)))
@@ -312,7 +320,17 @@ float SFE_ADS122C04::readPT100Centigrade(void) // Read the temperature in Centig
     raw_v.UINT32 |= 0xFF000000;
   }
 
-  // raw_v.UINT32 now contains the ADC result, correctly signed
+  return(convertPT100Centigrade(raw_v.INT32));
+}
+
+// Convert a signed raw PT100 ADC value into temperature in Centigrade
+// raw is float so that averaged (decimated) ADC values can be converted without losing resolution
+float SFE_ADS122C04::convertPT100Centigrade(float raw)
+{
+  float ret_val; // Return value
+  float RTD, POLY; // Variables needed to convert RTD to Centigrade
+
+  // raw now contains the ADC result, correctly signed
   // Now we need to convert it to temperature using the PT100 resistance,
   // the gain, excitation current and reference resistor value
 
@@ -321,7 +339,7 @@ float SFE_ADS122C04::readPT100Centigrade(void) // Read the temperature in Centig
   // https://www.analog.com/media/en/technical-documentation/application-notes/AN709_0.pdf
 
   // 2^23 is 8388608
-  RTD = ((float)raw_v.INT32) / 8388608.0; // Load RTD with the scaled ADC value
+  RTD = raw / 8388608.0; // Load RTD with the scaled ADC value
   RTD *= PT100_REFERENCE_RESISTOR; // Multiply by the reference resistor
   // Use the correct gain for high and low temperatures
   if ((_wireMode == ADS122C04_4WIRE_HI_TEMP) || (_wireMode == ADS122C04_3WIRE_HI_TEMP) || (_wireMode == ADS122C04_2WIRE_HI_TEMP))
@@ -463,6 +481,52 @@ uint32_t SFE_ADS122C04::readADC(void)
   return(ret_val);
 }
 
+// Start continuous (free-running) conversions using the selected wire mode
+// Use ADS122C04_DATA_RATE_1000SPS with ADS122C04_OP_MODE_TURBO for 2000 samples per second
+boolean SFE_ADS122C04::startContinuousConversion(uint8_t wire_mode, uint8_t rate, uint8_t mode)
+{
+  _convMode = ADS122C04_CONVERSION_MODE_CONTINUOUS;
+  _opMode = mode;
+  return(configureADCmode(wire_mode, rate)); // configureADCmode will issue the START/SYNC command
+}
+
+// Stop continuous conversions. Return to single shot, normal mode
+boolean SFE_ADS122C04::stopContinuousConversion(void)
+{
+  uint8_t rate = ADS122C04_Reg.reg1.bit.DR; // Record the rate so we can restore it
+  _convMode = ADS122C04_CONVERSION_MODE_SINGLE_SHOT;
+  _opMode = ADS122C04_OP_MODE_NORMAL;
+  powerdown(); // Stop the conversions
+  return(configureADCmode(_wireMode, rate));
+}
+
+// Check DRDY and read the raw signed 24-bit PT100 ADC value if a new conversion is ready
+// This does not wait. It returns true if a new conversion was read, false if no new data was available
+// Use this when the ADC is free-running - see startContinuousConversion
+boolean SFE_ADS122C04::readRawPT100NoWait(int32_t *raw)
+{
+  raw_voltage_union raw_v; // union to convert uint32_t to int32_t
+
+  if (checkDataReady() == false)
+    return(false);
+
+  if(ADS122C04_getConversionData(&raw_v.UINT32) == false)
+  {
+    if (_printDebug == true)
+    {
+      _debugPort->println(F("readRawPT100NoWait: ADS122C04_getConversionData failed"));
+    }
+    return(false);
+  }
+
+  // Pad out the MSB with the MS bit of the 24 bits to preserve the two's complement
+  if ((raw_v.UINT32 & 0x00800000) == 0x00800000)
+    raw_v.UINT32 |= 0xFF000000;
+
+  *raw = raw_v.INT32;
+  return(true);
+}
+
 // Read the internal temperature
 float SFE_ADS122C04::readInternalTemperature(uint8_t rate)
 {
@@ -333,6 +333,14 @@ public:
   // Read the internal temperature (C)
   float readInternalTemperature(uint8_t rate = ADS122C04_DATA_RATE_20SPS);
 
+  // Continuous conversion mode: the ADC is free-running and readRawPT100NoWait collects each completed conversion without waiting
+  // Use ADS122C04_DATA_RATE_1000SPS with ADS122C04_OP_MODE_TURBO for 2000 samples per second
+  boolean startContinuousConversion(uint8_t wire_mode, uint8_t rate = ADS122C04_DATA_RATE_1000SPS, uint8_t mode = ADS122C04_OP_MODE_TURBO);
+  boolean stopContinuousConversion(void); // Return to single shot, normal mode
+  boolean isContinuous(void) { return (_convMode == ADS122C04_CONVERSION_MODE_CONTINUOUS); }
+  boolean readRawPT100NoWait(int32_t *raw); // Returns true if a new conversion was ready. The signed 24-bit result is returned in raw
+  float convertPT100Centigrade(float raw); // Convert a (possibly averaged) raw PT100 ADC value to Centigrade using the current wire mode
+
   boolean reset(void); // Reset the ADS122C04
   boolean start(void); // Start a conversion
   boolean powerdown(void); // Put the chip into low power mode
@@ -391,6 +399,11 @@ private:
   // Keep a copy of the wire mode so we can restore it after reading the internal temperature
   uint8_t _wireMode = ADS122C04_4WIRE_MODE;
 
+  // Conversion and operating modes used by configureADCmode for the PT100 wire modes
+  // These are changed by startContinuousConversion and stopContinuousConversion
+  uint8_t _convMode = ADS122C04_CONVERSION_MODE_SINGLE_SHOT;
+  uint8_t _opMode = ADS122C04_OP_MODE_NORMAL;
+
   // Resistance of the reference resistor
   const float PT100_REFERENCE_RESISTOR = 1620.0;
 
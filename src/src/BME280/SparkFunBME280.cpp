@@ -380,6 +380,23 @@ void BME280::readAllMeasurements(BME280_SensorMeasurements *measurements, uint8_
 	readFloatHumidityFromBurst(dataBurst, measurements);
 }
 
+//Read all sensor registers as a burst and compensate them using integer math only.
+void BME280::readAllMeasurementsInteger(BME280_IntegerMeasurements *measurements){
+	
+	uint8_t dataBurst[8];
+	readRegisterRegion(dataBurst, BME280_MEASUREMENTS_REG, 8);
+	
+	int32_t adc_P = ((uint32_t)dataBurst[0] << 12) | ((uint32_t)dataBurst[1] << 4) | ((dataBurst[2] >> 4) & 0x0F);
+	int32_t adc_T = ((uint32_t)dataBurst[3] << 12) | ((uint32_t)dataBurst[4] << 4) | ((dataBurst[5] >> 4) & 0x0F);
+	int32_t adc_H = ((uint32_t)dataBurst[6] << 8) | ((uint32_t)dataBurst[7]);
+	
+	measurements->temperature = compensateTemperature(adc_T); //Temperature first: updates t_fine
+	if (settings.tempCorrection != 0.0)
+		measurements->temperature += (int32_t)(settings.tempCorrection * 100);
+	measurements->pressure = (((uint64_t)compensatePressure(adc_P) * 100) + 128) >> 8; //Q24.8 to hundredths, rounded to nearest
+	measurements->humidity = (((uint64_t)compensateHumidity(adc_H) * 100) + 512) >> 10; //Q22.10 to hundredths, rounded to nearest
+}
+
 //****************************************************************************//
 //
 //  Pressure Section
@@ -394,24 +411,7 @@ float BME280::readFloatPressure( void )
 	readRegisterRegion(buffer, BME280_PRESSURE_MSB_REG, 3);
     int32_t adc_P = ((uint32_t)buffer[0] << 12) | ((uint32_t)buffer[1] << 4) | ((buffer[2] >> 4) & 0x0F);
 	
-	int64_t var1, var2, p_acc;
-	var1 = ((int64_t)t_fine) - 128000;
-	var2 = var1 * var1 * (int64_t)calibration.dig_P6;
-	var2 = var2 + ((var1 * (int64_t)calibration.dig_P5)<<17);
-	var2 = var2 + (((int64_t)calibration.dig_P4)<<35);
-	var1 = ((var1 * var1 * (int64_t)calibration.dig_P3)>>8) + ((var1 * (int64_t)calibration.dig_P2)<<12);
-	var1 = (((((int64_t)1)<<47)+var1))*((int64_t)calibration.dig_P1)>>33;
-	if (var1 == 0)
-	{
-		return 0; // avoid exception caused by division by zero
-	}
-	p_acc = 1048576 - adc_P;
-	p_acc = (((p_acc<<31) - var2)*3125)/var1;
-	var1 = (((int64_t)calibration.dig_P9) * (p_acc>>13) * (p_acc>>13)) >> 25;
-	var2 = (((int64_t)calibration.dig_P8) * p_acc) >> 19;
-	p_acc = ((p_acc + var1 + var2) >> 8) + (((int64_t)calibration.dig_P7)<<4);
-	
-	return (float)p_acc / 256.0;
+	return (float)compensatePressure(adc_P) / 256.0;
 	
 }
 
@@ -423,6 +423,14 @@ void BME280::readFloatPressureFromBurst(uint8_t buffer[], BME280_SensorMeasureme
   
   int32_t adc_P = ((uint32_t)buffer[0] << 12) | ((uint32_t)buffer[1] << 4) | ((buffer[2] >> 4) & 0x0F);
 	
+	measurements->pressure = (float)compensatePressure(adc_P) / 256.0;
+}
+
+// Returns pressure in Pa as unsigned 32 bit integer in Q24.8 format (24 integer bits and 8 fractional bits).
+// Output value of “24674867” represents 24674867/256 = 96386.2 Pa = 963.862 hPa
+// Datasheet BME280_compensate_P_int64: integer math only
+uint32_t BME280::compensatePressure(int32_t adc_P)
+{
 	int64_t var1, var2, p_acc;
 	var1 = ((int64_t)t_fine) - 128000;
 	var2 = var1 * var1 * (int64_t)calibration.dig_P6;
@@ -432,18 +440,14 @@ void BME280::readFloatPressureFromBurst(uint8_t buffer[], BME280_SensorMeasureme
 	var1 = (((((int64_t)1)<<47)+var1))*((int64_t)calibration.dig_P1)>>33;
 	if (var1 == 0)
 	{
-		measurements->pressure = 0; // avoid exception caused by division by zero
-	}
-	else
-	{
-		p_acc = 1048576 - adc_P;
-		p_acc = (((p_acc<<31) - var2)*3125)/var1;
-		var1 = (((int64_t)calibration.dig_P9) * (p_acc>>13) * (p_acc>>13)) >> 25;
-		var2 = (((int64_t)calibration.dig_P8) * p_acc) >> 19;
-		p_acc = ((p_acc + var1 + var2) >> 8) + (((int64_t)calibration.dig_P7)<<4);
-		
-		measurements->pressure = (float)p_acc / 256.0;
+		return 0; // avoid exception caused by division by zero
 	}
+	p_acc = 1048576 - adc_P;
+	p_acc = (((p_acc<<31) - var2)*3125)/var1;
+	var1 = (((int64_t)calibration.dig_P9) * (p_acc>>13) * (p_acc>>13)) >> 25;
+	var2 = (((int64_t)calibration.dig_P8) * p_acc) >> 19;
+	p_acc = ((p_acc + var1 + var2) >> 8) + (((int64_t)calibration.dig_P7)<<4);
+	return (uint32_t)p_acc;
 }
 
 // Sets the internal variable _referencePressure so the altitude is calculated properly.
@@ -503,16 +507,7 @@ float BME280::readFloatHumidity( void )
 	readRegisterRegion(buffer, BME280_HUMIDITY_MSB_REG, 2);
     int32_t adc_H = ((uint32_t)buffer[0] << 8) | ((uint32_t)buffer[1]);
 	
-	int32_t var1;
-	var1 = (t_fine - ((int32_t)76800));
-	var1 = (((((adc_H << 14) - (((int32_t)calibration.dig_H4) << 20) - (((int32_t)calibration.dig_H5) * var1)) +
-	((int32_t)16384)) >> 15) * (((((((var1 * ((int32_t)calibration.dig_H6)) >> 10) * (((var1 * ((int32_t)calibration.dig_H3)) >> 11) + ((int32_t)32768))) >> 10) + ((int32_t)2097152)) *
-	((int32_t)calibration.dig_H2) + 8192) >> 14));
-	var1 = (var1 - (((((var1 >> 15) * (var1 >> 15)) >> 7) * ((int32_t)calibration.dig_H1)) >> 4));
-	var1 = (var1 < 0 ? 0 : var1);
-	var1 = (var1 > 419430400 ? 419430400 : var1);
-
-	return (float)(var1>>12) / 1024.0;
+	return (float)compensateHumidity(adc_H) / 1024.0;
 }
 
 void BME280::readFloatHumidityFromBurst(uint8_t buffer[], BME280_SensorMeasurements *measurements)
@@ -522,6 +517,12 @@ void BME280::readFloatHumidityFromBurst(uint8_t buffer[], BME280_SensorMeasureme
 	// Output value of “47445” represents 47445/1024 = 46. 333 %RH
   int32_t adc_H = ((uint32_t)buffer[6] << 8) | ((uint32_t)buffer[7]);
 	
+	measurements->humidity = (float)compensateHumidity(adc_H) / 1024.0;
+}
+
+// Returns humidity in %RH as unsigned 32 bit integer in Q22. 10 format (22 integer and 10 fractional bits).
+uint32_t BME280::compensateHumidity(int32_t adc_H)
+{
 	int32_t var1;
 	var1 = (t_fine - ((int32_t)76800));
 	var1 = (((((adc_H << 14) - (((int32_t)calibration.dig_H4) << 20) - (((int32_t)calibration.dig_H5) * var1)) +
@@ -531,7 +532,7 @@ void BME280::readFloatHumidityFromBurst(uint8_t buffer[], BME280_SensorMeasureme
 	var1 = (var1 < 0 ? 0 : var1);
 	var1 = (var1 > 419430400 ? 419430400 : var1);
 
-	measurements->humidity = (float)(var1>>12) / 1024.0;
+	return (uint32_t)(var1>>12);
 }
 
 //****************************************************************************//
@@ -556,13 +557,7 @@ float BME280::readTempC( void )
     int32_t adc_T = ((uint32_t)buffer[0] << 12) | ((uint32_t)buffer[1] << 4) | ((buffer[2] >> 4) & 0x0F);
 
 	//By datasheet, calibrate
-	int64_t var1, var2;
-
-	var1 = ((((adc_T>>3) - ((int32_t)calibration.dig_T1<<1))) * ((int32_t)calibration.dig_T2)) >> 11;
-	var2 = (((((adc_T>>4) - ((int32_t)calibration.dig_T1)) * ((adc_T>>4) - ((int32_t)calibration.dig_T1))) >> 12) *
-	((int32_t)calibration.dig_T3)) >> 14;
-	t_fine = var1 + var2;
-	float output = (t_fine * 5 + 128) >> 8;
+	float output = compensateTemperature(adc_T);
 
 	output = output / 100 + settings.tempCorrection;
 	
@@ -574,17 +569,24 @@ float BME280::readTempFromBurst(uint8_t buffer[])
   int32_t adc_T = ((uint32_t)buffer[3] << 12) | ((uint32_t)buffer[4] << 4) | ((buffer[5] >> 4) & 0x0F);
 
 	//By datasheet, calibrate
+	float output = compensateTemperature(adc_T);
+
+	output = output / 100 + settings.tempCorrection;
+	
+ 	return output;
+}
+
+// Returns temperature in DegC, resolution is 0.01 DegC. Output value of “5123” equals 51.23 DegC.
+// t_fine carries fine temperature as global value
+int32_t BME280::compensateTemperature(int32_t adc_T)
+{
 	int64_t var1, var2;
 
 	var1 = ((((adc_T>>3) - ((int32_t)calibration.dig_T1<<1))) * ((int32_t)calibration.dig_T2)) >> 11;
 	var2 = (((((adc_T>>4) - ((int32_t)calibration.dig_T1)) * ((adc_T>>4) - ((int32_t)calibration.dig_T1))) >> 12) *
 	((int32_t)calibration.dig_T3)) >> 14;
 	t_fine = var1 + var2;
-	float output = (t_fine * 5 + 128) >> 8;
-
-	output = output / 100 + settings.tempCorrection;
-	
- 	return output;
+	return (t_fine * 5 + 128) >> 8;
 }
 
 void BME280::readTempCFromBurst(uint8_t buffer[], BME280_SensorMeasurements *measurements)
@@ -181,6 +181,15 @@ struct BME280_SensorMeasurements
 	float humidity;
 };
 
+//Measurements as scaled integers. Used by readAllMeasurementsInteger
+struct BME280_IntegerMeasurements
+{
+  public:
+	int32_t temperature; //Hundredths of a DegC
+	uint32_t pressure; //Hundredths of a Pa
+	uint32_t humidity; //Hundredths of a %RH
+};
+
 //This is the main operational class of the driver.
 
 class BME280
@@ -225,6 +234,7 @@ class BME280
 	//Software reset routine
 	void reset( void );
 	void readAllMeasurements(BME280_SensorMeasurements *measurements, uint8_t tempScale = 0);
+	void readAllMeasurementsInteger(BME280_IntegerMeasurements *measurements); //Integer-only compensation. For MCUs without an FPU
 	
     //Returns the values as floats.
     float readFloatPressure( void );
@@ -263,6 +273,9 @@ private:
 	uint8_t checkSampleValue(uint8_t userValue); //Checks for valid over sample values
 	void readTempCFromBurst(uint8_t buffer[], BME280_SensorMeasurements *measurements);
 	void readTempFFromBurst(uint8_t buffer[], BME280_SensorMeasurements *measurements);
+	int32_t compensateTemperature(int32_t adc_T); //Updates t_fine. Returns hundredths of a DegC
+	uint32_t compensatePressure(int32_t adc_P); //Returns Pa in Q24.8 format
+	uint32_t compensateHumidity(int32_t adc_H); //Returns %RH in Q22.10 format
 
     uint8_t _wireType = HARD_WIRE; //Default to Wire.h
     TwoWire *_hardPort = NO_WIRE; //The generic connection to user's chosen I2C hardware
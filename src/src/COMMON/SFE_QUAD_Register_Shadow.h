@@ -0,0 +1,126 @@
+/*
+  SFE_QUAD_Register_Shadow
+
+  A small write-through shadow for sensor configuration registers.
+
+  Many of the sensor libraries perform read-modify-write on their configuration registers,
+  and their getters re-read configuration which only changes when the library writes it.
+  The shadow keeps a RAM copy of the registers the library chooses to shadow so that:
+    - configuration getters are answered from RAM
+    - read-modify-write only needs the write
+    - writes which would not change the register can be skipped (coalesced)
+
+  Only shadow registers whose contents are changed exclusively by the host.
+  Status, data and self-clearing bits must not be shadowed - mask them out before calling write.
+
+  The shadow does not perform any I2C itself. Use it from the library's register access functions:
+
+    if (!_shadow.read(reg, &value))   // Not shadowed, or not yet valid
+    {
+      value = <read from the device>;
+      if (<read succeeded>)
+        _shadow.write(reg, value);    // Fill the shadow
+    }
+
+    bool success = <write value to the device>;
+    if (success)
+      _shadow.write(reg, value);      // Write-through
+    else
+      _shadow.invalidate(reg);        // We no longer know what the device contains
+
+  Define SFE_QUAD_REGISTER_SHADOW_DISABLE to turn the shadow off (every access goes to the device).
+  The host tests (extras/test) use this to compare the bus traffic with and without the shadow.
+*/
+
+#ifndef SPARKFUN_QUAD_REGISTER_SHADOW_H
+#define SPARKFUN_QUAD_REGISTER_SHADOW_H
+
+#include <stdint.h>
+
+template <typename T, uint8_t NUM_REGISTERS>
+class SFE_QUAD_Register_Shadow
+{
+public:
+  // registers points to NUM_REGISTERS register addresses. These are the registers which will be shadowed
+  SFE_QUAD_Register_Shadow(const uint8_t *registers)
+  {
+    for (uint8_t i = 0; i < NUM_REGISTERS; i++)
+    {
+      _address[i] = registers[i];
+      _value[i] = 0;
+      _valid[i] = false;
+    }
+  }
+
+  // Return true if reg is one of the shadowed registers
+  bool isShadowed(uint8_t reg)
+  {
+    return (indexOf(reg) < NUM_REGISTERS);
+  }
+
+  // Return true if reg is shadowed and the shadow is valid. value is then set to the shadowed contents
+  bool read(uint8_t reg, T *value)
+  {
+#ifdef SFE_QUAD_REGISTER_SHADOW_DISABLE
+    (void)reg;
+    (void)value;
+    return (false); // The shadow is never valid: changes always returns true
+#else
+    uint8_t i = indexOf(reg);
+    if ((i >= NUM_REGISTERS) || (!_valid[i]))
+      return (false);
+    *value = _value[i];
+    return (true);
+#endif
+  }
+
+  // Update the shadow after a successful read from, or write to, the device. Ignored if reg is not shadowed
+  void write(uint8_t reg, T value)
+  {
+    uint8_t i = indexOf(reg);
+    if (i >= NUM_REGISTERS)
+      return;
+    _value[i] = value;
+    _valid[i] = true;
+  }
+
+  // Return true if writing value to reg would change it - or if we don't know what reg contains.
+  // Use this to coalesce read-modify-write: if it returns false, the write can be skipped
+  bool changes(uint8_t reg, T value)
+  {
+    T current;
+    if (!read(reg, &current))
+      return (true);
+    return (current != value);
+  }
+
+  // Forget the contents of reg. The next access will read it from the device
+  void invalidate(uint8_t reg)
+  {
+    uint8_t i = indexOf(reg);
+    if (i < NUM_REGISTERS)
+      _valid[i] = false;
+  }
+
+  // Forget everything. Call this after a device reset
+  void invalidateAll(void)
+  {
+    for (uint8_t i = 0; i < NUM_REGISTERS; i++)
+      _valid[i] = false;
+  }
+
+private:
+  uint8_t indexOf(uint8_t reg)
+  {
+    uint8_t i = 0;
+    while ((i < NUM_REGISTERS) && (_address[i] != reg))
+      i++;
+    return (i);
+  }
+
+  uint8_t _address[NUM_REGISTERS];
+  T _value[NUM_REGISTERS];
+  bool _valid[NUM_REGISTERS];
+};
+
+#endif
@@ -0,0 +1,51 @@
+/*
+  SFE_QUAD_Sensirion_CRC
+
+  The CRC-8 used by the Sensirion sensors (SCD30, SCD4x, SDP3x, SGP30, SGP40, SHTC3, STC3x):
+    polynomial 0x31 (x^8 + x^5 + x^4 + 1), initialization 0xFF, no reflection, no final XOR.
+
+  The CRC is calculated using a 256-byte lookup table (in PROGMEM) - one table lookup per byte
+  instead of eight shift-and-XOR steps. The table is shared by all of the Sensirion libraries.
+
+  Sensirion sensors return their data as 16-bit words, each followed by its CRC: [MSB, LSB, CRC] * words.
+  checkFrame checks a complete response in one call:
+
+    uint8_t buffer[18];
+    <read 18 bytes into buffer>
+    if (!SFE_QUAD_Sensirion_CRC::checkFrame(buffer, 6))
+      return (false); // One or more CRCs did not match
+*/
+
+#ifndef SPARKFUN_QUAD_SENSIRION_CRC_H
+#define SPARKFUN_QUAD_SENSIRION_CRC_H
+
+#include <Arduino.h>
+
+class SFE_QUAD_Sensirion_CRC
+{
+public:
+  // Return the CRC of len bytes of data
+  static uint8_t crc8(const uint8_t *data, uint8_t len);
+
+  // Return the CRC of a 16-bit word (MSB first)
+  static uint8_t crc8(uint16_t word);
+
+  // Check a [MSB, LSB, CRC] * words frame. Return true if all of the CRCs are correct
+  static bool checkFrame(const uint8_t *frame, uint8_t words);
+
+  // Return the 16-bit word (MSB first) at index word in a [MSB, LSB, CRC] * words frame
+  static uint16_t frameWord(const uint8_t *frame, uint8_t word)
+  {
+    return ((((uint16_t)frame[word * 3]) << 8) | frame[(word * 3) + 1]);
+  }
+
+private:
+  static uint8_t update(uint8_t crc, uint8_t data)
+  {
+    return (pgm_read_byte(&_table[crc ^ data]));
+  }
+
+  static const uint8_t _table[256];
+};
+
+#endif
@@ -22,10 +22,17 @@ Owen Lyke
 		'pressureSensorX.lastCode' for a status report
 */
 
+static const uint8_t LPS25HB_SHADOWED_REGISTERS[LPS25HB_NUM_SHADOWED_REGISTERS] = {
+	LPS25HB_REG_RES_CONF,
+	LPS25HB_REG_CTRL_REG1, LPS25HB_REG_CTRL_REG2, LPS25HB_REG_CTRL_REG3, LPS25HB_REG_CTRL_REG4,
+	LPS25HB_REG_INTERRUPT_CFG,
+	LPS25HB_REG_FIFO_CTRL,
+	LPS25HB_REG_THS_P_L, LPS25HB_REG_THS_P_H};
+
 /**
    * Constructor for an object of the LPS25HB class
 */
-LPS25HB::LPS25HB(void)
+LPS25HB::LPS25HB(void) : _shadow(LPS25HB_SHADOWED_REGISTERS)
 {
 }
 
@@ -40,6 +47,7 @@ bool LPS25HB::begin(TwoWire &wirePort, uint8_t address)
 	sensor_address = address; // Associate the specified I2C address with the object for later use
 
 	_i2cPort = &wirePort; // This line keeps the 'address' of the Wire port to use associated with the object for later. See a tutorial on pointers for more information
+	_shadow.invalidateAll(); // We don't know what this device contains yet
 	//_i2cPort->begin();					 // The '->' notation is like accessing the member of an object with '.' except used with pointers
 	//_i2cPort->setClock(clock_frequency); // So here we called X.begin() and X.setClock() where X is the wire port the user specified. For example Wire.begin() and Wire.setClock()
 
@@ -164,6 +172,44 @@ float LPS25HB::getPressure_hPa()
 	return (float)(raw / 4096.0);	// Divide by 4096 and cast to a float to get the result in hPa
 }
 
+/**
+   * Gets the 24 bit pressure and 16 bit temperature readings in ADC counts
+   * PRESS_OUT_XL to TEMP_OUT_H are contiguous, so both are read in a single 5 byte burst
+   * @return Boolean, true if read was successful and false if unsuccessful
+*/
+bool LPS25HB::getPressureAndTemperature_raw(int32_t *pressure, int16_t *temperature)
+{
+	uint8_t data[5];
+	if (read(LPS25HB_REG_PRESS_OUT_XL, data, 5) != true)
+	{
+		return false;
+	}
+	*pressure = ((int32_t)data[0] << 0) | ((int32_t)data[1] << 8) | ((int32_t)data[2] << 16);
+	if (data[2] & 0x80)
+	{
+		*pressure |= 0xFF000000;
+	} // Sign extend the 24 bit pressure
+	*temperature = (int16_t)(data[4] << 8 | data[3]);
+	return true;
+}
+
+/**
+   * Gets the pressure reading in hPa and the temperature reading in deg C, using a single burst read
+   * @return Boolean, true if read was successful and false if unsuccessful
+*/
+bool LPS25HB::getPressureAndTemperature(float *pressure_hPa, float *temperature_degC)
+{
+	int32_t pressure;
+	int16_t temperature;
+	if (getPressureAndTemperature_raw(&pressure, &temperature) != true)
+	{
+		return false;
+	}
+	*pressure_hPa = (float)(pressure / 4096.0);
+	*temperature_degC = (float)(42.5 + (temperature / 480.0)); // See getTemperature_degC for the offset
+	return true;
+}
+
 /**
    * Sets a threshold number of ADC counts that is used to trigger interrupts and flags on temperature
    * @param avg_code A byte that specifies the number of averages. Suggest using defined values in .h file
@@ -204,7 +250,7 @@ bool LPS25HB::setPressureThreshold(uint16_t adc_val)
 */
 bool LPS25HB::setTemperatureAverages(uint8_t avg_code)
 {
-	return applySetting(LPS25HB_REG_RES_CONF, (avg_code & 0x0C));
+	return updateSetting(LPS25HB_REG_RES_CONF, 0x0C, avg_code);
 }
 
 /**
@@ -216,7 +262,7 @@ bool LPS25HB::setTemperatureAverages(uint8_t avg_code)
 */
 bool LPS25HB::setPressureAverages(uint8_t avg_code)
 {
-	return applySetting(LPS25HB_REG_RES_CONF, (avg_code & 0x03));
+	return updateSetting(LPS25HB_REG_RES_CONF, 0x03, avg_code);
 }
 
 /**
@@ -229,7 +275,7 @@ bool LPS25HB::setPressureAverages(uint8_t avg_code)
 */
 bool LPS25HB::setOutputDataRate(uint8_t odr_code)
 {
-	return applySetting(LPS25HB_REG_CTRL_REG1, (odr_code & 0x70));
+	return updateSetting(LPS25HB_REG_CTRL_REG1, 0x70, odr_code);
 }
 
 /**
@@ -258,7 +304,7 @@ bool LPS25HB::setFIFOMode(uint8_t mode_code)
 	}
 
 	// This sets the new mode (and the bitmasking helps protect the other settings in the FIFO_CTRL register)
-	if (applySetting(LPS25HB_REG_FIFO_CTRL, (mode_code & 0xE0)) != LPS25HB_CODE_NOM)
+	if (updateSetting(LPS25HB_REG_FIFO_CTRL, 0xE0, mode_code) != true)
 	{
 		return false;
 	}
@@ -274,7 +320,86 @@ bool LPS25HB::setFIFOMode(uint8_t mode_code)
 */
 bool LPS25HB::setFIFOMeanNum(uint8_t num_code)
 {
-	return applySetting(LPS25HB_REG_FIFO_CTRL, (num_code & 0x1F));
+	return updateSetting(LPS25HB_REG_FIFO_CTRL, 0x1F, num_code);
+}
+
+/**
+   * Sets the FIFO watermark level. The FTH_FIFO flag in FIFO_STATUS is set when the FIFO holds this many samples
+   * Note: in FIFO Mean mode, the same field selects the number of samples to average. Use setFIFOMeanNum
+   * @param level The watermark level (0-31)
+   * @return Boolean, true if successful and false if unsuccessful
+*/
+bool LPS25HB::setFIFOWatermark(uint8_t level)
+{
+	return updateSetting(LPS25HB_REG_FIFO_CTRL, LPS25HB_FIFO_CTRL_WTM, level);
+}
+
+/**
+   * Gets the FIFO status from the FIFO_STATUS register of the device
+   * @return FIFO status. Use the LPS25HB_FIFO_STATUS defines to decode it
+*/
+uint8_t LPS25HB::getFIFOStatus()
+{
+	uint8_t retval = 0x00;
+	read(LPS25HB_REG_FIFO_STATUS, &retval, 1);
+	return retval;
+}
+
+/**
+   * Gets the number of unread samples in the FIFO
+   * FSS is only five bits wide, so a full FIFO is indicated by the overrun flag
+   * @return The number of unread samples (0-32)
+*/
+uint8_t LPS25HB::getFIFOLevel()
+{
+	uint8_t status = getFIFOStatus();
+	if (lastCode != LPS25HB_CODE_NOM)
+	{
+		return 0;
+	}
+	if (status & LPS25HB_FIFO_STATUS_EMPTY)
+	{
+		return 0;
+	}
+	if ((status & LPS25HB_FIFO_STATUS_OVR) || ((status & LPS25HB_FIFO_STATUS_FSS) == 0))
+	{
+		return LPS25HB_FIFO_DEPTH;
+	}
+	return (status & LPS25HB_FIFO_STATUS_FSS);
+}
+
+/**
+   * Reads samples from the FIFO in a single burst read
+   * When the FIFO is enabled, the register address rolls over from TEMP_OUT_H back to PRESS_OUT_XL
+   * and each five bytes read pops one sample
+   * @param pressure A pointer to an array which will hold the raw pressure readings
+   * @param temperature A pointer to an array which will hold the raw temperature readings
+   * @param maxSamples The size of the arrays. At most LPS25HB_FIFO_BURST_SAMPLES are read. Call getFIFOLevel first
+   * @return The number of samples read
+*/
+uint8_t LPS25HB::readFIFO(int32_t *pressure, int16_t *temperature, uint8_t maxSamples)
+{
+	uint8_t data[LPS25HB_FIFO_BURST_SAMPLES * LPS25HB_FIFO_SAMPLE_BYTES];
+	uint8_t samples = maxSamples;
+	if (samples > LPS25HB_FIFO_BURST_SAMPLES)
+	{
+		samples = LPS25HB_FIFO_BURST_SAMPLES;
+	}
+	if ((samples == 0) || (read(LPS25HB_REG_PRESS_OUT_XL, data, samples * LPS25HB_FIFO_SAMPLE_BYTES) != true))
+	{
+		return 0;
+	}
+	for (uint8_t indi = 0; indi < samples; indi++)
+	{
+		uint8_t *sample = &data[indi * LPS25HB_FIFO_SAMPLE_BYTES];
+		pressure[indi] = ((int32_t)sample[0] << 0) | ((int32_t)sample[1] << 8) | ((int32_t)sample[2] << 16);
+		if (sample[2] & 0x80)
+		{
+			pressure[indi] |= 0xFF000000;
+		} // Sign extend the 24 bit pressure
+		temperature[indi] = (int16_t)(sample[4] << 8 | sample[3]);
+	}
+	return samples;
 }
 
 /**
@@ -288,8 +413,13 @@ bool LPS25HB::setFIFOMeanNum(uint8_t num_code)
 bool LPS25HB::applySetting(uint8_t reg_adr, uint8_t setting)
 {
 	uint8_t data;									  // Declare space for the data
-	read(reg_adr, &data, 1);						  // Now fill that space with the old setting from the sensor
+	read(reg_adr, &data, 1);						  // Now fill that space with the old setting from the sensor (or the shadow)
 	data |= setting;								  // OR in the new setting, preserving the other fields
+	if (_shadow.changes(reg_adr, data) != true)		  // Nothing to do if the register already holds the setting
+	{
+		lastCode = LPS25HB_CODE_NOM;
+		return true;
+	}
 	if (write(reg_adr, &data, 1) != LPS25HB_CODE_NOM) // Write the new data back to the device and make sure it was successful
 	{
 		lastCode = LPS25HB_CODE_SET_FAIL;
@@ -310,8 +440,13 @@ bool LPS25HB::applySetting(uint8_t reg_adr, uint8_t setting)
 bool LPS25HB::removeSetting(uint8_t reg_adr, uint8_t setting)
 {
 	uint8_t data;									  // Declare space for the data
-	read(reg_adr, &data, 1);						  // Now fill that space with the old setting from the sensor
+	read(reg_adr, &data, 1);						  // Now fill that space with the old setting from the sensor (or the shadow)
 	data &= ~setting;								  // AND in the opposite of the setting value to reset the desired bit(s) while leaving others intact
+	if (_shadow.changes(reg_adr, data) != true)		  // Nothing to do if the bits are already reset
+	{
+		lastCode = LPS25HB_CODE_NOM;
+		return true;
+	}
 	if (write(reg_adr, &data, 1) != LPS25HB_CODE_NOM) // Write the new data back to the device and make sure it was successful
 	{
 		lastCode = LPS25HB_CODE_RESET_FAIL;
@@ -321,6 +456,36 @@ bool LPS25HB::removeSetting(uint8_t reg_adr, uint8_t setting)
 	return true; // Otherwise its all good!
 }
 
+/**
+   * A member that allows changing a field within a given register of the device, using a single read-modify-write
+   * @param reg_adr The address of the register to modify. Use of the LPS25HB_RegistersTypeDef enumeration values is suggested.
+   * @param mask A byte wide bitmask indicating which bits form the field
+   * @param setting The new value for the field. Bits outside mask are ignored
+   * @return Boolean, true if successful and false if unsuccessful
+*/
+bool LPS25HB::updateSetting(uint8_t reg_adr, uint8_t mask, uint8_t setting)
+{
+	uint8_t data;
+	if (read(reg_adr, &data, 1) != true) // Read the old setting from the sensor (or the shadow)
+	{
+		lastCode = LPS25HB_CODE_SET_FAIL;
+		return false;
+	}
+	data = (data & ~mask) | (setting & mask); // Replace the field, preserving the other bits
+	if (_shadow.changes(reg_adr, data) != true)
+	{
+		lastCode = LPS25HB_CODE_NOM;
+		return true;
+	}
+	if (write(reg_adr, &data, 1) != true)
+	{
+		lastCode = LPS25HB_CODE_SET_FAIL;
+		return false;
+	}
+	lastCode = LPS25HB_CODE_NOM;
+	return true;
+}
+
 /**
    * A member that allows reading a sequence of data from consecutive register locations in the device
    * @param reg_adr The address of the first register to read from. Use of the LPS25HB_RegistersTypeDef enumeration values is suggested.
@@ -331,6 +496,12 @@ bool LPS25HB::removeSetting(uint8_t reg_adr, uint8_t setting)
 */
 bool LPS25HB::read(uint8_t reg_adr, uint8_t *pdata, uint8_t size)
 {
+	if ((size == 1) && (_shadow.read(reg_adr, pdata))) // Single configuration registers are read from the shadow
+	{
+		lastCode = LPS25HB_CODE_NOM;
+		return true;
+	}
+
 	_i2cPort->beginTransmission(sensor_address); // Begin talking to the desired sensor
 	_i2cPort->write(reg_adr | (1 << 7));		 // Setting the 7th bit (the MSb) in this tells the device that we want a 'multi-byte' read
 	// _i2cPort->write(reg_adr);													// A multi-byte bit is not needed in this command
@@ -356,6 +527,12 @@ bool LPS25HB::read(uint8_t reg_adr, uint8_t *pdata, uint8_t size)
 		}
 	}
 
+	// Only single-register reads fill the shadow. Multi-byte reads are data bursts: with the FIFO enabled the address
+	// wraps from TEMP_OUT_H back to PRESS_OUT_XL, so reg_adr + indi is not the register which was read
+	if (size == 1)
+	{
+		updateShadow(reg_adr, pdata, size);
+	}
 	lastCode = LPS25HB_CODE_NOM;
 	return true;
 }
@@ -376,9 +553,43 @@ bool LPS25HB::write(uint8_t reg_adr, uint8_t *pdata, uint8_t size)
 
 	if (_i2cPort->endTransmission() == 0)
 	{
+		updateShadow(reg_adr, pdata, size); // Write-through
 		lastCode = LPS25HB_CODE_NOM;
 		return true;
 	}
 
+	for (uint8_t indi = 0; indi < size; indi++) // We no longer know what the device contains
+	{
+		_shadow.invalidate(reg_adr + indi);
+	}
 	return false; // If the sensor did not ACK then endTransmission would have exited with a nonzero return, and that would make us sad
+}
+
+/**
+   * Copy data read from, or successfully written to, consecutive registers into the shadow
+   * Registers which are not shadowed are ignored.
+   * A BOOT or SWRESET (in CTRL_REG2) resets the configuration, so the whole shadow is invalidated
+   * The self-clearing bits (RESET_AZ in CTRL_REG1; AUTOZERO and ONE_SHOT in CTRL_REG2) are never held in the shadow
+*/
+void LPS25HB::updateShadow(uint8_t reg_adr, uint8_t *pdata, uint8_t size)
+{
+	for (uint8_t indi = 0; indi < size; indi++)
+	{
+		uint8_t reg = reg_adr + indi;
+		uint8_t value = *(pdata + indi);
+		if (reg == LPS25HB_REG_CTRL_REG1)
+		{
+			value &= ~LPS25HB_CTRL_REG1_RESET_AZ; // Clears itself once the reset is done
+		}
+		if (reg == LPS25HB_REG_CTRL_REG2)
+		{
+			if (value & (LPS25HB_CTRL_REG2_REBOOT_MEM | LPS25HB_CTRL_REG2_SWRESET))
+			{
+				_shadow.invalidateAll();
+				return;
+			}
+			value &= ~(LPS25HB_CTRL_REG2_AUTOZERO | LPS25HB_CTRL_REG2_ONE_SHOT); // Clear themselves once the autozero / measurement is done
+		}
+		_shadow.write(reg, value);
+	}
 }
\ No newline at end of file
@@ -23,6 +23,9 @@ Owen Lyke
 #endif
 
 #include <Wire.h>
+#include "../COMMON/SFE_QUAD_Register_Shadow.h"
+
+#define LPS25HB_NUM_SHADOWED_REGISTERS 9 // RES_CONF, CTRL_REG1/2/3/4, INTERRUPT_CFG, FIFO_CTRL, THS_P_L/H. The self-clearing bits are masked out
 
 /////////////////////////////////////
 //				Defines
@@ -110,6 +113,17 @@ Owen Lyke
 #define LPS25HB_FIFO_CTRL_M_8 0x07	 // 8 sample moving average
 #define LPS25HB_FIFO_CTRL_M_16 0x0F	// 16 sample moving average
 #define LPS25HB_FIFO_CTRL_M_32 0x1F	// 32 sample moving average
+#define LPS25HB_FIFO_CTRL_WTM 0x1F	 // Watermark level (or number of mean samples - 1 in FIFO Mean mode)
+
+// FIFO Status
+#define LPS25HB_FIFO_STATUS_FTH_FIFO 0x80 // FIFO filling is equal or higher than the watermark level
+#define LPS25HB_FIFO_STATUS_OVR 0x40	  // FIFO is full / has overrun
+#define LPS25HB_FIFO_STATUS_EMPTY 0x20	// FIFO is empty
+#define LPS25HB_FIFO_STATUS_FSS 0x1F	  // FIFO stored data level
+
+#define LPS25HB_FIFO_DEPTH 32		   // The FIFO holds up to 32 pressure and temperature samples
+#define LPS25HB_FIFO_SAMPLE_BYTES 5	// PRESS_OUT_XL to TEMP_OUT_H
+#define LPS25HB_FIFO_BURST_SAMPLES 6   // Samples per burst read. 30 bytes fits in a 32 byte Wire buffer
 
 /////////////////////////////////////
 //				TypeDefs
@@ -191,6 +205,9 @@ public:
 	int32_t getPressure_raw();
 	float getPressure_hPa();
 
+	bool getPressureAndTemperature_raw(int32_t *pressure, int16_t *temperature); // Reads PRESS_OUT and TEMP_OUT in a single burst
+	bool getPressureAndTemperature(float *pressure_hPa, float *temperature_degC);
+
 	// Setters
 	bool setReferencePressure(uint32_t adc_val);
 	bool setPressureThreshold(uint16_t adc_val);
@@ -199,10 +216,17 @@ public:
 	bool setOutputDataRate(uint8_t odr_code);
 	bool setFIFOMode(uint8_t mode_code);
 	bool setFIFOMeanNum(uint8_t mean_num);
+	bool setFIFOWatermark(uint8_t level);
+
+	// FIFO
+	uint8_t getFIFOStatus();
+	uint8_t getFIFOLevel();																// Returns the number of unread samples in the FIFO (0-32)
+	uint8_t readFIFO(int32_t *pressure, int16_t *temperature, uint8_t maxSamples); // Reads up to LPS25HB_FIFO_BURST_SAMPLES samples in one burst
 
 	// Setting Changers
 	bool applySetting(uint8_t reg_adr, uint8_t setting);
 	bool removeSetting(uint8_t reg_adr, uint8_t setting);
+	bool updateSetting(uint8_t reg_adr, uint8_t mask, uint8_t setting);
 
 	// I2C Interface Basics
 	bool read(uint8_t reg_adr, uint8_t *pdata, uint8_t size);
@@ -210,6 +234,11 @@ public:
 
 private:
 	TwoWire *_i2cPort; // Allows user to specify which TwoWire port to use for the connection
+
+	// Write-through shadow of the configuration registers. Settings are read from RAM
+	// and applySetting / removeSetting only write when the register would change
+	SFE_QUAD_Register_Shadow<uint8_t, LPS25HB_NUM_SHADOWED_REGISTERS> _shadow;
+	void updateShadow(uint8_t reg_adr, uint8_t *pdata, uint8_t size);
 };
 
 #endif /* LPS25HB_H */
\ No newline at end of file
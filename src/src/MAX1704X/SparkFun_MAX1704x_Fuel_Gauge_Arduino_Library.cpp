@@ -20,7 +20,9 @@ Distributed as-is; no warranty is given.
 ******************************************************************************/
 #include "SparkFun_MAX1704x_Fuel_Gauge_Arduino_Library.h"
 
-SFE_MAX1704X::SFE_MAX1704X(sfe_max1704x_devices_e device)
+static const uint8_t MAX1704X_SHADOWED_REGISTERS[MAX1704X_NUM_SHADOWED_REGISTERS] = {MAX17048_HIBRT, MAX17048_CVALRT, MAX17048_VRESET_ID};
+
+SFE_MAX1704X::SFE_MAX1704X(sfe_max1704x_devices_e device) : _shadow(MAX1704X_SHADOWED_REGISTERS)
 {
   // Constructor
 
@@ -48,6 +50,7 @@ SFE_MAX1704X::SFE_MAX1704X(sfe_max1704x_devices_e device)
 boolean SFE_MAX1704X::begin(TwoWire &wirePort)
 {
   _i2cPort = &wirePort; //Grab which port the user wants us to use
+  _shadow.invalidateAll(); //We don't know what this device contains yet
 
   if (isConnected() == false)
   {
@@ -155,9 +158,11 @@ uint8_t SFE_MAX1704X::quickStart()
 
 float SFE_MAX1704X::getVoltage()
 {
-  uint16_t vCell;
-  vCell = read16(MAX17043_VCELL);
+  return (vCellToVoltage(read16(MAX17043_VCELL)));
+}
 
+float SFE_MAX1704X::vCellToVoltage(uint16_t vCell)
+{
   if (_device <= MAX1704X_MAX17044)
   {
     // On the MAX17043/44: vCell is a 12-bit register where each bit represents:
@@ -183,15 +188,46 @@ float SFE_MAX1704X::getVoltage()
 
 float SFE_MAX1704X::getSOC()
 {
-  uint16_t soc;
+  return (socToPercent(read16(MAX17043_SOC)));
+}
+
+float SFE_MAX1704X::socToPercent(uint16_t soc)
+{
   float percent;
-  soc = read16(MAX17043_SOC);
   percent = (float)((soc & 0xFF00) >> 8);
   percent += ((float)(soc & 0x00FF)) / 256.0;
 
   return percent;
 }
 
+bool SFE_MAX1704X::readVoltageAndSOC(float *voltage, float *soc)
+{
+  _i2cPort->beginTransmission(MAX1704x_ADDRESS);
+  _i2cPort->write(MAX17043_VCELL);
+  if (_i2cPort->endTransmission(false) != 0) // Don't release the bus
+    return (false);
+
+  if (_i2cPort->requestFrom(MAX1704x_ADDRESS, 4) != 4)
+  {
+    #if MAX1704X_ENABLE_DEBUGLOG
+    if (_printDebug == true)
+    {
+      _debugPort->println(F("readVoltageAndSOC: failed to read data!"));
+    }
+    #endif // if MAX1704X_ENABLE_DEBUGLOG
+    return (false);
+  }
+
+  uint16_t vCell = ((uint16_t)_i2cPort->read()) << 8;
+  vCell |= _i2cPort->read();
+  uint16_t socReg = ((uint16_t)_i2cPort->read()) << 8;
+  socReg |= _i2cPort->read();
+
+  *voltage = vCellToVoltage(vCell);
+  *soc = socToPercent(socReg);
+  return (true);
+}
+
 uint16_t SFE_MAX1704X::getVersion()
 {
   return read16(MAX17043_VERSION);
@@ -408,6 +444,17 @@ uint8_t SFE_MAX1704X::clearStatusRegBits(uint16_t mask)
   return (write16(statusReg, MAX17048_STATUS)); // Write the contents back again
 }
 
+uint8_t SFE_MAX1704X::clearAlertFlags(uint8_t flags)
+{
+  if (_device <= MAX1704X_MAX17044)
+    return (clearAlert()); // The MAX17043/44 only have the ALRT bit
+
+  uint8_t result = clearStatusRegBits(((uint16_t)(flags & 0x7F)) << 8);
+  if (result == 0)
+    result = clearAlert();
+  return (result);
+}
+
 uint8_t SFE_MAX1704X::clearAlert()
 {
   // Read config reg, so we don't modify any other values:
@@ -900,7 +947,14 @@ uint8_t SFE_MAX1704X::write16(uint16_t data, uint8_t address)
   _i2cPort->write(address);
   _i2cPort->write(msb);
   _i2cPort->write(lsb);
-  return (_i2cPort->endTransmission());
+  uint8_t result = _i2cPort->endTransmission();
+  if ((address == MAX17043_COMMAND) && (data == MAX17043_COMMAND_POR))
+    _shadow.invalidateAll(); // The POR restores the defaults (and is not ACK'd)
+  else if (result == 0)
+    _shadow.write(address, data); // Write-through (ignored if address is not shadowed)
+  else
+    _shadow.invalidate(address);
+  return (result);
 }
 
 uint16_t SFE_MAX1704X::read16(uint8_t address)
@@ -909,6 +963,9 @@ uint16_t SFE_MAX1704X::read16(uint8_t address)
   uint8_t retries = 3;
   uint16_t result = 0;
 
+  if (_shadow.read(address, &result)) // Shadowed registers are read from RAM
+    return (result);
+
   while ((success == false) && (retries > 0))
   {
     _i2cPort->beginTransmission(MAX1704x_ADDRESS);
@@ -921,6 +978,7 @@ uint16_t SFE_MAX1704X::read16(uint8_t address)
       uint8_t lsb = _i2cPort->read();
       result = ((uint16_t)msb << 8) | lsb;
       success = true;
+      _shadow.write(address, result); // Fill the shadow (ignored if address is not shadowed)
     }
     else
     {
@@ -32,6 +32,7 @@ Distributed as-is; no warranty is given.
 #endif
 
 #include <Wire.h>
+#include "../COMMON/SFE_QUAD_Register_Shadow.h"
 
 //Enable/disable including debug log (to allow saving some space)
 #ifndef MAX1704X_ENABLE_DEBUGLOG
@@ -70,6 +71,10 @@ typedef enum {
 #define MAX17048_CRATE 0x16     // R - (MAX17048/49) Charge rate 0.208%/hr
 #define MAX17048_VRESET_ID 0x18 // R/W - (MAX17048/49) Reset voltage and ID (default 0x96__)
 #define MAX17048_STATUS 0x1A    // R/W - (MAX17048/49) Status of ID (default 0x01__)
+
+// HIBRT, CVALRT and VRESET_ID only change when we write them, so they are shadowed.
+// CONFIG is not: the ALRT bit is set by the device. STATUS is not either.
+#define MAX1704X_NUM_SHADOWED_REGISTERS 3
 #define MAX17043_COMMAND 0xFE   // W - Sends special comands to IC
 
 ///////////////////////////////////
@@ -160,6 +165,11 @@ public:
   // full charge.
   float getSOC();
 
+  // readVoltageAndSOC() - Read the voltage and state-of-charge in a single 4-byte burst.
+  // VCELL and SOC are contiguous, so this halves the bus traffic compared to getVoltage plus getSOC.
+  // Output: true on success. voltage and soc are scaled as per getVoltage and getSOC.
+  bool readVoltageAndSOC(float *voltage, float *soc);
+
   // getVersion() - Get the MAX17043's production version number.
   // Output: 3 on success
   uint16_t getVersion();
@@ -279,6 +289,12 @@ public:
   bool isLow(bool clear = false);    //True when SOC crosses the value in ATHD (see setThreshold)
   bool isChange(bool clear = false); //True when SOC changes by at least 1% and SOCAlert is enabled
 
+  // clearAlertFlags([flags]) - (MAX17048/49) Clear the specified status flags
+  // (MAX1704x_STATUS_RI etc., unshifted) and the CONFIG ALRT bit, releasing the ALRT pin.
+  // Use this after getStatus to clear all of the flags which were set in one go.
+  // Output: 0 on success, positive integer on fail.
+  uint8_t clearAlertFlags(uint8_t flags);
+
   // getAlert([clear]) - Check if the MAX1704X's ALRT alert interrupt has been
   // triggered.
   // INPUT: [clear] - If [clear] is true, the alert flag will be cleared if it
@@ -379,6 +395,8 @@ private:
   //Variables
   TwoWire *_i2cPort; //The generic connection to user's chosen I2C hardware
 
+  SFE_QUAD_Register_Shadow<uint16_t, MAX1704X_NUM_SHADOWED_REGISTERS> _shadow; //Write-through shadow of the threshold registers
+
   #if MAX1704X_ENABLE_DEBUGLOG
   Stream *_debugPort;          //The stream to send debug messages to if enabled. Usually Serial.
   boolean _printDebug = false; //Flag to print debugging variables
@@ -390,6 +408,10 @@ private:
   // Output: 0 on success, positive integer on fail.
   uint8_t clearStatusRegBits(uint16_t mask);
 
+  // Convert the VCELL and SOC register contents (PRIVATE)
+  float vCellToVoltage(uint16_t vCell);
+  float socToPercent(uint16_t soc);
+
   int _device = MAX1704X_MAX17043; // Default to MAX17043
   float _full_scale = 5.12; // Default: full-scale for the MAX17043
 };
@@ -28,10 +28,22 @@ Distributed as-is; no warranty is given.
 
 /*-------------------------------- Device Status ------------------------*/
 
+static const uint8_t MCP9600_SHADOWED_REGISTERS[MCP9600_NUM_SHADOWED_REGISTERS] = {
+    THERMO_SENSOR_CONFIG,
+    ALERT1_CONFIG, ALERT2_CONFIG, ALERT3_CONFIG, ALERT4_CONFIG,
+    ALERT1_HYSTERESIS, ALERT2_HYSTERESIS, ALERT3_HYSTERESIS, ALERT4_HYSTERESIS};
+
+MCP9600::MCP9600() : _shadow(MCP9600_SHADOWED_REGISTERS)
+{
+  _i2cPort = NULL;
+  _deviceAddress = DEV_ADDR;
+}
+
 bool MCP9600::begin(uint8_t address, TwoWire &wirePort)
 {
   _deviceAddress = address; //grab the address that the sensor is on
   _i2cPort = &wirePort;     //grab the port that the user wants to use
+  _shadow.invalidateAll();  //we don't know what this device contains yet
 
   // This is the old .begin code. See below for the reason we don't use it any more...
   //
@@ -156,6 +168,18 @@ bool MCP9600::isInputRangeExceeded()
   return bitRead(status, 4);
 }
 
+bool MCP9600::getTemperatures(float *thermocouple, float *ambient)
+{
+  uint16_t hot, cold;
+  if (!readDoubleRegister(HOT_JUNC_TEMP, &hot))
+    return false;
+  if (!readDoubleRegister(COLD_JUNC_TEMP, &cold))
+    return false;
+  *thermocouple = ((float)((int16_t)hot) * DEV_RESOLUTION);
+  *ambient = ((float)((int16_t)cold) * DEV_RESOLUTION);
+  return true;
+}
+
 /*--------------------------- Measurement Configuration --------------- */
 
 bool MCP9600::setAmbientResolution(Ambient_Resolution res)
@@ -207,6 +231,7 @@ uint8_t MCP9600::setThermocoupleType(Thermocouple_Type type)
   config |= (type << 4); //set the necessary bits in the config register
   if (writeSingleRegister(THERMO_SENSOR_CONFIG, config))
     return 1; //if write fails, return 1
+  _shadow.invalidate(THERMO_SENSOR_CONFIG); //verify against the device, not the shadow
   if (readSingleRegister(THERMO_SENSOR_CONFIG) != config)
     return 2; //if the register didn't take the new value, return 2
 
@@ -225,11 +250,11 @@ uint8_t MCP9600::setFilterCoefficient(uint8_t coefficient)
     return 3; //return immediately if the value is too big
 
   uint8_t config = readSingleRegister(THERMO_SENSOR_CONFIG);
-  bitWrite(coefficient, 3, bitRead(config, 3));
-  bitWrite(coefficient, 4, bitRead(config, 3));
-  bitWrite(coefficient, 5, bitRead(config, 3));
-  bitWrite(coefficient, 6, bitRead(config, 3));
-  bitWrite(coefficient, 7, bitRead(config, 3));
+  bitWrite(coefficient, 3, bitRead(config, 3)); //preserve the thermocouple type (bits 4-6) and bits 3 and 7
+  bitWrite(coefficient, 4, bitRead(config, 4));
+  bitWrite(coefficient, 5, bitRead(config, 5));
+  bitWrite(coefficient, 6, bitRead(config, 6));
+  bitWrite(coefficient, 7, bitRead(config, 7));
 
   //config = config >> 3;
   //config = config << 3;
@@ -314,6 +339,15 @@ Shutdown_Mode MCP9600::getShutdownMode()
   return static_cast<Shutdown_Mode>(mode); //clear all bits except the last two and return
 }
 
+unsigned long MCP9600::getBurstDuration()
+{
+  uint8_t config = readSingleRegister(DEVICE_CONFIG);
+  const unsigned long thermocoupleMillis[] = {320, 80, 20, 5}; //conversion time for 18, 16, 14 and 12-bit resolution
+  unsigned long samples = 1UL << ((config >> 2) & 0b111);        //burst samples: 1 to 128
+  unsigned long ambientMillis = bitRead(config, 7) ? 63 : 250;   //conversion time for 0.25 and 0.0625 degree C resolution
+  return (samples * thermocoupleMillis[(config >> 5) & 0b11]) + ambientMillis;
+}
+
 /*---------------------------- Temperature Alerts ------------------- */
 
 bool MCP9600::configAlertTemp(uint8_t number, float temp)
@@ -577,6 +611,11 @@ bool MCP9600::isTempGreaterThanLimit(uint8_t number)
 
 uint8_t MCP9600::readSingleRegister(MCP9600_Register reg)
 {
+  //Shadowed configuration registers are read from RAM. This also avoids the clock stretching bug
+  uint8_t data;
+  if (_shadow.read(reg, &data))
+    return data;
+
   //Attempt to read the register until we exit with no error code
   //This attempts to fix the bug where clock stretching sometimes failes, as
   //described in the MCP9600 eratta
@@ -587,7 +626,9 @@ uint8_t MCP9600::readSingleRegister(MCP9600_Register reg)
     _i2cPort->endTransmission();
     if (_i2cPort->requestFrom(_deviceAddress, (uint8_t)1) != 0)
     {
-      return _i2cPort->read();
+      data = _i2cPort->read();
+      _shadow.write(reg, data); //fill the shadow (ignored if reg is not shadowed)
+      return data;
     }
   }
   return (0);
@@ -614,12 +655,44 @@ uint16_t MCP9600::readDoubleRegister(MCP9600_Register reg)
   return (0);
 }
 
+bool MCP9600::readDoubleRegister(MCP9600_Register reg, uint16_t *data)
+{
+  //As above, but report whether the read was successful
+  for (byte attempts = 0; attempts <= retryAttempts; attempts++)
+  {
+    _i2cPort->beginTransmission(_deviceAddress);
+    _i2cPort->write(reg);
+    _i2cPort->endTransmission();
+
+    if (_i2cPort->requestFrom(_deviceAddress, (uint8_t)2) == 2)
+    {
+      *data = _i2cPort->read() << 8;
+      *data |= _i2cPort->read();
+      return true;
+    }
+  }
+  return false;
+}
+
 bool MCP9600::writeSingleRegister(MCP9600_Register reg, uint8_t data)
 {
+  //The interrupt clear bit is write-only. Everything else in a shadowed register is configuration
+  uint8_t shadowed = data;
+  if ((reg >= ALERT1_CONFIG) && (reg <= ALERT4_CONFIG))
+    shadowed &= ~MCP9600_ALERT_CONFIG_INT_CLEAR;
+
+  if ((shadowed == data) && (!_shadow.changes(reg, data)))
+    return false; //the register already contains data. Skip the write
+
   _i2cPort->beginTransmission(_deviceAddress);
   _i2cPort->write(reg);
   _i2cPort->write(data);
-  return (_i2cPort->endTransmission() != 0);
+  bool failed = (_i2cPort->endTransmission() != 0);
+  if (failed)
+    _shadow.invalidate(reg);
+  else
+    _shadow.write(reg, shadowed); //write-through
+  return failed;
 }
 
 bool MCP9600::writeDoubleRegister(MCP9600_Register reg, uint16_t data)
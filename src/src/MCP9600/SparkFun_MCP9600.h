@@ -23,11 +23,14 @@ Distributed as-is; no warranty is given.
 
 #include <Wire.h>
 #include <Arduino.h>
+#include "../COMMON/SFE_QUAD_Register_Shadow.h"
 
 #define DEV_ADDR 0x60 //device address of the MCP9600
 #define DEV_ID_UPPER 0x40 //value of the upper half of the device ID register. lower half is used for device revision
 #define DEV_RESOLUTION 0.0625 //device resolution (temperature in C that the LSB represents)
 #define retryAttempts 3 //how many times to attempt to read a register from the thermocouple before giving up
+#define MCP9600_NUM_SHADOWED_REGISTERS 9 //THERMO_SENSOR_CONFIG, ALERTn_CONFIG and ALERTn_HYSTERESIS are shadowed
+#define MCP9600_ALERT_CONFIG_INT_CLEAR 0x80 //The interrupt clear bit in ALERTn_CONFIG is never held in the shadow
 
 // register pointers for various device functions
 enum MCP9600_Register: uint8_t {
@@ -95,6 +98,7 @@ enum Shutdown_Mode: uint8_t {
 
 class MCP9600{
   public:
+  MCP9600();
 
   //Device status
   bool begin(uint8_t address = DEV_ADDR, TwoWire &wirePort = Wire); //Sets device I2C address to a user-specified address, over whatever port the user specifies. 
@@ -110,6 +114,7 @@ class MCP9600{
   float getTempDelta(bool units = true);                            //Returns the difference in temperature between the thermocouple and ambient junctions. Set units to true for Celcius, or false for freedom units (Fahrenheit)
   signed long getRawADC();                                          //Returns the raw contents of the raw ADC register
   bool isInputRangeExceeded();                                      //Returns true if the MCP9600's EMF range has been exceeded, and false otherwise.
+  bool getTemperatures(float *thermocouple, float *ambient);        //Reads the thermocouple and ambient temperatures in Celcius. Does not touch the status register. Returns true if both reads succeeded.
 
   //Measurement configuration
   bool setAmbientResolution(Ambient_Resolution res);                //Changes the resolution on the cold (ambient) junction, for either 0.0625 or 0.25 degree C resolution. Lower resolution reduces conversion time.
@@ -128,6 +133,7 @@ class MCP9600{
   bool startBurst();                                                //Initiates a burst on the MCP9600.
   bool setShutdownMode(Shutdown_Mode mode);                         //Changes the shutdown "operating" mode of the MCP9600. Configurable to Normal, Shutdown, and Burst. Returns 0 if properly set, 1 otherwise.
   Shutdown_Mode getShutdownMode();                                  //Returns the shutdown "operating" mode of the MCP9600. Configurable to Normal, Shutdown, and Burst.
+  unsigned long getBurstDuration();                                 //Returns the worst-case time in milliseconds for a burst to complete, based on the samples and resolutions in the device's configuration register.
 
 
   //Temperature Alerts 
@@ -145,6 +151,7 @@ class MCP9600{
   //debug
   uint8_t readSingleRegister(MCP9600_Register reg);                 //Attempts to read a single register, will keep trying for retryAttempts amount of times
   uint16_t readDoubleRegister(MCP9600_Register reg);                //Attempts to read two registers, will keep trying for retryAttempts amount of times
+  bool readDoubleRegister(MCP9600_Register reg, uint16_t *data);    //As above, but returns true if the read was successful
   bool writeSingleRegister(MCP9600_Register reg, uint8_t data);     //Attempts to write data into a single 8-bit register. Does not check to make sure it was written successfully. Returns 0 if there wasn't an error on I2C transmission, and 1 otherwise.
   bool writeDoubleRegister(MCP9600_Register reg, uint16_t data);    //Attempts to write data into a double (two 8-bit) registers. Does not check to make sure it was written successfully. Returns 0 if there wasn't an error on I2C transmission, and 1 otherwise.
  
@@ -153,5 +160,6 @@ class MCP9600{
   private:
   TwoWire *_i2cPort;                                                //Generic connection to user's chosen I2C port
   uint8_t _deviceAddress;                                           //I2C address of the MCP9600
+  SFE_QUAD_Register_Shadow<uint8_t, MCP9600_NUM_SHADOWED_REGISTERS> _shadow; //Write-through shadow of the configuration registers. DEVICE_CONFIG is not shadowed as burst mode changes it
 };
 #endif
\ No newline at end of file
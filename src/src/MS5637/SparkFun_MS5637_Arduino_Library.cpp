@@ -238,18 +238,49 @@ boolean MS5637::crc_check(uint16_t *n_prom, uint8_t crc) {
 *       - ms5637_status_no_i2c_acknowledge : I2C did not acknowledge
 */
 enum ms5637_status MS5637::conversion_and_read_adc(uint8_t cmd, uint32_t *adc) {
-  enum ms5637_status status = ms5637_status_ok;
-  uint8_t i2c_status;
-  uint8_t buffer[3];
-  uint8_t i;
+  enum ms5637_status status = start_conversion(cmd);
+  if (status != ms5637_status_ok)
+    return status;
 
-  /* Read data */
+  //delay(conversion_time[(cmd & MS5637_CONVERSION_OSR_MASK) / 2]);
+  delay(conversion_time[ms5637_resolution_osr]); //A simplified way of getting the conversion time
+
+  return read_adc(adc);
+}
+
+/**
+* \brief Triggers a conversion. Does not wait
+*
+* \param[in] uint8_t : Command used for conversion (will determine Temperature
+* vs Pressure and osr)
+*
+* \return ms5637_status : status of MS5637
+*/
+enum ms5637_status MS5637::start_conversion(uint8_t cmd) {
   _i2cPort->beginTransmission((uint8_t)MS5637_ADDR);
   _i2cPort->write((uint8_t)cmd);
-  _i2cPort->endTransmission();
+  uint8_t i2c_status = _i2cPort->endTransmission();
 
-  //delay(conversion_time[(cmd & MS5637_CONVERSION_OSR_MASK) / 2]);
-  delay(conversion_time[ms5637_resolution_osr]); //A simplified way of getting the conversion time
+  if (i2c_status == ms5637_STATUS_ERR_OVERFLOW)
+    return ms5637_status_no_i2c_acknowledge;
+  if (i2c_status != ms5637_STATUS_OK)
+    return ms5637_status_i2c_transfer_error;
+
+  conversion_start = millis();
+  return ms5637_status_ok;
+}
+
+/**
+* \brief Reads the ADC value of the completed conversion
+*
+* \param[out] uint32_t* : ADC value.
+*
+* \return ms5637_status : status of MS5637
+*/
+enum ms5637_status MS5637::read_adc(uint32_t *adc) {
+  uint8_t i2c_status;
+  uint8_t buffer[3];
+  uint8_t i;
 
   _i2cPort->beginTransmission((uint8_t)MS5637_ADDR);
   _i2cPort->write((uint8_t)0x00);
@@ -260,15 +291,6 @@ enum ms5637_status MS5637::conversion_and_read_adc(uint8_t cmd, uint32_t *adc) {
     buffer[i] = _i2cPort->read();
   }
 
-  // delay conversion depending on resolution
-  //if (status != ms5637_status_ok)
-  //  return status;
-
-  // Send the read command
-  // status = ms5637_write_command(MS5637_READ_ADC);
-  //if (status != ms5637_status_ok)
-  //  return status;
-
   if (i2c_status == ms5637_STATUS_ERR_OVERFLOW)
     return ms5637_status_no_i2c_acknowledge;
   if (i2c_status != ms5637_STATUS_OK)
@@ -276,7 +298,7 @@ enum ms5637_status MS5637::conversion_and_read_adc(uint8_t cmd, uint32_t *adc) {
 
   *adc = ((uint32_t)buffer[0] << 16) | ((uint32_t)buffer[1] << 8) | buffer[2];
 
-  return status;
+  return ms5637_status_ok;
 }
 
 /**
@@ -294,10 +316,30 @@ enum ms5637_status MS5637::conversion_and_read_adc(uint8_t cmd, uint32_t *adc) {
 */
 enum ms5637_status MS5637::read_temperature_and_pressure(float *temperature,
                                                          float *pressure) {
+  int32_t temperature_integer, pressure_integer;
+  enum ms5637_status status = read_temperature_and_pressure_integer(&temperature_integer, &pressure_integer);
+  if (status != ms5637_status_ok)
+    return status;
+
+  *temperature = (float)temperature_integer / 100;
+  *pressure = (float)pressure_integer / 100;
+
+  return status;
+}
+
+/**
+* \brief Reads the temperature and pressure ADC value and compute the
+* compensated values using integer math only (datasheet reference algorithm).
+*
+* \param[out] int32_t* : temperature in hundredths of a Celsius Degree
+* \param[out] int32_t* : pressure in hundredths of a mbar (Pa)
+*
+* \return ms5637_status : status of MS5637
+*/
+enum ms5637_status MS5637::read_temperature_and_pressure_integer(int32_t *temperature,
+                                                                 int32_t *pressure) {
   enum ms5637_status status = ms5637_status_ok;
   uint32_t adc_temperature, adc_pressure;
-  int32_t dT, TEMP;
-  int64_t OFF, SENS, P, T2, OFF2, SENS2;
   uint8_t cmd;
 
 
@@ -315,6 +357,22 @@ enum ms5637_status MS5637::read_temperature_and_pressure(float *temperature,
   if (status != ms5637_status_ok)
     return status;
 
+  return compensate(adc_temperature, adc_pressure, temperature, pressure);
+}
+
+/**
+* \brief Compute the compensated temperature and pressure from the D2 and D1 ADC values
+*
+* \param[out] int32_t* : temperature in hundredths of a Celsius Degree
+* \param[out] int32_t* : pressure in hundredths of a mbar (Pa)
+*
+* \return ms5637_status : ms5637_status_i2c_transfer_error if either ADC value is zero
+*/
+enum ms5637_status MS5637::compensate(uint32_t adc_temperature, uint32_t adc_pressure,
+                                      int32_t *temperature, int32_t *pressure) {
+  int32_t dT, TEMP;
+  int64_t OFF, SENS, P, T2, OFF2, SENS2;
+
   if (adc_temperature == 0 || adc_pressure == 0)
     return ms5637_status_i2c_transfer_error;
 
@@ -362,12 +420,90 @@ enum ms5637_status MS5637::read_temperature_and_pressure(float *temperature,
   // Temperature compensated pressure = D1 * SENS - OFF
   P = (((adc_pressure * SENS) >> 21) - OFF) >> 15;
 
-  *temperature = ((float)TEMP - T2) / 100;
-  *pressure = (float)P / 100;
+  *temperature = TEMP - (int32_t)T2;
+  *pressure = (int32_t)P;
+
+  return ms5637_status_ok;
+}
 
+enum ms5637_status MS5637::start_measurement(void)
+{
+  measurement_state = ms5637_measurement_idle;
+  enum ms5637_status status = start_conversion((ms5637_resolution_osr * 2) | MS5637_START_TEMPERATURE_ADC_CONVERSION);
+  if (status == ms5637_status_ok)
+    measurement_state = ms5637_measurement_temperature;
   return status;
 }
 
+enum ms5637_status MS5637::service_measurement(void)
+{
+  if ((measurement_state != ms5637_measurement_temperature) && (measurement_state != ms5637_measurement_pressure))
+    return ms5637_status_ok; // Nothing to do
+  if (measurement_wait() > 0)
+    return ms5637_status_ok; // Conversion still in progress
+
+  enum ms5637_status status;
+  if (measurement_state == ms5637_measurement_temperature)
+  {
+    // Collect D2, start D1
+    status = read_adc(&measurement_adc_temperature);
+    if (status == ms5637_status_ok)
+      status = start_conversion((ms5637_resolution_osr * 2) | MS5637_START_PRESSURE_ADC_CONVERSION);
+    if (status == ms5637_status_ok)
+      measurement_state = ms5637_measurement_pressure;
+  }
+  else
+  {
+    // Collect D1, compensate
+    uint32_t adc_pressure;
+    status = read_adc(&adc_pressure);
+    if (status == ms5637_status_ok)
+      status = compensate(measurement_adc_temperature, adc_pressure, &measurement_temperature, &measurement_pressure);
+    if (status == ms5637_status_ok)
+      measurement_state = ms5637_measurement_complete;
+  }
+
+  if (status != ms5637_status_ok)
+    measurement_state = ms5637_measurement_idle; // Abandon the measurement
+  return status;
+}
+
+enum ms5637_measurement_state MS5637::get_measurement_state(void)
+{
+  return measurement_state;
+}
+
+unsigned long MS5637::measurement_wait(void)
+{
+  if ((measurement_state != ms5637_measurement_temperature) && (measurement_state != ms5637_measurement_pressure))
+    return 0;
+  // millis can tick just after conversion_start was recorded, so elapsed can be up to 1ms more than the real time. Wait for one more tick
+  unsigned long elapsed = millis() - conversion_start;
+  if (elapsed > conversion_time[ms5637_resolution_osr])
+    return 0;
+  return conversion_time[ms5637_resolution_osr] + 1 - elapsed;
+}
+
+enum ms5637_status MS5637::get_measurement(float *temperature, float *pressure)
+{
+  if (measurement_state != ms5637_measurement_complete)
+    return ms5637_status_i2c_transfer_error;
+  *temperature = (float)measurement_temperature / 100;
+  *pressure = (float)measurement_pressure / 100;
+  measurement_state = ms5637_measurement_idle;
+  return ms5637_status_ok;
+}
+
+enum ms5637_status MS5637::get_measurement_integer(int32_t *temperature, int32_t *pressure)
+{
+  if (measurement_state != ms5637_measurement_complete)
+    return ms5637_status_i2c_transfer_error;
+  *temperature = measurement_temperature;
+  *pressure = measurement_pressure;
+  measurement_state = ms5637_measurement_idle;
+  return ms5637_status_ok;
+}
+
 //Returns the latest pressure reading. Will initiate a reading if data is expired
 float MS5637::getPressure()
 {
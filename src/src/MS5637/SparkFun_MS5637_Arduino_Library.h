@@ -78,6 +78,14 @@ enum ms5637_status {
   ms5637_status_crc_error
 };
 
+// States of the non-blocking measurement
+enum ms5637_measurement_state {
+  ms5637_measurement_idle,
+  ms5637_measurement_temperature, // D2 (temperature) conversion in progress
+  ms5637_measurement_pressure,    // D1 (pressure) conversion in progress
+  ms5637_measurement_complete     // Compensated values ready for get_measurement
+};
+
 enum ms5637_status_code {
   ms5637_STATUS_OK = 0,
   ms5637_STATUS_ERR_OVERFLOW = 1,
@@ -139,6 +147,49 @@ class MS5637 {
     enum ms5637_status read_temperature_and_pressure(float *temperature,
         float *pressure);
 
+    /**
+      \brief As read_temperature_and_pressure, but returns the compensated values
+      as scaled integers so no floating point is needed (e.g. on SAMD21 / M0).
+
+      \param[out] int32_t* : temperature in hundredths of a Celsius Degree
+      \param[out] int32_t* : pressure in hundredths of a mbar (Pa)
+
+      \return ms5637_status : status of MS5637
+    */
+    enum ms5637_status read_temperature_and_pressure_integer(int32_t *temperature,
+        int32_t *pressure);
+
+    /**
+      \brief Non-blocking measurement. Start the temperature (D2) conversion.
+      Call service_measurement whenever measurement_wait returns zero:
+      the first call collects D2 and starts the pressure (D1) conversion;
+      the second collects D1 and computes the compensated values.
+      Several devices can be interleaved: start them all, then service them all.
+
+      \return ms5637_status : status of MS5637
+    */
+    enum ms5637_status start_measurement(void);
+
+    /**
+      \brief Advance the non-blocking measurement. Does nothing if the conversion
+      in progress is not yet complete.
+
+      \return ms5637_status : status of MS5637. On error, the measurement is abandoned
+    */
+    enum ms5637_status service_measurement(void);
+
+    enum ms5637_measurement_state get_measurement_state(void); //Returns the state of the non-blocking measurement
+    unsigned long measurement_wait(void); //Returns the time (ms) until the conversion in progress is complete
+
+    /**
+      \brief Return the compensated values from the non-blocking measurement.
+      The state returns to idle.
+
+      \return ms5637_status : ms5637_status_i2c_transfer_error if the measurement is not complete
+    */
+    enum ms5637_status get_measurement(float *temperature, float *pressure);
+    enum ms5637_status get_measurement_integer(int32_t *temperature, int32_t *pressure); //As get_measurement: hundredths of a Celsius Degree and of a mbar
+
     float getPressure(); //Returns the latest pressure measurement
     float getTemperature(); //Returns the latest temperature measurement
     double adjustToSeaLevel(double absolutePressure, double actualAltitude);
@@ -149,6 +200,10 @@ class MS5637 {
     enum ms5637_status read_eeprom_coeff(uint8_t command, uint16_t *coeff);
     boolean crc_check(uint16_t *n_prom, uint8_t crc);
     enum ms5637_status conversion_and_read_adc(uint8_t cmd, uint32_t *adc);
+    enum ms5637_status start_conversion(uint8_t cmd);
+    enum ms5637_status read_adc(uint32_t *adc);
+    enum ms5637_status compensate(uint32_t adc_temperature, uint32_t adc_pressure,
+        int32_t *temperature, int32_t *pressure);
     enum ms5637_status read_eeprom(void);
 
     uint16_t eeprom_coeff[MS5637_COEFFICIENT_COUNT + 1];
@@ -166,6 +221,13 @@ class MS5637 {
       MS5637_CONVERSION_TIME_OSR_4096, MS5637_CONVERSION_TIME_OSR_8192
     };
 
+    //Non-blocking measurement
+    enum ms5637_measurement_state measurement_state = ms5637_measurement_idle;
+    unsigned long conversion_start; //millis when the conversion in progress was started
+    uint32_t measurement_adc_temperature; //D2
+    int32_t measurement_temperature; //Hundredths of a Celsius Degree
+    int32_t measurement_pressure; //Hundredths of a mbar
+
     TwoWire *_i2cPort; //The generic connection to user's chosen I2C hardware
     float globalPressure;
     boolean pressureHasBeenRead = true;
@@ -212,6 +212,32 @@ MS8607::read_temperature_pressure_humidity(float *t, float *p, float *h)
   return status;
 }
 
+/*
+  \brief Reads the temperature, pressure and relative humidity value using
+         integer math only (datasheet reference algorithm). No floating point is needed.
+
+  \param[out] int32_t* : temperature in hundredths of a degC
+  \param[out] int32_t* : pressure in hundredths of a mbar (Pa)
+  \param[out] int32_t* : Relative Humidity in hundredths of a %RH
+
+  \return MS8607_status : status of MS8607
+*/
+enum MS8607_status
+MS8607::read_temperature_pressure_humidity_integer(int32_t *t, int32_t *p, int32_t *h)
+{
+  enum MS8607_status status = psensor_read_pressure_and_temperature_integer(t, p);
+  if (status != MS8607_status_ok)
+    return status;
+
+  uint16_t adc;
+  status = hsensor_humidity_conversion_and_read_adc(&adc);
+  if (status != MS8607_status_ok)
+    return status;
+
+  *h = hsensor_humidity_to_integer(adc);
+  return status;
+}
+
 /******************** Functions from humidity sensor ********************/
 
 /*
@@ -428,39 +454,74 @@ MS8607::set_humidity_resolution(enum MS8607_humidity_resolution res)
 enum MS8607_status
 MS8607::hsensor_humidity_conversion_and_read_adc(uint16_t *adc)
 {
-  enum MS8607_status status = MS8607_status_ok;
-  uint8_t i2c_status;
-  uint16_t _adc;
-  uint8_t buffer[3];
-  uint8_t crc;
-  uint8_t i;
-
-  /* Read data */
-  _i2cPort->beginTransmission((uint8_t)MS8607_HSENSOR_ADDR);
+  enum MS8607_status status;
 
   if (hsensor_i2c_master_mode == MS8607_i2c_hold)
   {
+    _i2cPort->beginTransmission((uint8_t)MS8607_HSENSOR_ADDR);
     _i2cPort->write(HSENSOR_READ_HUMIDITY_W_HOLD_COMMAND);
-    i2c_status = _i2cPort->endTransmission();
+    uint8_t i2c_status = _i2cPort->endTransmission();
+    if (i2c_status == i2c_status_err_overflow)
+      return MS8607_status_no_i2c_acknowledge;
+    if (i2c_status != i2c_status_ok)
+      return MS8607_status_i2c_transfer_error;
   }
   else
   {
-    _i2cPort->write(HSENSOR_READ_HUMIDITY_WO_HOLD_COMMAND);
-    i2c_status = _i2cPort->endTransmission();
+    status = hsensor_start_humidity_conversion();
+    if (status != MS8607_status_ok)
+      return status;
     // delay depending on resolution
     delay(hsensor_conversion_time);
   }
-  _i2cPort->requestFrom((uint8_t)MS8607_HSENSOR_ADDR, (uint8_t)3);
-  for (i = 0; i < 3; i++)
-  {
-    buffer[i] = _i2cPort->read();
-  }
+
+  return hsensor_read_humidity_adc(adc);
+}
+
+/*
+  \brief Starts a relative humidity conversion in no-hold mode. Does not wait
+
+  \return MS8607_status : status of MS8607
+*/
+enum MS8607_status MS8607::hsensor_start_humidity_conversion(void)
+{
+  _i2cPort->beginTransmission((uint8_t)MS8607_HSENSOR_ADDR);
+  _i2cPort->write(HSENSOR_READ_HUMIDITY_WO_HOLD_COMMAND);
+  uint8_t i2c_status = _i2cPort->endTransmission();
 
   if (i2c_status == i2c_status_err_overflow)
     return MS8607_status_no_i2c_acknowledge;
   if (i2c_status != i2c_status_ok)
     return MS8607_status_i2c_transfer_error;
 
+  return MS8607_status_ok;
+}
+
+/*
+  \brief Reads the relative humidity ADC value of the completed conversion
+
+  \param[out] uint16_t* : Relative humidity ADC value.
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_crc_error : CRC check error
+*/
+enum MS8607_status MS8607::hsensor_read_humidity_adc(uint16_t *adc)
+{
+  enum MS8607_status status;
+  uint16_t _adc;
+  uint8_t buffer[3];
+  uint8_t crc;
+  uint8_t i;
+
+  if (_i2cPort->requestFrom((uint8_t)MS8607_HSENSOR_ADDR, (uint8_t)3) != 3)
+    return MS8607_status_i2c_transfer_error;
+  for (i = 0; i < 3; i++)
+  {
+    buffer[i] = _i2cPort->read();
+  }
+
   _adc = (buffer[0] << 8) | buffer[1];
   crc = buffer[2];
 
@@ -500,6 +561,16 @@ enum MS8607_status MS8607::hsensor_read_relative_humidity(float *humidity)
   return status;
 }
 
+/*
+  \brief Convert the relative humidity ADC value to hundredths of a %RH using integer math
+
+  \return int32_t : Relative Humidity in hundredths of a %RH
+*/
+int32_t MS8607::hsensor_humidity_to_integer(uint16_t adc)
+{
+  return ((((int32_t)adc * HUMIDITY_COEFF_MUL * 100) >> 16) + (HUMIDITY_COEFF_ADD * 100));
+}
+
 /*
   \brief Returns result of compensated humidity
          Note : This function shall only be used when the heater is OFF. It
@@ -741,23 +812,47 @@ enum MS8607_status MS8607::psensor_read_eeprom(void)
 enum MS8607_status MS8607::psensor_conversion_and_read_adc(uint8_t cmd,
                                                            uint32_t *adc)
 {
-  uint8_t i2c_status;
-  uint8_t buffer[3];
-  uint8_t i;
+  enum MS8607_status status = psensor_start_conversion(cmd);
+  if (status != MS8607_status_ok)
+    return status;
 
-  /* Read data */
+  // 20ms wait for conversion
+  //delay(psensor_conversion_time[(cmd & PSENSOR_CONVERSION_OSR_MASK) / 2]);
+  delay(psensor_conversion_time[psensor_resolution_osr]);
+
+  return psensor_read_adc(adc);
+}
+
+/*
+  \brief Triggers a pressure sensor conversion. Does not wait
+
+  \return MS8607_status : status of MS8607
+*/
+enum MS8607_status MS8607::psensor_start_conversion(uint8_t cmd)
+{
   _i2cPort->beginTransmission((uint8_t)MS8607_PSENSOR_ADDR);
   _i2cPort->write(cmd);
-  i2c_status = _i2cPort->endTransmission();
+  uint8_t i2c_status = _i2cPort->endTransmission();
 
   if (i2c_status == i2c_status_err_overflow)
     return MS8607_status_no_i2c_acknowledge;
   if (i2c_status != i2c_status_ok)
     return MS8607_status_i2c_transfer_error;
 
-  // 20ms wait for conversion
-  //delay(psensor_conversion_time[(cmd & PSENSOR_CONVERSION_OSR_MASK) / 2]);
-  delay(psensor_conversion_time[psensor_resolution_osr]);
+  conversion_start = millis();
+  return MS8607_status_ok;
+}
+
+/*
+  \brief Reads the pressure sensor ADC value of the completed conversion
+
+  \return MS8607_status : status of MS8607
+*/
+enum MS8607_status MS8607::psensor_read_adc(uint32_t *adc)
+{
+  uint8_t i2c_status;
+  uint8_t buffer[3];
+  uint8_t i;
 
   // Send the read command
   _i2cPort->beginTransmission((uint8_t)MS8607_PSENSOR_ADDR);
@@ -793,10 +888,31 @@ enum MS8607_status MS8607::psensor_conversion_and_read_adc(uint8_t cmd,
 enum MS8607_status
 MS8607::psensor_read_pressure_and_temperature(float *temperature,
                                               float *pressure)
+{
+  int32_t temperature_integer, pressure_integer;
+  enum MS8607_status status = psensor_read_pressure_and_temperature_integer(&temperature_integer, &pressure_integer);
+  if (status != MS8607_status_ok)
+    return status;
+
+  *temperature = (float)temperature_integer / 100;
+  *pressure = (float)pressure_integer / 100;
+
+  return status;
+}
+
+/*
+  \brief Compute temperature and pressure using integer math only
+
+  \param[out] int32_t* : temperature in hundredths of a Celsius Degree
+  \param[out] int32_t* : pressure in hundredths of a mbar (Pa)
+
+  \return MS8607_status : status of MS8607
+*/
+enum MS8607_status
+MS8607::psensor_read_pressure_and_temperature_integer(int32_t *temperature,
+                                                      int32_t *pressure)
 {
   uint32_t adc_temperature, adc_pressure;
-  int32_t dT, TEMP;
-  int64_t OFF, SENS, P, T2, OFF2, SENS2;
   uint8_t cmd;
 
   // First read temperature
@@ -813,6 +929,23 @@ MS8607::psensor_read_pressure_and_temperature(float *temperature,
   if (status != MS8607_status_ok)
     return status;
 
+  return psensor_compensate(adc_temperature, adc_pressure, temperature, pressure);
+}
+
+/*
+  \brief Compute the compensated temperature and pressure from the D2 and D1 ADC values
+
+  \param[out] int32_t* : temperature in hundredths of a Celsius Degree
+  \param[out] int32_t* : pressure in hundredths of a mbar (Pa)
+
+  \return MS8607_status : MS8607_status_i2c_transfer_error if either ADC value is zero
+*/
+enum MS8607_status MS8607::psensor_compensate(uint32_t adc_temperature, uint32_t adc_pressure,
+                                              int32_t *temperature, int32_t *pressure)
+{
+  int32_t dT, TEMP;
+  int64_t OFF, SENS, P, T2, OFF2, SENS2;
+
   if (adc_temperature == 0 || adc_pressure == 0)
     return MS8607_status_i2c_transfer_error;
 
@@ -861,12 +994,105 @@ MS8607::psensor_read_pressure_and_temperature(float *temperature,
   // Temperature compensated pressure = D1 * SENS - OFF
   P = (((adc_pressure * SENS) >> 21) - OFF) >> 15;
 
-  *temperature = ((float)TEMP - T2) / 100;
-  *pressure = (float)P / 100;
+  *temperature = TEMP - (int32_t)T2;
+  *pressure = (int32_t)P;
 
+  return MS8607_status_ok;
+}
+
+enum MS8607_status MS8607::start_measurement(void)
+{
+  measurement_state = MS8607_measurement_idle;
+  enum MS8607_status status = hsensor_start_humidity_conversion();
+  if (status == MS8607_status_ok)
+    status = psensor_start_conversion((psensor_resolution_osr * 2) | PSENSOR_START_TEMPERATURE_ADC_CONVERSION);
+  if (status == MS8607_status_ok)
+    measurement_state = MS8607_measurement_temperature;
   return status;
 }
 
+enum MS8607_status MS8607::service_measurement(void)
+{
+  if ((measurement_state != MS8607_measurement_temperature) && (measurement_state != MS8607_measurement_pressure))
+    return MS8607_status_ok; // Nothing to do
+  if (measurement_wait() > 0)
+    return MS8607_status_ok; // Conversion(s) still in progress
+
+  enum MS8607_status status;
+  if (measurement_state == MS8607_measurement_temperature)
+  {
+    // Collect D2 and humidity, start D1
+    status = psensor_read_adc(&measurement_adc_temperature);
+    if (status == MS8607_status_ok)
+      status = hsensor_read_humidity_adc(&measurement_adc_humidity);
+    if (status == MS8607_status_ok)
+      status = psensor_start_conversion((psensor_resolution_osr * 2) | PSENSOR_START_PRESSURE_ADC_CONVERSION);
+    if (status == MS8607_status_ok)
+      measurement_state = MS8607_measurement_pressure;
+  }
+  else
+  {
+    // Collect D1, compensate
+    uint32_t adc_pressure;
+    status = psensor_read_adc(&adc_pressure);
+    if (status == MS8607_status_ok)
+      status = psensor_compensate(measurement_adc_temperature, adc_pressure, &measurement_temperature, &measurement_pressure);
+    if (status == MS8607_status_ok)
+      measurement_state = MS8607_measurement_complete;
+  }
+
+  if (status != MS8607_status_ok)
+    measurement_state = MS8607_measurement_idle; // Abandon the measurement
+  return status;
+}
+
+enum MS8607_measurement_state MS8607::get_measurement_state(void)
+{
+  return measurement_state;
+}
+
+unsigned long MS8607::measurement_wait(void)
+{
+  unsigned long conversion_time;
+  if (measurement_state == MS8607_measurement_temperature)
+  {
+    conversion_time = psensor_conversion_time[psensor_resolution_osr];
+    if (hsensor_conversion_time > conversion_time) // Wait for the humidity conversion too
+      conversion_time = hsensor_conversion_time;
+  }
+  else if (measurement_state == MS8607_measurement_pressure)
+    conversion_time = psensor_conversion_time[psensor_resolution_osr];
+  else
+    return 0;
+  // millis can tick just after conversion_start was recorded, so elapsed can be up to 1ms more than the real time. Wait for one more tick
+  unsigned long elapsed = millis() - conversion_start;
+  if (elapsed > conversion_time)
+    return 0;
+  return conversion_time + 1 - elapsed;
+}
+
+enum MS8607_status MS8607::get_measurement(float *t, float *p, float *h)
+{
+  if (measurement_state != MS8607_measurement_complete)
+    return MS8607_status_i2c_transfer_error;
+  *t = (float)measurement_temperature / 100;
+  *p = (float)measurement_pressure / 100;
+  *h = (float)measurement_adc_humidity * HUMIDITY_COEFF_MUL / (1UL << 16) + HUMIDITY_COEFF_ADD;
+  measurement_state = MS8607_measurement_idle;
+  return MS8607_status_ok;
+}
+
+enum MS8607_status MS8607::get_measurement_integer(int32_t *t, int32_t *p, int32_t *h)
+{
+  if (measurement_state != MS8607_measurement_complete)
+    return MS8607_status_i2c_transfer_error;
+  *t = measurement_temperature;
+  *p = measurement_pressure;
+  *h = hsensor_humidity_to_integer(measurement_adc_humidity);
+  measurement_state = MS8607_measurement_idle;
+  return MS8607_status_ok;
+}
+
 //Returns the latest pressure reading. Will initiate a reading if data is expired
 float MS8607::getPressure()
 {
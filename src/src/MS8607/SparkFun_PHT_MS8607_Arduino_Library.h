@@ -202,6 +202,15 @@ enum MS8607_pressure_resolution
        MS8607_pressure_resolution_osr_8192
 };
 
+// States of the non-blocking measurement
+enum MS8607_measurement_state
+{
+       MS8607_measurement_idle,
+       MS8607_measurement_temperature, // D2 (temperature) and humidity conversions in progress
+       MS8607_measurement_pressure,    // D1 (pressure) conversion in progress
+       MS8607_measurement_complete     // Compensated values ready for get_measurement
+};
+
 enum i2c_status_code
 {
        i2c_status_ok = 0x00,
@@ -303,6 +312,50 @@ public:
        enum MS8607_status read_temperature_pressure_humidity(float *t, float *p,
                                                              float *h);
 
+       /*
+   \brief As read_temperature_pressure_humidity, but returns the compensated values
+    as scaled integers so no floating point is needed (e.g. on SAMD21 / M0).
+
+   \param[out] int32_t* : temperature in hundredths of a degC
+   \param[out] int32_t* : pressure in hundredths of a mbar (Pa)
+   \param[out] int32_t* : Relative Humidity in hundredths of a %RH
+
+   \return MS8607_status : status of MS8607
+  */
+       enum MS8607_status read_temperature_pressure_humidity_integer(int32_t *t, int32_t *p,
+                                                                     int32_t *h);
+
+       /*
+   \brief Non-blocking measurement. Start the temperature (D2) and humidity conversions.
+    Call service_measurement whenever measurement_wait returns zero:
+    the first call collects D2 and humidity and starts the pressure (D1) conversion;
+    the second collects D1 and computes the compensated values.
+    Several devices can be interleaved: start them all, then service them all.
+    The humidity conversion always uses no-hold mode, so it runs in parallel with D2.
+
+   \return MS8607_status : status of MS8607
+  */
+       enum MS8607_status start_measurement(void);
+
+       /*
+   \brief Advance the non-blocking measurement. Does nothing if the conversion
+    in progress is not yet complete.
+
+   \return MS8607_status : status of MS8607. On error, the measurement is abandoned
+  */
+       enum MS8607_status service_measurement(void);
+
+       enum MS8607_measurement_state get_measurement_state(void); //Returns the state of the non-blocking measurement
+       unsigned long measurement_wait(void); //Returns the time (ms) until the conversion in progress is complete
+
+       /*
+   \brief Return the values from the non-blocking measurement. The state returns to idle.
+
+   \return MS8607_status : MS8607_status_i2c_transfer_error if the measurement is not complete
+  */
+       enum MS8607_status get_measurement(float *t, float *p, float *h);
+       enum MS8607_status get_measurement_integer(int32_t *t, int32_t *p, int32_t *h); //As get_measurement: hundredths of a degC, mbar and %RH
+
        /******************** Functions from humidity sensor ********************/
 
        /*
@@ -466,6 +519,9 @@ private:
           - MS8607_status_crc_error : CRC check error
   */
        enum MS8607_status hsensor_humidity_conversion_and_read_adc(uint16_t *adc);
+       enum MS8607_status hsensor_start_humidity_conversion(void); //Start a no-hold conversion. Does not wait
+       enum MS8607_status hsensor_read_humidity_adc(uint16_t *adc); //Read the completed conversion and check the CRC
+       int32_t hsensor_humidity_to_integer(uint16_t adc); //Convert to hundredths of a %RH
 
        /*
    \brief Reads the relative humidity value.
@@ -551,6 +607,8 @@ private:
   */
        enum MS8607_status psensor_read_pressure_and_temperature(float *temperature,
                                                                 float *pressure);
+       enum MS8607_status psensor_read_pressure_and_temperature_integer(int32_t *temperature,
+                                                                        int32_t *pressure); //Hundredths of a degC and mbar
 
        /*
    \brief Triggers conversion and read ADC value
@@ -566,6 +624,18 @@ private:
   */
        enum MS8607_status psensor_conversion_and_read_adc(uint8_t cmd,
                                                           uint32_t *adc);
+       enum MS8607_status psensor_start_conversion(uint8_t cmd); //Does not wait
+       enum MS8607_status psensor_read_adc(uint32_t *adc);
+       enum MS8607_status psensor_compensate(uint32_t adc_temperature, uint32_t adc_pressure,
+                                             int32_t *temperature, int32_t *pressure);
+
+       //Non-blocking measurement
+       enum MS8607_measurement_state measurement_state = MS8607_measurement_idle;
+       unsigned long conversion_start; //millis when the conversion(s) in progress were started
+       uint32_t measurement_adc_temperature; //D2
+       int32_t measurement_temperature; //Hundredths of a degC
+       int32_t measurement_pressure; //Hundredths of a mbar
+       uint16_t measurement_adc_humidity;
 
        uint32_t hsensor_conversion_time;
        bool hsensor_heater_on;
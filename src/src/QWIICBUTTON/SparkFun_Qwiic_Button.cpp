@@ -27,12 +27,22 @@ Distributed as-is; no warranty is given.
 #include "WProgram.h"
 #endif
 
+static const uint8_t SFE_QWIIC_BUTTON_SHADOWED_REGISTERS[SFE_QWIIC_BUTTON_NUM_SHADOWED_REGISTERS] = {
+    SFE_QWIIC_BUTTON_INTERRUPT_CONFIG, SFE_QWIIC_BUTTON_BUTTON_DEBOUNCE_TIME,
+    SFE_QWIIC_BUTTON_LED_BRIGHTNESS, SFE_QWIIC_BUTTON_LED_PULSE_GRANULARITY,
+    SFE_QWIIC_BUTTON_LED_PULSE_CYCLE_TIME, SFE_QWIIC_BUTTON_LED_PULSE_OFF_TIME};
+
+QwiicButton::QwiicButton() : _shadow(SFE_QWIIC_BUTTON_SHADOWED_REGISTERS)
+{
+}
+
 /*-------------------------------- Device Status ------------------------*/
 
 bool QwiicButton::begin(uint8_t address, TwoWire &wirePort)
 {
     _deviceAddress = address; //grab the address that the sensor is on
     _i2cPort = &wirePort;     //grab the port that the user wants to use
+    _shadow.invalidateAll();  //we don't know what this device contains yet
 
     //return true if the device is connected and the device ID is what we expect
     return (isConnected() && checkDeviceID());
@@ -261,6 +271,47 @@ unsigned long QwiicButton::popClickedQueue()
     return tempData;
 }
 
+//both queues
+bool QwiicButton::readQueues(bool *pressedEmpty, unsigned long *oldestPress, bool *clickedEmpty, unsigned long *oldestClick)
+{
+    //The pressed queue status, front and back are followed by the clicked queue status, front and back
+    const uint8_t numBytes = SFE_QWIIC_BUTTON_CLICKED_QUEUE_BACK + 4 - SFE_QWIIC_BUTTON_PRESSED_QUEUE_STATUS;
+    uint8_t data[numBytes];
+
+    _i2cPort->beginTransmission(_deviceAddress);
+    _i2cPort->write(SFE_QWIIC_BUTTON_PRESSED_QUEUE_STATUS);
+    if (_i2cPort->endTransmission() != 0)
+        return false;
+
+    if (_i2cPort->requestFrom(_deviceAddress, numBytes) != numBytes)
+        return false;
+    for (uint8_t i = 0; i < numBytes; i++)
+        data[i] = _i2cPort->read();
+
+    queueStatusBitField pressedQueueStatus;
+    pressedQueueStatus.byteWrapped = data[0];
+    *pressedEmpty = pressedQueueStatus.isEmpty;
+    uint8_t back = SFE_QWIIC_BUTTON_PRESSED_QUEUE_BACK - SFE_QWIIC_BUTTON_PRESSED_QUEUE_STATUS;
+    *oldestPress = ((unsigned long)data[back + 3] << 24) | ((unsigned long)data[back + 2] << 16) | ((unsigned long)data[back + 1] << 8) | data[back]; //little endian
+
+    queueStatusBitField clickedQueueStatus;
+    clickedQueueStatus.byteWrapped = data[SFE_QWIIC_BUTTON_CLICKED_QUEUE_STATUS - SFE_QWIIC_BUTTON_PRESSED_QUEUE_STATUS];
+    *clickedEmpty = clickedQueueStatus.isEmpty;
+    back = SFE_QWIIC_BUTTON_CLICKED_QUEUE_BACK - SFE_QWIIC_BUTTON_PRESSED_QUEUE_STATUS;
+    *oldestClick = ((unsigned long)data[back + 3] << 24) | ((unsigned long)data[back + 2] << 16) | ((unsigned long)data[back + 1] << 8) | data[back];
+
+    return true;
+}
+
+bool QwiicButton::popQueue(Qwiic_Button_Register queueStatus)
+{
+    //isEmpty and isFull are user immutable, so only popRequest needs to be written
+    queueStatusBitField status;
+    status.byteWrapped = 0;
+    status.popRequest = 1;
+    return writeSingleRegister(queueStatus, status.byteWrapped);
+}
+
 /*------------------------ LED Configuration ------------------------ */
 bool QwiicButton::LEDconfig(uint8_t brightness, uint16_t cycleTime, uint16_t offTime, uint8_t granularity)
 {
@@ -285,6 +336,10 @@ bool QwiicButton::LEDon(uint8_t brightness)
 
 uint8_t QwiicButton::readSingleRegister(Qwiic_Button_Register reg)
 {
+    uint16_t shadowed;
+    if (_shadow.read(reg, &shadowed)) //shadowed registers are read from RAM
+        return (uint8_t)shadowed;
+
     _i2cPort->beginTransmission(_deviceAddress);
     _i2cPort->write(reg);
     _i2cPort->endTransmission();
@@ -293,13 +348,19 @@ uint8_t QwiicButton::readSingleRegister(Qwiic_Button_Register reg)
     //doesn't give us a warning about multiple candidates
     if (_i2cPort->requestFrom(_deviceAddress, static_cast<uint8_t>(1)) != 0)
     {
-        return _i2cPort->read();
+        uint8_t data = _i2cPort->read();
+        _shadow.write(reg, data); //fill the shadow (ignored if reg is not shadowed)
+        return data;
     }
     return 0;
 }
 
 uint16_t QwiicButton::readDoubleRegister(Qwiic_Button_Register reg)
 { //little endian
+    uint16_t shadowed;
+    if (_shadow.read(reg, &shadowed)) //shadowed registers are read from RAM
+        return shadowed;
+
     _i2cPort->beginTransmission(_deviceAddress);
     _i2cPort->write(reg);
     _i2cPort->endTransmission();
@@ -310,6 +371,7 @@ uint16_t QwiicButton::readDoubleRegister(Qwiic_Button_Register reg)
     {
         uint16_t data = _i2cPort->read();
         data |= (_i2cPort->read() << 8);
+        _shadow.write(reg, data); //fill the shadow (ignored if reg is not shadowed)
         return data;
     }
     return 0;
@@ -342,22 +404,36 @@ unsigned long QwiicButton::readQuadRegister(Qwiic_Button_Register reg)
 
 bool QwiicButton::writeSingleRegister(Qwiic_Button_Register reg, uint8_t data)
 {
+    if (_shadow.changes(reg, data) == false) //nothing to do if the register already holds data
+        return true;
+
     _i2cPort->beginTransmission(_deviceAddress);
     _i2cPort->write(reg);
     _i2cPort->write(data);
     if (_i2cPort->endTransmission() == 0)
+    {
+        _shadow.write(reg, data); //write-through
         return true;
+    }
+    _shadow.invalidate(reg); //we no longer know what the device contains
     return false;
 }
 
 bool QwiicButton::writeDoubleRegister(Qwiic_Button_Register reg, uint16_t data)
 {
+    if (_shadow.changes(reg, data) == false) //nothing to do if the register already holds data
+        return true;
+
     _i2cPort->beginTransmission(_deviceAddress);
     _i2cPort->write(reg);
     _i2cPort->write(lowByte(data));
     _i2cPort->write(highByte(data));
     if (_i2cPort->endTransmission() == 0)
+    {
+        _shadow.write(reg, data); //write-through
         return true;
+    }
+    _shadow.invalidate(reg); //we no longer know what the device contains
     return false;
 }
 
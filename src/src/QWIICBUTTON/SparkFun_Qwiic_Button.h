@@ -25,17 +25,23 @@ Distributed as-is; no warranty is given.
 #include <Wire.h>
 #include <Arduino.h>
 #include "registers.h"
+#include "../COMMON/SFE_QUAD_Register_Shadow.h"
 
 #define SFE_QWIIC_BUTTON_DEFAULT_ADDRESS 0x6F //default I2C address of the button
 #define SFE_QWIIC_BUTTON_DEV_ID 0x5D          //device ID of the Qwiic Button
 
+#define SFE_QWIIC_BUTTON_NUM_SHADOWED_REGISTERS 6 //INTERRUPT_CONFIG, BUTTON_DEBOUNCE_TIME and the four LED registers are shadowed
+
 class QwiicButton
 {
 private:
     TwoWire *_i2cPort;      //Generic connection to user's chosen I2C port
     uint8_t _deviceAddress; //I2C address of the button/switch
+    SFE_QUAD_Register_Shadow<uint16_t, SFE_QWIIC_BUTTON_NUM_SHADOWED_REGISTERS> _shadow; //Write-through shadow of the configuration registers. The status and queue registers are changed by the button so are not shadowed
 
 public:
+    QwiicButton();
+
     //Device status
     bool begin(uint8_t address = SFE_QWIIC_BUTTON_DEFAULT_ADDRESS, TwoWire &wirePort = Wire); //Sets device I2C address to a user-specified address, over whatever port the user specifies.
     bool isConnected();                                                      //Returns true if the button/switch will acknowledge over I2C, and false otherwise
@@ -74,6 +80,10 @@ public:
     unsigned long timeSinceFirstClick(); //Returns how many milliseconds it has been since the first button click. Since this returns a 32-bit unsigned int, it will roll over about every 50 days.
     unsigned long popClickedQueue();     //Returns the oldest value in the queue (milliseconds since first button click), and then removes it.
 
+    bool readQueues(bool *pressedEmpty, unsigned long *oldestPress,
+                    bool *clickedEmpty, unsigned long *oldestClick); //Reads the status and oldest value of both queues in a single burst read. Returns true if the read was successful.
+    bool popQueue(Qwiic_Button_Register queueStatus);               //Removes the oldest value from the pressed (SFE_QWIIC_BUTTON_PRESSED_QUEUE_STATUS) or clicked (SFE_QWIIC_BUTTON_CLICKED_QUEUE_STATUS) queue, without reading it. Returns true if the write was successful.
+
     //LED configuration
     bool LEDconfig(uint8_t brightness, uint16_t cycleTime,
                    uint16_t offTime, uint8_t granularity = 1); //Configures the LED with the given max brightness, granularity (1 is fine for most applications), cycle time, and off time.
@@ -285,10 +285,11 @@ bool SCD30::dataAvailable()
 // Get 18 bytes from SCD30
 // Updates global variables with floats
 // Returns true if success
-bool SCD30::readMeasurement()
+// Set checkDataReady to false if dataAvailable has already been called - to avoid reading the status twice
+bool SCD30::readMeasurement(bool checkDataReady)
 {
   // Verify we have data from the sensor
-  if (dataAvailable() == false)
+  if ((checkDataReady) && (dataAvailable() == false))
     return (false);
 
   ByteToFl tempCO2;
@@ -307,58 +308,7 @@ bool SCD30::readMeasurement()
   delay(3);
 
   const uint8_t receivedBytes = _i2cPort->requestFrom((uint8_t)SCD30_ADDRESS, (uint8_t)18);
-  bool error = false;
-  if (_i2cPort->available())
-  {
-    uint8_t bytesToCrc[2];
-    for (uint8_t x = 0; x < 18; x++)
-    {
-      uint8_t incoming = _i2cPort->read();
-
-      switch (x)
-      {
-      case 0:
-      case 1:
-      case 3:
-      case 4:
-        tempCO2.array[x < 3 ? 3 - x : 4 - x] = incoming;
-        bytesToCrc[x % 3] = incoming;
-        break;
-      case 6:
-      case 7:
-      case 9:
-      case 10:
-        tempTemperature.array[x < 9 ? 9 - x : 10 - x] = incoming;
-        bytesToCrc[x % 3] = incoming;
-        break;
-      case 12:
-      case 13:
-      case 15:
-      case 16:
-        tempHumidity.array[x < 15 ? 15 - x : 16 - x] = incoming;
-        bytesToCrc[x % 3] = incoming;
-        break;
-      default:
-        // Validate CRC
-        uint8_t foundCrc = computeCRC8(bytesToCrc, 2);
-        if (foundCrc != incoming)
-        {
-          if (_printDebug == true)
-          {
-            _debugPort->print(F("readMeasurement: found CRC in byte "));
-            _debugPort->print(x);
-            _debugPort->print(F(", expected 0x"));
-            _debugPort->print(foundCrc, HEX);
-            _debugPort->print(F(", got 0x"));
-            _debugPort->println(incoming, HEX);
-          }
-          error = true;
-        }
-        break;
-      }
-    }
-  }
-  else
+  if (receivedBytes != 18)
   {
     if (_printDebug == true)
     {
@@ -366,15 +316,37 @@ bool SCD30::readMeasurement()
       _debugPort->print(receivedBytes);
       _debugPort->println(F(" bytes"));
     }
+    while (_i2cPort->available()) // Discard any partial data
+      _i2cPort->read();
     return false;
   }
 
-  if (error)
+  uint8_t buffer[18]; // CO2, temperature and humidity: each is two [MSB, LSB, CRC] words
+  for (uint8_t x = 0; x < 18; x++)
+    buffer[x] = _i2cPort->read();
+
+  // Validate all six CRCs in one go
+  if (!SFE_QUAD_Sensirion_CRC::checkFrame(buffer, 6))
   {
     if (_printDebug == true)
-      _debugPort->println(F("readMeasurement: encountered error reading SCD30 data."));
+      _debugPort->println(F("readMeasurement: encountered error reading SCD30 data (CRC)."));
     return false;
   }
+
+  // The floats are big-endian. Store them in little-endian format
+  tempCO2.array[3] = buffer[0];
+  tempCO2.array[2] = buffer[1];
+  tempCO2.array[1] = buffer[3];
+  tempCO2.array[0] = buffer[4];
+  tempTemperature.array[3] = buffer[6];
+  tempTemperature.array[2] = buffer[7];
+  tempTemperature.array[1] = buffer[9];
+  tempTemperature.array[0] = buffer[10];
+  tempHumidity.array[3] = buffer[12];
+  tempHumidity.array[2] = buffer[13];
+  tempHumidity.array[1] = buffer[15];
+  tempHumidity.array[0] = buffer[16];
+
   // Now copy the uint32s into their associated floats
   co2 = tempCO2.value;
   temperature = tempTemperature.value;
@@ -482,20 +454,5 @@ bool SCD30::sendCommand(uint16_t command)
 // x^8+x^5+x^4+1 = 0x31
 uint8_t SCD30::computeCRC8(uint8_t data[], uint8_t len)
 {
-  uint8_t crc = 0xFF; // Init with 0xFF
-
-  for (uint8_t x = 0; x < len; x++)
-  {
-    crc ^= data[x]; // XOR-in the next input byte
-
-    for (uint8_t i = 0; i < 8; i++)
-    {
-      if ((crc & 0x80) != 0)
-        crc = (uint8_t)((crc << 1) ^ 0x31);
-      else
-        crc <<= 1;
-    }
-  }
-
-  return crc; // No output reflection
+  return (SFE_QUAD_Sensirion_CRC::crc8(data, len)); // Shared lookup table
 }
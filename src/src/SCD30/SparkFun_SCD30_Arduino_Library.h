@@ -40,6 +40,8 @@
 #include <Wire.h>
 #endif
 
+#include "../COMMON/SFE_QUAD_Sensirion_CRC.h"
+
 // The default I2C address for the SCD30 is 0x61.
 #define SCD30_ADDRESS 0x61
 
@@ -109,7 +111,7 @@ public:
 	bool setTemperatureOffset(float tempOffset);
 
 	bool dataAvailable();
-	bool readMeasurement();
+	bool readMeasurement(bool checkDataReady = true);
 
 	void reset();
 
@@ -77,6 +77,38 @@ bool SCD4x::begin(TwoWire &wirePort, bool measBegin, bool autoCalibrate, bool sk
   return (success);
 }
 
+//Re-attach to a sensor which is already running periodic measurements
+#ifdef USE_TEENSY3_I2C_LIB
+bool SCD4x::resume(i2c_t3 &wirePort)
+#else
+bool SCD4x::resume(TwoWire &wirePort)
+#endif
+{
+  _i2cPort = &wirePort; //Grab which port the user wants us to use
+
+  //get_data_ready_status is allowed during periodic measurements. Check the sensor is responding
+  uint16_t response;
+  if (readRegister(SCD4x_COMMAND_GET_DATA_READY_STATUS, &response, 1) == false)
+    return (false);
+
+  //get_serial_number is only allowed when the sensor is idle. If it succeeds, the sensor has been power-cycled
+  //and periodic measurements are not running
+  char serialNumber[13];
+  if (getSerialNumber(serialNumber) == true)
+  {
+    #if SCD4x_ENABLE_DEBUGLOG
+    if (_printDebug == true)
+    {
+      _debugPort->println(F("SCD4x::resume: sensor is idle. Call begin instead"));
+    }
+    #endif // if SCD4x_ENABLE_DEBUGLOG
+    return (false);
+  }
+
+  periodicMeasurementsAreRunning = true;
+  return (true);
+}
+
 //Calling this function with nothing sets the debug port to Serial
 //You can also call it with other streams like Serial1, SerialUSB, etc.
 void SCD4x::enableDebugging(Stream &debugPort)
@@ -160,10 +192,11 @@ bool SCD4x::stopPeriodicMeasurement(uint16_t delayMillis, TwoWire &wirePort)
 //buffer is emptied upon read-out. If no data is available in the buffer, the sensor returns a NACK.
 //To avoid a NACK response, the get_data_ready_status can be issued to check data status
 //(see chapter 3.8.2 for further details).
-bool SCD4x::readMeasurement(void)
+//Set checkDataReady to false if getDataReadyStatus has already been called - to avoid reading the status twice
+bool SCD4x::readMeasurement(bool checkDataReady)
 {
   //Verify we have data from the sensor
-  if (getDataReadyStatus() == false)
+  if ((checkDataReady) && (getDataReadyStatus() == false))
     return (false);
 
   scd4x_unsigned16Bytes_t tempCO2;
@@ -181,58 +214,8 @@ bool SCD4x::readMeasurement(void)
 
   delay(1); //Datasheet specifies this
 
-  #if SCD4x_ENABLE_DEBUGLOG
-  uint8_t receivedBytes = (uint8_t)
-  #endif // if SCD4x_ENABLE_DEBUGLOG
-  _i2cPort->requestFrom((uint8_t)SCD4x_ADDRESS, (uint8_t)9);
-  bool error = false;
-  if (_i2cPort->available())
-  {
-    byte bytesToCrc[2];
-    for (byte x = 0; x < 9; x++)
-    {
-      byte incoming = _i2cPort->read();
-
-      switch (x)
-      {
-      case 0:
-      case 1:
-        tempCO2.bytes[x == 0 ? 1 : 0] = incoming; // Store the two CO2 bytes in little-endian format
-        bytesToCrc[x] = incoming; // Calculate the CRC on the two CO2 bytes in the order they arrive
-        break;
-      case 3:
-      case 4:
-        tempTemperature.bytes[x == 3 ? 1 : 0] = incoming; // Store the two T bytes in little-endian format
-        bytesToCrc[x % 3] = incoming; // Calculate the CRC on the two T bytes in the order they arrive
-        break;
-      case 6:
-      case 7:
-        tempHumidity.bytes[x == 6 ? 1 : 0] = incoming; // Store the two RH bytes in little-endian format
-        bytesToCrc[x % 3] = incoming; // Calculate the CRC on the two RH bytes in the order they arrive
-        break;
-      default: // x == 2, 5, 8
-        //Validate CRC
-        uint8_t foundCrc = computeCRC8(bytesToCrc, 2); // Calculate what the CRC should be for these two bytes
-        if (foundCrc != incoming) // Does this match the CRC byte from the sensor?
-        {
-          #if SCD4x_ENABLE_DEBUGLOG
-          if (_printDebug == true)
-          {
-            _debugPort->print(F("SCD4x::readMeasurement: found CRC in byte "));
-            _debugPort->print(x);
-            _debugPort->print(F(", expected 0x"));
-            _debugPort->print(foundCrc, HEX);
-            _debugPort->print(F(", got 0x"));
-            _debugPort->println(incoming, HEX);
-          }
-          #endif // if SCD4x_ENABLE_DEBUGLOG
-          error = true;
-        }
-        break;
-      }
-    }
-  }
-  else
+  uint8_t receivedBytes = (uint8_t)_i2cPort->requestFrom((uint8_t)SCD4x_ADDRESS, (uint8_t)9);
+  if (receivedBytes != 9)
   {
     #if SCD4x_ENABLE_DEBUGLOG
     if (_printDebug == true)
@@ -242,17 +225,29 @@ bool SCD4x::readMeasurement(void)
       _debugPort->println(F(" bytes"));
     }
     #endif // if SCD4x_ENABLE_DEBUGLOG
+    while (_i2cPort->available()) // Discard any partial data
+      _i2cPort->read();
     return (false);
   }
 
-  if (error)
+  uint8_t buffer[9]; // CO2, temperature and humidity: each is one [MSB, LSB, CRC] word
+  for (uint8_t x = 0; x < 9; x++)
+    buffer[x] = _i2cPort->read();
+
+  //Validate all three CRCs in one go
+  if (!SFE_QUAD_Sensirion_CRC::checkFrame(buffer, 3))
   {
     #if SCD4x_ENABLE_DEBUGLOG
     if (_printDebug == true)
-      _debugPort->println(F("SCD4x::readMeasurement: encountered error reading SCD4x data."));
+      _debugPort->println(F("SCD4x::readMeasurement: encountered error reading SCD4x data (CRC)."));
     #endif // if SCD4x_ENABLE_DEBUGLOG
     return (false);
   }
+
+  tempCO2.unsigned16 = SFE_QUAD_Sensirion_CRC::frameWord(buffer, 0);
+  tempTemperature.unsigned16 = SFE_QUAD_Sensirion_CRC::frameWord(buffer, 1);
+  tempHumidity.unsigned16 = SFE_QUAD_Sensirion_CRC::frameWord(buffer, 2);
+
   //Now copy the int16s into their associated floats
   co2 = (float)tempCO2.unsigned16;
   temperature = -45 + (((float)tempTemperature.unsigned16) * 175 / 65536);
@@ -1101,20 +1096,5 @@ bool SCD4x::readRegister(uint16_t registerAddress, uint16_t *response, uint16_t
 //x^8+x^5+x^4+1 = 0x31
 uint8_t SCD4x::computeCRC8(uint8_t data[], uint8_t len)
 {
-  uint8_t crc = 0xFF; //Init with 0xFF
-
-  for (uint8_t x = 0; x < len; x++)
-  {
-    crc ^= data[x]; // XOR-in the next input byte
-
-    for (uint8_t i = 0; i < 8; i++)
-    {
-      if ((crc & 0x80) != 0)
-        crc = (uint8_t)((crc << 1) ^ 0x31);
-      else
-        crc <<= 1;
-    }
-  }
-
-  return crc; //No output reflection
+  return (SFE_QUAD_Sensirion_CRC::crc8(data, len)); //Shared lookup table
 }
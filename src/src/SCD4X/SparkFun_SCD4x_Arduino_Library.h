@@ -39,6 +39,8 @@
 #include <Wire.h>
 #endif
 
+#include "../COMMON/SFE_QUAD_Sensirion_CRC.h"
+
 //Enable/disable including debug log (to allow saving some space)
 #ifndef SCD4x_ENABLE_DEBUGLOG
   #if defined(LIBRARIES_NO_LOG) && LIBRARIES_NO_LOG
@@ -119,6 +121,14 @@ public:
   bool begin(TwoWire &wirePort = Wire, bool measBegin = true, bool autoCalibrate = true, bool skipStopPeriodicMeasurements = false); //By default use Wire port
 #endif
 
+  // resume re-attaches to a sensor which is already running periodic measurements (e.g. after the MCU wakes from deep sleep)
+  // Periodic measurements are not stopped and no settings are sent. Returns false if the sensor is not running periodic measurements
+#ifdef USE_TEENSY3_I2C_LIB
+  bool resume(i2c_t3 &wirePort = Wire);
+#else
+  bool resume(TwoWire &wirePort = Wire);
+#endif
+
   void enableDebugging(Stream &debugPort = Serial); //Turn on debug printing. If user doesn't specify then Serial will be used
 
   bool startPeriodicMeasurement(void); // Signal update interval is 5 seconds
@@ -133,7 +143,7 @@ public:
   bool stopPeriodicMeasurement(uint16_t delayMillis = 500, TwoWire &wirePort = Wire);
 #endif
 
-  bool readMeasurement(void); // Check for fresh data; store it. Returns true if fresh data is available
+  bool readMeasurement(bool checkDataReady = true); // Check for fresh data; store it. Returns true if fresh data is available
 
   uint16_t getCO2(void); // Return the CO2 PPM. Automatically request fresh data is the data is 'stale'
   float getHumidity(void); // Return the RH. Automatically request fresh data is the data is 'stale'
@@ -433,6 +433,7 @@ SDP3XERR SDP3X::readMeasurement(float *pressure, float *temperature)
   }
 
   *pressure = differential / scale;
+  _scaleFactor = scaleFactor;
 
   //Convert temp to float and convert to degrees C
   *temperature = ((float)temp) / 200.0;
@@ -440,60 +441,66 @@ SDP3XERR SDP3X::readMeasurement(float *pressure, float *temperature)
   return (SDP3X_SUCCESS); //Success!
 }
 
-// CRC helper function for signed data
-uint8_t SDP3X::_CRC8signed(int16_t data)
+SDP3XERR SDP3X::readRawDifferentialPressure(int16_t *diffPress)
 {
+  //The read can be terminated after any byte. Only read:
+  // Byte1: Differential Pressure 8msb
+  // Byte2: Differential Pressure 8lsb
+  // Byte3: CRC
+  uint8_t toRead = _i2cPort->requestFrom(_SDP3XAddress, (uint8_t)3);
+  if (toRead != 3)
+  {
+    if (_printDebug == true)
+    {
+      _debugPort->print(F("readRawDifferentialPressure: requestFrom returned: "));
+      _debugPort->println(toRead);
+    }
+    return (SDP3X_ERR_I2C_ERROR); //Error out
+  }
+
+  // Avoid any confusion when casting unsigned data to signed
   union
   {
     uint16_t _unsigned;
     int16_t _signed;
   } _unsignedSigned;
 
-  _unsignedSigned._signed = data;
-  return (_CRC8(_unsignedSigned._unsigned));
-}
-
-#ifndef SDP3X_LOOKUP_TABLE
-//Given an array and a number of bytes, this calculate CRC8 for those bytes
-//CRC is only calc'd on the data portion (two bytes) of the four bytes being sent
-//From: http://www.sunshine2k.de/articles/coding/crc/understanding_crc.html
-//Tested with: http://www.sunshine2k.de/coding/javascript/crc/crc_js.html
-//x^8+x^5+x^4+1 = 0x31
-uint8_t SDP3X::_CRC8(uint16_t data)
-{
-  uint8_t crc = 0xFF; //Init with 0xFF
+  _unsignedSigned._unsigned = ((uint16_t)_i2cPort->read()) << 8; //store MSB
+  _unsignedSigned._unsigned |= (uint16_t)_i2cPort->read(); //store LSB
 
-  crc ^= (data >> 8); // XOR-in the first input byte
+  uint8_t crc = _i2cPort->read();
 
-  for (uint8_t i = 0 ; i < 8 ; i++)
+  if (crc != _CRC8signed(_unsignedSigned._signed)) //verify checksum
   {
-    if ((crc & 0x80) != 0)
-      crc = (uint8_t)((crc << 1) ^ 0x31);
-    else
-      crc <<= 1;
+    if (_printDebug == true)
+    {
+      _debugPort->print(F("readRawDifferentialPressure: checksum failed! Expected: 0x"));
+      _debugPort->print(_CRC8signed(_unsignedSigned._signed), HEX);
+      _debugPort->print(F(" Received: 0x"));
+      _debugPort->println(crc, HEX);
+    }
+    return (SDP3X_ERR_BAD_CRC); //checksum failed
   }
 
-  crc ^= (uint8_t)data; // XOR-in the last input byte
+  *diffPress = _unsignedSigned._signed;
+  return (SDP3X_SUCCESS); //Success!
+}
 
-  for (uint8_t i = 0 ; i < 8 ; i++)
+// CRC helper function for signed data
+uint8_t SDP3X::_CRC8signed(int16_t data)
+{
+  union
   {
-    if ((crc & 0x80) != 0)
-      crc = (uint8_t)((crc << 1) ^ 0x31);
-    else
-      crc <<= 1;
-  }
+    uint16_t _unsigned;
+    int16_t _signed;
+  } _unsignedSigned;
 
-  return crc; //No output reflection
+  _unsignedSigned._signed = data;
+  return (_CRC8(_unsignedSigned._unsigned));
 }
-#else
-//Generates CRC8 for SDP3X from lookup table
+
+//Generates CRC8 for SDP3X (using the shared Sensirion CRC lookup table)
 uint8_t SDP3X::_CRC8(uint16_t data)
 {
-  uint8_t crc8 = 0xFF; //inital value
-  crc8 ^= (uint8_t)(data >> 8); //start with MSB
-  crc8 = _CRC8LookupTable[crc8 >> 4][crc8 & 0xF]; //look up table [MSnibble][LSnibble]
-  crc8 ^= (uint8_t)data; //use LSB
-  crc8 = _CRC8LookupTable[crc8 >> 4][crc8 & 0xF]; //look up table [MSnibble][LSnibble]
-  return crc8;
+  return (SFE_QUAD_Sensirion_CRC::crc8(data));
 }
-#endif
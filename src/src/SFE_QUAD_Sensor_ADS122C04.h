@@ -30,13 +30,24 @@
 
 #define SETTING_COUNT 6 // <=== Update this with the number of things that can be set on this sensor
 
-#define CONFIGURATION_ITEM_COUNT 1 // <=== Update this with the number of things that can be configured on this sensor
+#define CONFIGURATION_ITEM_COUNT 5 // <=== Update this with the number of things that can be configured on this sensor
 
 #define SENSOR_I2C_ADDRESSES const uint8_t sensorI2cAddresses[] = {0x45, 0x44, 0x41, 0x40} // <=== Update this with the I2C addresses for this sensor
 
 class CLASSTITLE : public SFE_QUAD_Sensor
 {
 public:
+  // Continuous conversion mode. The ADC is free-running and samples are collected by pollSensor without waiting
+  bool _continuous;     // Use continuous conversion mode for the PT100 wire modes
+  uint8_t _dataRate;    // ADS122C04_DATA_RATE_20SPS to ADS122C04_DATA_RATE_1000SPS
+  bool _turbo;          // Turbo mode doubles the data rate (2000 SPS max)
+  bool _average;        // Average (decimate) all of the samples collected between readings
+  bool _haveRaw;        // True once a continuous sample has been collected
+  int32_t _lastRaw;     // The most recent continuous sample
+  int64_t _rawSum;      // The sum of the samples collected since the last reading
+  uint32_t _rawCount;   // The number of samples collected since the last reading
+  float _latchedTempC;  // The PT100 temperature for this reading. Shared by the C and F senses
+
   CLASSTITLE(void)
   {
     _sensorAddress = 0;
@@ -48,6 +59,77 @@ public:
     for (size_t i = 0; i <= SENSE_COUNT; i++)
       _logSense[i] = true;
     _customInitializePtr = NULL;
+    _continuous = false;
+    _dataRate = ADS122C04_DATA_RATE_20SPS;
+    _turbo = false;
+    _average = false;
+    _haveRaw = false;
+    _lastRaw = 0;
+    _rawSum = 0;
+    _rawCount = 0;
+    _latchedTempC = 0.0;
+  }
+
+  // Return true if the wire mode is one of the PT100 modes (which support continuous conversion)
+  bool isPT100Mode(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    return ((device->getWireMode() != ADS122C04_TEMPERATURE_MODE) && (device->getWireMode() != ADS122C04_RAW_MODE));
+  }
+
+  // Discard any accumulated samples
+  void resetAccumulator(void)
+  {
+    _haveRaw = false;
+    _rawSum = 0;
+    _rawCount = 0;
+  }
+
+  // Apply _continuous, _dataRate and _turbo. Discard any accumulated samples
+  bool applyConversionMode(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    resetAccumulator();
+    if (_continuous)
+      return (device->startContinuousConversion(device->getWireMode(), _dataRate, _turbo ? ADS122C04_OP_MODE_TURBO : ADS122C04_OP_MODE_NORMAL));
+    if (device->isContinuous())
+      device->stopContinuousConversion();
+    return (device->configureADCmode(device->getWireMode(), _dataRate));
+  }
+
+  // Collect the latest continuous sample (if one is ready). Does not wait
+  bool collectSample(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    int32_t raw;
+    if (!device->readRawPT100NoWait(&raw))
+      return (false);
+    _lastRaw = raw;
+    _haveRaw = true;
+    if (_average)
+    {
+      _rawSum += raw;
+      _rawCount++;
+    }
+    return (true);
+  }
+
+  // Calculate the PT100 temperature for this reading from the average or latest continuous sample
+  float latchPT100Centigrade(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    collectSample();
+    if (_average && (_rawCount > 0))
+    {
+      _latchedTempC = device->convertPT100Centigrade((float)((double)_rawSum / (double)_rawCount));
+      _rawSum = 0;
+      _rawCount = 0;
+    }
+    else if (_haveRaw)
+      _latchedTempC = device->convertPT100Centigrade((float)_lastRaw);
+    else
+      _latchedTempC = device->readPT100Centigrade(); // No samples yet. Wait for the next one
+    return (_latchedTempC);
   }
 
   void deleteSensorStorage(void)
@@ -112,6 +194,18 @@ public:
     }
   }
 
+  // Return true if the sensor needs to be polled between readings
+  bool pollingEnabled(void)
+  {
+    return (_continuous && isPT100Mode());
+  }
+
+  // Collect the latest continuous sample (if one is ready)
+  bool pollSensor(uint8_t sensorAddress, TwoWire &port)
+  {
+    return (collectSample());
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -153,27 +247,57 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  // Note: these are hard-wired to 20Hz sampling. TODO: allow the sample rate to be changed
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  // Note: the PT100 data rate is set by the Data_Rate configuration item. The internal temperature and raw voltage use 20Hz sampling
+  // In continuous mode, the PT100 temperature is the average of the samples collected since the last reading (Average_Samples), or the latest sample
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (sense)
     {
     case 0:
-      _sprintf._dtostrf((double)device->readPT100Centigrade(), reading); // Get the temperature
+      if (pollingEnabled())
+        *value = (double)latchPT100Centigrade(); // Get the averaged or latest temperature
+      else
+        *value = (double)device->readPT100Centigrade(); // Get the temperature
       return (true);
       break;
     case 1:
-      _sprintf._dtostrf((double)device->readPT100Fahrenheit(), reading); // Get the temperature
+      if (pollingEnabled())
+      {
+        if (!_logSense[1])      // If the Centigrade sense is not being logged, calculate the temperature here
+          latchPT100Centigrade(); // Otherwise use the same temperature as the Centigrade sense
+        *value = ((double)_latchedTempC * 1.8) + 32.0; // Convert to Fahrenheit
+      }
+      else
+        *value = (double)device->readPT100Fahrenheit(); // Get the temperature
       return (true);
       break;
     case 2:
-      _sprintf._dtostrf((double)device->readInternalTemperature(), reading); // Get the temperature
+      *value = (double)device->readInternalTemperature(); // Get the temperature
+      return (true);
+      break;
+    case 3:
+      *value = (double)device->readRawVoltage() * 0.000000244140625; // Get the raw voltage. Convert to volts
       return (true);
       break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+    case 2:
     case 3:
-      _sprintf._dtostrf((double)device->readRawVoltage() * 0.000000244140625, reading); // Get the raw voltage. Convert to volts
+      _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
@@ -267,27 +391,28 @@ public:
     switch (setting)
     {
     case 0:
-      device->configureADCmode(ADS122C04_4WIRE_MODE);
+      device->configureADCmode(ADS122C04_4WIRE_MODE, _dataRate);
       break;
     case 1:
-      device->configureADCmode(ADS122C04_3WIRE_MODE);
+      device->configureADCmode(ADS122C04_3WIRE_MODE, _dataRate);
       break;
     case 2:
-      device->configureADCmode(ADS122C04_2WIRE_MODE);
+      device->configureADCmode(ADS122C04_2WIRE_MODE, _dataRate);
       break;
     case 3:
-      device->configureADCmode(ADS122C04_4WIRE_HI_TEMP);
+      device->configureADCmode(ADS122C04_4WIRE_HI_TEMP, _dataRate);
       break;
     case 4:
-      device->configureADCmode(ADS122C04_3WIRE_HI_TEMP);
+      device->configureADCmode(ADS122C04_3WIRE_HI_TEMP, _dataRate);
       break;
     case 5:
-      device->configureADCmode(ADS122C04_2WIRE_HI_TEMP);
+      device->configureADCmode(ADS122C04_2WIRE_HI_TEMP, _dataRate);
       break;
     default:
       return (false);
       break;
     }
+    resetAccumulator(); // The wire mode has changed. Discard any accumulated samples
     return (true);
   }
 
@@ -317,6 +442,18 @@ public:
     case 0:
       return ("Wire_Mode");
       break;
+    case 1:
+      return ("Continuous_Mode");
+      break;
+    case 2:
+      return ("Data_Rate");
+      break;
+    case 3:
+      return ("Turbo_Mode");
+      break;
+    case 4:
+      return ("Average_Samples");
+      break;
     default:
       return (NULL);
       break;
@@ -332,6 +469,18 @@ public:
     case 0:
       *type = SFE_QUAD_SETTING_TYPE_UINT8_T;
       break;
+    case 1:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
+    case 2:
+      *type = SFE_QUAD_SETTING_TYPE_UINT8_T;
+      break;
+    case 3:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
+    case 4:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -348,6 +497,18 @@ public:
     case 0:
       value->UINT8_T = device->getWireMode();
       break;
+    case 1:
+      value->BOOL = _continuous;
+      break;
+    case 2:
+      value->UINT8_T = _dataRate;
+      break;
+    case 3:
+      value->BOOL = _turbo;
+      break;
+    case 4:
+      value->BOOL = _average;
+      break;
     default:
       return (false);
       break;
@@ -362,7 +523,26 @@ public:
     switch (configItem)
     {
     case 0:
-      device->configureADCmode(value->UINT8_T);
+      device->configureADCmode(value->UINT8_T, _dataRate); // configureADCmode restarts continuous conversions (if enabled)
+      resetAccumulator();
+      break;
+    case 1:
+      _continuous = value->BOOL;
+      return (applyConversionMode());
+      break;
+    case 2:
+      if (value->UINT8_T > ADS122C04_DATA_RATE_1000SPS)
+        return (false);
+      _dataRate = value->UINT8_T;
+      return (applyConversionMode());
+      break;
+    case 3:
+      _turbo = value->BOOL;
+      return (applyConversionMode());
+      break;
+    case 4:
+      _average = value->BOOL;
+      resetAccumulator();
       break;
     default:
       return (false);
@@ -147,18 +147,35 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (sense)
     {
     case 0:
-      _sprintf._dtostrf((double)device->getHumidity(), reading); // Get the humidity
+      *value = (double)device->getHumidity(); // Get the humidity
       return (true);
       break;
     case 1:
-      _sprintf._dtostrf((double)device->getTemperature(), reading); // Get the temperature
+      *value = (double)device->getTemperature(); // Get the temperature
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+      _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
@@ -28,15 +28,22 @@
 
 #define SENSE_COUNT 3 // <=== Update this with the number of things this sensor can sense
 
-#define SETTING_COUNT 0 // <=== Update this with the number of things that can be set on this sensor
+#define SETTING_COUNT 1 // <=== Update this with the number of things that can be set on this sensor
 
-#define CONFIGURATION_ITEM_COUNT 0 // <=== Update this with the number of things that can be configured on this sensor
+#define CONFIGURATION_ITEM_COUNT 1 // <=== Update this with the number of things that can be configured on this sensor
 
 #define SENSOR_I2C_ADDRESSES const uint8_t sensorI2cAddresses[] = {0x76, 0x77} // <=== Update this with the I2C addresses for this sensor
 
 class CLASSTITLE : public SFE_QUAD_Sensor
 {
 public:
+  BME280_SensorMeasurements _latched; // Measurements latched by acquireCompensation
+  bool _pressLatched;                 // true if _latched.pressure has not yet been read by getSenseReading
+  bool _tempLatched;                  // true if _latched.temperature has not yet been read by getSenseReading
+  bool _rhLatched;                    // true if _latched.humidity has not yet been read by getSenseReading
+  bool _integerMath;                  // Compensate and format using integer math only (for MCUs without an FPU)
+  BME280_IntegerMeasurements _latchedInt; // Measurements latched when _integerMath is true
+
   CLASSTITLE(void)
   {
     _sensorAddress = 0;
@@ -48,6 +55,10 @@ public:
     for (size_t i = 0; i <= SENSE_COUNT; i++)
       _logSense[i] = true;
     _customInitializePtr = NULL;
+    _pressLatched = false;
+    _tempLatched = false;
+    _rhLatched = false;
+    _integerMath = false;
   }
 
   void deleteSensorStorage(void)
@@ -120,6 +131,52 @@ public:
     }
   }
 
+  // Return true if this sensor can produce the specified compensation value
+  bool producesCompensation(SFE_QUAD_Sensor_Compensation_Type_e type)
+  {
+    return ((type == SFE_QUAD_COMPENSATION_TEMPERATURE) || (type == SFE_QUAD_COMPENSATION_HUMIDITY) || (type == SFE_QUAD_COMPENSATION_PRESSURE));
+  }
+
+  // Read all three measurements in one burst and latch them for getSenseReading
+  bool acquireCompensation(uint8_t sensorAddress, TwoWire &port)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (_integerMath)
+    {
+      device->readAllMeasurementsInteger(&_latchedInt);
+      _latched.temperature = (float)_latchedInt.temperature / 100.0;
+      _latched.pressure = (float)_latchedInt.pressure / 100.0; // Pa
+      _latched.humidity = (float)_latchedInt.humidity / 100.0;
+    }
+    else
+      device->readAllMeasurements(&_latched); // Temperature in C
+    _pressLatched = true;
+    _tempLatched = true;
+    _rhLatched = true;
+    return (true);
+  }
+
+  // Return the compensation value latched by acquireCompensation
+  bool getCompensation(SFE_QUAD_Sensor_Compensation_Type_e type, float *value)
+  {
+    switch (type)
+    {
+    case SFE_QUAD_COMPENSATION_TEMPERATURE:
+      *value = _latched.temperature;
+      break;
+    case SFE_QUAD_COMPENSATION_HUMIDITY:
+      *value = _latched.humidity;
+      break;
+    case SFE_QUAD_COMPENSATION_PRESSURE:
+      *value = _latched.pressure / 100.0; // Convert Pa to mbar
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (true);
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -158,22 +215,81 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
+
+    // Read all three measurements in one burst when the first enabled sense is read - unless acquireCompensation has already done it.
+    // The burst compensates the temperature first, so the pressure and humidity use this measurement's t_fine, not the previous one
+    uint8_t firstSense = 0;
+    while ((firstSense < (SENSE_COUNT - 1)) && (!_logSense[firstSense + 1]))
+      firstSense++;
+    bool latched = (firstSense == 0) ? _pressLatched : ((firstSense == 1) ? _tempLatched : _rhLatched);
+    if ((sense == firstSense) && (!latched))
+    {
+      if (_integerMath)
+        device->readAllMeasurementsInteger(&_latchedInt);
+      else
+      {
+        device->readAllMeasurements(&_latched); // Temperature in C
+        _pressLatched = true;
+        _tempLatched = true;
+        _rhLatched = true;
+      }
+    }
+
     switch (sense)
     {
     case 0:
-      _sprintf._dtostrf((double)device->readFloatPressure(), reading); // Get the pressure
+      if (_integerMath)
+        *value = (double)_latchedInt.pressure / 100.0;
+      else if (_pressLatched) // Use the pressure latched by acquireCompensation
+        *value = (double)_latched.pressure;
+      else
+        *value = (double)device->readFloatPressure(); // Get the pressure
+      _pressLatched = false;
       return (true);
       break;
     case 1:
-      _sprintf._dtostrf((double)device->readTempC(), reading); // Get the temperature
+      if (_integerMath)
+        *value = (double)_latchedInt.temperature / 100.0;
+      else if (_tempLatched) // Use the temperature latched by acquireCompensation
+        *value = (double)_latched.temperature;
+      else
+        *value = (double)device->readTempC(); // Get the temperature
+      _tempLatched = false;
       return (true);
       break;
     case 2:
-      _sprintf._dtostrf((double)device->readFloatHumidity(), reading); // Get the humidity
+      if (_integerMath)
+        *value = (double)_latchedInt.humidity / 100.0;
+      else if (_rhLatched) // Use the humidity latched by acquireCompensation
+        *value = (double)_latched.humidity;
+      else
+        *value = (double)device->readFloatHumidity(); // Get the humidity
+      _rhLatched = false;
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+    case 2:
+      if (_integerMath) // Round to the nearest 0.01 and convert without using floating point
+        _sprintf._fixtostrf((int32_t)((value * 100.0) + ((value < 0.0) ? -0.5 : 0.5)), 2, reading);
+      else
+        _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
@@ -194,9 +310,9 @@ public:
   uint8_t getSettingNameMaxLen()
   {
     size_t longest = 0;
-    // for (uint8_t x = 0; x < SETTING_COUNT; x++)
-    //   if (strlen(getSettingName(x)) > longest)
-    //     longest = strlen(getSettingName(x));
+    for (uint8_t x = 0; x < SETTING_COUNT; x++)
+      if (strlen(getSettingName(x)) > longest)
+        longest = strlen(getSettingName(x));
     return (longest);
   }
 
@@ -205,6 +321,9 @@ public:
   {
     switch (setting)
     {
+    case 0:
+      return ("Integer Math");
+      break;
     default:
       return (NULL);
       break;
@@ -217,6 +336,9 @@ public:
   {
     switch (setting)
     {
+    case 0:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -230,6 +352,9 @@ public:
     //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (setting)
     {
+    case 0:
+      _integerMath = value->BOOL;
+      break;
     default:
       return (false);
       break;
@@ -248,9 +373,9 @@ public:
   uint8_t getConfigurationItemNameMaxLen()
   {
     size_t longest = 0;
-    // for (uint8_t x = 0; x < CONFIGURATION_ITEM_COUNT; x++)
-    //   if (strlen(getConfigurationItemName(x)) > longest)
-    //     longest = strlen(getConfigurationItemName(x));
+    for (uint8_t x = 0; x < CONFIGURATION_ITEM_COUNT; x++)
+      if (strlen(getConfigurationItemName(x)) > longest)
+        longest = strlen(getConfigurationItemName(x));
     return (longest);
   }
 
@@ -260,6 +385,9 @@ public:
   {
     switch (configItem)
     {
+    case 0:
+      return ("Integer_Math");
+      break;
     default:
       return (NULL);
       break;
@@ -272,6 +400,9 @@ public:
   {
     switch (configItem)
     {
+    case 0:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -285,6 +416,9 @@ public:
     //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (configItem)
     {
+    case 0:
+      value->BOOL = _integerMath;
+      break;
     default:
       return (false);
       break;
@@ -298,6 +432,9 @@ public:
     //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (configItem)
     {
+    case 0:
+      _integerMath = value->BOOL;
+      break;
     default:
       return (false);
       break;
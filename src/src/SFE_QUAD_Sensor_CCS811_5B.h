@@ -39,6 +39,9 @@ class CLASSTITLE : public SFE_QUAD_Sensor
 public:
   bool _tvoc;
   bool _co2;
+  float _rh;                 // Compensation humidity (%RH). Applied with setEnvironmentalData
+  float _temp;               // Compensation temperature (C). Applied with setEnvironmentalData
+  bool _compensationPending; // true if _rh or _temp has changed and needs to be applied
 
   CLASSTITLE(void)
   {
@@ -53,6 +56,9 @@ public:
     _customInitializePtr = NULL;
     _tvoc = false;
     _co2 = false;
+    _rh = 50.0;
+    _temp = 25.0;
+    _compensationPending = false;
   }
 
   void deleteSensorStorage(void)
@@ -123,6 +129,38 @@ public:
     }
   }
 
+  // Return true if this sensor can use the specified compensation value
+  bool consumesCompensation(SFE_QUAD_Sensor_Compensation_Type_e type)
+  {
+    return ((type == SFE_QUAD_COMPENSATION_TEMPERATURE) || (type == SFE_QUAD_COMPENSATION_HUMIDITY));
+  }
+
+  // Set the compensation value. It is applied by getSenseReading - when the mux port is selected
+  // Only changes of 0.5C / 0.5%RH or more are applied, to avoid rewriting the environment registers every reading
+  // (The CCS811 stores the humidity in 0.5%RH steps)
+  bool setCompensation(SFE_QUAD_Sensor_Compensation_Type_e type, float value)
+  {
+    float *compensation;
+    switch (type)
+    {
+    case SFE_QUAD_COMPENSATION_TEMPERATURE:
+      compensation = &_temp;
+      break;
+    case SFE_QUAD_COMPENSATION_HUMIDITY:
+      compensation = &_rh;
+      break;
+    default:
+      return (false);
+      break;
+    }
+    if ((value >= *compensation + 0.5) || (value <= *compensation - 0.5))
+    {
+      *compensation = value;
+      _compensationPending = true;
+    }
+    return (true);
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -158,10 +196,15 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (_compensationPending) // Apply any new compensation values
+    {
+      device->setEnvironmentalData(_rh, _temp);
+      _compensationPending = false;
+    }
     switch (sense)
     {
     case 0:
@@ -171,7 +214,7 @@ public:
         _co2 = true;
       }
       _tvoc = false;
-      sprintf(reading, "%d", device->getTVOC());
+      *value = device->getTVOC();
       return (true);
       break;
     case 1:
@@ -181,7 +224,24 @@ public:
         _tvoc = true;
       }
       _co2 = false;
-      sprintf(reading, "%d", device->getCO2());
+      *value = device->getCO2();
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+      sprintf(reading, "%ld", (long)value);
       return (true);
       break;
     default:
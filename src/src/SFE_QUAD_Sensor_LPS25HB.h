@@ -26,17 +26,27 @@
 
 #define CLASSTITLE SFE_QUAD_Sensor_LPS25HB // <=== Update this with the new sensor type
 
-#define SENSE_COUNT 2 // <=== Update this with the number of things this sensor can sense
+#define SENSE_COUNT 3 // <=== Update this with the number of things this sensor can sense
 
-#define SETTING_COUNT 0 // <=== Update this with the number of things that can be set on this sensor
+#define SETTING_COUNT 4 // <=== Update this with the number of things that can be set on this sensor
 
-#define CONFIGURATION_ITEM_COUNT 0 // <=== Update this with the number of things that can be configured on this sensor
+#define CONFIGURATION_ITEM_COUNT 2 // <=== Update this with the number of things that can be configured on this sensor
 
 #define SENSOR_I2C_ADDRESSES const uint8_t sensorI2cAddresses[] = {0x5C, 0x5D} // <=== Update this with the I2C addresses for this sensor
 
 class CLASSTITLE : public SFE_QUAD_Sensor
 {
 public:
+  float _latchedPress; // Pressure and temperature, read together in a single burst
+  float _latchedTemp;
+  bool _latched; // true if acquireCompensation has already latched the readings for getSenseReading
+  uint8_t _fifoMode; // 0: FIFO off; 1: Stream - the readings are the mean of the samples drained from the FIFO; 2: FIFO Mean - the sensor averages in hardware
+  uint8_t _meanSamples; // The number of samples averaged in FIFO Mean mode: 2, 4, 8, 16 or 32
+  double _sumPress; // The samples drained from the FIFO since the last reading (Stream mode)
+  double _sumTemp;
+  uint16_t _numSamples;
+  uint16_t _latchedSamples; // The number of samples in this reading
+
   CLASSTITLE(void)
   {
     _sensorAddress = 0;
@@ -48,6 +58,94 @@ public:
     for (size_t i = 0; i <= SENSE_COUNT; i++)
       _logSense[i] = true;
     _customInitializePtr = NULL;
+    _latchedPress = 0.0;
+    _latchedTemp = 0.0;
+    _latched = false;
+    _logSense[3] = false; // Don't log the sample count by default
+    _fifoMode = 0;
+    _meanSamples = 32;
+    resetStatistics();
+    _latchedSamples = 0;
+  }
+
+  // Clear the samples drained from the FIFO
+  void resetStatistics(void)
+  {
+    _sumPress = 0.0;
+    _sumTemp = 0.0;
+    _numSamples = 0;
+  }
+
+  // Drain the FIFO, LPS25HB_FIFO_BURST_SAMPLES at a time, and add the samples to the statistics
+  bool drainFIFO(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    int32_t pressure[LPS25HB_FIFO_BURST_SAMPLES];
+    int16_t temperature[LPS25HB_FIFO_BURST_SAMPLES];
+    uint8_t level = device->getFIFOLevel();
+    while (level > 0)
+    {
+      uint8_t samples = device->readFIFO(pressure, temperature, level);
+      if (samples == 0)
+        return (false);
+      for (uint8_t i = 0; i < samples; i++)
+      {
+        _sumPress += ((double)pressure[i]) / 4096.0;
+        _sumTemp += 42.5 + (((double)temperature[i]) / 480.0); // See getTemperature_degC for the offset
+      }
+      _numSamples += samples;
+      level -= samples;
+    }
+    return (true);
+  }
+
+  // Read the pressure and temperature in a single burst
+  // In Stream mode, drain the FIFO and latch the mean of the samples instead. The previous readings are kept if the FIFO was empty
+  void latchReadings(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (_fifoMode != 1)
+    {
+      _latched = device->getPressureAndTemperature(&_latchedPress, &_latchedTemp);
+      _latchedSamples = _latched ? 1 : 0;
+      return;
+    }
+    drainFIFO();
+    _latched = (_numSamples > 0);
+    if (_latched)
+    {
+      _latchedPress = (float)(_sumPress / (double)_numSamples);
+      _latchedTemp = (float)(_sumTemp / (double)_numSamples);
+    }
+    _latchedSamples = _numSamples;
+    resetStatistics();
+  }
+
+  // Configure the FIFO for _fifoMode and _meanSamples. Changing mode passes through Bypass, which empties the FIFO
+  bool applyFIFOMode(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    bool success = device->setFIFOMode(LPS25HB_FIFO_CTRL_BYPASS);
+    if (_fifoMode == 1)
+    {
+      success &= device->setFIFOMode(LPS25HB_FIFO_CTRL_STREAM);
+    }
+    else if (_fifoMode == 2)
+    {
+      success &= device->setFIFOMode(LPS25HB_FIFO_CTRL_MEAN);
+      success &= device->setFIFOMeanNum(_meanSamples - 1);
+    }
+    resetStatistics();
+    return (success);
+  }
+
+  // Round samples to the nearest number of samples supported by FIFO Mean mode
+  uint8_t limitMeanSamples(uint8_t samples)
+  {
+    uint8_t limited = 2;
+    while ((limited < 32) && (limited < samples))
+      limited <<= 1;
+    return (limited);
   }
 
   void deleteSensorStorage(void)
@@ -95,7 +193,11 @@ public:
   bool beginSensor(uint8_t sensorAddress, TwoWire &port)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
-    return (device->begin(port, sensorAddress));
+    if (!device->begin(port, sensorAddress))
+      return (false);
+    if (_fifoMode != 0)
+      return (applyFIFOMode());
+    return (true);
   }
 
   // Initialize the sensor. ===> Adapt this to match the sensor type <===
@@ -112,6 +214,44 @@ public:
     }
   }
 
+  // Return true if the sensor needs to be polled between readings - in Stream mode, so the FIFO does not overrun
+  bool pollingEnabled(void)
+  {
+    return (_fifoMode == 1);
+  }
+
+  // Drain the FIFO once it is half full. At 25Hz, that is every 0.64 seconds
+  bool pollSensor(uint8_t sensorAddress, TwoWire &port)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (device->getFIFOLevel() < (LPS25HB_FIFO_DEPTH / 2))
+      return (false);
+    return (drainFIFO());
+  }
+
+  // Return true if this sensor can produce the specified compensation value
+  // Only pressure is produced. The LPS25HB temperature is the die temperature
+  bool producesCompensation(SFE_QUAD_Sensor_Compensation_Type_e type)
+  {
+    return (type == SFE_QUAD_COMPENSATION_PRESSURE);
+  }
+
+  // Read the pressure and latch it for getSenseReading
+  bool acquireCompensation(uint8_t sensorAddress, TwoWire &port)
+  {
+    latchReadings();
+    return (_latched);
+  }
+
+  // Return the compensation value latched by acquireCompensation
+  bool getCompensation(SFE_QUAD_Sensor_Compensation_Type_e type, float *value)
+  {
+    if (type != SFE_QUAD_COMPENSATION_PRESSURE)
+      return (false);
+    *value = _latchedPress; // hPa == mbar
+    return (true);
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -140,6 +280,9 @@ public:
     case 1:
       return ("Temperature (C)");
       break;
+    case 2:
+      return ("Samples");
+      break;
     default:
       return (NULL);
       break;
@@ -147,18 +290,52 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  // The first enabled sense reads both pressure and temperature - unless acquireCompensation already has
+  bool getSenseValue(uint8_t sense, double *value)
   {
-    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    uint8_t firstSense = 0;
+    while ((firstSense < (SENSE_COUNT - 1)) && (!_logSense[firstSense + 1]))
+      firstSense++;
+    if (sense == firstSense)
+    {
+      if (!_latched)
+        latchReadings();
+      _latched = false;
+    }
     switch (sense)
     {
     case 0:
-      _sprintf._dtostrf((double)device->getPressure_hPa(), reading); // Get the pressure
+      *value = (double)_latchedPress; // Get the pressure
+      return (true);
+      break;
+    case 1:
+      *value = (double)_latchedTemp; // Get the temperature
       return (true);
       break;
+    case 2:
+      *value = _latchedSamples;
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
     case 1:
-      _sprintf._dtostrf((double)device->getTemperature_degC(), reading); // Get the temperature
+      _sprintf._dtostrf(value, reading);
+      return (true);
+      break;
+    case 2:
+      sprintf(reading, "%ld", (long)value);
       return (true);
       break;
     default:
@@ -179,9 +356,9 @@ public:
   uint8_t getSettingNameMaxLen()
   {
     size_t longest = 0;
-    // for (uint8_t x = 0; x < SETTING_COUNT; x++)
-    //   if (strlen(getSettingName(x)) > longest)
-    //     longest = strlen(getSettingName(x));
+    for (uint8_t x = 0; x < SETTING_COUNT; x++)
+      if (strlen(getSettingName(x)) > longest)
+        longest = strlen(getSettingName(x));
     return (longest);
   }
 
@@ -190,6 +367,18 @@ public:
   {
     switch (setting)
     {
+    case 0:
+      return ("FIFO: Off");
+      break;
+    case 1:
+      return ("FIFO: Stream (Mean Of Samples)");
+      break;
+    case 2:
+      return ("FIFO: Hardware Mean");
+      break;
+    case 3:
+      return ("Hardware Mean Samples");
+      break;
     default:
       return (NULL);
       break;
@@ -202,6 +391,14 @@ public:
   {
     switch (setting)
     {
+    case 0:
+    case 1:
+    case 2:
+      *type = SFE_QUAD_SETTING_TYPE_NONE;
+      break;
+    case 3:
+      *type = SFE_QUAD_SETTING_TYPE_UINT8_T;
+      break;
     default:
       return (false);
       break;
@@ -212,9 +409,20 @@ public:
   // Set the specified setting. ===> Adapt this to match the sensor type <===
   bool setSetting(uint8_t setting, SFE_QUAD_Sensor_Every_Type_t *value)
   {
-    //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (setting)
     {
+    case 0:
+    case 1:
+    case 2:
+      _fifoMode = setting;
+      applyFIFOMode();
+      break;
+    case 3:
+      value->UINT8_T = limitMeanSamples(value->UINT8_T);
+      _meanSamples = value->UINT8_T;
+      if (_fifoMode == 2)
+        applyFIFOMode();
+      break;
     default:
       return (false);
       break;
@@ -233,9 +441,9 @@ public:
   uint8_t getConfigurationItemNameMaxLen()
   {
     size_t longest = 0;
-    // for (uint8_t x = 0; x < CONFIGURATION_ITEM_COUNT; x++)
-    //   if (strlen(getConfigurationItemName(x)) > longest)
-    //     longest = strlen(getConfigurationItemName(x));
+    for (uint8_t x = 0; x < CONFIGURATION_ITEM_COUNT; x++)
+      if (strlen(getConfigurationItemName(x)) > longest)
+        longest = strlen(getConfigurationItemName(x));
     return (longest);
   }
 
@@ -245,6 +453,12 @@ public:
   {
     switch (configItem)
     {
+    case 0:
+      return ("FIFO_Mode");
+      break;
+    case 1:
+      return ("Mean_Samples");
+      break;
     default:
       return (NULL);
       break;
@@ -257,6 +471,10 @@ public:
   {
     switch (configItem)
     {
+    case 0:
+    case 1:
+      *type = SFE_QUAD_SETTING_TYPE_UINT8_T;
+      break;
     default:
       return (false);
       break;
@@ -267,9 +485,14 @@ public:
   // Get (read) the sensor configuration item
   bool getConfigurationItem(uint8_t configItem, SFE_QUAD_Sensor_Every_Type_t *value)
   {
-    //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (configItem)
     {
+    case 0:
+      value->UINT8_T = _fifoMode;
+      break;
+    case 1:
+      value->UINT8_T = _meanSamples;
+      break;
     default:
       return (false);
       break;
@@ -280,9 +503,19 @@ public:
   // Set (write) the sensor configuration item
   bool setConfigurationItem(uint8_t configItem, SFE_QUAD_Sensor_Every_Type_t *value)
   {
-    //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (configItem)
     {
+    case 0:
+      if (value->UINT8_T > 2)
+        return (false);
+      _fifoMode = value->UINT8_T;
+      applyFIFOMode();
+      break;
+    case 1:
+      _meanSamples = limitMeanSamples(value->UINT8_T);
+      if (_fifoMode == 2)
+        applyFIFOMode();
+      break;
     default:
       return (false);
       break;
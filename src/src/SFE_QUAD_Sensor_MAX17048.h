@@ -28,15 +28,25 @@
 
 #define SENSE_COUNT 3 // <=== Update this with the number of things this sensor can sense
 
-#define SETTING_COUNT 0 // <=== Update this with the number of things that can be set on this sensor
+#define SETTING_COUNT 4 // <=== Update this with the number of things that can be set on this sensor
 
-#define CONFIGURATION_ITEM_COUNT 0 // <=== Update this with the number of things that can be configured on this sensor
+#define CONFIGURATION_ITEM_COUNT 4 // <=== Update this with the number of things that can be configured on this sensor
 
 #define SENSOR_I2C_ADDRESSES const uint8_t sensorI2cAddresses[] = {0x36} // <=== Update this with the I2C addresses for this sensor
 
 class CLASSTITLE : public SFE_QUAD_Sensor
 {
 public:
+  bool _alertMode;             // true: only STATUS is read each cycle. The readings are refreshed on an alert or when they reach _maxAge
+  float _alertVoltageMin;      // Voltage low alert threshold (V/cell)
+  float _alertVoltageMax;      // Voltage high alert threshold (V/cell)
+  uint32_t _maxAge;            // Maximum age (s) of the readings in alert mode
+  float _voltage;              // The most recent readings
+  float _soc;
+  float _changeRate;
+  bool _readingsValid;         // false until the first full read
+  unsigned long _lastFullRead; // millis of the most recent full read
+
   CLASSTITLE()
   {
     _sensorAddress = 0;
@@ -48,6 +58,57 @@ public:
     for (size_t i = 0; i <= SENSE_COUNT; i++)
       _logSense[i] = true;
     _customInitializePtr = NULL;
+    _alertMode = false;
+    _alertVoltageMin = 3.0;
+    _alertVoltageMax = 4.3;
+    _maxAge = 600;
+    _voltage = 0.0;
+    _soc = 0.0;
+    _changeRate = 0.0;
+    _readingsValid = false;
+    _lastFullRead = 0;
+  }
+
+  // Configure the alerts: 1% SOC change plus voltage high/low. Disable them when alert mode is off
+  void applyAlertMode(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (_alertMode)
+    {
+      device->setVALRTMin(_alertVoltageMin);
+      device->setVALRTMax(_alertVoltageMax);
+      device->enableSOCAlert();
+    }
+    else
+    {
+      device->setVALRTMin((uint8_t)0x00);
+      device->setVALRTMax((uint8_t)0xFF);
+      device->disableSOCAlert();
+    }
+    device->clearAlertFlags(MAX1704x_STATUS_RI | MAX1704x_STATUS_VH | MAX1704x_STATUS_VL | MAX1704x_STATUS_SC);
+    _readingsValid = false;
+  }
+
+  // Refresh the readings. In alert mode, only STATUS is read unless an alert has fired or the readings are too old
+  void updateReadings(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (_alertMode && _readingsValid)
+    {
+      uint8_t status = device->getStatus() & (MAX1704x_STATUS_RI | MAX1704x_STATUS_VH | MAX1704x_STATUS_VL | MAX1704x_STATUS_SC);
+      if (status & MAX1704x_STATUS_RI) // The device has been reset. The alert configuration has been lost
+        applyAlertMode();
+      else if (status != 0)
+        device->clearAlertFlags(status);
+      else if ((millis() - _lastFullRead) < (_maxAge * 1000))
+        return; // No alert. Use the previous readings
+    }
+    if (device->readVoltageAndSOC(&_voltage, &_soc))
+    {
+      _changeRate = device->getChangeRate();
+      _readingsValid = true;
+      _lastFullRead = millis();
+    }
   }
 
   void deleteSensorStorage(void)
@@ -95,7 +156,12 @@ public:
   bool beginSensor(uint8_t sensorAddress, TwoWire &port)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
-    return (device->begin(port));
+    if (!device->begin(port))
+      return (false);
+    if (_alertMode)
+      applyAlertMode();
+    _readingsValid = false;
+    return (true);
   }
 
   // Initialize the sensor. ===> Adapt this to match the sensor type <===
@@ -151,22 +217,45 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  // The first enabled sense updates the readings. All senses return the stored values
+  bool getSenseValue(uint8_t sense, double *value)
   {
-    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    uint8_t firstSense = 0;
+    while ((firstSense < (SENSE_COUNT - 1)) && (!_logSense[firstSense + 1]))
+      firstSense++;
+    if (sense == firstSense)
+      updateReadings();
     switch (sense)
     {
     case 0:
-      _sprintf._dtostrf((double)device->getVoltage(), reading);
+      *value = (double)_voltage;
       return (true);
       break;
     case 1:
-      _sprintf._dtostrf((double)device->getSOC(), reading);
+      *value = (double)_soc;
       return (true);
       break;
     case 2:
-      _sprintf._dtostrf((double)device->getChangeRate(), reading);
+      *value = (double)_changeRate;
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+    case 2:
+      _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
@@ -187,9 +276,9 @@ public:
   uint8_t getSettingNameMaxLen()
   {
     size_t longest = 0;
-    // for (uint8_t x = 0; x < SETTING_COUNT; x++)
-    //   if (strlen(getSettingName(x)) > longest)
-    //     longest = strlen(getSettingName(x));
+    for (uint8_t x = 0; x < SETTING_COUNT; x++)
+      if (strlen(getSettingName(x)) > longest)
+        longest = strlen(getSettingName(x));
     return (longest);
   }
 
@@ -198,6 +287,18 @@ public:
   {
     switch (setting)
     {
+    case 0:
+      return ("Alert Mode");
+      break;
+    case 1:
+      return ("Alert Voltage Min (V)");
+      break;
+    case 2:
+      return ("Alert Voltage Max (V)");
+      break;
+    case 3:
+      return ("Max Reading Age (s)");
+      break;
     default:
       return (NULL);
       break;
@@ -210,6 +311,16 @@ public:
   {
     switch (setting)
     {
+    case 0:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
+    case 1:
+    case 2:
+      *type = SFE_QUAD_SETTING_TYPE_FLOAT;
+      break;
+    case 3:
+      *type = SFE_QUAD_SETTING_TYPE_UINT32_T;
+      break;
     default:
       return (false);
       break;
@@ -220,9 +331,25 @@ public:
   // Set the specified setting. ===> Adapt this to match the sensor type <===
   bool setSetting(uint8_t setting, SFE_QUAD_Sensor_Every_Type_t *value)
   {
-    //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (setting)
     {
+    case 0:
+      _alertMode = value->BOOL;
+      applyAlertMode();
+      break;
+    case 1:
+      _alertVoltageMin = value->FLOAT;
+      if (_alertMode)
+        applyAlertMode();
+      break;
+    case 2:
+      _alertVoltageMax = value->FLOAT;
+      if (_alertMode)
+        applyAlertMode();
+      break;
+    case 3:
+      _maxAge = value->UINT32_T;
+      break;
     default:
       return (false);
       break;
@@ -241,9 +368,9 @@ public:
   uint8_t getConfigurationItemNameMaxLen()
   {
     size_t longest = 0;
-    // for (uint8_t x = 0; x < CONFIGURATION_ITEM_COUNT; x++)
-    //   if (strlen(getConfigurationItemName(x)) > longest)
-    //     longest = strlen(getConfigurationItemName(x));
+    for (uint8_t x = 0; x < CONFIGURATION_ITEM_COUNT; x++)
+      if (strlen(getConfigurationItemName(x)) > longest)
+        longest = strlen(getConfigurationItemName(x));
     return (longest);
   }
 
@@ -253,6 +380,18 @@ public:
   {
     switch (configItem)
     {
+    case 0:
+      return ("Alert_Mode");
+      break;
+    case 1:
+      return ("Alert_V_Min");
+      break;
+    case 2:
+      return ("Alert_V_Max");
+      break;
+    case 3:
+      return ("Max_Age");
+      break;
     default:
       return (NULL);
       break;
@@ -265,6 +404,16 @@ public:
   {
     switch (configItem)
     {
+    case 0:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
+    case 1:
+    case 2:
+      *type = SFE_QUAD_SETTING_TYPE_FLOAT;
+      break;
+    case 3:
+      *type = SFE_QUAD_SETTING_TYPE_UINT32_T;
+      break;
     default:
       return (false);
       break;
@@ -275,9 +424,20 @@ public:
   // Get (read) the sensor configuration item
   bool getConfigurationItem(uint8_t configItem, SFE_QUAD_Sensor_Every_Type_t *value)
   {
-    //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (configItem)
     {
+    case 0:
+      value->BOOL = _alertMode;
+      break;
+    case 1:
+      value->FLOAT = _alertVoltageMin;
+      break;
+    case 2:
+      value->FLOAT = _alertVoltageMax;
+      break;
+    case 3:
+      value->UINT32_T = _maxAge;
+      break;
     default:
       return (false);
       break;
@@ -288,9 +448,25 @@ public:
   // Set (write) the sensor configuration item
   bool setConfigurationItem(uint8_t configItem, SFE_QUAD_Sensor_Every_Type_t *value)
   {
-    //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (configItem)
     {
+    case 0:
+      _alertMode = value->BOOL;
+      applyAlertMode();
+      break;
+    case 1:
+      _alertVoltageMin = value->FLOAT;
+      if (_alertMode)
+        applyAlertMode();
+      break;
+    case 2:
+      _alertVoltageMax = value->FLOAT;
+      if (_alertMode)
+        applyAlertMode();
+      break;
+    case 3:
+      _maxAge = value->UINT32_T;
+      break;
     default:
       return (false);
       break;
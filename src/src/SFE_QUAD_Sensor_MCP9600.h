@@ -28,15 +28,21 @@
 
 #define SENSE_COUNT 2 // <=== Update this with the number of things this sensor can sense
 
-#define SETTING_COUNT 0 // <=== Update this with the number of things that can be set on this sensor
+#define SETTING_COUNT 2 // <=== Update this with the number of things that can be set on this sensor
 
-#define CONFIGURATION_ITEM_COUNT 0 // <=== Update this with the number of things that can be configured on this sensor
+#define CONFIGURATION_ITEM_COUNT 2 // <=== Update this with the number of things that can be configured on this sensor
 
 #define SENSOR_I2C_ADDRESSES const uint8_t sensorI2cAddresses[] = {0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67} // <=== Update this with the I2C addresses for this sensor
 
 class CLASSTITLE : public SFE_QUAD_Sensor
 {
 public:
+  bool _burstMode;             // true: triggerSensor starts a burst each cycle. The sensor is shut down between bursts
+  uint8_t _burstSamples;       // The number of samples per burst: 1, 2, 4, ... 128
+  bool _triggered;             // true if a burst has been started by triggerSensor and has not yet been collected
+  float _latchedThermocouple;  // The readings from the most recent burst
+  float _latchedAmbient;
+
   CLASSTITLE(void)
   {
     _sensorAddress = 0;
@@ -48,6 +54,57 @@ public:
     for (size_t i = 0; i <= SENSE_COUNT; i++)
       _logSense[i] = true;
     _customInitializePtr = NULL;
+    _burstMode = false;
+    _burstSamples = 1;
+    _triggered = false;
+    _latchedThermocouple = 0.0;
+    _latchedAmbient = 0.0;
+  }
+
+  // Select burst or continuous (normal) mode. In burst mode, the sensor is shut down until triggered
+  bool applyBurstMode(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    bool failed = false;
+    _triggered = false;
+    if (_burstMode)
+    {
+      uint8_t code = 0;
+      while ((code < SAMPLES_128) && ((1 << code) < _burstSamples))
+        code++;
+      failed |= device->setBurstSamples((Burst_Sample)code);
+      failed |= device->setShutdownMode(SHUTDOWN);
+    }
+    else
+      failed |= device->setShutdownMode(NORMAL);
+    return (!failed);
+  }
+
+  // Round samples to the nearest number of burst samples supported by the sensor
+  uint8_t limitBurstSamples(uint8_t samples)
+  {
+    uint8_t limited = 1;
+    while ((limited < 128) && (limited < samples))
+      limited <<= 1;
+    return (limited);
+  }
+
+  // Collect the burst started by triggerSensor: check the burst complete flag once, then read both temperatures
+  // If the burst is not complete, keep the previous readings and check the flag again on the next cycle
+  void collectBurst(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (!_triggered)
+      return;
+    if (!device->burstAvailable())
+      return;
+    _triggered = false;
+    float thermocouple, ambient;
+    if (device->getTemperatures(&thermocouple, &ambient))
+    {
+      _latchedThermocouple = thermocouple;
+      _latchedAmbient = ambient;
+    }
   }
 
   void deleteSensorStorage(void)
@@ -101,7 +158,11 @@ public:
   bool beginSensor(uint8_t sensorAddress, TwoWire &port)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
-    return (device->begin(sensorAddress, port));
+    if (!device->begin(sensorAddress, port))
+      return (false);
+    if (_burstMode)
+      return (applyBurstMode());
+    return (true);
   }
 
   // Initialize the sensor. ===> Adapt this to match the sensor type <===
@@ -127,6 +188,17 @@ public:
     }
   }
 
+  // In burst mode, start a burst - unless the previous one is still running. The burst can take up to 41s,
+  // so settleMillis is left at zero: triggerSensors does not wait for it. collectBurst polls the burst complete flag instead
+  bool triggerSensor(uint8_t sensorAddress, TwoWire &port, unsigned long *settleMillis)
+  {
+    if ((!_burstMode) || (_triggered))
+      return (false);
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    _triggered = !device->startBurst(); // startBurst returns true if it failed
+    return (false); // No second stage
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -162,18 +234,50 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  // In burst mode, the first enabled sense collects the burst and both senses return its readings
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (_burstMode)
+    {
+      uint8_t firstSense = 0;
+      while ((firstSense < (SENSE_COUNT - 1)) && (!_logSense[firstSense + 1]))
+        firstSense++;
+      if (sense == firstSense)
+        collectBurst();
+    }
     switch (sense)
     {
     case 0:
-      _sprintf._dtostrf((double)device->getThermocoupleTemp(), reading); // Get the temperature
+      if (_burstMode)
+        *value = (double)_latchedThermocouple;
+      else
+        *value = (double)device->getThermocoupleTemp(); // Get the temperature
       return (true);
       break;
     case 1:
-      _sprintf._dtostrf((double)device->getAmbientTemp(), reading); // Get the ambient temperature
+      if (_burstMode)
+        *value = (double)_latchedAmbient;
+      else
+        *value = (double)device->getAmbientTemp(); // Get the ambient temperature
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+      _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
@@ -194,9 +298,9 @@ public:
   uint8_t getSettingNameMaxLen()
   {
     size_t longest = 0;
-    // for (uint8_t x = 0; x < SETTING_COUNT; x++)
-    //   if (strlen(getSettingName(x)) > longest)
-    //     longest = strlen(getSettingName(x));
+    for (uint8_t x = 0; x < SETTING_COUNT; x++)
+      if (strlen(getSettingName(x)) > longest)
+        longest = strlen(getSettingName(x));
     return (longest);
   }
 
@@ -205,6 +309,12 @@ public:
   {
     switch (setting)
     {
+    case 0:
+      return ("Burst Mode");
+      break;
+    case 1:
+      return ("Burst Samples");
+      break;
     default:
       return (NULL);
       break;
@@ -217,6 +327,12 @@ public:
   {
     switch (setting)
     {
+    case 0:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
+    case 1:
+      *type = SFE_QUAD_SETTING_TYPE_UINT8_T;
+      break;
     default:
       return (false);
       break;
@@ -227,9 +343,18 @@ public:
   // Set the specified setting. ===> Adapt this to match the sensor type <===
   bool setSetting(uint8_t setting, SFE_QUAD_Sensor_Every_Type_t *value)
   {
-    //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (setting)
     {
+    case 0:
+      _burstMode = value->BOOL;
+      applyBurstMode();
+      break;
+    case 1:
+      value->UINT8_T = limitBurstSamples(value->UINT8_T);
+      _burstSamples = value->UINT8_T;
+      if (_burstMode)
+        applyBurstMode();
+      break;
     default:
       return (false);
       break;
@@ -248,9 +373,9 @@ public:
   uint8_t getConfigurationItemNameMaxLen()
   {
     size_t longest = 0;
-    // for (uint8_t x = 0; x < CONFIGURATION_ITEM_COUNT; x++)
-    //   if (strlen(getConfigurationItemName(x)) > longest)
-    //     longest = strlen(getConfigurationItemName(x));
+    for (uint8_t x = 0; x < CONFIGURATION_ITEM_COUNT; x++)
+      if (strlen(getConfigurationItemName(x)) > longest)
+        longest = strlen(getConfigurationItemName(x));
     return (longest);
   }
 
@@ -260,6 +385,12 @@ public:
   {
     switch (configItem)
     {
+    case 0:
+      return ("Burst_Mode");
+      break;
+    case 1:
+      return ("Burst_Samples");
+      break;
     default:
       return (NULL);
       break;
@@ -272,6 +403,12 @@ public:
   {
     switch (configItem)
     {
+    case 0:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
+    case 1:
+      *type = SFE_QUAD_SETTING_TYPE_UINT8_T;
+      break;
     default:
       return (false);
       break;
@@ -282,9 +419,14 @@ public:
   // Get (read) the sensor configuration item
   bool getConfigurationItem(uint8_t configItem, SFE_QUAD_Sensor_Every_Type_t *value)
   {
-    //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (configItem)
     {
+    case 0:
+      value->BOOL = _burstMode;
+      break;
+    case 1:
+      value->UINT8_T = _burstSamples;
+      break;
     default:
       return (false);
       break;
@@ -295,9 +437,17 @@ public:
   // Set (write) the sensor configuration item
   bool setConfigurationItem(uint8_t configItem, SFE_QUAD_Sensor_Every_Type_t *value)
   {
-    //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (configItem)
     {
+    case 0:
+      _burstMode = value->BOOL;
+      applyBurstMode();
+      break;
+    case 1:
+      _burstSamples = limitBurstSamples(value->UINT8_T);
+      if (_burstMode)
+        applyBurstMode();
+      break;
     default:
       return (false);
       break;
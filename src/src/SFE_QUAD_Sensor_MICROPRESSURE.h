@@ -164,38 +164,60 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (sense)
     {
     case 0:
-      _sprintf._dtostrf((double)device->readPressure(), reading); // Get the pressure
+      *value = (double)device->readPressure(); // Get the pressure
       return (true);
       break;
     case 1:
-      _sprintf._dtostrf((double)device->readPressure(PA), reading); // Get the pressure
+      *value = (double)device->readPressure(PA); // Get the pressure
       return (true);
       break;
     case 2:
-      _sprintf._dtostrf((double)device->readPressure(KPA), reading); // Get the pressure
+      *value = (double)device->readPressure(KPA); // Get the pressure
       return (true);
       break;
     case 3:
-      _sprintf._dtostrf((double)device->readPressure(TORR), reading); // Get the pressure
+      *value = (double)device->readPressure(TORR); // Get the pressure
       return (true);
       break;
     case 4:
-      _sprintf._dtostrf((double)device->readPressure(INHG), reading); // Get the pressure
+      *value = (double)device->readPressure(INHG); // Get the pressure
       return (true);
       break;
     case 5:
-      _sprintf._dtostrf((double)device->readPressure(ATM), reading); // Get the pressure
+      *value = (double)device->readPressure(ATM); // Get the pressure
       return (true);
       break;
     case 6:
-      _sprintf._dtostrf((double)device->readPressure(BAR), reading); // Get the pressure
+      *value = (double)device->readPressure(BAR); // Get the pressure
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+    case 2:
+    case 3:
+    case 4:
+    case 5:
+    case 6:
+      _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
@@ -28,15 +28,21 @@
 
 #define SENSE_COUNT 2 // <=== Update this with the number of things this sensor can sense
 
-#define SETTING_COUNT 0 // <=== Update this with the number of things that can be set on this sensor
+#define SETTING_COUNT 1 // <=== Update this with the number of things that can be set on this sensor
 
-#define CONFIGURATION_ITEM_COUNT 0 // <=== Update this with the number of things that can be configured on this sensor
+#define CONFIGURATION_ITEM_COUNT 1 // <=== Update this with the number of things that can be configured on this sensor
 
 #define SENSOR_I2C_ADDRESSES const uint8_t sensorI2cAddresses[] = {0x76} // <=== Update this with the I2C addresses for this sensor
 
 class CLASSTITLE : public SFE_QUAD_Sensor
 {
 public:
+  float _pressure; // Latched by the first enabled sense so both senses come from the same measurement
+  float _temperature;
+  bool _integerMath;       // Compensate and format using integer math only (for MCUs without an FPU)
+  int32_t _pressureInt;    // Hundredths of a mbar. Latched when _integerMath is true
+  int32_t _temperatureInt; // Hundredths of a degree C
+
   CLASSTITLE(void)
   {
     _sensorAddress = 0;
@@ -48,6 +54,11 @@ public:
     for (size_t i = 0; i <= SENSE_COUNT; i++)
       _logSense[i] = true;
     _customInitializePtr = NULL;
+    _pressure = 0.0;
+    _temperature = 0.0;
+    _integerMath = false;
+    _pressureInt = 0;
+    _temperatureInt = 0;
   }
 
   void deleteSensorStorage(void)
@@ -112,6 +123,29 @@ public:
     }
   }
 
+  // Start the temperature (D2) conversion. triggerSensors waits, then calls continueTrigger to start the pressure (D1) conversion
+  bool triggerSensor(uint8_t sensorAddress, TwoWire &port, unsigned long *settleMillis)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (device->start_measurement() != ms5637_status_ok)
+      return (false);
+    *settleMillis = device->measurement_wait();
+    return (true);
+  }
+
+  // Collect D2 and start D1, then collect D1 and compensate. Return true while a conversion is in progress
+  bool continueTrigger(uint8_t sensorAddress, TwoWire &port, unsigned long *settleMillis)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    device->service_measurement();
+    if (device->get_measurement_state() == ms5637_measurement_complete)
+      return (false);
+    if (device->get_measurement_state() == ms5637_measurement_idle) // Measurement abandoned. getSenseReading will read the sensor directly
+      return (false);
+    *settleMillis = device->measurement_wait();
+    return (true);
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -147,18 +181,63 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
+
+    // Latch the measurement when the first enabled sense is read
+    uint8_t firstSense = 0;
+    while ((firstSense < (SENSE_COUNT - 1)) && (!_logSense[firstSense + 1]))
+      firstSense++;
+    if (sense == firstSense)
+    {
+      if (_integerMath)
+      {
+        if (device->get_measurement_integer(&_temperatureInt, &_pressureInt) != ms5637_status_ok) // Use the measurement completed by triggerSensors
+          device->read_temperature_and_pressure_integer(&_temperatureInt, &_pressureInt);         // Else read the sensor directly
+      }
+      else
+      {
+        if (device->get_measurement(&_temperature, &_pressure) != ms5637_status_ok) // Use the measurement completed by triggerSensors
+          device->read_temperature_and_pressure(&_temperature, &_pressure);         // Else read the sensor directly
+      }
+    }
+
     switch (sense)
     {
     case 0:
-      _sprintf._dtostrf((double)device->getPressure(), reading); // Get the pressure
+      if (_integerMath)
+        *value = (double)_pressureInt / 100.0;
+      else
+        *value = (double)_pressure; // Get the pressure
       return (true);
       break;
     case 1:
-      _sprintf._dtostrf((double)device->getTemperature(), reading); // Get the temperature
+      if (_integerMath)
+        *value = (double)_temperatureInt / 100.0;
+      else
+        *value = (double)_temperature; // Get the temperature
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+      if (_integerMath) // Round to the nearest 0.01 and convert without using floating point
+        _sprintf._fixtostrf((int32_t)((value * 100.0) + ((value < 0.0) ? -0.5 : 0.5)), 2, reading);
+      else
+        _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
@@ -179,9 +258,9 @@ public:
   uint8_t getSettingNameMaxLen()
   {
     size_t longest = 0;
-    // for (uint8_t x = 0; x < SETTING_COUNT; x++)
-    //   if (strlen(getSettingName(x)) > longest)
-    //     longest = strlen(getSettingName(x));
+    for (uint8_t x = 0; x < SETTING_COUNT; x++)
+      if (strlen(getSettingName(x)) > longest)
+        longest = strlen(getSettingName(x));
     return (longest);
   }
 
@@ -190,6 +269,9 @@ public:
   {
     switch (setting)
     {
+    case 0:
+      return ("Integer Math");
+      break;
     default:
       return (NULL);
       break;
@@ -202,6 +284,9 @@ public:
   {
     switch (setting)
     {
+    case 0:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -215,6 +300,9 @@ public:
     //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (setting)
     {
+    case 0:
+      _integerMath = value->BOOL;
+      break;
     default:
       return (false);
       break;
@@ -233,9 +321,9 @@ public:
   uint8_t getConfigurationItemNameMaxLen()
   {
     size_t longest = 0;
-    // for (uint8_t x = 0; x < CONFIGURATION_ITEM_COUNT; x++)
-    //   if (strlen(getConfigurationItemName(x)) > longest)
-    //     longest = strlen(getConfigurationItemName(x));
+    for (uint8_t x = 0; x < CONFIGURATION_ITEM_COUNT; x++)
+      if (strlen(getConfigurationItemName(x)) > longest)
+        longest = strlen(getConfigurationItemName(x));
     return (longest);
   }
 
@@ -245,6 +333,9 @@ public:
   {
     switch (configItem)
     {
+    case 0:
+      return ("Integer_Math");
+      break;
     default:
       return (NULL);
       break;
@@ -257,6 +348,9 @@ public:
   {
     switch (configItem)
     {
+    case 0:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -270,6 +364,9 @@ public:
     //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (configItem)
     {
+    case 0:
+      value->BOOL = _integerMath;
+      break;
     default:
       return (false);
       break;
@@ -283,6 +380,9 @@ public:
     //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (configItem)
     {
+    case 0:
+      _integerMath = value->BOOL;
+      break;
     default:
       return (false);
       break;
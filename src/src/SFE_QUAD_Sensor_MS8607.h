@@ -28,15 +28,26 @@
 
 #define SENSE_COUNT 3 // <=== Update this with the number of things this sensor can sense
 
-#define SETTING_COUNT 2 // <=== Update this with the number of things that can be set on this sensor
+#define SETTING_COUNT 3 // <=== Update this with the number of things that can be set on this sensor
 
-#define CONFIGURATION_ITEM_COUNT 1 // <=== Update this with the number of things that can be configured on this sensor
+#define CONFIGURATION_ITEM_COUNT 2 // <=== Update this with the number of things that can be configured on this sensor
 
 #define SENSOR_I2C_ADDRESSES const uint8_t sensorI2cAddresses[] = {0x40} // <=== Update this with the I2C addresses for this sensor
 
 class CLASSTITLE : public SFE_QUAD_Sensor
 {
 public:
+  float _latchedPress; // Measurements latched by acquireCompensation or triggerSensors
+  float _latchedTemp;
+  float _latchedRH;
+  bool _pressLatched; // true if _latchedPress has not yet been read by getSenseReading
+  bool _tempLatched;  // true if _latchedTemp has not yet been read by getSenseReading
+  bool _rhLatched;    // true if _latchedRH has not yet been read by getSenseReading
+  bool _integerMath;  // Compensate and format using integer math only (for MCUs without an FPU)
+  int32_t _latchedPressInt; // Hundredths of a mbar. Latched alongside the floats when _integerMath is true
+  int32_t _latchedTempInt;  // Hundredths of a degree C
+  int32_t _latchedRHInt;    // Hundredths of a %RH
+
   CLASSTITLE(void)
   {
     _sensorAddress = 0;
@@ -48,6 +59,27 @@ public:
     for (size_t i = 0; i <= SENSE_COUNT; i++)
       _logSense[i] = true;
     _customInitializePtr = NULL;
+    _latchedPress = 0.0;
+    _latchedTemp = 0.0;
+    _latchedRH = 0.0;
+    _pressLatched = false;
+    _tempLatched = false;
+    _rhLatched = false;
+    _integerMath = false;
+    _latchedPressInt = 0;
+    _latchedTempInt = 0;
+    _latchedRHInt = 0;
+  }
+
+  // Copy the integer measurements into the floats used by getCompensation
+  void latchIntegerMeasurements(void)
+  {
+    _latchedPress = (float)_latchedPressInt / 100.0;
+    _latchedTemp = (float)_latchedTempInt / 100.0;
+    _latchedRH = (float)_latchedRHInt / 100.0;
+    _pressLatched = true;
+    _tempLatched = true;
+    _rhLatched = true;
   }
 
   void deleteSensorStorage(void)
@@ -112,6 +144,91 @@ public:
     }
   }
 
+  // Return true if this sensor can produce the specified compensation value
+  bool producesCompensation(SFE_QUAD_Sensor_Compensation_Type_e type)
+  {
+    return ((type == SFE_QUAD_COMPENSATION_TEMPERATURE) || (type == SFE_QUAD_COMPENSATION_HUMIDITY) || (type == SFE_QUAD_COMPENSATION_PRESSURE));
+  }
+
+  // Read all three measurements in one go and latch them for getSenseReading
+  bool acquireCompensation(uint8_t sensorAddress, TwoWire &port)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (_integerMath)
+    {
+      if (device->read_temperature_pressure_humidity_integer(&_latchedTempInt, &_latchedPressInt, &_latchedRHInt) != MS8607_status_ok)
+        return (false);
+      latchIntegerMeasurements();
+      return (true);
+    }
+    if (device->read_temperature_pressure_humidity(&_latchedTemp, &_latchedPress, &_latchedRH) != MS8607_status_ok)
+      return (false);
+    _pressLatched = true;
+    _tempLatched = true;
+    _rhLatched = true;
+    return (true);
+  }
+
+  // Return the compensation value latched by acquireCompensation
+  bool getCompensation(SFE_QUAD_Sensor_Compensation_Type_e type, float *value)
+  {
+    switch (type)
+    {
+    case SFE_QUAD_COMPENSATION_TEMPERATURE:
+      *value = _latchedTemp;
+      break;
+    case SFE_QUAD_COMPENSATION_HUMIDITY:
+      *value = _latchedRH;
+      break;
+    case SFE_QUAD_COMPENSATION_PRESSURE:
+      *value = _latchedPress; // Already mbar
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (true);
+  }
+
+  // Start the temperature (D2) and humidity conversions. triggerSensors waits, then calls continueTrigger to start the pressure (D1) conversion
+  // Nothing to do if acquireCompensation has already latched a measurement this cycle
+  bool triggerSensor(uint8_t sensorAddress, TwoWire &port, unsigned long *settleMillis)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if ((_pressLatched && _logSense[1]) || (_tempLatched && _logSense[2]) || (_rhLatched && _logSense[3]))
+      return (false);
+    if (device->start_measurement() != MS8607_status_ok)
+      return (false);
+    *settleMillis = device->measurement_wait();
+    return (true);
+  }
+
+  // Collect D2 and humidity and start D1, then collect D1 and compensate. Return true while a conversion is in progress
+  bool continueTrigger(uint8_t sensorAddress, TwoWire &port, unsigned long *settleMillis)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    device->service_measurement();
+    if (device->get_measurement_state() == MS8607_measurement_complete)
+    {
+      if (_integerMath)
+      {
+        if (device->get_measurement_integer(&_latchedTempInt, &_latchedPressInt, &_latchedRHInt) == MS8607_status_ok)
+          latchIntegerMeasurements();
+      }
+      else if (device->get_measurement(&_latchedTemp, &_latchedPress, &_latchedRH) == MS8607_status_ok) // Latch the measurement for getSenseReading
+      {
+        _pressLatched = true;
+        _tempLatched = true;
+        _rhLatched = true;
+      }
+      return (false);
+    }
+    if (device->get_measurement_state() == MS8607_measurement_idle) // Measurement abandoned. getSenseReading will read the sensor directly
+      return (false);
+    *settleMillis = device->measurement_wait();
+    return (true);
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -150,22 +267,76 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
+
+    if (_integerMath)
+    {
+      // Read all three measurements when the first enabled sense is read - unless they have already been latched
+      uint8_t firstSense = 0;
+      while ((firstSense < (SENSE_COUNT - 1)) && (!_logSense[firstSense + 1]))
+        firstSense++;
+      bool latched = (firstSense == 0) ? _pressLatched : ((firstSense == 1) ? _tempLatched : _rhLatched);
+      if ((sense == firstSense) && (!latched))
+      {
+        if (device->read_temperature_pressure_humidity_integer(&_latchedTempInt, &_latchedPressInt, &_latchedRHInt) == MS8607_status_ok)
+          latchIntegerMeasurements();
+      }
+    }
+
     switch (sense)
     {
     case 0:
-      _sprintf._dtostrf((double)device->getPressure(), reading); // Get the pressure
+      if (_integerMath && _pressLatched)
+        *value = (double)_latchedPressInt / 100.0;
+      else if (_pressLatched) // Use the pressure latched by acquireCompensation or triggerSensors
+        *value = (double)_latchedPress;
+      else
+        *value = (double)device->getPressure(); // Get the pressure
+      _pressLatched = false;
       return (true);
       break;
     case 1:
-      _sprintf._dtostrf((double)device->getTemperature(), reading); // Get the temperature
+      if (_integerMath && _tempLatched)
+        *value = (double)_latchedTempInt / 100.0;
+      else if (_tempLatched) // Use the temperature latched by acquireCompensation or triggerSensors
+        *value = (double)_latchedTemp;
+      else
+        *value = (double)device->getTemperature(); // Get the temperature
+      _tempLatched = false;
       return (true);
       break;
     case 2:
-      _sprintf._dtostrf((double)device->getHumidity(), reading); // Get the temperature
+      if (_integerMath && _rhLatched)
+        *value = (double)_latchedRHInt / 100.0;
+      else if (_rhLatched) // Use the humidity latched by acquireCompensation or triggerSensors
+        *value = (double)_latchedRH;
+      else
+        *value = (double)device->getHumidity(); // Get the temperature
+      _rhLatched = false;
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+    case 2:
+      if (_integerMath) // Round to the nearest 0.01 and convert without using floating point
+        _sprintf._fixtostrf((int32_t)((value * 100.0) + ((value < 0.0) ? -0.5 : 0.5)), 2, reading);
+      else
+        _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
@@ -203,6 +374,9 @@ public:
     case 1:
       return ("Disable Heater");
       break;
+    case 2:
+      return ("Integer Math");
+      break;
     default:
       return (NULL);
       break;
@@ -221,6 +395,9 @@ public:
     case 1:
       *type = SFE_QUAD_SETTING_TYPE_NONE;
       break;
+    case 2:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -240,6 +417,9 @@ public:
     case 1:
       device->disable_heater();
       break;
+    case 2:
+      _integerMath = value->BOOL;
+      break;
     default:
       return (false);
       break;
@@ -273,6 +453,9 @@ public:
     case 0:
       return ("Heater");
       break;
+    case 1:
+      return ("Integer_Math");
+      break;
     default:
       return (NULL);
       break;
@@ -288,6 +471,9 @@ public:
     case 0:
       *type = SFE_QUAD_SETTING_TYPE_BOOL;
       break;
+    case 1:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -306,6 +492,9 @@ public:
       device->get_heater_status(&status);
       value->BOOL = status == MS8607_heater_on;
       break;
+    case 1:
+      value->BOOL = _integerMath;
+      break;
     default:
       return (false);
       break;
@@ -325,6 +514,9 @@ public:
       else
         device->disable_heater();
       break;
+    case 1:
+      _integerMath = value->BOOL;
+      break;
     default:
       return (false);
       break;
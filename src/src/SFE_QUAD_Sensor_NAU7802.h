@@ -26,17 +26,41 @@
 
 #define CLASSTITLE SFE_QUAD_Sensor_NAU7802 // <=== Update this with the new sensor type
 
-#define SENSE_COUNT 1 // <=== Update this with the number of things this sensor can sense
+#define SENSE_COUNT 3 // <=== Update this with the number of things this sensor can sense
 
 #define SETTING_COUNT 2 // <=== Update this with the number of things that can be set on this sensor
 
-#define CONFIGURATION_ITEM_COUNT 2 // <=== Update this with the number of things that can be configured on this sensor
+#define CONFIGURATION_ITEM_COUNT 7 // <=== Update this with the number of things that can be configured on this sensor
 
 #define SENSOR_I2C_ADDRESSES const uint8_t sensorI2cAddresses[] = {0x2A} // <=== Update this with the I2C addresses for this sensor
 
+#ifndef NAU7802_SAMPLE_RING_SIZE
+#define NAU7802_SAMPLE_RING_SIZE 64 // The maximum number of samples in the statistics window
+#endif
+
 class CLASSTITLE : public SFE_QUAD_Sensor
 {
 public:
+  // The sample ring holds the most recent _window conversions
+  // The running sums provide the mean and variance in constant time
+  // _sorted holds the same samples in ascending order, so the median is also read in constant time.
+  // Each new sample costs a binary search plus a shift of at most _window samples
+  int32_t _ring[NAU7802_SAMPLE_RING_SIZE];
+  int32_t _sorted[NAU7802_SAMPLE_RING_SIZE];
+  uint8_t _window;     // The number of samples in the statistics window (1 to NAU7802_SAMPLE_RING_SIZE)
+  uint8_t _ringHead;   // The index of the next sample to be written (the oldest sample once the ring is full)
+  uint8_t _ringCount;  // The number of samples in the ring
+  int64_t _ringSum;    // The sum of the samples in the ring
+  int64_t _ringSumSq;  // The sum of the squares of the samples in the ring. 24-bit samples: 64 * 2^46 fits comfortably
+  uint8_t _sampleRate; // NAU7802_SPS_10 to NAU7802_SPS_320
+  bool _highRate;      // Drain every conversion into the ring between readings (via pollSensor)
+  bool _autoTare;      // Track zero drift while the scale is stable and (nearly) empty
+  float _autoTareBand; // The auto-tare band in weight units. The mean and standard deviation must both be within this band
+  float _tareRemainder; // The part of the drift correction which is smaller than one ADC count. Accumulated so small drifts are still corrected
+  float _latchedMean;   // The statistics for this reading. Shared by the three senses
+  float _latchedMedian;
+  float _latchedStdDev;
+
   CLASSTITLE(void)
   {
     _sensorAddress = 0;
@@ -47,7 +71,162 @@ public:
     _logSense = new bool[SENSE_COUNT + 1];
     for (size_t i = 0; i <= SENSE_COUNT; i++)
       _logSense[i] = true;
+    for (size_t i = 2; i <= SENSE_COUNT; i++) // Don't log the median and standard deviation by default
+      _logSense[i] = false;
     _customInitializePtr = NULL;
+    _window = 8; // The same number of samples as getWeight uses by default
+    _sampleRate = NAU7802_SPS_80;
+    _highRate = false;
+    _autoTare = false;
+    _autoTareBand = 0.0;
+    _tareRemainder = 0.0;
+    _latchedMean = 0.0;
+    _latchedMedian = 0.0;
+    _latchedStdDev = 0.0;
+    resetRing();
+  }
+
+  // Discard all samples
+  void resetRing(void)
+  {
+    _ringHead = 0;
+    _ringCount = 0;
+    _ringSum = 0;
+    _ringSumSq = 0;
+  }
+
+  // Return the index of the first entry in _sorted which is not less than sample (binary search)
+  uint8_t findSorted(int32_t sample, uint8_t count)
+  {
+    uint8_t lower = 0;
+    uint8_t upper = count;
+    while (lower < upper)
+    {
+      uint8_t middle = (lower + upper) / 2;
+      if (_sorted[middle] < sample)
+        lower = middle + 1;
+      else
+        upper = middle;
+    }
+    return (lower);
+  }
+
+  // Add a sample to the ring. Remove the oldest sample from the running sums and _sorted once the window is full
+  void addSample(int32_t sample)
+  {
+    if (_ringCount == _window)
+    {
+      _ringSum -= _ring[_ringHead];
+      _ringSumSq -= (int64_t)_ring[_ringHead] * _ring[_ringHead];
+      uint8_t oldest = findSorted(_ring[_ringHead], _ringCount);
+      memmove(&_sorted[oldest], &_sorted[oldest + 1], (_ringCount - oldest - 1) * sizeof(int32_t));
+      _ringCount--;
+    }
+    uint8_t position = findSorted(sample, _ringCount);
+    memmove(&_sorted[position + 1], &_sorted[position], (_ringCount - position) * sizeof(int32_t));
+    _sorted[position] = sample;
+    _ringCount++;
+    _ring[_ringHead] = sample;
+    _ringSum += sample;
+    _ringSumSq += (int64_t)sample * sample;
+    _ringHead++;
+    if (_ringHead >= _window)
+      _ringHead = 0;
+  }
+
+  // Return the mean of the samples in the ring (raw ADC counts)
+  float getRingMean(void)
+  {
+    if (_ringCount == 0)
+      return (0.0);
+    return ((float)((double)_ringSum / (double)_ringCount));
+  }
+
+  // Return the variance of the samples in the ring (raw ADC counts squared)
+  float getRingVariance(void)
+  {
+    if (_ringCount < 2)
+      return (0.0);
+    double mean = (double)_ringSum / (double)_ringCount;
+    double variance = ((double)_ringSumSq / (double)_ringCount) - (mean * mean);
+    if (variance < 0.0) // Guard against rounding errors
+      variance = 0.0;
+    return ((float)variance);
+  }
+
+  // Return the median of the samples in the ring (raw ADC counts)
+  float getRingMedian(void)
+  {
+    if (_ringCount == 0)
+      return (0.0);
+    if ((_ringCount & 1) == 1)
+      return ((float)_sorted[_ringCount / 2]);
+    return ((float)(((double)_sorted[(_ringCount / 2) - 1] + (double)_sorted[_ringCount / 2]) / 2.0));
+  }
+
+  // Drain the latest conversion (if one is ready) into the ring. Does not wait
+  bool collectSample(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (!device->available())
+      return (false);
+    addSample(device->getReading());
+    if (_autoTare)
+      trackZeroDrift();
+    return (true);
+  }
+
+  // Fill the window by waiting for _window conversions. Gives up after 1000ms (like getAverage)
+  void fillWindow(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    resetRing();
+    unsigned long startTime = millis();
+    while ((_ringCount < _window) && (millis() - startTime <= 1000))
+    {
+      if (device->available())
+        addSample(device->getReading());
+      else
+        delay(1);
+    }
+  }
+
+  // Nudge the zero offset towards the mean when the window is full, stable and within the auto-tare band
+  void trackZeroDrift(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (_ringCount < _window)
+      return;
+    float bandCounts = _autoTareBand * device->getCalibrationFactor(); // Convert the band from weight units to ADC counts
+    if (bandCounts < 0.0)
+      bandCounts = -bandCounts;
+    float drift = getRingMean() - (float)device->getZeroOffset();
+    if ((drift > bandCounts) || (drift < -bandCounts)) // Is there something on the scale?
+      return;
+    if (getRingVariance() > (bandCounts * bandCounts)) // Is the scale moving?
+      return;
+    _tareRemainder += drift / 16.0; // Track slowly
+    int32_t correction = (int32_t)_tareRemainder; // Apply the whole counts. Keep the fraction for next time
+    _tareRemainder -= (float)correction;
+    if (correction != 0)
+      device->setZeroOffset(device->getZeroOffset() + correction);
+  }
+
+  // Calculate the statistics for this reading (in weight units). Negative weights are allowed
+  void latchStatistics(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (_highRate)
+      collectSample();
+    else
+      fillWindow();
+    float zero = (float)device->getZeroOffset();
+    float cal = device->getCalibrationFactor();
+    _latchedMean = (getRingMean() - zero) / cal;
+    _latchedMedian = (getRingMedian() - zero) / cal;
+    _latchedStdDev = sqrt(getRingVariance()) / cal;
+    if (_latchedStdDev < 0.0)
+      _latchedStdDev = -_latchedStdDev;
   }
 
   void deleteSensorStorage(void)
@@ -114,6 +293,18 @@ public:
     }
   }
 
+  // Return true if the sensor needs to be polled between readings
+  bool pollingEnabled(void)
+  {
+    return (_highRate);
+  }
+
+  // Drain the latest conversion (if one is ready) into the ring
+  bool pollSensor(uint8_t sensorAddress, TwoWire &port)
+  {
+    return (collectSample());
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -139,6 +330,12 @@ public:
     case 0:
       return ("Weight");
       break;
+    case 1:
+      return ("Weight (Median)");
+      break;
+    case 2:
+      return ("Weight (Std Dev)");
+      break;
     default:
       return (NULL);
       break;
@@ -146,14 +343,45 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  // The statistics are calculated over the window once per reading, by the first enabled sense
+  bool getSenseValue(uint8_t sense, double *value)
   {
-    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    uint8_t firstSense = 0;
+    while ((firstSense < (SENSE_COUNT - 1)) && (!_logSense[firstSense + 1]))
+      firstSense++;
+    if (sense == firstSense)
+      latchStatistics();
     switch (sense)
     {
     case 0:
-      _sprintf._dtostrf((double)device->getWeight(true), reading); // Get the weight. Allow negative weights
+      *value = (double)_latchedMean; // Get the mean weight. Allow negative weights
+      return (true);
+      break;
+    case 1:
+      *value = (double)_latchedMedian; // Get the median weight
+      return (true);
+      break;
+    case 2:
+      *value = (double)_latchedStdDev; // Get the standard deviation of the weight
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+    case 2:
+      _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
@@ -223,10 +451,16 @@ public:
     switch (setting)
     {
     case 0:
-      device->calculateZeroOffset(64); // Zero the scale - calculateZeroOffset(uint8_t averageAmount = 8)
+      if (_highRate && (_ringCount == _window)) // Use the window if it is full. No need to wait
+        device->setZeroOffset((int32_t)getRingMean());
+      else
+        device->calculateZeroOffset(64); // Zero the scale - calculateZeroOffset(uint8_t averageAmount = 8)
       break;
     case 1:
-      device->calculateCalibrationFactor(value->FLOAT, 64); // Set the calibration factor - calculateCalibrationFactor(float weightOnScale, uint8_t averageAmount = 8)
+      if (_highRate && (_ringCount == _window)) // Use the window if it is full. No need to wait
+        device->setCalibrationFactor((getRingMean() - (float)device->getZeroOffset()) / value->FLOAT);
+      else
+        device->calculateCalibrationFactor(value->FLOAT, 64); // Set the calibration factor - calculateCalibrationFactor(float weightOnScale, uint8_t averageAmount = 8)
       break;
     default:
       return (false);
@@ -264,6 +498,21 @@ public:
     case 1:
       return ("Calibration_Factor");
       break;
+    case 2:
+      return ("Sample_Rate");
+      break;
+    case 3:
+      return ("High_Rate");
+      break;
+    case 4:
+      return ("Window");
+      break;
+    case 5:
+      return ("Auto_Tare");
+      break;
+    case 6:
+      return ("Auto_Tare_Band");
+      break;
     default:
       return (NULL);
       break;
@@ -282,6 +531,21 @@ public:
     case 1:
       *type = SFE_QUAD_SETTING_TYPE_FLOAT; // float getCalibrationFactor() / setCalibrationFactor(float calFactor)
       break;
+    case 2:
+      *type = SFE_QUAD_SETTING_TYPE_UINT8_T; // setSampleRate(uint8_t rate)
+      break;
+    case 3:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
+    case 4:
+      *type = SFE_QUAD_SETTING_TYPE_UINT8_T;
+      break;
+    case 5:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
+    case 6:
+      *type = SFE_QUAD_SETTING_TYPE_FLOAT;
+      break;
     default:
       return (false);
       break;
@@ -301,6 +565,21 @@ public:
     case 1:
       value->FLOAT = device->getCalibrationFactor();
       break;
+    case 2:
+      value->UINT8_T = _sampleRate;
+      break;
+    case 3:
+      value->BOOL = _highRate;
+      break;
+    case 4:
+      value->UINT8_T = _window;
+      break;
+    case 5:
+      value->BOOL = _autoTare;
+      break;
+    case 6:
+      value->FLOAT = _autoTareBand;
+      break;
     default:
       return (false);
       break;
@@ -320,6 +599,31 @@ public:
     case 1:
       device->setCalibrationFactor(value->FLOAT);
       break;
+    case 2:
+      if (value->UINT8_T == _sampleRate)
+        break;
+      _sampleRate = value->UINT8_T;
+      device->setSampleRate(_sampleRate);
+      device->calibrateAFE(); // Re-cal analog front end when we change gain, sample rate, or channel
+      resetRing();
+      break;
+    case 3:
+      _highRate = value->BOOL;
+      resetRing();
+      break;
+    case 4:
+      if ((value->UINT8_T == 0) || (value->UINT8_T > NAU7802_SAMPLE_RING_SIZE))
+        return (false);
+      _window = value->UINT8_T;
+      resetRing();
+      break;
+    case 5:
+      _autoTare = value->BOOL;
+      _tareRemainder = 0.0;
+      break;
+    case 6:
+      _autoTareBand = value->FLOAT;
+      break;
     default:
       return (false);
       break;
@@ -28,18 +28,29 @@
 
 #define SENSE_COUNT 2 // <=== Update this with the number of things this sensor can sense
 
-#define SETTING_COUNT 2 // <=== Update this with the number of things that can be set on this sensor
+#define SETTING_COUNT 3 // <=== Update this with the number of things that can be set on this sensor
 
-#define CONFIGURATION_ITEM_COUNT 2 // <=== Update this with the number of things that can be configured on this sensor
+#define CONFIGURATION_ITEM_COUNT 3 // <=== Update this with the number of things that can be configured on this sensor
 
 #define SENSOR_I2C_ADDRESSES const uint8_t sensorI2cAddresses[] = {0x6F, 0x6E, 0x6D, 0x6C, 0x6B, 0x6A, 0x69, 0x68} // <=== Update this with the I2C addresses for this sensor
 
+#define SFE_QUAD_QWIICBUTTON_EVENTS 32 // The number of events which can be buffered between calls to getSensorEvents
+
 class CLASSTITLE : public SFE_QUAD_Sensor
 {
 public:
   uint8_t _ledBrightness;
   bool _ledState;
   bool _toggleLEDOnClick;
+  bool _logEvents;                                   // true: every press and click is buffered for getSensorEvents. pollSensor drains the button queues
+  unsigned long _eventMillis[SFE_QUAD_QWIICBUTTON_EVENTS]; // The buffered events: the time (millis) of each event
+  bool _eventClicked[SFE_QUAD_QWIICBUTTON_EVENTS];   // false: pressed; true: clicked
+  uint8_t _eventHead;                                // The oldest buffered event
+  uint8_t _eventCount;                               // The number of buffered events
+  unsigned long _lastPressedMillis;                  // The time (millis) of the most recent press and click drained since the last reading
+  unsigned long _lastClickedMillis;
+  bool _pressedSeen;                                 // true if a press / click has been drained since the last reading
+  bool _clickedSeen;
 
   CLASSTITLE(void)
   {
@@ -55,6 +66,71 @@ public:
     _ledBrightness = 128;
     _ledState = false;
     _toggleLEDOnClick = true;
+    _logEvents = false;
+    _eventHead = 0;
+    _eventCount = 0;
+    _lastPressedMillis = 0;
+    _lastClickedMillis = 0;
+    _pressedSeen = false;
+    _clickedSeen = false;
+  }
+
+  // Add an event to the buffer. If the buffer is full, the oldest event is discarded
+  void bufferEvent(unsigned long eventMillis, bool clicked)
+  {
+    if (_eventCount == SFE_QUAD_QWIICBUTTON_EVENTS)
+    {
+      _eventHead = (_eventHead + 1) % SFE_QUAD_QWIICBUTTON_EVENTS;
+      _eventCount--;
+    }
+    uint8_t tail = (_eventHead + _eventCount) % SFE_QUAD_QWIICBUTTON_EVENTS;
+    _eventMillis[tail] = eventMillis;
+    _eventClicked[tail] = clicked;
+    _eventCount++;
+  }
+
+  // Drain both button queues, oldest first
+  // Each pass reads the status and oldest timestamp of both queues in a single burst, then pops them
+  // The button timestamps are ages (ms before the read). They are converted to millis
+  void drainQueues(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    bool pressedEmpty, clickedEmpty;
+    unsigned long oldestPress, oldestClick;
+    bool toggled = false;
+    for (uint8_t pass = 0; pass < SFE_QUAD_QWIICBUTTON_EVENTS; pass++) // Limit the number of passes - in case the button is very busy
+    {
+      if (!device->readQueues(&pressedEmpty, &oldestPress, &clickedEmpty, &oldestClick))
+        break;
+      if (pressedEmpty && clickedEmpty)
+        break;
+      unsigned long now = millis();
+      if (!pressedEmpty)
+      {
+        _lastPressedMillis = now - oldestPress;
+        _pressedSeen = true;
+        if (_logEvents)
+          bufferEvent(_lastPressedMillis, false);
+        device->popQueue(SFE_QWIIC_BUTTON_PRESSED_QUEUE_STATUS);
+      }
+      if (!clickedEmpty)
+      {
+        _lastClickedMillis = now - oldestClick;
+        _clickedSeen = true;
+        if (_logEvents)
+          bufferEvent(_lastClickedMillis, true);
+        device->popQueue(SFE_QWIIC_BUTTON_CLICKED_QUEUE_STATUS);
+        _ledState ^= 1; // Toggle ledState
+        toggled = true;
+      }
+    }
+    if ((toggled) && (_toggleLEDOnClick))
+    {
+      if (_ledState)
+        device->LEDon(_ledBrightness);
+      else
+        device->LEDoff();
+    }
   }
 
   void deleteSensorStorage(void)
@@ -121,6 +197,35 @@ public:
     }
   }
 
+  // Return true if the sensor needs to be polled between readings - when logging events, so the button queues do not overflow
+  bool pollingEnabled(void)
+  {
+    return (_logEvents);
+  }
+
+  // Drain the button queues into the event buffer
+  bool pollSensor(uint8_t sensorAddress, TwoWire &port)
+  {
+    uint8_t count = _eventCount;
+    drainQueues();
+    return (_eventCount != count);
+  }
+
+  // Return the next buffered event: millis,Pressed or millis,Clicked
+  bool getSensorEvent(uint8_t sensorAddress, TwoWire &port, char *event)
+  {
+    if (!_logEvents)
+      return (false);
+    if (_eventCount == 0)
+      drainQueues();
+    if (_eventCount == 0)
+      return (false);
+    sprintf(event, "%lu,%s", _eventMillis[_eventHead], _eventClicked[_eventHead] ? "Clicked" : "Pressed");
+    _eventHead = (_eventHead + 1) % SFE_QUAD_QWIICBUTTON_EVENTS;
+    _eventCount--;
+    return (true);
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -156,39 +261,30 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  // The first enabled sense drains both queues. Each sense returns the age (s) of the most recent press / click since the last reading - or zero
+  bool getSenseValue(uint8_t sense, double *value)
   {
-    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    uint8_t firstSense = 0;
+    while ((firstSense < (SENSE_COUNT - 1)) && (!_logSense[firstSense + 1]))
+      firstSense++;
+    if (sense == firstSense)
+      drainQueues();
     switch (sense)
     {
     case 0:
     {
-      long pressedPopped = 0;
-      while (device->isPressedQueueEmpty() == false)
-      {
-        pressedPopped = device->popPressedQueue();
-      }
-      _sprintf._dtostrf(((double)pressedPopped) / 1000.0, reading); // Get the pressure
+      double pressedAge = _pressedSeen ? ((double)(millis() - _lastPressedMillis)) / 1000.0 : 0.0;
+      _pressedSeen = false;
+      *value = pressedAge;
       return (true);
     }
       break;
     case 1:
     {
-      long clickedPopped = 0;
-      while (device->isClickedQueueEmpty() == false)
-      {
-        clickedPopped = device->popClickedQueue();
-        _ledState ^= 1; // Toggle ledState
-      }
-      _sprintf._dtostrf(((double)clickedPopped) / 1000.0, reading); // Get the pressure
-      if (_toggleLEDOnClick)
-      {
-        if (_ledState)
-          device->LEDon(_ledBrightness);
-        else
-          device->LEDoff();
-      }
+      double clickedAge = _clickedSeen ? ((double)(millis() - _lastClickedMillis)) / 1000.0 : 0.0;
+      _clickedSeen = false;
+      *value = clickedAge;
       return (true);
     }
       break;
@@ -199,6 +295,23 @@ public:
     return (false);
   }
 
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+      _sprintf._dtostrf(value, reading);
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
   // Return the count of the number of things that can be set on this sensor
   bool getSettingCount(uint8_t *count)
   {
@@ -227,6 +340,9 @@ public:
     case 1:
       return ("LED Brightness");
       break;
+    case 2:
+      return ("Log Events");
+      break;
     default:
       return (NULL);
       break;
@@ -245,6 +361,9 @@ public:
     case 1:
       *type = SFE_QUAD_SETTING_TYPE_UINT8_T;
       break;
+    case 2:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -264,6 +383,10 @@ public:
     case 1:
       _ledBrightness = value->UINT8_T;
       break;
+    case 2:
+      _logEvents = value->BOOL;
+      _eventCount = 0;
+      break;
     default:
       return (false);
       break;
@@ -300,6 +423,9 @@ public:
     case 1:
       return ("LED_Bright");
       break;
+    case 2:
+      return ("Log_Events");
+      break;
     default:
       return (NULL);
       break;
@@ -318,6 +444,9 @@ public:
     case 1:
       *type = SFE_QUAD_SETTING_TYPE_UINT8_T;
       break;
+    case 2:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -337,6 +466,9 @@ public:
     case 1:
       value->UINT8_T = _ledBrightness;
       break;
+    case 2:
+      value->BOOL = _logEvents;
+      break;
     default:
       return (false);
       break;
@@ -353,9 +485,16 @@ public:
     case 0:
       _toggleLEDOnClick = value->BOOL;
       break;
-    default:
+    case 1:
       _ledBrightness = value->UINT8_T;
       break;
+    case 2:
+      _logEvents = value->BOOL;
+      _eventCount = 0;
+      break;
+    default:
+      return (false);
+      break;
     }
     return (true);
   }
@@ -26,7 +26,7 @@
 
 #define CLASSTITLE SFE_QUAD_Sensor_SCD40 // <=== Update this with the new sensor type
 
-#define SENSE_COUNT 3 // <=== Update this with the number of things this sensor can sense
+#define SENSE_COUNT 4 // <=== Update this with the number of things this sensor can sense
 
 #define SETTING_COUNT 3 // <=== Update this with the number of things that can be set on this sensor
 
@@ -37,10 +37,13 @@
 class CLASSTITLE : public SFE_QUAD_Sensor
 {
 public:
-  bool _co2;
-  bool _temp;
-  bool _rh;
   bool _autoCalibrate;
+  uint16_t _press;           // Compensation pressure (mbar). Applied with setAmbientPressure
+  bool _compensationPending; // true if _press has changed and needs to be applied
+  uint16_t _co2Cache;        // The most recent measurement. Returned until the sensor has new data
+  float _tempCache;
+  float _rhCache;
+  bool _fresh;               // true if the cached values were read from the sensor during this reading
 
   CLASSTITLE(void)
   {
@@ -52,11 +55,15 @@ public:
     _logSense = new bool[SENSE_COUNT + 1];
     for (size_t i = 0; i <= SENSE_COUNT; i++)
       _logSense[i] = true;
+    _logSense[SENSE_COUNT] = false; // Don't log New Data by default
     _customInitializePtr = NULL;
-    _co2 = false;
-    _temp = false;
-    _rh = false;
     _autoCalibrate = true;
+    _press = 0;
+    _compensationPending = false;
+    _co2Cache = 0;
+    _tempCache = 0.0;
+    _rhCache = 0.0;
+    _fresh = false;
   }
 
   void deleteSensorStorage(void)
@@ -127,6 +134,95 @@ public:
     }
   }
 
+  // Save the sensor state for resumeSensor
+  uint8_t getSensorState(uint8_t *state, uint8_t maxLen)
+  {
+    // Save the compensation pressure and the cached measurement. The SCD4x takes 5 seconds to produce new data after a wake
+    uint8_t len = sizeof(_autoCalibrate) + sizeof(_press) + sizeof(_compensationPending) + sizeof(_co2Cache) + sizeof(_tempCache) + sizeof(_rhCache);
+    if (len > maxLen)
+      return (0);
+    memcpy(state, &_autoCalibrate, sizeof(_autoCalibrate));
+    state += sizeof(_autoCalibrate);
+    memcpy(state, &_press, sizeof(_press));
+    state += sizeof(_press);
+    memcpy(state, &_compensationPending, sizeof(_compensationPending));
+    state += sizeof(_compensationPending);
+    memcpy(state, &_co2Cache, sizeof(_co2Cache));
+    state += sizeof(_co2Cache);
+    memcpy(state, &_tempCache, sizeof(_tempCache));
+    state += sizeof(_tempCache);
+    memcpy(state, &_rhCache, sizeof(_rhCache));
+    return (len);
+  }
+
+  // Re-attach to the sensor after an MCU deep sleep. Return false if the sensor needs to be begun again
+  bool resumeSensor(uint8_t sensorAddress, TwoWire &port, const uint8_t *state, uint8_t stateLen)
+  {
+    if (stateLen != sizeof(_autoCalibrate) + sizeof(_press) + sizeof(_compensationPending) + sizeof(_co2Cache) + sizeof(_tempCache) + sizeof(_rhCache))
+      return (false);
+    // Restore the state first so a fallback beginSensor uses it too
+    memcpy(&_autoCalibrate, state, sizeof(_autoCalibrate));
+    state += sizeof(_autoCalibrate);
+    memcpy(&_press, state, sizeof(_press));
+    state += sizeof(_press);
+    memcpy(&_compensationPending, state, sizeof(_compensationPending));
+    state += sizeof(_compensationPending);
+    memcpy(&_co2Cache, state, sizeof(_co2Cache));
+    state += sizeof(_co2Cache);
+    memcpy(&_tempCache, state, sizeof(_tempCache));
+    state += sizeof(_tempCache);
+    memcpy(&_rhCache, state, sizeof(_rhCache));
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (!device->resume(port)) // Fails if the sensor has been power-cycled and periodic measurements are not running
+    {
+      if (_press > 0)
+        _compensationPending = true; // The sensor has lost the compensation pressure. Apply it again after beginSensor
+      return (false);
+    }
+    return (true);
+  }
+
+  // Return true if this sensor can use the specified compensation value
+  bool consumesCompensation(SFE_QUAD_Sensor_Compensation_Type_e type)
+  {
+    return (type == SFE_QUAD_COMPENSATION_PRESSURE);
+  }
+
+  // Set the compensation value. It is applied by getSenseReading - when the mux port is selected
+  // Only changes of 1 mbar or more are applied, to avoid rewriting the same pressure every reading
+  bool setCompensation(SFE_QUAD_Sensor_Compensation_Type_e type, float value)
+  {
+    if (type != SFE_QUAD_COMPENSATION_PRESSURE)
+      return (false);
+    if ((value < 0.0) || (value > 65535.0))
+      return (false);
+    uint16_t press = (uint16_t)(value + 0.5);
+    if (press != _press)
+    {
+      _press = press;
+      _compensationPending = true;
+    }
+    return (true);
+  }
+
+  // Check data-ready once per reading. Only read the 9-byte measurement block when the sensor has new data
+  // Otherwise the cached values are returned and _fresh is false
+  void updateMeasurement(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    _fresh = false;
+    if (device->getDataReadyStatus())
+    {
+      if (device->readMeasurement(false)) // No need to check data-ready again
+      {
+        _co2Cache = device->getCO2(); // These return the values just read - without another bus read
+        _tempCache = device->getTemperature();
+        _rhCache = device->getHumidity();
+        _fresh = true;
+      }
+    }
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -158,6 +254,9 @@ public:
     case 2:
       return ("Humidity (%)");
       break;
+    case 3:
+      return ("New Data");
+      break;
     default:
       return (NULL);
       break;
@@ -165,43 +264,59 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (_compensationPending) // Apply any new compensation pressure
+    {
+      device->setAmbientPressure(((float)_press) * 100.0); // Convert mbar to Pa
+      _compensationPending = false;
+    }
+    // Data-ready is checked once per reading, by the first enabled sense
+    uint8_t firstSense = 0;
+    while ((firstSense < (SENSE_COUNT - 1)) && (!_logSense[firstSense + 1]))
+      firstSense++;
+    if (sense == firstSense)
+      updateMeasurement();
     switch (sense)
     {
     case 0:
-      if (_co2 == false)
-      {
-        device->readMeasurement();
-        _temp = true;
-        _rh = true;
-      }
-      _co2 = false;
-      sprintf(reading, "%d", device->getCO2());
+      *value = _co2Cache;
       return (true);
       break;
     case 1:
-      if (_temp == false)
-      {
-        device->readMeasurement();
-        _co2 = true;
-        _rh = true;
-      }
-      _temp = false;
-      _sprintf._dtostrf((double)device->getTemperature(), reading); // Get the temperature
+      *value = (double)_tempCache; // Get the temperature
       return (true);
       break;
     case 2:
-      if (_rh == false)
-      {
-        device->readMeasurement();
-        _co2 = true;
-        _temp = true;
-      }
-      _rh = false;
-      _sprintf._dtostrf((double)device->getHumidity(), reading); // Get the humidity
+      *value = (double)_rhCache; // Get the humidity
+      return (true);
+      break;
+    case 3:
+      *value = _fresh ? 1 : 0; // 1 if the readings are new, 0 if they are cached
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 3:
+      sprintf(reading, "%ld", (long)value);
+      return (true);
+      break;
+    case 1:
+    case 2:
+      _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
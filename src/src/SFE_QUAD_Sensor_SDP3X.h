@@ -26,11 +26,11 @@
 
 #define CLASSTITLE SFE_QUAD_Sensor_SDP3X // <=== Update this with the new sensor type
 
-#define SENSE_COUNT 2 // <=== Update this with the number of things this sensor can sense
+#define SENSE_COUNT 7 // <=== Update this with the number of things this sensor can sense
 
-#define SETTING_COUNT 3 // <=== Update this with the number of things that can be set on this sensor
+#define SETTING_COUNT 4 // <=== Update this with the number of things that can be set on this sensor
 
-#define CONFIGURATION_ITEM_COUNT 2 // <=== Update this with the number of things that can be configured on this sensor
+#define CONFIGURATION_ITEM_COUNT 3 // <=== Update this with the number of things that can be configured on this sensor
 
 #define SENSOR_I2C_ADDRESSES const uint8_t sensorI2cAddresses[] = {0x21, 0x22, 0x23} // <=== Update this with the I2C addresses for this sensor
 
@@ -41,6 +41,18 @@ public:
   bool _measurementAveraging;
   float _temperature;
   float _pressure;
+  // High-rate sampling: pollSensor reads the raw differential pressure between readings (3 bytes per sample)
+  // The integer running sums give the exact mean, RMS and variance of every sample since the previous reading
+  bool _highRate;
+  uint32_t _statCount;     // The number of samples since the previous reading
+  int64_t _statSum;        // The sum of the raw samples
+  int64_t _statSumSq;      // The sum of the squares of the raw samples. 16-bit samples: 2^32 * 2^30 fits comfortably
+  int16_t _statPeak;       // The raw sample with the largest magnitude
+  float _latchedMean;      // The statistics for this reading (Pa). Shared by the statistics senses
+  float _latchedRMS;
+  float _latchedPeak;
+  float _latchedVariance;
+  uint32_t _latchedCount;
 
   CLASSTITLE(void)
   {
@@ -55,8 +67,88 @@ public:
     _customInitializePtr = NULL;
     _temperatureCompensation = true; // True == Mass Flow; False == Differential Pressure
     _measurementAveraging = false;
-    _temperature = -9999; // Mark the temperature as stale
-    _pressure = -9999; // Mark the pressure as stale
+    _temperature = 0.0;
+    _pressure = 0.0;
+    _highRate = false;
+    _latchedMean = 0.0;
+    _latchedRMS = 0.0;
+    _latchedPeak = 0.0;
+    _latchedVariance = 0.0;
+    _latchedCount = 0;
+    for (size_t i = 3; i <= SENSE_COUNT; i++) // The statistics senses are off by default
+      _logSense[i] = false;
+    resetStatistics();
+  }
+
+  // Discard all samples
+  void resetStatistics(void)
+  {
+    _statCount = 0;
+    _statSum = 0;
+    _statSumSq = 0;
+    _statPeak = 0;
+  }
+
+  // Add a raw sample to the running sums
+  void addSample(int16_t sample)
+  {
+    _statCount++;
+    _statSum += sample;
+    _statSumSq += (int32_t)sample * sample;
+    if (((int32_t)sample * sample) > ((int32_t)_statPeak * _statPeak))
+      _statPeak = sample;
+  }
+
+  // Read the latest pressure from the continuous measurement into the running sums
+  bool collectSample(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (device->getScaleFactor() == 0) // The scale factor comes from the first full measurement
+    {
+      if (device->readMeasurement(&_pressure, &_temperature) != SDP3X_SUCCESS)
+        return (false);
+      addSample((int16_t)lround(_pressure * (float)device->getScaleFactor()));
+      return (true);
+    }
+    int16_t sample;
+    if (device->readRawDifferentialPressure(&sample) != SDP3X_SUCCESS)
+      return (false);
+    addSample(sample);
+    return (true);
+  }
+
+  // Read the full measurement and calculate the statistics for this reading, then restart them
+  void latchStatistics(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (device->readMeasurement(&_pressure, &_temperature) == SDP3X_SUCCESS)
+    {
+      if (_statCount == 0) // Not in high-rate mode, or no samples yet: use this measurement
+        addSample((int16_t)lround(_pressure * (float)device->getScaleFactor()));
+    }
+    double scale = (double)device->getScaleFactor();
+    _latchedCount = _statCount;
+    if ((_statCount == 0) || (scale == 0.0))
+    {
+      _latchedMean = 0.0;
+      _latchedRMS = 0.0;
+      _latchedPeak = 0.0;
+      _latchedVariance = 0.0;
+    }
+    else
+    {
+      double n = (double)_statCount;
+      double sum = (double)_statSum;
+      double sumSq = (double)_statSumSq;
+      _latchedMean = (float)(sum / n / scale);
+      _latchedRMS = (float)(sqrt(sumSq / n) / scale);
+      _latchedPeak = (float)(((double)_statPeak) / scale);
+      if (_statCount < 2)
+        _latchedVariance = 0.0;
+      else
+        _latchedVariance = (float)(((sumSq - ((sum * sum) / n)) / (n - 1.0)) / (scale * scale));
+    }
+    resetStatistics();
   }
 
   void deleteSensorStorage(void)
@@ -126,6 +218,18 @@ public:
     }
   }
 
+  // Return true if the sensor needs to be polled between readings
+  bool pollingEnabled(void)
+  {
+    return (_highRate);
+  }
+
+  // Read the latest pressure into the running statistics
+  bool pollSensor(uint8_t sensorAddress, TwoWire &port)
+  {
+    return (collectSample());
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -154,6 +258,21 @@ public:
     case 1:
       return ("Pressure (Pa)");
       break;
+    case 2:
+      return ("Pressure Mean (Pa)");
+      break;
+    case 3:
+      return ("Pressure RMS (Pa)");
+      break;
+    case 4:
+      return ("Pressure Peak (Pa)");
+      break;
+    case 5:
+      return ("Pressure Variance (Pa^2)");
+      break;
+    case 6:
+      return ("Samples");
+      break;
     default:
       return (NULL);
       break;
@@ -161,28 +280,68 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  // The first enabled sense reads the measurement and latches the statistics. All senses return the latched values
+  bool getSenseValue(uint8_t sense, double *value)
   {
-    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    uint8_t firstSense = 0;
+    while ((firstSense < (SENSE_COUNT - 1)) && (!_logSense[firstSense + 1]))
+      firstSense++;
+    if (sense == firstSense)
+      latchStatistics();
     switch (sense)
     {
     case 0:
-      if (_temperature == -9999)
-      {
-        device->readMeasurement(&_pressure, &_temperature);
-      }
-      _sprintf._dtostrf((double)_temperature, reading); // Get the temperature
-      _temperature = -9999; // Mark the temperature as stale
+      *value = (double)_temperature; // Get the temperature
+      return (true);
+      break;
+    case 1:
+      *value = (double)_pressure; // Get the pressure
+      return (true);
+      break;
+    case 2:
+      *value = (double)_latchedMean;
+      return (true);
+      break;
+    case 3:
+      *value = (double)_latchedRMS;
+      return (true);
+      break;
+    case 4:
+      *value = (double)_latchedPeak;
+      return (true);
+      break;
+    case 5:
+      *value = (double)_latchedVariance;
+      return (true);
+      break;
+    case 6:
+      *value = (double)_latchedCount;
       return (true);
       break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
     case 1:
-      if (_pressure == -9999)
-      {
-        device->readMeasurement(&_pressure, &_temperature);
-      }
-      _sprintf._dtostrf((double)_pressure, reading); // Get the pressure
-      _pressure = -9999; // Mark the pressure as stale
+    case 2:
+    case 3:
+    case 4:
+    case 5:
+      _sprintf._dtostrf(value, reading);
+      return (true);
+      break;
+    case 6:
+      sprintf(reading, "%lu", (unsigned long)value);
       return (true);
       break;
     default:
@@ -223,6 +382,9 @@ public:
     case 2:
       return ("Measurement Averaging");
       break;
+    case 3:
+      return ("High Rate Sampling");
+      break;
     default:
       return (NULL);
       break;
@@ -244,6 +406,9 @@ public:
     case 2:
       *type = SFE_QUAD_SETTING_TYPE_BOOL;
       break;
+    case 3:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -272,6 +437,10 @@ public:
       _measurementAveraging = value->BOOL;
       device->startContinuousMeasurement(_temperatureCompensation, _measurementAveraging); //Request continuous measurements
       break;
+    case 3:
+      _highRate = value->BOOL;
+      resetStatistics();
+      break;
     default:
       return (false);
       break;
@@ -308,6 +477,9 @@ public:
     case 1:
       return ("Meas_Avg");
       break;
+    case 2:
+      return ("High_Rate");
+      break;
     default:
       return (NULL);
       break;
@@ -326,6 +498,9 @@ public:
     case 1:
       *type = SFE_QUAD_SETTING_TYPE_BOOL;
       break;
+    case 2:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -345,6 +520,9 @@ public:
     case 1:
       value->BOOL = _measurementAveraging;
       break;
+    case 2:
+      value->BOOL = _highRate;
+      break;
     default:
       return (false);
       break;
@@ -368,6 +546,10 @@ public:
       _measurementAveraging = value->BOOL;
       device->startContinuousMeasurement(_temperatureCompensation, _measurementAveraging); //Request continuous measurements
       break;
+    case 2:
+      _highRate = value->BOOL;
+      resetStatistics();
+      break;
     default:
       return (false);
       break;
@@ -170,8 +170,8 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (sense)
@@ -187,7 +187,7 @@ public:
         _ethanol = true;
       }
       _tvoc = false;
-      sprintf(reading, "%d", device->TVOC);
+      *value = device->TVOC;
       return (true);
     }
       break;
@@ -202,7 +202,7 @@ public:
         _ethanol = true;
       }
       _co2 = false;
-      sprintf(reading, "%d", device->CO2);
+      *value = device->CO2;
       return (true);
     }
       break;
@@ -217,7 +217,7 @@ public:
         _ethanol = true;
       }
       _h2 = false;
-      sprintf(reading, "%d", device->H2);
+      *value = device->H2;
       return (true);
     }
       break;
@@ -232,7 +232,7 @@ public:
         _h2 = true;
       }
       _ethanol = false;
-      sprintf(reading, "%d", device->ethanol);
+      *value = device->ethanol;
       return (true);
     }
       break;
@@ -243,6 +243,25 @@ public:
     return (false);
   }
 
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+    case 2:
+    case 3:
+      sprintf(reading, "%ld", (long)value);
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
   // Return the count of the number of things that can be set on this sensor
   bool getSettingCount(uint8_t *count)
   {
@@ -39,6 +39,12 @@ class CLASSTITLE : public SFE_QUAD_Sensor
 public:
   float _rh;
   float _temp;
+  bool _triggered;        // true if a raw measurement has been started by triggerSensor and is waiting to be read
+  bool _collected;        // true if the raw measurement has been read by continueTrigger. _vocIndex is valid once the batch has been processed
+  bool _batched;          // true while this sensor is waiting in the batch for the VOC algorithm
+  uint16_t _rawTicks;     // The raw measurement read by continueTrigger
+  int32_t _vocIndex;      // The VOC Index from the batch
+  CLASSTITLE *_batchNext; // The next SGP40 in the batch
 
   CLASSTITLE(void)
   {
@@ -53,6 +59,12 @@ public:
     _customInitializePtr = NULL;
     _rh = 50.0;
     _temp = 25.0;
+    _triggered = false;
+    _collected = false;
+    _batched = false;
+    _rawTicks = 0;
+    _vocIndex = -100;
+    _batchNext = NULL;
   }
 
   void setRH(float RH)
@@ -67,6 +79,7 @@ public:
 
   void deleteSensorStorage(void)
   {
+    removeFromBatch();
     if (_classPtr != NULL)
     {
       delete (CLASSNAME *)_classPtr;
@@ -134,6 +147,127 @@ public:
     }
   }
 
+  // Return true if this sensor can use the specified compensation value
+  bool consumesCompensation(SFE_QUAD_Sensor_Compensation_Type_e type)
+  {
+    return ((type == SFE_QUAD_COMPENSATION_TEMPERATURE) || (type == SFE_QUAD_COMPENSATION_HUMIDITY));
+  }
+
+  // Set the compensation value. It is used by the next measurement
+  bool setCompensation(SFE_QUAD_Sensor_Compensation_Type_e type, float value)
+  {
+    switch (type)
+    {
+    case SFE_QUAD_COMPENSATION_TEMPERATURE:
+      _temp = value;
+      break;
+    case SFE_QUAD_COMPENSATION_HUMIDITY:
+      _rh = value;
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (true);
+  }
+
+  // Trigger a raw measurement so that all SGP40s can share a single 30ms wait. ===> Adapt this to match the sensor type <===
+  // Return true so that continueTrigger is called to read it
+  bool triggerSensor(uint8_t sensorAddress, TwoWire &port, unsigned long *settleMillis)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    removeFromBatch(); // Discard any result which was never read
+    _collected = false;
+    _triggered = (device->startMeasureRaw(_rh, _temp) == SGP40_SUCCESS);
+    if (_triggered)
+      *settleMillis = 30; // Datasheet says 30ms
+    return (_triggered);
+  }
+
+  // Read the raw measurement and add this sensor to the batch. The VOC algorithm is run for the whole batch by the first getVOCindex
+  bool continueTrigger(uint8_t sensorAddress, TwoWire &port, unsigned long *settleMillis)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (!_triggered)
+      return (false);
+    _triggered = false;
+    _collected = true;
+    if (device->readMeasureRaw(&_rawTicks) != SGP40_SUCCESS)
+    {
+      _vocIndex = -100;
+      return (false);
+    }
+    if (!_batched)
+    {
+      _batchNext = batchHead();
+      batchHead() = this;
+      _batched = true;
+    }
+    return (false); // Measurement complete
+  }
+
+  // Return the VOC index. Run the VOC algorithm for the whole batch if it has not been run yet
+  // Fall back to a single (or blocking) measurement if triggerSensors was not called
+  int32_t getVOCindex(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (_collected)
+    {
+      if (_batched)
+        processBatch();
+      _collected = false;
+      return (_vocIndex);
+    }
+    if (!_triggered)
+      return (device->getVOCindex(_rh, _temp));
+    _triggered = false;
+    uint16_t SRAW_ticks;
+    if (device->readMeasureRaw(&SRAW_ticks) != SGP40_SUCCESS)
+      return (-100);
+    return (device->processVOCindex(SRAW_ticks));
+  }
+
+  // The SGP40s whose raw measurements are waiting for the VOC algorithm. Shared by all SGP40s
+  static CLASSTITLE *&batchHead(void)
+  {
+    static CLASSTITLE *head = NULL;
+    return (head);
+  }
+
+  // Run the VOC algorithm for every SGP40 in the batch, then empty the batch
+  static void processBatch(void)
+  {
+    CLASSTITLE *thisSGP40 = batchHead();
+    while (thisSGP40 != NULL)
+    {
+      CLASSTITLE *nextSGP40 = thisSGP40->_batchNext;
+      thisSGP40->_vocIndex = ((CLASSNAME *)thisSGP40->_classPtr)->processVOCindex(thisSGP40->_rawTicks);
+      thisSGP40->_batchNext = NULL;
+      thisSGP40->_batched = false;
+      thisSGP40 = nextSGP40;
+    }
+    batchHead() = NULL;
+  }
+
+  // Remove this sensor from the batch (if it is in it)
+  void removeFromBatch(void)
+  {
+    if (!_batched)
+      return;
+    CLASSTITLE **link = &batchHead();
+    while (*link != NULL)
+    {
+      if (*link == this)
+      {
+        *link = _batchNext;
+        break;
+      }
+      link = &(*link)->_batchNext;
+    }
+    _batchNext = NULL;
+    _batched = false;
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -166,14 +300,29 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  bool getSenseValue(uint8_t sense, double *value)
+  {
+    switch (sense)
+    {
+    case 0:
+      *value = (int)getVOCindex();
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
   {
-    CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (sense)
     {
     case 0:
-      sprintf(reading, "%d", device->getVOCindex(_rh, _temp));
+      sprintf(reading, "%ld", (long)value);
       return (true);
       break;
     default:
@@ -124,6 +124,41 @@ public:
     }
   }
 
+  // Return true if this sensor can produce the specified compensation value
+  bool producesCompensation(SFE_QUAD_Sensor_Compensation_Type_e type)
+  {
+    return ((type == SFE_QUAD_COMPENSATION_TEMPERATURE) || (type == SFE_QUAD_COMPENSATION_HUMIDITY));
+  }
+
+  // Update the humidity and temperature. Mark both as updated so getSenseReading does not update again
+  bool acquireCompensation(uint8_t sensorAddress, TwoWire &port)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    bool result = (device->update() == SHTC3_Status_Nominal);
+    _rh = true;
+    _temp = true;
+    return (result);
+  }
+
+  // Return the compensation value updated by acquireCompensation
+  bool getCompensation(SFE_QUAD_Sensor_Compensation_Type_e type, float *value)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    switch (type)
+    {
+    case SFE_QUAD_COMPENSATION_TEMPERATURE:
+      *value = device->toDegC();
+      break;
+    case SFE_QUAD_COMPENSATION_HUMIDITY:
+      *value = device->toPercent();
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (true);
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -159,8 +194,8 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (sense)
@@ -172,7 +207,7 @@ public:
         _temp = true;
       }
       _rh = false;
-      _sprintf._dtostrf((double)device->toPercent(), reading); // Get the humidity
+      *value = (double)device->toPercent(); // Get the humidity
       return (true);
       break;
     case 1:
@@ -182,7 +217,24 @@ public:
         _rh = true;
       }
       _temp = false;
-      _sprintf._dtostrf((double)device->toDegC(), reading); // Get the temperature
+      *value = (double)device->toDegC(); // Get the temperature
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+      _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
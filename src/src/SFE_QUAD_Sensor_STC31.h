@@ -41,8 +41,9 @@ public:
   float _temp;
   uint16_t _press;
   STC3X_binary_gas_type_e _binaryGas;
-  bool _co2;
-  bool _validTemp;
+  bool _triggered;   // true if a measurement has been started by triggerSensor and is waiting to be read
+  bool _rhPending;    // true if _rh has been changed by setCompensation and needs to be applied
+  bool _pressPending; // true if _press has been changed by setCompensation and needs to be applied
 
   CLASSTITLE(void)
   {
@@ -58,9 +59,26 @@ public:
     _rh = 50.0;
     _temp = 25.0;
     _press = 1000;
+    _rhPending = false;
+    _pressPending = false;
     _binaryGas = STC3X_BINARY_GAS_CO2_AIR_25;
-    _co2 = false;
-    _validTemp = false;
+    _triggered = false;
+  }
+
+  // Apply any new compensation values. Call this when the mux port is selected
+  void applyCompensation(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (_rhPending)
+    {
+      device->setRelativeHumidity(_rh);
+      _rhPending = false;
+    }
+    if (_pressPending)
+    {
+      device->setPressure(_press);
+      _pressPending = false;
+    }
   }
 
   void deleteSensorStorage(void)
@@ -136,6 +154,50 @@ public:
     }
   }
 
+  // Return true if this sensor can use the specified compensation value
+  // Temperature is not consumed. The STC31 uses its on-chip temperature sensor (see initializeSensor)
+  bool consumesCompensation(SFE_QUAD_Sensor_Compensation_Type_e type)
+  {
+    return ((type == SFE_QUAD_COMPENSATION_HUMIDITY) || (type == SFE_QUAD_COMPENSATION_PRESSURE));
+  }
+
+  // Set the compensation value. It is applied by triggerSensor (or getSenseReading) - when the mux port is selected
+  bool setCompensation(SFE_QUAD_Sensor_Compensation_Type_e type, float value)
+  {
+    switch (type)
+    {
+    case SFE_QUAD_COMPENSATION_HUMIDITY:
+      _rh = value;
+      _rhPending = true;
+      break;
+    case SFE_QUAD_COMPENSATION_PRESSURE:
+      if ((value < 0.0) || (value > 65535.0))
+        return (false);
+      if ((uint16_t)(value + 0.5) != _press) // Only apply changes of 1 mbar or more
+      {
+        _press = (uint16_t)(value + 0.5);
+        _pressPending = true;
+      }
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (true);
+  }
+
+  // Apply any new compensation values, then start a measurement. The measurement runs in parallel with any other triggered sensors
+  // There is no second stage: getSenseReading collects the measurement
+  bool triggerSensor(uint8_t sensorAddress, TwoWire &port, unsigned long *settleMillis)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    applyCompensation();
+    _triggered = device->startGasConcentration();
+    if (_triggered)
+      *settleMillis = STC3X_MEASUREMENT_DELAY_MILLIS;
+    return (false);
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -171,30 +233,50 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  // The first enabled sense collects the triggered measurement - or measures now if triggerSensor was not called
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
-    switch (sense)
+    uint8_t firstSense = 0;
+    while ((firstSense < (SENSE_COUNT - 1)) && (!_logSense[firstSense + 1]))
+      firstSense++;
+    if (sense == firstSense)
     {
-    case 0:
-      if (_co2 == false)
+      if (_triggered)
+        device->readGasConcentration();
+      else
       {
+        applyCompensation();
         device->measureGasConcentration();
-        _validTemp = true;
       }
-      _co2 = false;
-      _sprintf._dtostrf((double)device->getCO2(), reading); // Get the CO2 concentration
+      _triggered = false;
+    }
+    switch (sense)
+    {
+    case 0:
+      *value = (double)device->getCO2(); // Get the CO2 concentration
       return (true);
       break;
     case 1:
-      if (_validTemp == false)
-      {
-        device->measureGasConcentration();
-        _co2 = true;
-      }
-      _validTemp = false;
-      _sprintf._dtostrf((double)device->getTemperature(), reading); // Get the temperature
+      *value = (double)device->getTemperature(); // Get the temperature
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+      _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
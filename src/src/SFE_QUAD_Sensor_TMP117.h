@@ -28,15 +28,18 @@
 
 #define SENSE_COUNT 1 // <=== Update this with the number of things this sensor can sense
 
-#define SETTING_COUNT 0 // <=== Update this with the number of things that can be set on this sensor
+#define SETTING_COUNT 5 // <=== Update this with the number of things that can be set on this sensor
 
-#define CONFIGURATION_ITEM_COUNT 0 // <=== Update this with the number of things that can be configured on this sensor
+#define CONFIGURATION_ITEM_COUNT 2 // <=== Update this with the number of things that can be configured on this sensor
 
 #define SENSOR_I2C_ADDRESSES const uint8_t sensorI2cAddresses[] = {0x48, 0x49, 0x4A, 0x4B} // <=== Update this with the I2C addresses for this sensor
 
 class CLASSTITLE : public SFE_QUAD_Sensor
 {
 public:
+  uint8_t _averaging; // Conversion averaging: 0 = none; 1 = 8; 2 = 32; 3 = 64
+  bool _oneShot;      // true: the sensor is shut down between readings. triggerSensor starts a one-shot conversion
+
   CLASSTITLE(void)
   {
     _sensorAddress = 0;
@@ -48,6 +51,19 @@ public:
     for (size_t i = 0; i <= SENSE_COUNT; i++)
       _logSense[i] = true;
     _customInitializePtr = NULL;
+    _averaging = 0;
+    _oneShot = false;
+  }
+
+  // Apply the averaging and conversion mode. In one-shot mode, the sensor is shut down until triggered
+  void applyConversionMode(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    device->setConversionAverageMode(_averaging);
+    if (_oneShot)
+      device->setShutdownMode();
+    else
+      device->setContinuousConversionMode();
   }
 
   void deleteSensorStorage(void)
@@ -104,9 +120,8 @@ public:
     if (_customInitializePtr == NULL) // Has a custom initialize function been defined?
     {
       CLASSNAME *device = (CLASSNAME *)_classPtr;
-      device->setConversionAverageMode(0);
       device->setConversionCycleBit(0);
-      device->setContinuousConversionMode();
+      applyConversionMode();
       return (true);
     }
     else
@@ -116,6 +131,18 @@ public:
     }
   }
 
+  // In one-shot mode, start a conversion. The conversions run in parallel with any other triggered sensors. There is no second stage
+  bool triggerSensor(uint8_t sensorAddress, TwoWire &port, unsigned long *settleMillis)
+  {
+    if (!_oneShot)
+      return (false);
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    const unsigned long conversionMillis[] = {17, 138, 550, 1100}; // One-shot conversion time for each averaging mode. Datasheet typical plus 10%
+    device->setOneShotMode();
+    *settleMillis = conversionMillis[_averaging & 0x03];
+    return (false);
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -148,14 +175,30 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (sense)
     {
     case 0:
-      _sprintf._dtostrf((double)device->readTempC(), reading); // Get the temperature
+      *value = (double)device->readTempC(); // Get the temperature
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+      _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
@@ -176,9 +219,9 @@ public:
   uint8_t getSettingNameMaxLen()
   {
     size_t longest = 0;
-    // for (uint8_t x = 0; x < SETTING_COUNT; x++)
-    //   if (strlen(getSettingName(x)) > longest)
-    //     longest = strlen(getSettingName(x));
+    for (uint8_t x = 0; x < SETTING_COUNT; x++)
+      if (strlen(getSettingName(x)) > longest)
+        longest = strlen(getSettingName(x));
     return (longest);
   }
 
@@ -187,6 +230,21 @@ public:
   {
     switch (setting)
     {
+    case 0:
+      return ("Averaging: None");
+      break;
+    case 1:
+      return ("Averaging: 8");
+      break;
+    case 2:
+      return ("Averaging: 32");
+      break;
+    case 3:
+      return ("Averaging: 64");
+      break;
+    case 4:
+      return ("One-Shot Mode");
+      break;
     default:
       return (NULL);
       break;
@@ -199,6 +257,15 @@ public:
   {
     switch (setting)
     {
+    case 0:
+    case 1:
+    case 2:
+    case 3:
+      *type = SFE_QUAD_SETTING_TYPE_NONE;
+      break;
+    case 4:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -209,9 +276,19 @@ public:
   // Set the specified setting. ===> Adapt this to match the sensor type <===
   bool setSetting(uint8_t setting, SFE_QUAD_Sensor_Every_Type_t *value)
   {
-    //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (setting)
     {
+    case 0:
+    case 1:
+    case 2:
+    case 3:
+      _averaging = setting;
+      applyConversionMode();
+      break;
+    case 4:
+      _oneShot = value->BOOL;
+      applyConversionMode();
+      break;
     default:
       return (false);
       break;
@@ -230,9 +307,9 @@ public:
   uint8_t getConfigurationItemNameMaxLen()
   {
     size_t longest = 0;
-    // for (uint8_t x = 0; x < CONFIGURATION_ITEM_COUNT; x++)
-    //   if (strlen(getConfigurationItemName(x)) > longest)
-    //     longest = strlen(getConfigurationItemName(x));
+    for (uint8_t x = 0; x < CONFIGURATION_ITEM_COUNT; x++)
+      if (strlen(getConfigurationItemName(x)) > longest)
+        longest = strlen(getConfigurationItemName(x));
     return (longest);
   }
 
@@ -242,6 +319,12 @@ public:
   {
     switch (configItem)
     {
+    case 0:
+      return ("Averaging");
+      break;
+    case 1:
+      return ("One_Shot");
+      break;
     default:
       return (NULL);
       break;
@@ -254,6 +337,12 @@ public:
   {
     switch (configItem)
     {
+    case 0:
+      *type = SFE_QUAD_SETTING_TYPE_UINT8_T;
+      break;
+    case 1:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -264,9 +353,14 @@ public:
   // Get (read) the sensor configuration item
   bool getConfigurationItem(uint8_t configItem, SFE_QUAD_Sensor_Every_Type_t *value)
   {
-    //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (configItem)
     {
+    case 0:
+      value->UINT8_T = _averaging;
+      break;
+    case 1:
+      value->BOOL = _oneShot;
+      break;
     default:
       return (false);
       break;
@@ -277,9 +371,18 @@ public:
   // Set (write) the sensor configuration item
   bool setConfigurationItem(uint8_t configItem, SFE_QUAD_Sensor_Every_Type_t *value)
   {
-    //CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (configItem)
     {
+    case 0:
+      if (value->UINT8_T > 3)
+        return (false);
+      _averaging = value->UINT8_T;
+      applyConversionMode();
+      break;
+    case 1:
+      _oneShot = value->BOOL;
+      applyConversionMode();
+      break;
     default:
       return (false);
       break;
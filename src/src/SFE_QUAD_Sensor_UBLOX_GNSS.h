@@ -116,6 +116,17 @@ public:
     }
   }
 
+  // Re-attach to the module after an MCU deep sleep. Return false if the module needs to be begun again
+  bool resumeSensor(uint8_t sensorAddress, TwoWire &port, const uint8_t *state, uint8_t stateLen)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (!device->begin(port, sensorAddress))
+      return (false);
+    // The module kept its configuration (UBX-only output, auto PVT) through the sleep. Only the library storage needs to be allocated.
+    // No configuration is sent and nothing is saved to flash
+    return (device->assumeAutoPVT(true));
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -196,78 +207,110 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (sense)
     {
     case 0:
-      sprintf(reading, "%d", device->getYear());
+      *value = device->getYear();
       return (true);
       break;
     case 1:
-      sprintf(reading, "%d", device->getMonth());
+      *value = device->getMonth();
       return (true);
       break;
     case 2:
-      sprintf(reading, "%d", device->getDay());
+      *value = device->getDay();
       return (true);
       break;
     case 3:
-      sprintf(reading, "%d", device->getHour());
+      *value = device->getHour();
       return (true);
       break;
     case 4:
-      sprintf(reading, "%d", device->getMinute());
+      *value = device->getMinute();
       return (true);
       break;
     case 5:
-      sprintf(reading, "%d", device->getSecond());
+      *value = device->getSecond();
       return (true);
       break;
     case 6:
-      sprintf(reading, "%d", device->getLatitude());
+      *value = device->getLatitude();
       return (true);
       break;
     case 7:
-      sprintf(reading, "%d", device->getLongitude());
+      *value = device->getLongitude();
       return (true);
       break;
     case 8:
-      sprintf(reading, "%d", device->getAltitude());
+      *value = device->getAltitude();
       return (true);
       break;
     case 9:
-      sprintf(reading, "%d", device->getAltitudeMSL());
+      *value = device->getAltitudeMSL();
       return (true);
       break;
     case 10:
-      sprintf(reading, "%d", device->getSIV());
+      *value = device->getSIV();
       return (true);
       break;
     case 11:
-      sprintf(reading, "%d", device->getFixType());
+      *value = device->getFixType();
       return (true);
       break;
     case 12:
-      sprintf(reading, "%d", device->getCarrierSolutionType());
+      *value = device->getCarrierSolutionType();
       return (true);
       break;
     case 13:
-      sprintf(reading, "%d", device->getGroundSpeed());
+      *value = device->getGroundSpeed();
       return (true);
       break;
     case 14:
-      sprintf(reading, "%d", device->getHeading());
+      *value = device->getHeading();
       return (true);
       break;
     case 15:
-      sprintf(reading, "%d", device->getPDOP());
+      *value = device->getPDOP();
       return (true);
       break;
     case 16:
-      sprintf(reading, "%d", device->getTimeOfWeek());
+      *value = device->getTimeOfWeek();
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+    case 2:
+    case 3:
+    case 4:
+    case 5:
+    case 6:
+    case 7:
+    case 8:
+    case 9:
+    case 10:
+    case 11:
+    case 12:
+    case 13:
+    case 14:
+    case 15:
+    case 16:
+      sprintf(reading, "%ld", (long)value);
       return (true);
       break;
     default:
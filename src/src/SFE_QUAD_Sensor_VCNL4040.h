@@ -28,9 +28,9 @@
 
 #define SENSE_COUNT 2 // <=== Update this with the number of things this sensor can sense
 
-#define SETTING_COUNT 6 // <=== Update this with the number of things that can be set on this sensor
+#define SETTING_COUNT 11 // <=== Update this with the number of things that can be set on this sensor
 
-#define CONFIGURATION_ITEM_COUNT 5 // <=== Update this with the number of things that can be configured on this sensor
+#define CONFIGURATION_ITEM_COUNT 10 // <=== Update this with the number of things that can be configured on this sensor
 
 #define SENSOR_I2C_ADDRESSES const uint8_t sensorI2cAddresses[] = {0x60} // <=== Update this with the I2C addresses for this sensor
 
@@ -42,6 +42,16 @@ public:
   uint8_t _proxIntTime;
   uint8_t _proxRes;
   uint16_t _ambIntTime;
+  bool _eventMode;        // true: the interrupt flags are read each cycle. Proximity / ambient are only read after a threshold crossing
+  uint16_t _proxHigh;     // Proximity thresholds (close / away)
+  uint16_t _proxLow;
+  uint16_t _ambHigh;      // Ambient light thresholds (raw counts)
+  uint16_t _ambLow;
+  uint8_t _intFlags;      // The interrupt flags read by the first enabled sense
+  uint16_t _proximity;    // The last known readings
+  uint16_t _ambient;
+  bool _proximityValid;
+  bool _ambientValid;
 
   CLASSTITLE(void)
   {
@@ -59,6 +69,39 @@ public:
     _proxIntTime = 8;
     _proxRes = 16;
     _ambIntTime = 80;
+    _eventMode = false;
+    _proxHigh = 2000;
+    _proxLow = 1000;
+    _ambHigh = 5000;
+    _ambLow = 50;
+    _intFlags = 0;
+    _proximity = 0;
+    _ambient = 0;
+    _proximityValid = false;
+    _ambientValid = false;
+  }
+
+  // Program the thresholds and enable the proximity (close and away) and ambient light interrupts. Disable them when event mode is off
+  void applyEventMode(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (_eventMode)
+    {
+      device->setProxHighThreshold(_proxHigh);
+      device->setProxLowThreshold(_proxLow);
+      device->setALSHighThreshold(_ambHigh);
+      device->setALSLowThreshold(_ambLow);
+      device->setProxInterruptType(VCNL4040_PS_INT_BOTH);
+      device->enableAmbientInterrupts();
+      device->getInterruptFlags(); // Clear any stale flags
+    }
+    else
+    {
+      device->setProxInterruptType(VCNL4040_PS_INT_DISABLE);
+      device->disableAmbientInterrupts();
+    }
+    _proximityValid = false;
+    _ambientValid = false;
   }
 
   void deleteSensorStorage(void)
@@ -127,6 +170,7 @@ public:
       device->setProxIntegrationTime(_proxIntTime);
       device->setProxResolution(_proxRes);
       device->setAmbientIntegrationTime(_ambIntTime);
+      applyEventMode();
       return (true);
     }
     else
@@ -171,18 +215,51 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  // In event mode, the first enabled sense reads the interrupt flags. Each value is only re-read after its threshold has been crossed
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
+    uint8_t firstSense = 0;
+    while ((firstSense < (SENSE_COUNT - 1)) && (!_logSense[firstSense + 1]))
+      firstSense++;
+    if ((sense == firstSense) && (_eventMode))
+      _intFlags = device->getInterruptFlags();
     switch (sense)
     {
     case 0:
-      sprintf(reading, "%d", device->getProximity());
+      if ((!_eventMode) || (!_proximityValid) || (_intFlags & (VCNL4040_INT_FLAG_CLOSE | VCNL4040_INT_FLAG_AWAY)))
+      {
+        _proximity = device->getProximity();
+        _proximityValid = true;
+      }
+      *value = _proximity;
       return (true);
       break;
     case 1:
-      sprintf(reading, "%d", device->getAmbient());
+      if ((!_eventMode) || (!_ambientValid) || (_intFlags & (VCNL4040_INT_FLAG_ALS_HIGH | VCNL4040_INT_FLAG_ALS_LOW)))
+      {
+        _ambient = device->getAmbient();
+        _ambientValid = true;
+      }
+      *value = _ambient;
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+      sprintf(reading, "%ld", (long)value);
       return (true);
       break;
     default:
@@ -232,6 +309,21 @@ public:
     case 5:
       return ("Proximity Resolution (16 bit)");
       break;
+    case 6:
+      return ("Event Mode");
+      break;
+    case 7:
+      return ("Proximity High Threshold");
+      break;
+    case 8:
+      return ("Proximity Low Threshold");
+      break;
+    case 9:
+      return ("Ambient Light High Threshold");
+      break;
+    case 10:
+      return ("Ambient Light Low Threshold");
+      break;
     default:
       return (NULL);
       break;
@@ -262,6 +354,15 @@ public:
     case 5:
       *type = SFE_QUAD_SETTING_TYPE_NONE;
       break;
+    case 6:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
+    case 7:
+    case 8:
+    case 9:
+    case 10:
+      *type = SFE_QUAD_SETTING_TYPE_UINT16_T;
+      break;
     default:
       return (false);
       break;
@@ -311,6 +412,30 @@ public:
       _proxRes = 16;
       device->setProxResolution(16);
       break;
+    case 6:
+      _eventMode = value->BOOL;
+      applyEventMode();
+      break;
+    case 7:
+      _proxHigh = value->UINT16_T;
+      if (_eventMode)
+        applyEventMode();
+      break;
+    case 8:
+      _proxLow = value->UINT16_T;
+      if (_eventMode)
+        applyEventMode();
+      break;
+    case 9:
+      _ambHigh = value->UINT16_T;
+      if (_eventMode)
+        applyEventMode();
+      break;
+    case 10:
+      _ambLow = value->UINT16_T;
+      if (_eventMode)
+        applyEventMode();
+      break;
     default:
       return (false);
       break;
@@ -356,6 +481,21 @@ public:
     case 4:
       return ("Prox_Res");
       break;
+    case 5:
+      return ("Event_Mode");
+      break;
+    case 6:
+      return ("Prox_THDH");
+      break;
+    case 7:
+      return ("Prox_THDL");
+      break;
+    case 8:
+      return ("Amb_THDH");
+      break;
+    case 9:
+      return ("Amb_THDL");
+      break;
     default:
       return (NULL);
       break;
@@ -383,6 +523,15 @@ public:
     case 4:
       *type = SFE_QUAD_SETTING_TYPE_UINT8_T;
       break;
+    case 5:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
+    case 6:
+    case 7:
+    case 8:
+    case 9:
+      *type = SFE_QUAD_SETTING_TYPE_UINT16_T;
+      break;
     default:
       return (false);
       break;
@@ -411,6 +560,21 @@ public:
     case 4:
       value->UINT8_T = _proxRes;
       break;
+    case 5:
+      value->BOOL = _eventMode;
+      break;
+    case 6:
+      value->UINT16_T = _proxHigh;
+      break;
+    case 7:
+      value->UINT16_T = _proxLow;
+      break;
+    case 8:
+      value->UINT16_T = _ambHigh;
+      break;
+    case 9:
+      value->UINT16_T = _ambLow;
+      break;
     default:
       return (false);
       break;
@@ -444,6 +608,30 @@ public:
       _proxRes = value->UINT8_T;
       device->setProxResolution(value->UINT8_T);
       break;
+    case 5:
+      _eventMode = value->BOOL;
+      applyEventMode();
+      break;
+    case 6:
+      _proxHigh = value->UINT16_T;
+      if (_eventMode)
+        applyEventMode();
+      break;
+    case 7:
+      _proxLow = value->UINT16_T;
+      if (_eventMode)
+        applyEventMode();
+      break;
+    case 8:
+      _ambHigh = value->UINT16_T;
+      if (_eventMode)
+        applyEventMode();
+      break;
+    case 9:
+      _ambLow = value->UINT16_T;
+      if (_eventMode)
+        applyEventMode();
+      break;
     default:
       return (false);
       break;
@@ -156,22 +156,40 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (sense)
     {
     case 0:
-      _sprintf._dtostrf((double)device->uva(), reading); // Get the pressure
+      *value = (double)device->uva(); // Get the pressure
       return (true);
       break;
     case 1:
-      _sprintf._dtostrf((double)device->uvb(), reading); // Get the temperature
+      *value = (double)device->uvb(); // Get the temperature
       return (true);
       break;
     case 2:
-      _sprintf._dtostrf((double)device->index(), reading); // Get the humidity
+      *value = (double)device->index(); // Get the humidity
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+    case 2:
+      _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
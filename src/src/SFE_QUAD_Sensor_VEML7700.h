@@ -156,22 +156,43 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  bool getSenseValue(uint8_t sense, double *value)
   {
     CLASSNAME *device = (CLASSNAME *)_classPtr;
     switch (sense)
     {
     case 0:
-      sprintf(reading, "%d", device->getAmbientLight());
+      *value = device->getAmbientLight();
       return (true);
       break;
     case 1:
-      sprintf(reading, "%d", device->getWhiteLevel());
+      *value = device->getWhiteLevel();
       return (true);
       break;
     case 2:
-      _sprintf._dtostrf((double)device->getLux(), reading); // Get the Lux
+      *value = (double)device->getLux(); // Get the Lux
+      return (true);
+      break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
+      sprintf(reading, "%ld", (long)value);
+      return (true);
+      break;
+    case 2:
+      _sprintf._dtostrf(value, reading);
       return (true);
       break;
     default:
@@ -404,7 +425,7 @@ public:
       value->UINT8_T = (uint8_t)device->getSensitivityMode(); // VEML7700_sensitivity_mode_t
       break;
     case 2:
-      value->UINT8_T = (uint8_t)device->getIntegrationTime(); // VEML7700_integration_time_t
+      value->UINT8_T = (uint8_t)device->getPersistenceProtect(); // VEML7700_persistence_protect_t
       break;
     default:
       return (false);
@@ -426,7 +447,7 @@ public:
       device->setSensitivityMode((VEML7700_sensitivity_mode_t)value->UINT8_T);
       break;
     case 2:
-      device->setIntegrationTime((VEML7700_integration_time_t)value->UINT8_T);
+      device->setPersistenceProtect((VEML7700_persistence_protect_t)value->UINT8_T);
       break;
     default:
       return (false);
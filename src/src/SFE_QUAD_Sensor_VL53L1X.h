@@ -26,11 +26,11 @@
 
 #define CLASSTITLE SFE_QUAD_Sensor_VL53L1X // <=== Update this with the new sensor type
 
-#define SENSE_COUNT 3 // <=== Update this with the number of things this sensor can sense
+#define SENSE_COUNT 7 // <=== Update this with the number of things this sensor can sense
 
-#define SETTING_COUNT 5 // <=== Update this with the number of things that can be set on this sensor
+#define SETTING_COUNT 7 // <=== Update this with the number of things that can be set on this sensor
 
-#define CONFIGURATION_ITEM_COUNT 4 // <=== Update this with the number of things that can be configured on this sensor
+#define CONFIGURATION_ITEM_COUNT 6 // <=== Update this with the number of things that can be configured on this sensor
 
 #define SENSOR_I2C_ADDRESSES const uint8_t sensorI2cAddresses[] = {0x29} // <=== Update this with the I2C addresses for this sensor
 
@@ -38,6 +38,16 @@ class CLASSTITLE : public SFE_QUAD_Sensor
 {
 public:
   bool _shortDistanceMode;
+  bool _streaming;          // true: pollSensor collects every result. The readings include the min/max/mean distance since the last reading
+  VL53L1X_Result_t _result; // The most recent result
+  uint16_t _minDist;        // The valid (status 0) distances accumulated since the last reading
+  uint16_t _maxDist;
+  uint32_t _sumDist;
+  uint32_t _numDist;
+  uint16_t _latchedMin; // The statistics for this reading. Shared by the senses
+  uint16_t _latchedMax;
+  float _latchedMean;
+  uint32_t _latchedNum;
 
   CLASSTITLE(TwoWire &port)
   {
@@ -51,6 +61,86 @@ public:
       _logSense[i] = true;
     _customInitializePtr = NULL;
     _shortDistanceMode = true;
+    _streaming = false;
+    for (size_t i = 4; i <= SENSE_COUNT; i++)
+      _logSense[i] = false; // Don't log the statistics by default
+    memset(&_result, 0, sizeof(_result));
+    resetStatistics();
+    _latchedMin = 0;
+    _latchedMax = 0;
+    _latchedMean = 0.0;
+    _latchedNum = 0;
+  }
+
+  // Clear the accumulated distances
+  void resetStatistics(void)
+  {
+    _minDist = 0xFFFF;
+    _maxDist = 0;
+    _sumDist = 0;
+    _numDist = 0;
+  }
+
+  // Read the whole result block in one go, then clear the interrupt so the next result can be flagged
+  // Valid distances are added to the statistics
+  bool collectResult(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    bool success = device->getResult(&_result);
+    device->clearInterrupt();
+    if ((success) && (_result.Status == 0))
+    {
+      if (_result.Distance < _minDist)
+        _minDist = _result.Distance;
+      if (_result.Distance > _maxDist)
+        _maxDist = _result.Distance;
+      _sumDist += _result.Distance;
+      _numDist++;
+    }
+    return (success);
+  }
+
+  // Latch the result and statistics for this reading
+  // In streaming mode, collect any final result first. Otherwise, read the latest result now
+  void latchStatistics(void)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (!_streaming)
+    {
+      resetStatistics();
+      collectResult();
+    }
+    else if (device->checkForDataReady())
+      collectResult();
+    if (_numDist > 0)
+    {
+      _latchedMin = _minDist;
+      _latchedMax = _maxDist;
+      _latchedMean = ((float)_sumDist) / ((float)_numDist);
+    }
+    else
+    {
+      _latchedMin = 0;
+      _latchedMax = 0;
+      _latchedMean = 0.0;
+    }
+    _latchedNum = _numDist;
+    resetStatistics();
+  }
+
+  // Set the timing budget. Round up to the nearest budget the sensor supports (15ms is short distance mode only)
+  // Make sure the intermeasurement period is at least as long as the timing budget
+  uint16_t applyTimingBudget(uint16_t budget)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    const uint16_t budgets[] = {15, 20, 33, 50, 100, 200, 500};
+    uint8_t i = _shortDistanceMode ? 0 : 1;
+    while ((i < ((sizeof(budgets) / sizeof(budgets[0])) - 1)) && (budgets[i] < budget))
+      i++;
+    device->setTimingBudgetInMs(budgets[i]);
+    if (device->getIntermeasurementPeriod() < budgets[i])
+      device->setIntermeasurementPeriod(budgets[i]);
+    return (budgets[i]);
   }
 
   void deleteSensorStorage(void)
@@ -127,6 +217,21 @@ public:
     }
   }
 
+  // Return true if the sensor needs to be polled between readings - in streaming mode
+  bool pollingEnabled(void)
+  {
+    return (_streaming);
+  }
+
+  // Collect the next result - only when data is ready
+  bool pollSensor(uint8_t sensorAddress, TwoWire &port)
+  {
+    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    if (!device->checkForDataReady())
+      return (false);
+    return (collectResult());
+  }
+
   // Return the count of the number of things which this sensor can sense
   bool getSenseCount(uint8_t *count)
   {
@@ -158,6 +263,18 @@ public:
     case 2:
       return ("Signal Rate");
       break;
+    case 3:
+      return ("Min Distance (mm)");
+      break;
+    case 4:
+      return ("Max Distance (mm)");
+      break;
+    case 5:
+      return ("Mean Distance (mm)");
+      break;
+    case 6:
+      return ("Samples");
+      break;
     default:
       return (NULL);
       break;
@@ -165,22 +282,71 @@ public:
     return (NULL);
   }
 
-  // Return the specified sense reading as text. ===> Adapt this to match the sensor type <===
-  bool getSenseReading(uint8_t sense, char *reading)
+  // Return the specified sense reading as a number. ===> Adapt this to match the sensor type <===
+  // The result block is read once per reading, by the first enabled sense
+  bool getSenseValue(uint8_t sense, double *value)
   {
-    CLASSNAME *device = (CLASSNAME *)_classPtr;
+    uint8_t firstSense = 0;
+    while ((firstSense < (SENSE_COUNT - 1)) && (!_logSense[firstSense + 1]))
+      firstSense++;
+    if (sense == firstSense)
+      latchStatistics();
     switch (sense)
     {
     case 0:
-      sprintf(reading, "%d", device->getDistance());
+      *value = _result.Distance;
       return (true);
       break;
     case 1:
-      sprintf(reading, "%d", device->getRangeStatus());
+      *value = _result.Status;
+      return (true);
+      break;
+    case 2:
+      *value = _result.SigPerSPAD;
+      return (true);
+      break;
+    case 3:
+      *value = _latchedMin;
+      return (true);
+      break;
+    case 4:
+      *value = _latchedMax;
+      return (true);
+      break;
+    case 5:
+      *value = (double)_latchedMean;
+      return (true);
+      break;
+    case 6:
+      *value = (double)_latchedNum;
       return (true);
       break;
+    default:
+      return (false);
+      break;
+    }
+    return (false);
+  }
+
+  // Convert the sense value to text. ===> Adapt this to match the sensor type <===
+  bool formatSenseValue(uint8_t sense, double value, char *reading)
+  {
+    switch (sense)
+    {
+    case 0:
+    case 1:
     case 2:
-      sprintf(reading, "%d", device->getSignalRate());
+    case 3:
+    case 4:
+      sprintf(reading, "%ld", (long)value);
+      return (true);
+      break;
+    case 5:
+      _sprintf._dtostrf(value, reading);
+      return (true);
+      break;
+    case 6:
+      sprintf(reading, "%lu", (unsigned long)value);
       return (true);
       break;
     default:
@@ -227,6 +393,12 @@ public:
     case 4:
       return ("Offset");
       break;
+    case 5:
+      return ("Timing Budget");
+      break;
+    case 6:
+      return ("Streaming (Min/Max/Mean)");
+      break;
     default:
       return (NULL);
       break;
@@ -246,8 +418,12 @@ public:
     case 2:
     case 3:
     case 4:
+    case 5:
       *type = SFE_QUAD_SETTING_TYPE_UINT16_T;
       break;
+    case 6:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -301,6 +477,15 @@ public:
       device->setOffset(value->UINT16_T);
       device->startRanging();
       break;
+    case 5:
+      device->stopRanging();
+      value->UINT16_T = applyTimingBudget(value->UINT16_T);
+      device->startRanging();
+      break;
+    case 6:
+      _streaming = value->BOOL;
+      resetStatistics();
+      break;
     default:
       return (false);
       break;
@@ -343,6 +528,12 @@ public:
     case 3:
       return ("Offset");
       break;
+    case 4:
+      return ("Timing_Budget");
+      break;
+    case 5:
+      return ("Streaming");
+      break;
     default:
       return (NULL);
       break;
@@ -361,8 +552,12 @@ public:
     case 1:
     case 2:
     case 3:
+    case 4:
       *type = SFE_QUAD_SETTING_TYPE_UINT16_T;
       break;
+    case 5:
+      *type = SFE_QUAD_SETTING_TYPE_BOOL;
+      break;
     default:
       return (false);
       break;
@@ -388,6 +583,12 @@ public:
     case 3:
       value->UINT16_T = device->getOffset();
       break;
+    case 4:
+      value->UINT16_T = device->getTimingBudgetInMs();
+      break;
+    case 5:
+      value->BOOL = _streaming;
+      break;
     default:
       return (false);
       break;
@@ -425,6 +626,15 @@ public:
       device->setOffset(value->UINT16_T);
       device->startRanging();
       break;
+    case 4:
+      device->stopRanging();
+      applyTimingBudget(value->UINT16_T);
+      device->startRanging();
+      break;
+    case 5:
+      _streaming = value->BOOL;
+      resetStatistics();
+      break;
     default:
       return (false);
       break;
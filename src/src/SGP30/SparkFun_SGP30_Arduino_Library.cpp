@@ -288,48 +288,8 @@ SGP30ERR SGP30::measureTest(void)
   return SGP30_SUCCESS;
 }
 
-#ifndef SGP30_LOOKUP_TABLE
-//Given an array and a number of bytes, this calculate CRC8 for those bytes
-//CRC is only calc'd on the data portion (two bytes) of the four bytes being sent
-//From: http://www.sunshine2k.de/articles/coding/crc/understanding_crc.html
-//Tested with: http://www.sunshine2k.de/coding/javascript/crc/crc_js.html
-//x^8+x^5+x^4+1 = 0x31
+//Generates CRC8 for SGP30 (using the shared Sensirion CRC lookup table)
 uint8_t SGP30::_CRC8(uint16_t data)
 {
-  uint8_t crc = 0xFF; //Init with 0xFF
-
-  crc ^= (data >> 8); // XOR-in the first input byte
-
-  for (uint8_t i = 0; i < 8; i++)
-  {
-    if ((crc & 0x80) != 0)
-      crc = (uint8_t)((crc << 1) ^ 0x31);
-    else
-      crc <<= 1;
-  }
-  crc ^= (uint8_t)data; // XOR-in the last input byte
-
-  for (uint8_t i = 0; i < 8; i++)
-  {
-    if ((crc & 0x80) != 0)
-      crc = (uint8_t)((crc << 1) ^ 0x31);
-    else
-      crc <<= 1;
-  }
-
-  return crc; //No output reflection
-}
-#endif
-
-#ifdef SGP30_LOOKUP_TABLE
-//Generates CRC8 for SGP30 from lookup table
-uint8_t SGP30::_CRC8(uint16_t data)
-{
-  uint8_t CRC = 0xFF;                          //inital value
-  CRC ^= (uint8_t)(data >> 8);                 //start with MSB
-  CRC = _CRC8LookupTable[CRC >> 4][CRC & 0xF]; //look up table [MSnibble][LSnibble]
-  CRC ^= (uint8_t)data;                        //use LSB
-  CRC = _CRC8LookupTable[CRC >> 4][CRC & 0xF]; //look up table [MSnibble][LSnibble]
-  return CRC;
+  return (SFE_QUAD_Sensirion_CRC::crc8(data));
 }
-#endif
@@ -188,6 +188,22 @@ SGP40ERR SGP40::heaterOff(void)
 //Default DegC = 25 (T_ticks = 0x6666)
 //See the SGP40 datasheet for more details
 SGP40ERR SGP40::measureRaw(uint16_t *SRAW_ticks, float RH, float T)
+{
+  SGP40ERR result = startMeasureRaw(RH, T);
+
+  if (result != SGP40_SUCCESS)
+    return result;
+
+  //Hang out while measurement is taken. datasheet says 30ms
+  delay(30);
+
+  return readMeasureRaw(SRAW_ticks);
+}
+
+//Start a raw measurement but do not wait for it to complete
+//Returns SUCCESS (0) if successful
+//Call readMeasureRaw at least 30ms later to collect the result
+SGP40ERR SGP40::startMeasureRaw(float RH, float T)
 {
   uint16_t RH_ticks, T_ticks;
 
@@ -195,25 +211,25 @@ SGP40ERR SGP40::measureRaw(uint16_t *SRAW_ticks, float RH, float T)
   if (RH < 0)
   {
     if (_printDebug == true)
-      _debugPort->println(F("measureRaw: RH too low! Correcting..."));
+      _debugPort->println(F("startMeasureRaw: RH too low! Correcting..."));
     RH = 0;
   }
   if (RH > 100)
   {
     if (_printDebug == true)
-      _debugPort->println(F("measureRaw: RH too high! Correcting..."));
+      _debugPort->println(F("startMeasureRaw: RH too high! Correcting..."));
     RH = 100;
   }
   if (T < -45)
   {
     if (_printDebug == true)
-      _debugPort->println(F("measureRaw: T too low! Correcting..."));
+      _debugPort->println(F("startMeasureRaw: T too low! Correcting..."));
     T = -45;
   }
   if (T > 130)
   {
     if (_printDebug == true)
-      _debugPort->println(F("measureRaw: T too high! Correcting..."));
+      _debugPort->println(F("startMeasureRaw: T too high! Correcting..."));
     T = 130;
   }
 
@@ -221,7 +237,7 @@ SGP40ERR SGP40::measureRaw(uint16_t *SRAW_ticks, float RH, float T)
   T_ticks = (uint16_t)((T + 45) * 65535 / 175); // Convert T from DegC to ticks
   if (_printDebug == true)
   {
-    _debugPort->print(F("measureRaw: RH_ticks: 0x"));
+    _debugPort->print(F("startMeasureRaw: RH_ticks: 0x"));
     _debugPort->print(RH_ticks, HEX);
     _debugPort->print(F(" T_ticks: 0x"));
     _debugPort->println(T_ticks, HEX);
@@ -244,22 +260,27 @@ SGP40ERR SGP40::measureRaw(uint16_t *SRAW_ticks, float RH, float T)
   {
     if (_printDebug == true)
     {
-      _debugPort->print(F("measureRaw: endTransmission returned: "));
+      _debugPort->print(F("startMeasureRaw: endTransmission returned: "));
       _debugPort->println(i2cResult);
     }
     return SGP40_ERR_I2C_ERROR;
   }
 
-  //Hang out while measurement is taken. datasheet says 30ms
-  delay(30);
+  return SGP40_SUCCESS;
+}
 
+//Read the result of a measurement started with startMeasureRaw
+//Returns SUCCESS (0) if successful
+//The raw signal is returned in SRAW_ticks
+SGP40ERR SGP40::readMeasureRaw(uint16_t *SRAW_ticks)
+{
   //Comes back in 3 bytes, data(MSB) / data(LSB) / Checksum
   uint8_t toRead = _i2cPort->requestFrom(_SGP40Address, (uint8_t)3);
   if (toRead != 3)
   {
     if (_printDebug == true)
     {
-      _debugPort->print(F("measureRaw: requestFrom returned: "));
+      _debugPort->print(F("readMeasureRaw: requestFrom returned: "));
       _debugPort->println(toRead);
     }
     return SGP40_ERR_I2C_ERROR; //Error out
@@ -273,7 +294,7 @@ SGP40ERR SGP40::measureRaw(uint16_t *SRAW_ticks, float RH, float T)
   {
     if (_printDebug == true)
     {
-      _debugPort->print(F("measureRaw: checksum failed! Expected: 0x"));
+      _debugPort->print(F("readMeasureRaw: checksum failed! Expected: 0x"));
       _debugPort->print(_CRC8(results), HEX);
       _debugPort->print(F(" Received: 0x"));
       _debugPort->println(checkSum, HEX);
@@ -291,7 +312,6 @@ SGP40ERR SGP40::measureRaw(uint16_t *SRAW_ticks, float RH, float T)
 //The user can provide Relative Humidity and Temperature parameters if desired
 int32_t SGP40::getVOCindex(float RH, float T)
 {
-  int32_t vocIndex;
   uint16_t SRAW_ticks;
 
   SGP40ERR result = measureRaw(&SRAW_ticks, RH, T);
@@ -306,52 +326,22 @@ int32_t SGP40::getVOCindex(float RH, float T)
     return -100; //fail...
   }
 
-  VocAlgorithm_process(&vocAlgorithmParameters, SRAW_ticks, &vocIndex);
-
-  return vocIndex;
+  return processVOCindex(SRAW_ticks);
 }
 
-#ifndef SGP40_LOOKUP_TABLE
-//Given an array and a number of bytes, this calculate CRC8 for those bytes
-//CRC is only calc'd on the data portion (two bytes) of the four bytes being sent
-//From: http://www.sunshine2k.de/articles/coding/crc/understanding_crc.html
-//Tested with: http://www.sunshine2k.de/coding/javascript/crc/crc_js.html
-//x^8+x^5+x^4+1 = 0x31
-uint8_t SGP40::_CRC8(uint16_t data)
+//Run the Sensirion VOC Algorithm on a raw signal
+//Returns the VOC Index
+int32_t SGP40::processVOCindex(uint16_t SRAW_ticks)
 {
-  uint8_t crc = 0xFF; //Init with 0xFF
-
-  crc ^= (data >> 8); // XOR-in the first input byte
-
-  for (uint8_t i = 0 ; i < 8 ; i++)
-  {
-    if ((crc & 0x80) != 0)
-      crc = (uint8_t)((crc << 1) ^ 0x31);
-    else
-      crc <<= 1;
-  }
-
-  crc ^= (uint8_t)data; // XOR-in the last input byte
+  int32_t vocIndex;
 
-  for (uint8_t i = 0 ; i < 8 ; i++)
-  {
-    if ((crc & 0x80) != 0)
-      crc = (uint8_t)((crc << 1) ^ 0x31);
-    else
-      crc <<= 1;
-  }
+  VocAlgorithm_process(&vocAlgorithmParameters, SRAW_ticks, &vocIndex);
 
-  return crc; //No output reflection
+  return vocIndex;
 }
-#else
-//Generates CRC8 for SGP40 from lookup table
+
+//Generates CRC8 for SGP40 (using the shared Sensirion CRC lookup table)
 uint8_t SGP40::_CRC8(uint16_t data)
 {
-  uint8_t crc = 0xFF; //inital value
-  crc ^= (uint8_t)(data >> 8); //start with MSB
-  crc = _CRC8LookupTable[crc >> 4][crc & 0xF]; //look up table [MSnibble][LSnibble]
-  crc ^= (uint8_t)data; //use LSB
-  crc = _CRC8LookupTable[crc >> 4][crc & 0xF]; //look up table [MSnibble][LSnibble]
-  return crc;
+  return (SFE_QUAD_Sensirion_CRC::crc8(data));
 }
-#endif
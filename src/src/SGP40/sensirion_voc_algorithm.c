@@ -65,6 +65,31 @@ static fix16_t fix16_sqrt(fix16_t inValue);
 /*! Returns the exponent (e^) of the given fix16_t. */
 static fix16_t fix16_exp(fix16_t inValue);
 
+#if !defined(FIXMATH_NO_64BIT) && !defined(__AVR__)
+static fix16_t fix16_mul(fix16_t inArg0, fix16_t inArg1) {
+    // On 32-bit cores with a single-cycle 32x32->64 multiply this is much
+    // cheaper than composing the product from 16-bit parts (below). The
+    // rounding matches the 16-bit version: halves round up for positive
+    // products and down for negative products.
+    int64_t product = (int64_t)inArg0 * inArg1;
+
+#ifndef FIXMATH_NO_OVERFLOW
+    // The upper 17 bits should all be the same (the sign).
+    int32_t upper = (int32_t)(product >> 47);
+    if ((upper != 0) && (upper != -1))
+        return FIX16_OVERFLOW;
+#endif
+
+#ifdef FIXMATH_NO_ROUNDING
+    return (fix16_t)(product >> 16);
+#else
+    int64_t rounded = product + 0x8000;
+    if (product < 0)
+        rounded--;
+    return (fix16_t)(rounded >> 16);
+#endif
+}
+#else
 static fix16_t fix16_mul(fix16_t inArg0, fix16_t inArg1) {
     // Each argument is divided to 16-bit parts.
     //					AB
@@ -118,6 +143,7 @@ static fix16_t fix16_mul(fix16_t inArg0, fix16_t inArg1) {
     return result;
 #endif
 }
+#endif
 
 static fix16_t fix16_div(fix16_t a, fix16_t b) {
     // This uses the basic binary restoring division algorithm.
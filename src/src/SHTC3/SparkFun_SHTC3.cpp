@@ -394,28 +394,7 @@ SHTC3_Status_TypeDef SHTC3::update()
 
 SHTC3_Status_TypeDef SHTC3::checkCRC(uint16_t packet, uint8_t cs)
 {
-	uint8_t upper = packet >> 8;
-	uint8_t lower = packet & 0x00FF;
-	uint8_t data[2] = {upper, lower};
-	uint8_t crc = 0xFF;
-	uint8_t poly = 0x31;
-
-	for (uint8_t indi = 0; indi < 2; indi++)
-	{
-		crc ^= data[indi];
-
-		for (uint8_t indj = 0; indj < 8; indj++)
-		{
-			if (crc & 0x80)
-			{
-				crc = (uint8_t)((crc << 1) ^ poly);
-			}
-			else
-			{
-				crc <<= 1;
-			}
-		}
-	}
+	uint8_t crc = SFE_QUAD_Sensirion_CRC::crc8(packet); // Shared lookup table
 
 	if (cs ^ crc)
 	{
@@ -10,6 +10,8 @@ An Arduino library for the Sensirion SHTC3 humidity and temerature sensor
 #include <Arduino.h>
 #include <Wire.h>
 
+#include "../COMMON/SFE_QUAD_Sensirion_CRC.h"
+
 #define SHTC3_ADDR_7BIT 0b1110000
 #define SHTC3_ADDR_WRITE 0b11100000
 #define SHTC3_ADDR_READ 0b11100001
@@ -124,6 +124,20 @@ bool STC3x::setPressure(uint16_t pressure)
 //Updates global variables with floats
 //Returns true if data is read successfully
 bool STC3x::measureGasConcentration(void)
+{
+  if (startGasConcentration() == false)
+    return (false);
+
+  delay(STC3X_MEASUREMENT_DELAY_MILLIS);
+
+  return (readGasConcentration());
+}
+
+//Send the measure gas concentration command. See 3.3.6
+//The result can be read with readGasConcentration after STC3X_MEASUREMENT_DELAY_MILLIS
+//This allows the measurement to run in parallel with other sensors
+//Returns true if the command was sent successfully
+bool STC3x::startGasConcentration(void)
 {
   // The measurement command should not be triggered more often than once a second.
   // Check if it is OK to trigger a new measurement
@@ -131,25 +145,31 @@ bool STC3x::measureGasConcentration(void)
   {
     if (_printDebug == true)
     {
-      _debugPort->print(F("STC3x::measureGasConcentration: too early! Please wait another "));
+      _debugPort->print(F("STC3x::startGasConcentration: too early! Please wait another "));
       _debugPort->print(_lastReadTimeMillis + 1000 - millis());
       _debugPort->println(F("ms"));
     }
     return (false); // Too early!
   }
 
-  STC3x_unsigned16Bytes_t tempCO2;
-  tempCO2.unsigned16 = 0;
-  STC3x_signed16Bytes_t  tempTemperature;
-  tempTemperature.signed16 = 0;
-
   _i2cPort->beginTransmission(_stc3x_i2c_address);
   _i2cPort->write(STC3X_COMMAND_MEASURE_GAS_CONCENTRATION >> 8);   //MSB
   _i2cPort->write(STC3X_COMMAND_MEASURE_GAS_CONCENTRATION & 0xFF); //LSB
   if (_i2cPort->endTransmission() != 0)
     return (false); //Sensor did not ACK
 
-  delay(75); //Datasheet specifies 66ms but sensor seems to need at least 70ms. 75ms provides margin.
+  return (true);
+}
+
+//Read the 9 bytes of a measurement started by startGasConcentration. See 3.3.6
+//Updates global variables with floats
+//Returns true if data is read successfully
+bool STC3x::readGasConcentration(void)
+{
+  STC3x_unsigned16Bytes_t tempCO2;
+  tempCO2.unsigned16 = 0;
+  STC3x_signed16Bytes_t  tempTemperature;
+  tempTemperature.signed16 = 0;
 
   uint8_t receivedBytes = (uint8_t)_i2cPort->requestFrom((uint8_t)_stc3x_i2c_address, (uint8_t)9);
   bool error = false;
@@ -183,7 +203,7 @@ bool STC3x::measureGasConcentration(void)
         {
           if (_printDebug == true)
           {
-            _debugPort->print(F("STC3x::measureGasConcentration: found CRC in byte "));
+            _debugPort->print(F("STC3x::readGasConcentration: found CRC in byte "));
             _debugPort->print(x);
             _debugPort->print(F(", expected 0x"));
             _debugPort->print(foundCrc, HEX);
@@ -200,7 +220,7 @@ bool STC3x::measureGasConcentration(void)
   {
     if (_printDebug == true)
     {
-      _debugPort->print(F("STC3x::measureGasConcentration: no STC3x data found from I2C, I2C claims we should receive "));
+      _debugPort->print(F("STC3x::readGasConcentration: no STC3x data found from I2C, I2C claims we should receive "));
       _debugPort->print(receivedBytes);
       _debugPort->println(F(" bytes"));
     }
@@ -210,7 +230,7 @@ bool STC3x::measureGasConcentration(void)
   if (error)
   {
     if (_printDebug == true)
-      _debugPort->println(F("STC3x::measureGasConcentration: encountered error reading STC3x data."));
+      _debugPort->println(F("STC3x::readGasConcentration: encountered error reading STC3x data."));
     return (false);
   }
 
@@ -478,20 +498,5 @@ bool STC3x::readRegister(uint16_t registerAddress, uint16_t *response, uint16_t
 //x^8+x^5+x^4+1 = 0x31
 uint8_t STC3x::computeCRC8(uint8_t data[], uint8_t len)
 {
-  uint8_t crc = 0xFF; //Init with 0xFF
-
-  for (uint8_t x = 0; x < len; x++)
-  {
-    crc ^= data[x]; // XOR-in the next input byte
-
-    for (uint8_t i = 0; i < 8; i++)
-    {
-      if ((crc & 0x80) != 0)
-        crc = (uint8_t)((crc << 1) ^ 0x31);
-      else
-        crc <<= 1;
-    }
-  }
-
-  return crc; //No output reflection
+  return (SFE_QUAD_Sensirion_CRC::crc8(data, len)); //Shared lookup table
 }
@@ -36,6 +36,8 @@
 #include <Wire.h>
 #endif
 
+#include "../COMMON/SFE_QUAD_Sensirion_CRC.h"
+
 //The default I2C address for the STC31 is 0x29. 0X2A, 0x2B and 0x2C can be selected via the ADDR pin.
 #define STC3x_DEFAULT_ADDRESS 0x29
 
@@ -68,6 +70,9 @@ typedef enum
 #define STC3X_COMMAND_READ_PRODUCT_IDENTIFIER_1               0x367C
 #define STC3X_COMMAND_READ_PRODUCT_IDENTIFIER_2               0xE102
 
+//Measure gas concentration duration. Datasheet specifies 66ms but sensor seems to need at least 70ms. 75ms provides margin.
+#define STC3X_MEASUREMENT_DELAY_MILLIS 75
+
 typedef union
 {
   int16_t signed16;
@@ -123,6 +128,10 @@ public:
 
   bool measureGasConcentration(void); // Check for fresh data; store it. Returns true if fresh data is available
 
+  // measureGasConcentration split into two, so the measurement can run in parallel with other sensors
+  bool startGasConcentration(void); // Send the measure command. Returns true if I2C transfer was OK
+  bool readGasConcentration(void); // Read the result STC3X_MEASUREMENT_DELAY_MILLIS later; store it. Returns true if fresh data is available
+
   float getCO2(void); // Return the CO2 concentration %. Automatically request fresh data is the data is 'stale'
   float getTemperature(void); // Return the temperature. Automatically request fresh data is the data is 'stale'
 
@@ -42,7 +42,9 @@ Distributed as-is; no warranty is given.
 	This needs to be called when running the example sketches to
 	initialize the sensor and be able to call to the library. 
 */
-TMP117::TMP117()
+static const uint8_t TMP117_SHADOWED_REGISTERS[TMP117_NUM_SHADOWED_REGISTERS] = {TMP117_TEMP_OFFSET, TMP117_T_LOW_LIMIT, TMP117_T_HIGH_LIMIT};
+
+TMP117::TMP117() : _shadow(TMP117_SHADOWED_REGISTERS)
 {
 }
 
@@ -57,6 +59,7 @@ bool TMP117::begin(uint8_t sensorAddress, TwoWire &wirePort)
 {
 	_i2cPort = &wirePort;			// Chooses the wire port of the device
 	_deviceAddress = sensorAddress; // Sets the address of the device
+	_shadow.invalidateAll();		// We don't know what this device contains yet
 
 	//make sure the TMP will acknowledge over I2C
 	_i2cPort->beginTransmission(_deviceAddress);
@@ -93,10 +96,14 @@ uint8_t TMP117::getAddress()
 */
 uint16_t TMP117::readRegister(uint8_t reg) // originally TMP117_Register reg
 {
+	uint16_t shadowed;
+	if (_shadow.read(reg, &shadowed)) // Shadowed registers are read from RAM
+		return shadowed;
+
 	_i2cPort->beginTransmission(_deviceAddress); // Originally cast (uint8_t)
 	_i2cPort->write(reg);
-	_i2cPort->endTransmission();					   // endTransmission but keep the connection active
-	_i2cPort->requestFrom(_deviceAddress, (uint8_t)2); // Ask for 2 bytes, once done, bus is released by default
+	_i2cPort->endTransmission();										   // endTransmission but keep the connection active
+	uint8_t received = _i2cPort->requestFrom(_deviceAddress, (uint8_t)2); // Ask for 2 bytes, once done, bus is released by default
 
 	uint8_t data[2] = {0};			// Declares an array of length 2 to be empty
 	int16_t datac = 0;				// Declares the return variable to be 0
@@ -106,6 +113,8 @@ uint16_t TMP117::readRegister(uint8_t reg) // originally TMP117_Register reg
 		data[1] = _i2cPort->read();			// Reads the second set of bits (D7-D0)
 		datac = ((data[0] << 8) | data[1]); // Swap the LSB and the MSB
 	}
+	if (received == 2)
+		_shadow.write(reg, datac); // Fill the shadow (ignored if reg is not shadowed)
 	return datac;
 }
 
@@ -118,7 +127,10 @@ void TMP117::writeRegister(uint8_t reg, uint16_t data) // originally TMP117_Regi
 	_i2cPort->write(reg);
 	_i2cPort->write(highByte(data)); // Write MSB (D15-D8)
 	_i2cPort->write(lowByte(data));  // Write LSB (D7-D0)
-	_i2cPort->endTransmission();	 // Stop transmitting data
+	if (_i2cPort->endTransmission() == 0) // Stop transmitting data
+		_shadow.write(reg, data);			  // Write-through
+	else
+		_shadow.invalidate(reg);
 }
 
 /* READ TEMPERATURE CELSIUS
@@ -354,6 +366,7 @@ void TMP117::softReset()
 	reset = readRegister(TMP117_CONFIGURATION); // Fills mode to be the configuration register
 	bitWrite(reset, 1, 1);
 	writeRegister(TMP117_CONFIGURATION, reset);
+	_shadow.invalidateAll(); // The reset reloads the offset and limits from EEPROM
 }
 
 /* SET CONTINUOUS CONVERSION MODE
@@ -24,6 +24,11 @@ Distributed as-is; no warranty is given.
 #include <Wire.h>
 #include <Arduino.h>
 #include "SparkFun_TMP117_Registers.h"
+#include "../COMMON/SFE_QUAD_Register_Shadow.h"
+
+// The offset and limit registers only change when we write them, so they are shadowed.
+// The configuration register is not: its flags are cleared by reading, and MOD changes at the end of a one-shot
+#define TMP117_NUM_SHADOWED_REGISTERS 3
 
 #define DEVICE_ID_VALUE 0x0117			// Value found in the device ID register on reset (page 24 Table 3 of datasheet)
 #define TMP117_RESOLUTION 0.0078125f	// Resolution of the device, found on (page 1 of datasheet)
@@ -98,6 +103,8 @@ private:
 	TwoWire *_i2cPort = NULL; //The generic connection to user's chosen I2C hardware
 	uint8_t _deviceAddress;   // Address of Temperature sensor
 
+	SFE_QUAD_Register_Shadow<uint16_t, TMP117_NUM_SHADOWED_REGISTERS> _shadow; // Write-through shadow of the offset and limit registers
+
 	uint16_t readRegister(uint8_t reg);				// Reads 2 register bytes from sensor
 	void writeRegister(uint8_t reg, uint16_t data); // Wires single byte of data to the sensor
 };
@@ -53,12 +53,19 @@ const uint8_t VCNL4040_ADDR = 0x60; //7-bit unshifted I2C address of VCNL4040
 #define VCNL4040_INT_FLAG 0x0B //Upper
 #define VCNL4040_ID 0x0C
 
+//Command codes which only change when we write them
+static const uint8_t VCNL4040_SHADOWED_COMMANDS[VCNL4040_NUM_SHADOWED_COMMANDS] = {
+  VCNL4040_ALS_CONF, VCNL4040_ALS_THDH, VCNL4040_ALS_THDL, VCNL4040_PS_CONF1,
+  VCNL4040_PS_CONF3, VCNL4040_PS_CANC, VCNL4040_PS_THDL, VCNL4040_PS_THDH
+};
+
 //Class constructor
-VCNL4040::VCNL4040(void) {}
+VCNL4040::VCNL4040(void) : _shadow(VCNL4040_SHADOWED_COMMANDS) {}
 
 //Check comm with sensor and set it to default init settings
 boolean VCNL4040::begin(TwoWire &wirePort) {
   _i2cPort = &wirePort; //Grab which port the user wants us to use
+  _shadow.invalidateAll(); //We don't know what this sensor contains yet
 
   //We expect caller to begin their I2C port, with the speed of their choice external to the library
   //But if they forget, we start the hardware here.
@@ -352,9 +359,19 @@ boolean VCNL4040::isDark()
   return (interruptFlags & VCNL4040_INT_FLAG_ALS_LOW);
 }
 
+//Returns all of the interrupt flags
+//The flags are cleared by the read, so use this rather than isClose etc. when more than one flag is of interest
+uint8_t VCNL4040::getInterruptFlags()
+{
+  return (readCommandUpper(VCNL4040_INT_FLAG));
+}
+
 //Reads two consecutive bytes from a given 'command code' location
 uint16_t VCNL4040::readCommand(uint8_t commandCode)
 {
+  uint16_t shadowed;
+  if (_shadow.read(commandCode, &shadowed)) return (shadowed); //Configuration is read from RAM
+
   _i2cPort->beginTransmission(VCNL4040_ADDR);
   _i2cPort->write(commandCode);
   if (_i2cPort->endTransmission(false) != 0) //Send a restart command. Do not release bus.
@@ -367,6 +384,7 @@ uint16_t VCNL4040::readCommand(uint8_t commandCode)
   {
     uint8_t lsb = _i2cPort->read();
     uint8_t msb = _i2cPort->read();
+    _shadow.write(commandCode, (uint16_t)msb << 8 | lsb); //Fill the shadow (ignored if not shadowed)
     return ((uint16_t)msb << 8 | lsb);
   }
 
@@ -376,15 +394,24 @@ uint16_t VCNL4040::readCommand(uint8_t commandCode)
 //Write two bytes to a given command code location (8 bits)
 boolean VCNL4040::writeCommand(uint8_t commandCode, uint16_t value)
 {
+  //PS_TRIG clears itself once the forced measurement is done, so never hold it in the shadow
+  uint16_t shadowed = value;
+  if (commandCode == VCNL4040_PS_CONF3) shadowed &= ~((uint16_t)VCNL4040_PS_TRIG_TRIGGER);
+
+  //Skip writes which would not change the register
+  if ((shadowed == value) && (_shadow.changes(commandCode, value) == false)) return (true);
+
   _i2cPort->beginTransmission(VCNL4040_ADDR);
   _i2cPort->write(commandCode);
   _i2cPort->write(value & 0xFF); //LSB
   _i2cPort->write(value >> 8); //MSB
   if (_i2cPort->endTransmission() != 0)
   {
+    _shadow.invalidate(commandCode);
     return (false); //Sensor did not ACK
   }
 
+  _shadow.write(commandCode, shadowed); //Write-through
   return (true);
 }
 
@@ -35,6 +35,10 @@
 #include "WProgram.h"
 #endif
 
+#include "../COMMON/SFE_QUAD_Register_Shadow.h"
+
+#define VCNL4040_NUM_SHADOWED_COMMANDS 8 //ALS_CONF to PS_THDH
+
 static const uint8_t VCNL4040_ALS_IT_MASK = (uint8_t)~((1 << 7) | (1 << 6));
 static const uint8_t VCNL4040_ALS_IT_80MS = 0;
 static const uint8_t VCNL4040_ALS_IT_160MS = (1 << 7);
@@ -99,7 +103,7 @@ static const uint8_t VCNL4040_PS_AF_MASK = (uint8_t)~((1 << 3));
 static const uint8_t VCNL4040_PS_AF_DISABLE = 0;
 static const uint8_t VCNL4040_PS_AF_ENABLE = (1 << 3);
 
-static const uint8_t VCNL4040_PS_TRIG_MASK = (uint8_t)~((1 << 3));
+static const uint8_t VCNL4040_PS_TRIG_MASK = (uint8_t)~((1 << 2));
 static const uint8_t VCNL4040_PS_TRIG_TRIGGER = (1 << 2);
 
 static const uint8_t VCNL4040_WHITE_EN_MASK = (uint8_t)~((1 << 7));
@@ -183,6 +187,7 @@ class VCNL4040 {
     boolean isAway(); //Interrupt flag: True if prox value lower than low threshold
     boolean isLight(); //Interrupt flag: True if ALS value higher than high threshold
     boolean isDark(); //Interrupt flag: True if ALS value lower than low threshold
+    uint8_t getInterruptFlags(); //Read all four interrupt flags at once (VCNL4040_INT_FLAG_CLOSE etc.). Reading clears them
 
     uint16_t readCommand(uint8_t commandCode);
     uint8_t readCommandLower(uint8_t commandCode);
@@ -197,5 +202,9 @@ class VCNL4040 {
   private:
     TwoWire *_i2cPort; //The generic connection to user's chosen I2C hardware
 
+    //Write-through shadow of the configuration and threshold command codes (0x00 to 0x07)
+    //Read-modify-write of a configuration byte then only needs the write
+    SFE_QUAD_Register_Shadow<uint16_t, VCNL4040_NUM_SHADOWED_COMMANDS> _shadow;
+
 };
 #endif
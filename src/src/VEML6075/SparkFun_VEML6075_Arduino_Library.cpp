@@ -103,9 +103,16 @@ VEML6075::VEML6075()
     _i2cPort = NULL;
     _debugPort = NULL;
     _deviceAddress = VEML6075_ADDRESS_INVALID;
-    _lastReadTime = 0;
     _integrationTime = 0;
     _lastIndex = 0.0;
+    _conf = 0;
+    _confValid = false;
+    for (int i = 0; i < NUM_SAMPLE_REGISTERS; i++)
+    {
+        _sample[i] = 0;
+        _sampleReadTime[i] = 0;
+        _sampleValid[i] = false;
+    }
     _aResponsivity = UVA_RESPONSIVITY_100MS_UNCOVERED;
     _bResponsivity = UVB_RESPONSIVITY_100MS_UNCOVERED;
     _hdEnabled = false;
@@ -168,7 +175,7 @@ VEML6075_error_t VEML6075::setIntegrationTime(VEML6075::veml6075_uv_it_t it)
         return VEML6075_ERROR_UNDEFINED;
     }
 
-    err = readI2CRegister(&conf, VEML6075::REG_UV_CONF);
+    err = readConfRegister(&conf);
     if (err != VEML6075_ERROR_SUCCESS)
     {
         return err;
@@ -176,7 +183,7 @@ VEML6075_error_t VEML6075::setIntegrationTime(VEML6075::veml6075_uv_it_t it)
 
     conf &= ~(VEML6075_UV_IT_MASK);
     conf |= (it << VEML6075_UV_IT_SHIFT);
-    err = writeI2CRegister(conf, VEML6075::REG_UV_CONF);
+    err = writeConfRegister(conf);
     if (err != VEML6075_ERROR_SUCCESS)
     {
         return err;
@@ -213,7 +220,7 @@ VEML6075::veml6075_uv_it_t VEML6075::getIntegrationTime(void)
     VEML6075_error_t err;
     veml6075_t conf;
 
-    err = readI2CRegister(&conf, VEML6075::REG_UV_CONF);
+    err = readConfRegister(&conf);
     if (err != VEML6075_ERROR_SUCCESS)
     {
         return IT_INVALID;
@@ -226,7 +233,7 @@ VEML6075_error_t VEML6075::setHighDynamic(VEML6075::veml6075_hd_t hd)
     VEML6075_error_t err;
     veml6075_t conf;
 
-    err = readI2CRegister(&conf, VEML6075::REG_UV_CONF);
+    err = readConfRegister(&conf);
     if (err != VEML6075_ERROR_SUCCESS)
     {
         return err;
@@ -242,7 +249,7 @@ VEML6075_error_t VEML6075::setHighDynamic(VEML6075::veml6075_hd_t hd)
     }
     conf &= ~(VEML6075_HD_MASK);
     conf |= (hd << VEML6075_HD_SHIFT);
-    return writeI2CRegister(conf, VEML6075::REG_UV_CONF);
+    return writeConfRegister(conf);
 }
 
 VEML6075::veml6075_hd_t VEML6075::getHighDynamic(void)
@@ -250,7 +257,7 @@ VEML6075::veml6075_hd_t VEML6075::getHighDynamic(void)
     VEML6075_error_t err;
     veml6075_t conf;
 
-    err = readI2CRegister(&conf, VEML6075::REG_UV_CONF);
+    err = readConfRegister(&conf);
     if (err != VEML6075_ERROR_SUCCESS)
     {
         return HD_INVALID;
@@ -263,7 +270,7 @@ VEML6075_error_t VEML6075::setTrigger(VEML6075::veml6075_uv_trig_t trig)
     VEML6075_error_t err;
     veml6075_t conf;
 
-    err = readI2CRegister(&conf, VEML6075::REG_UV_CONF);
+    err = readConfRegister(&conf);
     if (err != VEML6075_ERROR_SUCCESS)
     {
         return err;
@@ -271,7 +278,7 @@ VEML6075_error_t VEML6075::setTrigger(VEML6075::veml6075_uv_trig_t trig)
 
     conf &= ~(VEML6075_TRIG_MASK);
     conf |= (trig << VEML6075_TRIG_SHIFT);
-    return writeI2CRegister(conf, VEML6075::REG_UV_CONF);
+    return writeConfRegister(conf);
 }
 
 VEML6075::veml6075_uv_trig_t VEML6075::getTrigger(void)
@@ -279,6 +286,7 @@ VEML6075::veml6075_uv_trig_t VEML6075::getTrigger(void)
     VEML6075_error_t err;
     veml6075_t conf;
 
+    // Read the device, not the shadow: UV_TRIG clears itself when the forced measurement is complete
     err = readI2CRegister(&conf, VEML6075::REG_UV_CONF);
     if (err != VEML6075_ERROR_SUCCESS)
     {
@@ -292,7 +300,7 @@ VEML6075_error_t VEML6075::setAutoForce(VEML6075::veml6075_af_t af)
     VEML6075_error_t err;
     veml6075_t conf;
 
-    err = readI2CRegister(&conf, VEML6075::REG_UV_CONF);
+    err = readConfRegister(&conf);
     if (err != VEML6075_ERROR_SUCCESS)
     {
         return err;
@@ -300,7 +308,7 @@ VEML6075_error_t VEML6075::setAutoForce(VEML6075::veml6075_af_t af)
 
     conf &= ~(VEML6075_AF_MASK);
     conf |= (af << VEML6075_AF_SHIFT);
-    return writeI2CRegister(conf, VEML6075::REG_UV_CONF);
+    return writeConfRegister(conf);
 }
 
 VEML6075::veml6075_af_t VEML6075::getAutoForce(void)
@@ -308,7 +316,7 @@ VEML6075::veml6075_af_t VEML6075::getAutoForce(void)
     VEML6075_error_t err;
     veml6075_t conf;
 
-    err = readI2CRegister(&conf, VEML6075::REG_UV_CONF);
+    err = readConfRegister(&conf);
     if (err != VEML6075_ERROR_SUCCESS)
     {
         return AF_INVALID;
@@ -327,7 +335,7 @@ VEML6075_error_t VEML6075::shutdown(boolean shutdown)
     veml6075_t conf;
     VEML6075_shutdown_t sd = VEML6075::POWER_ON;
 
-    err = readI2CRegister(&conf, VEML6075::REG_UV_CONF);
+    err = readConfRegister(&conf);
     if (err != VEML6075_ERROR_SUCCESS)
     {
         return err;
@@ -339,7 +347,7 @@ VEML6075_error_t VEML6075::shutdown(boolean shutdown)
     }
     conf &= ~(VEML6075_SHUTDOWN_MASK);     // Clear shutdown bit
     conf |= sd << VEML6075_SHUTDOWN_SHIFT; //VEML6075_MASK(conf, VEML6075_SHUTDOWN_MASK, VEML6075_SHUTDOWN_SHIFT);
-    return writeI2CRegister(conf, VEML6075::REG_UV_CONF);
+    return writeConfRegister(conf);
 }
 
 VEML6075_error_t VEML6075::trigger(void)
@@ -374,49 +382,16 @@ float VEML6075::uvb(void)
 
 uint16_t VEML6075::rawUva(void)
 {
-    VEML6075_error_t err;
-    uint8_t uva[2] = {0, 0};
-
-    /*if ((_lastReadTime + _integrationTime) > millis())
-    {
-        return _lastUVA;
-    }*/
-    err = readI2CBuffer(uva, VEML6075::REG_UVA_DATA, 2);
-    if (err != VEML6075_ERROR_SUCCESS)
-    {
-        return err;
-    }
-    _lastReadTime = millis();
-    _lastUVA = (uva[0] & 0x00FF) | ((uva[1] & 0x00FF) << 8);
-    return _lastUVA;
+    return readSample(SAMPLE_UVA, VEML6075::REG_UVA_DATA);
 }
 
 uint16_t VEML6075::rawUvb(void)
 {
-    VEML6075_error_t err;
-    uint8_t uvb[2] = {0, 0};
-
-    /*if ((_lastReadTime + _integrationTime) > millis())
-    {
-        return _lastUVB;
-    }*/
-    err = readI2CBuffer(uvb, VEML6075::REG_UVB_DATA, 2);
-    if (err != VEML6075_ERROR_SUCCESS)
-    {
-        return err;
-    }
-    _lastReadTime = millis();
-    _lastUVB = (uvb[0] & 0x00FF) | ((uvb[1] & 0x00FF) << 8);
-    return _lastUVB;
+    return readSample(SAMPLE_UVB, VEML6075::REG_UVB_DATA);
 }
 
 float VEML6075::index(void)
 {
-    /*if ((_lastReadTime + _integrationTime) > millis())
-    {
-        return _lastIndex;
-    }*/
-
     float uvaCalc = this->uva();
     float uvbCalc = this->uvb();
 
@@ -428,32 +403,72 @@ float VEML6075::index(void)
         _lastIndex *= HD_SCALAR;
     }
 
-    _lastReadTime = millis();
     return _lastIndex;
 }
 
 uint16_t VEML6075::uvComp1(void)
 {
+    return readSample(SAMPLE_UVCOMP1, VEML6075::REG_UVCOMP1_DATA);
+}
+
+uint16_t VEML6075::uvComp2(void)
+{
+    return readSample(SAMPLE_UVCOMP2, VEML6075::REG_UVCOMP2_DATA);
+}
+
+// The data registers only update once per integration time. Return the cached sample if it was
+// read within the integration time. Otherwise read the register.
+// uva(), uvb() and index() all use uvComp1 and uvComp2, so this saves several reads per index
+uint16_t VEML6075::readSample(VEML6075_SAMPLE_t sample, VEML6075_REGISTER_t registerAddress)
+{
+    if ((_sampleValid[sample]) && (_integrationTime > 0) && ((millis() - _sampleReadTime[sample]) < _integrationTime))
+    {
+        return _sample[sample];
+    }
+
     VEML6075_error_t err;
-    uint8_t uvcomp1[2] = {0, 0};
-    err = readI2CBuffer(uvcomp1, VEML6075::REG_UVCOMP1_DATA, 2);
+    uint8_t data[2] = {0, 0};
+    err = readI2CBuffer(data, registerAddress, 2);
     if (err != VEML6075_ERROR_SUCCESS)
     {
+        _sampleValid[sample] = false;
         return err;
     }
-    return (uvcomp1[0] & 0x00FF) | ((uvcomp1[1] & 0x00FF) << 8);
+    _sample[sample] = (data[0] & 0x00FF) | ((data[1] & 0x00FF) << 8);
+    _sampleReadTime[sample] = millis();
+    _sampleValid[sample] = true;
+    return _sample[sample];
 }
 
-uint16_t VEML6075::uvComp2(void)
+// Read UV_CONF - from the shadow if it is valid
+VEML6075_error_t VEML6075::readConfRegister(veml6075_t *conf)
 {
-    VEML6075_error_t err;
-    uint8_t uvcomp2[2] = {0, 0};
-    err = readI2CBuffer(uvcomp2, VEML6075::REG_UVCOMP2_DATA, 2);
-    if (err != VEML6075_ERROR_SUCCESS)
+    if (!_confValid)
     {
-        return err;
+        VEML6075_error_t err = readI2CRegister(&_conf, VEML6075::REG_UV_CONF);
+        if (err != VEML6075_ERROR_SUCCESS)
+        {
+            return err;
+        }
+        _confValid = true;
     }
-    return (uvcomp2[0] & 0x00FF) | ((uvcomp2[1] & 0x00FF) << 8);
+    *conf = _conf;
+    return VEML6075_ERROR_SUCCESS;
+}
+
+// Write UV_CONF and update the shadow. The shadow is only valid if the write succeeds.
+// UV_TRIG clears itself, so it is never held in the shadow.
+// A configuration change invalidates the cached samples
+VEML6075_error_t VEML6075::writeConfRegister(veml6075_t conf)
+{
+    VEML6075_error_t err = writeI2CRegister(conf, VEML6075::REG_UV_CONF);
+    _conf = conf & ~(VEML6075_TRIG_MASK);
+    _confValid = (err == VEML6075_ERROR_SUCCESS);
+    for (int i = 0; i < NUM_SAMPLE_REGISTERS; i++)
+    {
+        _sampleValid[i] = false;
+    }
+    return err;
 }
 
 uint16_t VEML6075::visibleCompensation(void)
@@ -163,16 +163,34 @@ private:
         REG_ID = 0x0C
     } VEML6075_REGISTER_t;
 
+    // Slots for the cached data registers
+    typedef enum
+    {
+        SAMPLE_UVA,
+        SAMPLE_UVB,
+        SAMPLE_UVCOMP1,
+        SAMPLE_UVCOMP2,
+        NUM_SAMPLE_REGISTERS
+    } VEML6075_SAMPLE_t;
+
     TwoWire *_i2cPort; //The generic connection to user's chosen I2C hardware
     Stream *_debugPort;
     VEML6075_Address_t _deviceAddress;
 
     unsigned int _integrationTime;
-    unsigned long _lastReadTime;
-    float _lastIndex, _lastUVA, _lastUVB;
+    float _lastIndex;
     float _aResponsivity, _bResponsivity;
     bool _hdEnabled;
 
+    // Write-through shadow of UV_CONF
+    veml6075_t _conf;
+    bool _confValid;
+
+    // Cached data registers. Reused until the integration time has elapsed
+    uint16_t _sample[NUM_SAMPLE_REGISTERS];
+    unsigned long _sampleReadTime[NUM_SAMPLE_REGISTERS];
+    bool _sampleValid[NUM_SAMPLE_REGISTERS];
+
     VEML6075_error_t _connected(void);
 
     // I2C Read/Write
@@ -180,4 +198,9 @@ private:
     VEML6075_error_t writeI2CBuffer(uint8_t *src, VEML6075_REGISTER_t startRegister, uint16_t len);
     VEML6075_error_t readI2CRegister(veml6075_t *dest, VEML6075_REGISTER_t registerAddress);
     VEML6075_error_t writeI2CRegister(veml6075_t data, VEML6075_REGISTER_t registerAddress);
+
+    // Shadowed configuration and cached data access
+    VEML6075_error_t readConfRegister(veml6075_t *conf);
+    VEML6075_error_t writeConfRegister(veml6075_t conf);
+    uint16_t readSample(VEML6075_SAMPLE_t sample, VEML6075_REGISTER_t registerAddress);
 };
\ No newline at end of file
@@ -67,6 +67,18 @@ VEML7700::VEML7700()
   _debugPort = NULL;
   _deviceAddress = VEML7700_I2C_ADDRESS;
   _debugEnabled = false;
+  _configurationRegister.all = 0x0000;
+  _configurationShadowValid = false;
+  _highThreshold = 0;
+  _highThresholdValid = false;
+  _lowThreshold = 0;
+  _lowThresholdValid = false;
+  _ambient = 0;
+  _ambientReadTime = 0;
+  _ambientValid = false;
+  _whiteLevel = 0;
+  _whiteLevelReadTime = 0;
+  _whiteLevelValid = false;
 }
 
 /**************************************************************************/
@@ -95,7 +107,7 @@ bool VEML7700::begin(TwoWire &wirePort)
   _configurationRegister.CONFIG_REG_IT = (VEML7700_t)integrationTimeConfig(VEML7700_INTEGRATION_100ms);
   _configurationRegister.CONFIG_REG_SM = VEML7700_SENSITIVITY_x1;
 
-  err = writeI2CRegister(_configurationRegister.all, VEML7700_CONFIGURATION_REGISTER);
+  err = writeConfigurationRegister();
 
   if (_debugEnabled)
   {
@@ -151,6 +163,8 @@ VEML7700_error_t VEML7700::_connected()
 
   err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
 
+  _configurationShadowValid = (err == VEML7700_ERROR_SUCCESS); // Refresh the shadow while we are here
+
   if (err != VEML7700_ERROR_SUCCESS)
   {
     if (_debugEnabled)
@@ -180,7 +194,7 @@ VEML7700_error_t VEML7700::setShutdown(VEML7700_shutdown_t sd)
 {
   VEML7700_error_t err;
 
-  err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  err = readConfigurationRegister();
   if (err != VEML7700_ERROR_SUCCESS)
   {
     return err;
@@ -188,7 +202,7 @@ VEML7700_error_t VEML7700::setShutdown(VEML7700_shutdown_t sd)
 
   _configurationRegister.CONFIG_REG_SD = (VEML7700_t)sd;
 
-  return writeI2CRegister(_configurationRegister.all, VEML7700_CONFIGURATION_REGISTER);
+  return writeConfigurationRegister();
 }
 
 /**************************************************************************/
@@ -201,7 +215,7 @@ VEML7700_shutdown_t VEML7700::getShutdown()
 {
   VEML7700_error_t err;
 
-  err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  err = readConfigurationRegister();
   if (err != VEML7700_ERROR_SUCCESS)
   {
     return VEML7700_SHUTDOWN_INVALID;
@@ -224,7 +238,7 @@ VEML7700_error_t VEML7700::setInterruptEnable(VEML7700_interrupt_enable_t ie)
 {
   VEML7700_error_t err;
 
-  err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  err = readConfigurationRegister();
   if (err != VEML7700_ERROR_SUCCESS)
   {
     return err;
@@ -232,7 +246,7 @@ VEML7700_error_t VEML7700::setInterruptEnable(VEML7700_interrupt_enable_t ie)
 
   _configurationRegister.CONFIG_REG_INT_EN = (VEML7700_t)ie;
 
-  return writeI2CRegister(_configurationRegister.all, VEML7700_CONFIGURATION_REGISTER);
+  return writeConfigurationRegister();
 }
 
 /**************************************************************************/
@@ -247,7 +261,7 @@ VEML7700_error_t VEML7700::getInterruptEnable(VEML7700_interrupt_enable_t *ie)
 {
   VEML7700_error_t err;
 
-  err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  err = readConfigurationRegister();
   
   if (err == VEML7700_ERROR_SUCCESS)
   {
@@ -271,7 +285,7 @@ VEML7700_interrupt_enable_t VEML7700::getInterruptEnable()
 {
   VEML7700_error_t err;
 
-  err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  err = readConfigurationRegister();
   if (err != VEML7700_ERROR_SUCCESS)
   {
     return VEML7700_INT_INVALID;
@@ -296,7 +310,7 @@ VEML7700_error_t VEML7700::setPersistenceProtect(VEML7700_persistence_protect_t
 {
   VEML7700_error_t err;
 
-  err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  err = readConfigurationRegister();
   if (err != VEML7700_ERROR_SUCCESS)
   {
     return err;
@@ -304,7 +318,7 @@ VEML7700_error_t VEML7700::setPersistenceProtect(VEML7700_persistence_protect_t
 
   _configurationRegister.CONFIG_REG_PERS = (VEML7700_t)pp;
 
-  return writeI2CRegister(_configurationRegister.all, VEML7700_CONFIGURATION_REGISTER);
+  return writeConfigurationRegister();
 }
 
 /**************************************************************************/
@@ -319,7 +333,7 @@ VEML7700_error_t VEML7700::getPersistenceProtect(VEML7700_persistence_protect_t
 {
   VEML7700_error_t err;
 
-  err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  err = readConfigurationRegister();
   
   if (err == VEML7700_ERROR_SUCCESS)
   {
@@ -349,7 +363,7 @@ VEML7700_persistence_protect_t VEML7700::getPersistenceProtect()
 {
   VEML7700_error_t err;
 
-  err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  err = readConfigurationRegister();
   if (err != VEML7700_ERROR_SUCCESS)
   {
     return VEML7700_PERSISTENCE_INVALID;
@@ -392,7 +406,7 @@ VEML7700_error_t VEML7700::setIntegrationTime(VEML7700_integration_time_t it)
 {
   VEML7700_error_t err;
 
-  err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  err = readConfigurationRegister();
   if (err != VEML7700_ERROR_SUCCESS)
   {
     return err;
@@ -400,7 +414,7 @@ VEML7700_error_t VEML7700::setIntegrationTime(VEML7700_integration_time_t it)
 
   _configurationRegister.CONFIG_REG_IT = (VEML7700_t)integrationTimeConfig(it);
 
-  return writeI2CRegister(_configurationRegister.all, VEML7700_CONFIGURATION_REGISTER);
+  return writeConfigurationRegister();
 }
 
 /**************************************************************************/
@@ -415,7 +429,7 @@ VEML7700_error_t VEML7700::getIntegrationTime(VEML7700_integration_time_t *it)
 {
   VEML7700_error_t err;
 
-  err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  err = readConfigurationRegister();
 
   if (err == VEML7700_ERROR_SUCCESS)
   {
@@ -447,7 +461,7 @@ VEML7700_integration_time_t VEML7700::getIntegrationTime()
 {
   VEML7700_error_t err;
 
-  err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  err = readConfigurationRegister();
   if (err != VEML7700_ERROR_SUCCESS)
   {
     return VEML7700_INTEGRATION_INVALID;
@@ -486,7 +500,7 @@ VEML7700_error_t VEML7700::setSensitivityMode(VEML7700_sensitivity_mode_t sm)
 {
   VEML7700_error_t err;
 
-  err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  err = readConfigurationRegister();
   if (err != VEML7700_ERROR_SUCCESS)
   {
     return err;
@@ -494,7 +508,7 @@ VEML7700_error_t VEML7700::setSensitivityMode(VEML7700_sensitivity_mode_t sm)
 
   _configurationRegister.CONFIG_REG_SM = (VEML7700_t)sm;
 
-  return writeI2CRegister(_configurationRegister.all, VEML7700_CONFIGURATION_REGISTER);
+  return writeConfigurationRegister();
 }
 
 /**************************************************************************/
@@ -509,7 +523,7 @@ VEML7700_error_t VEML7700::getSensitivityMode(VEML7700_sensitivity_mode_t *sm)
 {
   VEML7700_error_t err;
 
-  err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  err = readConfigurationRegister();
   
   if (err == VEML7700_ERROR_SUCCESS)
   {
@@ -539,7 +553,7 @@ VEML7700_sensitivity_mode_t VEML7700::getSensitivityMode()
 {
   VEML7700_error_t err;
 
-  err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  err = readConfigurationRegister();
   if (err != VEML7700_ERROR_SUCCESS)
   {
     return VEML7700_SENSITIVITY_INVALID;
@@ -572,7 +586,10 @@ const char * VEML7700::getSensitivityModeStr()
 /**************************************************************************/
 VEML7700_error_t VEML7700::setHighThreshold(uint16_t threshold)
 {
-  return (writeI2CRegister((VEML7700_t)threshold, VEML7700_HIGH_THRESHOLD));
+  VEML7700_error_t err = writeI2CRegister((VEML7700_t)threshold, VEML7700_HIGH_THRESHOLD);
+  _highThreshold = threshold;
+  _highThresholdValid = (err == VEML7700_ERROR_SUCCESS);
+  return (err);
 }
 
 /**************************************************************************/
@@ -585,7 +602,15 @@ VEML7700_error_t VEML7700::setHighThreshold(uint16_t threshold)
 /**************************************************************************/
 VEML7700_error_t VEML7700::getHighThreshold(uint16_t *threshold)
 {
-  return (readI2CRegister((VEML7700_t *)threshold, VEML7700_HIGH_THRESHOLD));
+  if (!_highThresholdValid)
+  {
+    VEML7700_error_t err = readI2CRegister((VEML7700_t *)&_highThreshold, VEML7700_HIGH_THRESHOLD);
+    if (err != VEML7700_ERROR_SUCCESS)
+      return (err);
+    _highThresholdValid = true;
+  }
+  *threshold = _highThreshold;
+  return (VEML7700_ERROR_SUCCESS);
 }
 
 /**************************************************************************/
@@ -611,7 +636,10 @@ uint16_t VEML7700::getHighThreshold()
 /**************************************************************************/
 VEML7700_error_t VEML7700::setLowThreshold(uint16_t threshold)
 {
-  return (writeI2CRegister((VEML7700_t)threshold, VEML7700_LOW_THRESHOLD));
+  VEML7700_error_t err = writeI2CRegister((VEML7700_t)threshold, VEML7700_LOW_THRESHOLD);
+  _lowThreshold = threshold;
+  _lowThresholdValid = (err == VEML7700_ERROR_SUCCESS);
+  return (err);
 }
 
 /**************************************************************************/
@@ -624,7 +652,15 @@ VEML7700_error_t VEML7700::setLowThreshold(uint16_t threshold)
 /**************************************************************************/
 VEML7700_error_t VEML7700::getLowThreshold(uint16_t *threshold)
 {
-  return (readI2CRegister((VEML7700_t *)threshold, VEML7700_LOW_THRESHOLD));
+  if (!_lowThresholdValid)
+  {
+    VEML7700_error_t err = readI2CRegister((VEML7700_t *)&_lowThreshold, VEML7700_LOW_THRESHOLD);
+    if (err != VEML7700_ERROR_SUCCESS)
+      return (err);
+    _lowThresholdValid = true;
+  }
+  *threshold = _lowThreshold;
+  return (VEML7700_ERROR_SUCCESS);
 }
 
 /**************************************************************************/
@@ -643,6 +679,8 @@ uint16_t VEML7700::getLowThreshold()
 /**************************************************************************/
 /*!
     @brief  Get the VEML7700's ambient light sensor data (ALS)
+            <br>The ALS register only updates once per integration time.
+            <br>Repeat calls within the integration time return the cached value.
     @param  ambient
             <br>Will be set to the ambient level on return
     @return VEML7700_SUCCESS (VEML7700_ERROR_SUCCESS) if successful
@@ -650,7 +688,19 @@ uint16_t VEML7700::getLowThreshold()
 /**************************************************************************/
 VEML7700_error_t VEML7700::getAmbientLight(uint16_t *ambient)
 {
-  return (readI2CRegister((VEML7700_t *)ambient, VEML7700_ALS_OUTPUT));
+  if ((!_ambientValid) || (!sampleIsFresh(_ambientReadTime)))
+  {
+    VEML7700_error_t err = readI2CRegister((VEML7700_t *)&_ambient, VEML7700_ALS_OUTPUT);
+    if (err != VEML7700_ERROR_SUCCESS)
+    {
+      _ambientValid = false;
+      return (err);
+    }
+    _ambientReadTime = millis();
+    _ambientValid = true;
+  }
+  *ambient = _ambient;
+  return (VEML7700_ERROR_SUCCESS);
 }
 
 /**************************************************************************/
@@ -669,6 +719,8 @@ uint16_t VEML7700::getAmbientLight()
 /**************************************************************************/
 /*!
     @brief  Get the VEML7700's white level data (WHITE)
+            <br>The WHITE register only updates once per integration time.
+            <br>Repeat calls within the integration time return the cached value.
     @param  whiteLevel
             <br>Will be set to the white level on return
     @return VEML7700_SUCCESS (VEML7700_ERROR_SUCCESS) if successful
@@ -676,7 +728,19 @@ uint16_t VEML7700::getAmbientLight()
 /**************************************************************************/
 VEML7700_error_t VEML7700::getWhiteLevel(uint16_t *whiteLevel)
 {
-  return (readI2CRegister((VEML7700_t *)whiteLevel, VEML7700_WHITE_OUTPUT));
+  if ((!_whiteLevelValid) || (!sampleIsFresh(_whiteLevelReadTime)))
+  {
+    VEML7700_error_t err = readI2CRegister((VEML7700_t *)&_whiteLevel, VEML7700_WHITE_OUTPUT);
+    if (err != VEML7700_ERROR_SUCCESS)
+    {
+      _whiteLevelValid = false;
+      return (err);
+    }
+    _whiteLevelReadTime = millis();
+    _whiteLevelValid = true;
+  }
+  *whiteLevel = _whiteLevel;
+  return (VEML7700_ERROR_SUCCESS);
 }
 
 /**************************************************************************/
@@ -843,6 +907,41 @@ VEML7700_interrupt_status_t VEML7700::getInterruptStatus()
   return ((VEML7700_interrupt_status_t)isr.INT_STATUS_REG_INT_FLAGS);  
 }
 
+/** Read the configuration register into _configurationRegister - from the shadow if it is valid */
+VEML7700_error_t VEML7700::readConfigurationRegister(void)
+{
+  if (_configurationShadowValid)
+    return (VEML7700_ERROR_SUCCESS);
+
+  VEML7700_error_t err = readI2CRegister((VEML7700_t *)&_configurationRegister, VEML7700_CONFIGURATION_REGISTER);
+  _configurationShadowValid = (err == VEML7700_ERROR_SUCCESS);
+  return (err);
+}
+
+/** Write _configurationRegister to the device. The shadow is only valid if the write succeeds.
+    Any change to the configuration invalidates the cached ALS and WHITE samples. */
+VEML7700_error_t VEML7700::writeConfigurationRegister(void)
+{
+  VEML7700_error_t err = writeI2CRegister(_configurationRegister.all, VEML7700_CONFIGURATION_REGISTER);
+  _configurationShadowValid = (err == VEML7700_ERROR_SUCCESS);
+  _ambientValid = false;
+  _whiteLevelValid = false;
+  return (err);
+}
+
+/** Return true if a sample read at readTime is younger than the integration time - the data registers
+    cannot have changed since */
+bool VEML7700::sampleIsFresh(unsigned long readTime)
+{
+  if (!_configurationShadowValid)
+    return (false);
+  VEML7700_integration_time_t it = integrationTimeFromConfig((VEML7700_config_integration_time_t)_configurationRegister.CONFIG_REG_IT);
+  if (it == VEML7700_INTEGRATION_INVALID)
+    return (false);
+  unsigned long integrationMillis = 25UL << (uint8_t)it; // 25ms, 50ms, ..., 800ms
+  return ((millis() - readTime) < integrationMillis);
+}
+
 VEML7700_error_t VEML7700::readI2CBuffer(uint8_t *dest, VEML7700_registers_t startRegister, uint16_t len)
 {
   _i2cPort->beginTransmission(_deviceAddress);
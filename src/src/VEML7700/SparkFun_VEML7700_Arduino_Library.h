@@ -187,6 +187,7 @@ private:
     };
   } VEML7700_CONFIGURATION_REGISTER_t;
   VEML7700_CONFIGURATION_REGISTER_t _configurationRegister;
+  bool _configurationShadowValid; // True when _configurationRegister matches the device. Configuration reads then come from RAM
 
   /** Provide bit field access to the interrupt status register
       Note: reading the interrupt status register clears the interrupts.
@@ -234,6 +235,20 @@ private:
   uint8_t _deviceAddress;
   bool _debugEnabled;
 
+  /** Write-through shadows of the threshold registers */
+  uint16_t _highThreshold;
+  bool _highThresholdValid;
+  uint16_t _lowThreshold;
+  bool _lowThresholdValid;
+
+  /** Cached ALS and WHITE samples. Reused until the integration time has elapsed */
+  uint16_t _ambient;
+  unsigned long _ambientReadTime;
+  bool _ambientValid;
+  uint16_t _whiteLevel;
+  unsigned long _whiteLevelReadTime;
+  bool _whiteLevelValid;
+
   VEML7700_error_t _connected(void);
 
   /** I2C Read/Write */
@@ -242,6 +257,11 @@ private:
   VEML7700_error_t readI2CRegister(VEML7700_t *dest, VEML7700_registers_t registerAddress);
   VEML7700_error_t writeI2CRegister(VEML7700_t data, VEML7700_registers_t registerAddress);
 
+  /** Configuration register shadow */
+  VEML7700_error_t readConfigurationRegister(void);
+  VEML7700_error_t writeConfigurationRegister(void);
+  bool sampleIsFresh(unsigned long readTime);
+
   /** Convert the (sequential) integration time into the corresponding (non-sequential) configuration value */
   VEML7700_config_integration_time_t integrationTimeConfig(VEML7700_integration_time_t it);
   /** Convert the (non-sequential) integration time config into the corresponding (sequential) integration time */
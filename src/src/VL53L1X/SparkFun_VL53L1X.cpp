@@ -260,6 +260,11 @@ uint8_t SFEVL53L1X::getRangeStatus()
 	return temp;
 }
 
+bool SFEVL53L1X::getResult(VL53L1X_Result_t *result)
+{
+	return (_device->VL53L1X_GetResult(result) == 0);
+}
+
 void SFEVL53L1X::setOffset(int16_t offset)
 {
 	_device->VL53L1X_SetOffset(offset);
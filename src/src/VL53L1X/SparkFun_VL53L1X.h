@@ -92,6 +92,7 @@ class SFEVL53L1X
 	uint16_t getSpadNb(); //Returns the current number of enabled SPADs
 	uint16_t getAmbientRate(); // Returns the total ambinet rate in kcps. All SPADs combined.
 	uint8_t getRangeStatus(); //Returns the range status, which can be any of the following. 0 = no error, 1 = signal fail, 2 = sigma fail, 7 = wrapped target fail
+	bool getResult(VL53L1X_Result_t *result); //Returns the range status, distance, ambient rate, signal rate and SPAD count using a single block read. Returns true if successful
 	void setOffset(int16_t offset); //Manually set an offset in mm
 	int16_t getOffset(); //Get the current offset in mm
 	void setXTalk(uint16_t xTalk); //Manually set the value of crosstalk in counts per second (cps), which is interference from any sort of window in front of your sensor.
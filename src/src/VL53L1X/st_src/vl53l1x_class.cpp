@@ -576,6 +576,29 @@ VL53L1X_ERROR VL53L1X::VL53L1X_GetRangeStatus(uint8_t *rangeStatus)
 	uint8_t RgSt;
 
 	status = VL53L1_RdByte(Device, VL53L1_RESULT__RANGE_STATUS, &RgSt);
+	*rangeStatus = VL53L1X_MapRangeStatus(RgSt);
+	return status;
+}
+
+VL53L1X_ERROR VL53L1X::VL53L1X_GetResult(VL53L1X_Result_t *pResult)
+{
+	VL53L1X_ERROR status = 0;
+	uint8_t Temp[17];
+
+	status = VL53L1_ReadMulti(Device, VL53L1_RESULT__RANGE_STATUS, Temp, 17);
+	if (status == 0)
+	{
+		pResult->Status = VL53L1X_MapRangeStatus(Temp[0]);
+		pResult->Ambient = (Temp[7] << 8 | Temp[8]) * 8;
+		pResult->NumSPADs = Temp[3];
+		pResult->SigPerSPAD = (Temp[15] << 8 | Temp[16]) * 8;
+		pResult->Distance = Temp[13] << 8 | Temp[14];
+	}
+	return status;
+}
+
+uint8_t VL53L1X::VL53L1X_MapRangeStatus(uint8_t RgSt)
+{
 	RgSt = RgSt & 0x1F;
 	switch (RgSt)
 	{
@@ -622,8 +645,7 @@ VL53L1X_ERROR VL53L1X::VL53L1X_GetRangeStatus(uint8_t *rangeStatus)
 		RgSt = 255;
 		break;
 	}
-	*rangeStatus = RgSt;
-	return status;
+	return RgSt;
 }
 
 VL53L1X_ERROR VL53L1X::VL53L1X_SetOffset(int16_t OffsetValue)
@@ -114,6 +114,17 @@ typedef struct {
 	uint32_t     revision; /*!< revision number */
 } VL53L1X_Version_t;
 
+/**
+ *  @brief defines packed reading results type
+ */
+typedef struct {
+	uint8_t      Status;     /*!< ranging status (0-23, mapped as VL53L1X_GetRangeStatus) */
+	uint16_t     Distance;   /*!< distance in mm */
+	uint16_t     Ambient;    /*!< ambient rate in kcps */
+	uint16_t     SigPerSPAD; /*!< signal rate in kcps (as VL53L1X_GetSignalRate) */
+	uint16_t     NumSPADs;   /*!< number of enabled SPADs */
+} VL53L1X_Result_t;
+
 
 typedef struct {
 
@@ -402,6 +413,12 @@ class VL53L1X : public RangeSensor
 	 */
 	VL53L1X_ERROR VL53L1X_GetRangeStatus(uint8_t *rangeStatus);
 
+	/**
+	 * @brief This function returns the ranging status, distance, ambient rate, signal rate and SPAD count \n
+	 * using a single 17-byte block read starting at VL53L1_RESULT__RANGE_STATUS
+	 */
+	VL53L1X_ERROR VL53L1X_GetResult(VL53L1X_Result_t *pResult);
+
 	/**
 	 * @brief This function programs the offset correction in mm
 	 * @param OffsetValue:the offset correction value to program in mm
@@ -529,6 +546,8 @@ class VL53L1X : public RangeSensor
 
  protected:
     
+    /* Map the raw RESULT__RANGE_STATUS value to the ranging status error reported by VL53L1X_GetRangeStatus */
+    uint8_t VL53L1X_MapRangeStatus(uint8_t RgSt);
 
     /* Write and read functions from I2C */
 